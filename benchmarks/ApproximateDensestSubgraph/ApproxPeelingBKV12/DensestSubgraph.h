@@ -100,6 +100,20 @@ double WorkEfficientDensestSubgraph(Graph& G, double epsilon = 0.001) {
     auto degree_seq = pbbslib::make_sequence<size_t>(vtxs_remaining.size(), degree_f);
     long edges_remaining = pbbslib::reduce_add(degree_seq);
 
+    // Early exit: every future candidate is a subset of the remaining
+    // vertices, and any subgraph's (bidirectional) density is bounded by
+    // its maximum degree, which only shrinks as peeling proceeds. Once the
+    // remaining max degree cannot beat the best density already found, the
+    // remaining rounds -- typically many rounds peeling a sub-0.1% tail --
+    // cannot improve the answer.
+    size_t max_deg_remaining = pbbslib::reduce_max(degree_seq);
+    if ((double)max_deg_remaining <= max_density) {
+      debug(std::cout << "early exit on round " << round
+                      << ": max remaining degree " << max_deg_remaining
+                      << " <= best density " << max_density << std::endl;);
+      break;
+    }
+
     // Update density
     double current_density = ((double)edges_remaining) / ((double)vtxs_remaining.size());
     double target_density = (density_multiplier*((double)edges_remaining)) / ((double)vtxs_remaining.size());
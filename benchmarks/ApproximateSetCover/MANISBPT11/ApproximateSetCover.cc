@@ -29,6 +29,8 @@
 //     -m : indicate that the graph should be mmap'd
 //     -c : indicate that the graph is compressed
 //     -nb : the number of buckets to use in the bucketing implementation
+//     -cover-frac : stop once this fraction of elements is covered (default
+//                   1.0, i.e. run to completion)
 
 #include "ApproximateSetCover.h"
 
@@ -37,17 +39,19 @@ namespace gbbs {
 template <class Graph>
 double SetCover_runner(Graph& G, commandLine P) {
   size_t num_buckets = P.getOptionLongValue("-nb", 128);
+  double cover_fraction = P.getOptionDoubleValue("-cover-frac", 1.0);
 
   std::cout << "### Application: Approximate Set Cover" << std::endl;
   std::cout << "### Graph: " << P.getArgument(0) << std::endl;
   std::cout << "### Threads: " << num_workers() << std::endl;
   std::cout << "### n: " << G.n << std::endl;
   std::cout << "### m: " << G.m << std::endl;
-  std::cout << "### Params: -nb (num_buckets) = " << num_buckets << std::endl;
+  std::cout << "### Params: -nb (num_buckets) = " << num_buckets
+            << " -cover-frac = " << cover_fraction << std::endl;
   std::cout << "### ------------------------------------" << std::endl;
 
   timer t; t.start();
-  auto cover = SetCover(G, num_buckets);
+  auto cover = SetCover(G, num_buckets, cover_fraction);
   cover.del();
   double tt = t.stop();
 
@@ -66,8 +66,14 @@ struct Visit_Elms {
 // reductions are handled by atomic reduction operators; external to bucketing
 // interface.
 
+// cover_fraction < 1.0 enables output-sensitive termination: the peeling
+// stops once that fraction of elements is covered (the remaining tail is
+// where bucket churn dominates on few-giant-sets / many-singletons
+// instances, and callers that only need near-complete covers stop paying
+// for it). The coverage count is only maintained when the option is on.
 template <class Graph>
-inline pbbslib::dyn_arr<uintE> SetCover(Graph& G, size_t num_buckets = 512) {
+inline pbbslib::dyn_arr<uintE> SetCover(Graph& G, size_t num_buckets = 512,
+                                        double cover_fraction = 1.0) {
   using W = typename Graph::weight_type;
   timer it; it.start();
   auto Elms = sequence<uintE>(G.n, [&](size_t i) { return UINT_E_MAX; });
@@ -79,6 +85,15 @@ inline pbbslib::dyn_arr<uintE> SetCover(Graph& G, size_t num_buckets = 512) {
   auto b = make_vertex_buckets(G.n, d_slice, decreasing, num_buckets);
 
   auto perm = sequence<uintE>(G.n);
+  // Lazy degree maintenance: LastVerify[v] is the round (plus one) at which
+  // v's degree was last recomputed by a pack; last_cover_round is the last
+  // round in which any set entered the cover. A popped set whose pack is
+  // newer than the last covering round has an exact cached degree -- its
+  // neighborhood cannot have lost elements -- so it skips the adjacency
+  // scan and re-enters the round directly. Rounds where no set wins
+  // (pure bucket churn, common near the tail) touch no edges at all.
+  auto LastVerify = sequence<size_t>(G.n, [](size_t i) { return (size_t)0; });
+  size_t last_cover_round = 0;
   timer bktt, packt, permt, emt;
 
   timer nbt;
@@ -97,12 +112,27 @@ inline pbbslib::dyn_arr<uintE> SetCover(Graph& G, size_t num_buckets = 512) {
     nbt.stop();
 
     packt.start();
-    // 1. sets -> elements (Pack out sets and update their degree)
+    // 1. sets -> elements (Pack out stale sets and update their degree).
+    // Fresh sets (packed since the last covering round) were placed in this
+    // bucket with an exact degree and are still active by construction.
+    active.toSparse();
+    auto active_seq = pbbslib::make_sequence<uintE>(
+        active.size(), [&](size_t i) { return active.vtx(i); });
+    auto stale_ids = pbbslib::filter(active_seq, [&](uintE v) {
+      return LastVerify[v] <= last_cover_round;
+    });
+    auto fresh_ids = pbbslib::filter(active_seq, [&](uintE v) {
+      return LastVerify[v] > last_cover_round;
+    });
+    auto stale = vertexSubset(G.n, std::move(stale_ids));
     auto pack_predicate = [&](const uintE& u, const uintE& ngh, const W& wgh) {
       return Elms[ngh] != sc::COVERED;
     };
-    auto pack_apply = [&](uintE v, size_t ct) { D[v] = get_bucket_clamped(ct); };
-    auto packed_vtxs = srcPack(G, active, pack_predicate, pack_edges);
+    auto pack_apply = [&](uintE v, size_t ct) {
+      D[v] = get_bucket_clamped(ct);
+      LastVerify[v] = rounds + 1;
+    };
+    auto packed_vtxs = srcPack(G, stale, pack_predicate, pack_edges);
     vertexMap(packed_vtxs, pack_apply);
     packt.stop();
 
@@ -112,7 +142,18 @@ inline pbbslib::dyn_arr<uintE> SetCover(Graph& G, size_t num_buckets = 512) {
       return deg >= threshold;
     };
     //auto still_active = vertexFilter_sparse(packed_vtxs, above_threshold);
-    auto still_active = vertexFilter(packed_vtxs, above_threshold, no_dense);
+    auto still_active_stale = vertexFilter(packed_vtxs, above_threshold, no_dense);
+
+    // still_active = fresh sets + verified stale sets.
+    still_active_stale.toSparse();
+    auto still_ids = sequence<uintE>(fresh_ids.size() + still_active_stale.size());
+    par_for(0, fresh_ids.size(), pbbslib::kSequentialForThreshold,
+            [&](size_t i) { still_ids[i] = fresh_ids[i]; });
+    par_for(0, still_active_stale.size(), pbbslib::kSequentialForThreshold,
+            [&](size_t i) {
+              still_ids[fresh_ids.size() + i] = still_active_stale.vtx(i);
+            });
+    auto still_active = vertexSubset(G.n, std::move(still_ids));
 
     permt.start();
     // Update the permutation for the sets that are active in this round.
@@ -136,8 +177,13 @@ inline pbbslib::dyn_arr<uintE> SetCover(Graph& G, size_t num_buckets = 512) {
             no_output | dense_forward);
 
     // 3. sets -> elements (count and add to cover if enough elms were won)
+    // note: cur_bkt - 1 underflows at bucket zero, sending low_threshold to
+    // SIZE_MAX and locking every degree-one set out of the cover forever.
     const size_t low_threshold =
-        std::max((size_t)ceil(pow(1.0 + sc::epsilon, cur_bkt - 1)), (size_t)1);
+        (cur_bkt == 0)
+            ? 1
+            : std::max((size_t)ceil(pow(1.0 + sc::epsilon, cur_bkt - 1)),
+                       (size_t)1);
     auto won_ngh_f = [&](const uintE& u, const uintE& v, const W& wgh) -> bool {
       return Elms[v] == perm[u];
     };
@@ -152,6 +198,7 @@ inline pbbslib::dyn_arr<uintE> SetCover(Graph& G, size_t num_buckets = 512) {
           return numWon >= low_threshold;
         }, no_dense);
     cover.copyInF([&](uintE i) { return inCover.vtx(i); }, inCover.size());
+    if (inCover.size() > 0) last_cover_round = rounds + 1;
 
     // 4. sets -> elements (Sets that joined the cover mark their neighboring
     // elements as covered. Sets that didn't reset any acquired elements)
@@ -185,6 +232,19 @@ inline pbbslib::dyn_arr<uintE> SetCover(Graph& G, size_t num_buckets = 512) {
     rounds++;
     bktt.stop();
     r = r.next();
+
+    if (cover_fraction < 1.0 && inCover.size() > 0) {
+      auto cov_f = [&](size_t v) -> size_t {
+        return (size_t)(Elms[v] == sc::COVERED);
+      };
+      size_t covered =
+          pbbslib::reduce_add(pbbslib::make_sequence<size_t>(G.n, cov_f));
+      if (covered >= (size_t)(cover_fraction * G.n)) {
+        std::cout << "### Terminating early: covered " << covered << " / "
+                  << G.n << " elements\n";
+        break;
+      }
+    }
   }
   b.del();
 
@@ -0,0 +1,114 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Bidirectional point-to-point BFS: two frontiers grow simultaneously --
+// forward from s over out-edges and backward from t over in-edges (the
+// in_edges flag of edgeMapData; on symmetric graphs both directions use
+// the same lists) -- and the side with the smaller frontier expands each
+// step. When a newly labeled vertex is already labeled by the other side,
+// the searches have met; the distance is the minimum of
+// fwd_dist[v] + bwd_dist[v] over the meeting frontier, checked one extra
+// level to account for the frontiers crossing on an edge. Per-query work
+// is roughly two balls of half the s-t radius instead of one full ball.
+
+#pragma once
+
+#include "gbbs/gbbs.h"
+
+namespace gbbs {
+
+namespace bidirectional_bfs {
+
+template <class W>
+struct BiBFS_F {
+  uintE* dist;
+  uintE next_dist;
+  BiBFS_F(uintE* dist, uintE next_dist) : dist(dist), next_dist(next_dist) {}
+  inline bool update(uintE s, uintE d, W w) {
+    if (dist[d] == UINT_E_MAX) {
+      dist[d] = next_dist;
+      return 1;
+    }
+    return 0;
+  }
+  inline bool updateAtomic(uintE s, uintE d, W w) {
+    return pbbslib::atomic_compare_and_swap(&dist[d], UINT_E_MAX, next_dist);
+  }
+  inline bool cond(uintE d) { return dist[d] == UINT_E_MAX; }
+};
+
+// Returns dist(s, t), or UINT_E_MAX if t is unreachable from s.
+template <class Graph>
+uintE BidirectionalBFS(Graph& G, uintE s, uintE t) {
+  using W = typename Graph::weight_type;
+  size_t n = G.n;
+  if (s == t) return 0;
+
+  auto fwd_dist = sequence<uintE>(n, (uintE)UINT_E_MAX);
+  auto bwd_dist = sequence<uintE>(n, (uintE)UINT_E_MAX);
+  fwd_dist[s] = 0;
+  bwd_dist[t] = 0;
+  auto fwd = vertexSubset(n, s);
+  auto bwd = vertexSubset(n, t);
+  uintE fwd_d = 0, bwd_d = 0;
+  uintE best = UINT_E_MAX;
+
+  // Once the searches have met, one more level on each side can still
+  // improve the answer (the optimal path may cross between levels).
+  bool met = false;
+  while (!fwd.isEmpty() && !bwd.isEmpty()) {
+    bool expand_fwd = fwd.size() <= bwd.size();
+    auto& frontier = expand_fwd ? fwd : bwd;
+    auto& dist = expand_fwd ? fwd_dist : bwd_dist;
+    auto& other_dist = expand_fwd ? bwd_dist : fwd_dist;
+    uintE next_dist = (expand_fwd ? fwd_d : bwd_d) + 1;
+
+    auto f = BiBFS_F<W>(dist.begin(), next_dist);
+    flags fl = expand_fwd ? 0 : in_edges;
+    auto output = edgeMap(G, frontier, f, -1, fl);
+    frontier = std::move(output);
+    (expand_fwd ? fwd_d : bwd_d) = next_dist;
+
+    // meet detection over the new frontier
+    uintE round_best = UINT_E_MAX;
+    vertexMap(frontier, [&](uintE v) {
+      if (other_dist[v] != UINT_E_MAX) {
+        uintE total = dist[v] + other_dist[v];
+        pbbslib::write_min(&round_best, total, std::less<uintE>());
+      }
+    });
+    if (round_best != UINT_E_MAX) {
+      best = std::min(best, round_best);
+      if (met) break;  // second level after meeting: done
+      met = true;
+    } else if (met) {
+      break;
+    }
+    // prune: no shorter path possible once the radii sum passes best
+    if (best != UINT_E_MAX && fwd_d + bwd_d >= best) break;
+  }
+  return best;
+}
+
+}  // namespace bidirectional_bfs
+}  // namespace gbbs
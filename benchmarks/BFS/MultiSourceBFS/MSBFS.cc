@@ -0,0 +1,72 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Usage:
+// numactl -i all ./MSBFS -src 10 -nsrc 64 -s -m twitter_SJ
+// flags:
+//   required:
+//     -s : indicate that the graph is symmetric
+//   optional:
+//     -src:  the first source; sources are src, src+1, ..., src+nsrc-1
+//     -nsrc: number of sources in the batch (<= 64)
+//     -m : indicate that the graph should be mmap'd
+//     -c : indicate that the graph is compressed
+
+#include "MSBFS.h"
+
+namespace gbbs {
+
+template <class Graph>
+double MSBFS_runner(Graph& G, commandLine P) {
+  uintE src = static_cast<uintE>(P.getOptionLongValue("-src", 0));
+  size_t nsrc = static_cast<size_t>(P.getOptionLongValue("-nsrc", 64));
+  if (nsrc > 64) nsrc = 64;
+  std::cout << "### Application: MSBFS" << std::endl;
+  std::cout << "### Graph: " << P.getArgument(0) << std::endl;
+  std::cout << "### Threads: " << num_workers() << std::endl;
+  std::cout << "### n: " << G.n << std::endl;
+  std::cout << "### m: " << G.m << std::endl;
+  std::cout << "### Params: -src = " << src << " -nsrc = " << nsrc
+            << std::endl;
+  std::cout << "### ------------------------------------" << std::endl;
+
+  auto sources = sequence<uintE>(
+      nsrc, [&](size_t k) { return (uintE)((src + k) % G.n); });
+
+  timer t; t.start();
+  auto [visited, rounds] = MSBFS(G, sources);
+  double tt = t.stop();
+
+  size_t total_reached = 0;
+  for (size_t i = 0; i < G.n; i++) {
+    total_reached += __builtin_popcountll(visited[i]);
+  }
+  std::cout << "Total (source, vertex) pairs reached: " << total_reached
+            << std::endl;
+  std::cout << "### Running Time: " << tt << std::endl;
+  return tt;
+}
+
+}  // namespace gbbs
+
+generate_main(gbbs::MSBFS_runner, false);
@@ -0,0 +1,116 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Multi-source BFS (MS-BFS): up to 64 sources run together, one bit per
+// source packed into a machine word per vertex. Each edge is read once per
+// round for the whole batch -- the bit masks of all sources propagate
+// through a single edgeMap traversal with the usual direction
+// optimization -- amortizing edge reads ~64x over sequential single-source
+// runs. visited[v] holds the sources that have reached v; round_reached[v]
+// records the round the first source arrived (per-source distances can be
+// recovered by re-running per word if needed; the similarity workloads this
+// serves consume the masks directly).
+
+#pragma once
+
+#include "gbbs/gbbs.h"
+
+namespace gbbs {
+
+struct MSBFS_F {
+  uint64_t* visited;
+  uint64_t* next_bits;
+  uint64_t batch_mask;  // bits of the sources actually in this batch
+  MSBFS_F(uint64_t* visited, uint64_t* next_bits, uint64_t batch_mask)
+      : visited(visited), next_bits(next_bits), batch_mask(batch_mask) {}
+
+  // Propagates s's mask to d; succeeds (adds d to the output frontier)
+  // only for the call that contributes d's first new bits this round.
+  inline bool update(uintE s, uintE d, pbbslib::empty w) {
+    uint64_t new_bits = visited[s] & ~visited[d] & ~next_bits[d];
+    if (new_bits == 0) return false;
+    bool first = (next_bits[d] == 0);
+    next_bits[d] |= new_bits;
+    return first;
+  }
+
+  inline bool updateAtomic(uintE s, uintE d, pbbslib::empty w) {
+    uint64_t new_bits = visited[s] & ~visited[d];
+    if (new_bits == 0) return false;
+    while (true) {
+      uint64_t cur = next_bits[d];
+      uint64_t add = new_bits & ~cur;
+      if (add == 0) return false;
+      if (pbbslib::atomic_compare_and_swap(&next_bits[d], cur, cur | add)) {
+        // the call that installs d's first pending bits emits it
+        return cur == 0;
+      }
+    }
+  }
+
+  // A vertex already reached by every source in the batch is done.
+  inline bool cond(uintE d) { return (visited[d] & batch_mask) != batch_mask; }
+};
+
+// Runs BFS from up to 64 sources simultaneously. Returns (visited masks,
+// first-arrival rounds): visited[v] bit k is set iff sources[k] reaches v.
+template <class Graph>
+inline std::tuple<sequence<uint64_t>, sequence<uintE>> MSBFS(
+    Graph& G, sequence<uintE> const& sources) {
+  using W = typename Graph::weight_type;
+  static_assert(std::is_same<W, pbbslib::empty>::value,
+                "MS-BFS runs on unweighted graphs");
+  size_t n = G.n;
+  size_t batch = sources.size();
+  assert(batch <= 64);
+
+  auto visited = sequence<uint64_t>(n, (uint64_t)0);
+  auto next_bits = sequence<uint64_t>(n, (uint64_t)0);
+  auto round_reached = sequence<uintE>(n, UINT_E_MAX);
+
+  auto init = sequence<uintE>(batch, [&](size_t k) { return sources[k]; });
+  for (size_t k = 0; k < batch; k++) {
+    visited[sources[k]] |= (uint64_t{1} << k);
+    round_reached[sources[k]] = 0;
+  }
+  auto Frontier = vertexSubset(n, sequence<uintE>(init));
+
+  uintE round = 0;
+  while (!Frontier.isEmpty()) {
+    round++;
+    uint64_t batch_mask =
+        (batch == 64) ? ~uint64_t{0} : ((uint64_t{1} << batch) - 1);
+    auto f = MSBFS_F(visited.begin(), next_bits.begin(), batch_mask);
+    auto output = edgeMap(G, Frontier, f, -1);
+    Frontier = std::move(output);
+    // fold the pending bits into visited and stamp first arrivals
+    vertexMap(Frontier, [&](uintE v) {
+      if (round_reached[v] == UINT_E_MAX) round_reached[v] = round;
+      visited[v] |= next_bits[v];
+      next_bits[v] = 0;
+    });
+  }
+  return std::make_tuple(std::move(visited), std::move(round_reached));
+}
+
+}  // namespace gbbs
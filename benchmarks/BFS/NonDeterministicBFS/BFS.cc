@@ -33,6 +33,7 @@
 //     -s : indicate that the graph is symmetric
 
 #include "BFS.h"
+#include "gbbs/residency.h"
 
 namespace gbbs {
 
@@ -48,9 +49,21 @@ double BFS_runner(Graph& G, commandLine P) {
   std::cout << "### ------------------------------------" << std::endl;
   std::cout << "### ------------------------------------" << std::endl;
 
+  // -prefetch: semi-external mode; madvise the frontier's edge blocks
+  // before each sparse traversal (pair with -m on an mmap'd snapshot)
+  flags extra_fl = P.getOption("-prefetch") ? prefetch_edges : 0;
+  // -residency: mincore profile of the edge region before and after
+  bool track_residency = P.getOption("-residency");
+  auto first_range = G.edge_range_bytes(0);
+  auto last_range = G.edge_range_bytes((uintE)(G.n - 1));
+  size_t edge_bytes =
+      (size_t)((last_range.first + last_range.second) - first_range.first);
+  auto R = residency::tracker(first_range.first, edge_bytes);
+  if (track_residency) R.report("before");
   timer t; t.start();
-  auto parents = BFS(G, src);
+  auto parents = BFS(G, src, extra_fl);
   double tt = t.stop();
+  if (track_residency) R.report("after bfs");
 
   std::cout << "### Running Time: " << tt << std::endl;
   return tt;
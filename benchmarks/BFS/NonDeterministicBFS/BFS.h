@@ -46,7 +46,7 @@ struct BFS_F {
 };
 
 template <class Graph>
-inline sequence<uintE> BFS(Graph& G, uintE src) {
+inline sequence<uintE> BFS(Graph& G, uintE src, flags extra_fl = 0) {
   using W = typename Graph::weight_type;
   /* Creates Parents array, initialized to all -1, except for src. */
   auto Parents = sequence<uintE>(G.n, [&](size_t i) { return UINT_E_MAX; });
@@ -57,7 +57,8 @@ inline sequence<uintE> BFS(Graph& G, uintE src) {
   while (!Frontier.isEmpty()) {
     std::cout << Frontier.size() << "\n";
     reachable += Frontier.size();
-    Frontier = edgeMap(G, Frontier, BFS_F<W>(Parents.begin()), -1, sparse_blocked | dense_parallel);
+    Frontier = edgeMap(G, Frontier, BFS_F<W>(Parents.begin()), -1,
+                       sparse_blocked | dense_parallel | extra_fl);
   }
   std::cout << "Reachable: " << reachable << "\n";
   return Parents;
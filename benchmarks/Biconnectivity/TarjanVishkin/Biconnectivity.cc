@@ -146,7 +146,17 @@ double Biconnectivity_runner(symmetric_graph<vertex, W>& GA, commandLine P) {
     BiconnectivityStats(GA, in_f);
   } else {
     timer t; t.start();
-    Biconnectivity(GA, out_f);
+    if (P.getOption("-index")) {
+      // build the compact query index instead of writing per-edge labels
+      auto [parents, cc] = Biconnectivity(GA);
+      auto index = bicc_query_index(GA.n, parents, cc, bc::VAL_MASK);
+      std::cout << "num cut vertices = " << index.num_cut_vertices()
+                << std::endl;
+      pbbslib::free_array(parents);
+      pbbslib::free_array(cc);
+    } else {
+      Biconnectivity(GA, out_f);
+    }
     double tt = t.stop();
     std::cout << "### Running Time: " << tt << std::endl;
   }
@@ -29,6 +29,7 @@
 #include "gbbs/pbbslib/dyn_arr.h"
 #include "pbbslib/random.h"
 #include "pbbslib/sample_sort.h"
+#include "pbbslib/semisort.h"
 #include "pbbslib/strings/string_basics.h"
 
 namespace gbbs {
@@ -113,30 +114,24 @@ inline std::tuple<labels*, uintE*, uintE*> preorder_number(symmetric_graph<verte
   auto edges = pbbslib::filter(
       out_edges, [](const edge& e) { return std::get<0>(e) != UINT_E_MAX; });
   out_edges.clear();
-  auto sort_tup = [](const edge& l, const edge& r) { return l < r; };
-  pbbslib::sample_sort_inplace(edges.slice(), sort_tup, true);
 
-  auto starts = sequence<uintE>(n + 1, [](size_t i) { return UINT_E_MAX; });
-  par_for(0, edges.size(), [&] (size_t i) {
-    if (i == 0 || std::get<0>(edges[i]) != std::get<0>(edges[i - 1])) {
-      starts[std::get<0>(edges[i])] = i;
-    }
+  // Group the tree edges by parent with the semisort group-by: the CSR
+  // built below only needs each parent's children contiguous, not the
+  // parents in id order, so the comparison sort (and the sequential
+  // backward fill over empty parents it required) is unnecessary.
+  auto group_starts = sequence<uintE>(n, (uintE)0);
+  auto group_degs = sequence<uintE>(n, (uintE)0);
+  auto get_parent = [](const edge& e) { return std::get<0>(e); };
+  auto grouped = pbbs::group_by_ranges(edges, get_parent,
+                                       [&](uintE key, size_t s, size_t e) {
+    group_starts[key] = (uintE)s;
+    group_degs[key] = (uintE)(e - s);
   });
-  starts[n] = edges.size();
-
-  timer seq;
-  seq.start();
-  for (long i = starts.size() - 1; i >= 0; i--) {
-    if (starts[i] == UINT_E_MAX) {
-      starts[i] = starts[i + 1];
-    }
-  }
-  seq.stop();
-  debug(seq.reportTotal("seq time"););
+  edges.clear();
 
   auto nghs = sequence<uintE>(
-      edges.size(), [&](size_t i) { return std::get<1>(edges[i]); });
-  edges.clear();
+      grouped.size(), [&](size_t i) { return std::get<1>(grouped[i]); });
+  grouped.clear();
 
   timer augs;
   augs.start();
@@ -146,10 +141,8 @@ inline std::tuple<labels*, uintE*, uintE*> preorder_number(symmetric_graph<verte
   auto v_out = pbbslib::new_array_no_init<vertex_data>(n);
   auto v_in = pbbslib::new_array_no_init<vertex_data>(n);
   par_for(0, n, [&] (size_t i) {
-    uintE out_off = starts[i];
-    uintE out_deg = starts[i + 1] - out_off;
-    v_out[i].offset = out_off;
-    v_out[i].degree = out_deg;
+    v_out[i].offset = group_starts[i];
+    v_out[i].degree = group_degs[i];
 
     uintE parent = Parents[i];
     if (parent != i) {
@@ -167,10 +160,7 @@ inline std::tuple<labels*, uintE*, uintE*> preorder_number(symmetric_graph<verte
   auto cts =
       sequence<intE>(n, [&](size_t i) { return Tree.get_vertex(i).out_degree(); });
   auto leaf_im = pbbslib::make_sequence<bool>(n, [&](size_t i) {
-    auto s_i = starts[i];
-    auto s_n = starts[i + 1];
-    size_t deg = s_n - s_i;
-    return (Parents[i] != i) && deg == 0;
+    return (Parents[i] != i) && group_degs[i] == 0;
   });
   auto leafs = pbbslib::pack_index<uintE>(leaf_im);
 
@@ -520,6 +510,81 @@ inline std::tuple<uintE*, uintE*> critical_connectivity(
   return std::make_tuple(Parents, cc.to_array());
 }
 
+// A compact query structure over the biconnectivity labeling: instead of
+// materializing per-edge labels, each vertex keeps its sorted, deduplicated
+// list of incident biconnected-component ids in a CSR layout (every tree
+// edge (i, parent(i)) carries label cc[i] and is incident to both
+// endpoints). Queries: a cut vertex is one incident to >= 2 components, a
+// "same biconnected component" query intersects two (typically tiny)
+// sorted lists, and a tree edge's component is cc[child]. A block-cut tree
+// with range_min LCA was considered but rejected: the incident-component
+// lists answer the same queries in effectively constant time without
+// building another tree.
+struct bicc_query_index {
+  size_t n;
+  sequence<uintT> offsets;   // n + 1
+  sequence<uintE> comps;     // sorted component ids per vertex
+
+  // Builds from the (Parents, cc) labeling that Biconnectivity computes.
+  bicc_query_index(size_t n, uintE* Parents, uintE* cc, uintE val_mask)
+      : n(n) {
+    // each non-root vertex contributes (i, cc[i]) and (parent, cc[i])
+    using P = std::pair<uintE, uintE>;
+    auto pairs = sequence<P>::no_init(2 * n);
+    par_for(0, n, [&](size_t i) {
+      uintE parent = Parents[i] & val_mask;
+      if (parent != i && parent != UINT_E_MAX) {
+        pairs[2 * i] = P((uintE)i, cc[i]);
+        pairs[2 * i + 1] = P(parent, cc[i]);
+      } else {
+        pairs[2 * i] = P(UINT_E_MAX, UINT_E_MAX);
+        pairs[2 * i + 1] = P(UINT_E_MAX, UINT_E_MAX);
+      }
+    });
+    auto live = pbbs::filter(pairs, [&](const P& p) {
+      return p.first != UINT_E_MAX;
+    });
+    auto less = [](const P& a, const P& b) { return a < b; };
+    pbbs::sample_sort_inplace(live.slice(), less);
+
+    // dedupe (vertex, comp) and build CSR
+    auto keep = pbbslib::make_sequence<bool>(live.size(), [&](size_t i) {
+      return i == 0 || live[i] != live[i - 1];
+    });
+    auto uniq = pbbs::pack(live, keep);
+    offsets = sequence<uintT>(n + 1, (uintT)0);
+    for (size_t i = 0; i < uniq.size(); i++) offsets[uniq[i].first]++;
+    pbbslib::scan_add_inplace(offsets.slice());
+    comps = sequence<uintE>(uniq.size(), [&](size_t i) {
+      return uniq[i].second;
+    });
+  }
+
+  inline size_t num_incident(uintE v) const {
+    return offsets[v + 1] - offsets[v];
+  }
+  inline bool is_cut_vertex(uintE v) const { return num_incident(v) >= 2; }
+
+  // True when u and v share a biconnected component.
+  inline bool same_bicomp(uintE u, uintE v) const {
+    uintT i = offsets[u], iend = offsets[u + 1];
+    uintT j = offsets[v], jend = offsets[v + 1];
+    while (i < iend && j < jend) {
+      if (comps[i] == comps[j]) return true;
+      if (comps[i] < comps[j]) i++;
+      else j++;
+    }
+    return false;
+  }
+
+  size_t num_cut_vertices() const {
+    auto cut_im = pbbslib::make_sequence<size_t>(n, [&](size_t i) {
+      return (size_t)(num_incident(i) >= 2);
+    });
+    return pbbslib::reduce_add(cut_im);
+  }
+};
+
 // CC -> BFS from one source from each component = set of BFS trees in a single
 // array
 template <template <class W> class vertex, class W>
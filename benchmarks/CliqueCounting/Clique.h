@@ -46,6 +46,7 @@
 #include "induced_neighborhood.h"
 #include "induced_hybrid.h"
 #include "induced_split.h"
+#include "induced_bitset.h"
 #include "relabel.h"
 #include "peel.h"
 
@@ -125,6 +126,7 @@ inline size_t Clique_count(Graph& DG, size_t k, long space_type, bool label, boo
     else if (space_type == 3) count = induced_neighborhood::CountCliques(DG, k-1);
     else if (space_type == 5) count = induced_hybrid::CountCliques(DG, k-1, base_f, use_base, label, recursive_level);
     else if (space_type == 6) count = induced_split::CountCliques(DG, k-1, base_f, use_base, label, recursive_level);
+    else if (space_type == 7) count = induced_bitset::CountCliques(DG, k-1);
   } else { // if counting per vertex
     auto base_f = [&](uintE vtx, size_t _count) { per_vert[(vtx+worker_id()*n)] += _count; };
     // Everything except space_type = 5 should not be used -- for testing on larger graphs
@@ -34,20 +34,44 @@ struct HybridSpace_lw {
   bool free_relabel = true; // if true, take ownership of induced_edges, induced_degs, and relabel
   uintE* relabel = nullptr; // if counting per vertex, must undo local relabeling for 0 to alpha indices
   bool use_base = false; // if true, counting per vertex
+  // Capacities the buffers were actually sized for. The spaces persist per
+  // scheduler worker across parallel_for_alloc invocations (and therefore
+  // across queries), so alloc() must grow the buffers when a later query
+  // asks for more -- reusing a space sized by a small first query for a
+  // larger graph/k silently overran the old buffers.
+  size_t cap_induced = 0;
+  size_t cap_k = 0;
+  size_t cap_n = 0;
   HybridSpace_lw () {}
 
   void alloc(size_t max_induced, size_t k, size_t n, bool _use_old_labels, bool _use_base, bool _free_relabel=true) {
     use_old_labels = _use_old_labels;
     use_base = _use_base;
     free_relabel = _free_relabel;
-    if (induced == nullptr) induced = (uintE*) malloc(sizeof(uintE)*k*max_induced);
-    if (free_relabel && induced_degs == nullptr) induced_degs = (uintE*) malloc(sizeof(uintE)*max_induced);
-    if (labels == nullptr) labels = (char*) calloc(max_induced, sizeof(char));
+    if (induced == nullptr) { cap_induced = std::max(cap_induced, max_induced); cap_k = std::max(cap_k, k); }
+    if (max_induced > cap_induced || k > cap_k) {
+      // grow: release the old (undersized) buffers and reallocate below
+      if (induced) { free(induced); induced = nullptr; }
+      if (induced_degs) { free(induced_degs); induced_degs = nullptr; }
+      if (labels) { free(labels); labels = nullptr; }
+      if (induced_edges) { free(induced_edges); induced_edges = nullptr; }
+      if (num_induced) { free(num_induced); num_induced = nullptr; }
+      if (relabel) { free(relabel); relabel = nullptr; }
+      cap_induced = std::max(max_induced, cap_induced);
+      cap_k = std::max(k, cap_k);
+    }
+    if (n > cap_n) {
+      if (old_labels) { free(old_labels); old_labels = nullptr; }
+      cap_n = n;
+    }
+    if (induced == nullptr) induced = (uintE*) malloc(sizeof(uintE)*cap_k*cap_induced);
+    if (free_relabel && induced_degs == nullptr) induced_degs = (uintE*) malloc(sizeof(uintE)*cap_induced);
+    if (labels == nullptr) labels = (char*) calloc(cap_induced, sizeof(char));
     if (free_relabel && induced_edges == nullptr)
-      induced_edges = (uintE*) malloc(sizeof(uintE)*max_induced*max_induced);
-    if (num_induced == nullptr) num_induced = (uintE*) malloc(sizeof(uintE)*k);
-    if (free_relabel && use_old_labels && old_labels == nullptr) old_labels = (uintE*) calloc(n, sizeof(uintE));
-    if (free_relabel && use_base && relabel == nullptr) relabel = (uintE*) malloc(sizeof(uintE)*max_induced);
+      induced_edges = (uintE*) malloc(sizeof(uintE)*cap_induced*cap_induced);
+    if (num_induced == nullptr) num_induced = (uintE*) malloc(sizeof(uintE)*cap_k);
+    if (free_relabel && use_old_labels && old_labels == nullptr) old_labels = (uintE*) calloc(cap_n, sizeof(uintE));
+    if (free_relabel && use_base && relabel == nullptr) relabel = (uintE*) malloc(sizeof(uintE)*cap_induced);
   }
 
   void copy(HybridSpace_lw* space) {
@@ -0,0 +1,47 @@
+// Usage:
+// ./AffinityClustering -s [-maxrounds 50] [-sum] <graph>
+// flags:
+//   required:
+//     -s : indicates that the graph is symmetric
+//   optional:
+//     -w : indicate the graph is integer-weighted
+//     -maxrounds : level cap (default 50)
+//     -sum : sum-linkage aggregation (default: max / single linkage)
+//     -stats : print per-level cluster counts
+
+#include "AffinityClustering.h"
+
+namespace gbbs {
+
+template <class Graph>
+double AffinityClustering_runner(Graph& G, commandLine P) {
+  size_t max_rounds = P.getOptionLongValue("-maxrounds", 50);
+  bool sum_linkage = P.getOption("-sum");
+  std::cout << "### Application: AffinityClustering" << std::endl;
+  std::cout << "### Graph: " << P.getArgument(0) << std::endl;
+  std::cout << "### Threads: " << num_workers() << std::endl;
+  std::cout << "### n: " << G.n << std::endl;
+  std::cout << "### m: " << G.m << std::endl;
+  std::cout << "### Params: -maxrounds = " << max_rounds << " -sum = "
+            << sum_linkage << std::endl;
+  std::cout << "### ------------------------------------" << std::endl;
+  assert(P.getOption("-s"));
+
+  timer t; t.start();
+  auto R = affinity_clustering::AffinityClustering(G, max_rounds, sum_linkage);
+  double tt = t.stop();
+  std::cout << "### rounds = " << R.rounds << " clusters = "
+            << R.num_clusters << std::endl;
+  if (P.getOption("-stats")) {
+    for (size_t l = 0; l < R.level_sizes.size(); l++) {
+      std::cout << "### level " << l << ": " << R.level_sizes[l]
+                << " clusters" << std::endl;
+    }
+  }
+  std::cout << "### Running Time: " << tt << std::endl;
+  return tt;
+}
+
+}  // namespace gbbs
+
+generate_symmetric_weighted_main(gbbs::AffinityClustering_runner, false);
@@ -0,0 +1,168 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Parallel affinity / HAC-style clustering by repeated best-edge
+// contraction (Boruvka-shaped): every round each cluster hooks to its
+// best-weighted incident cluster -- the selection is a heap-free atomic
+// max-reduce with the (weight, neighbor) pair packed into one 64-bit word
+// -- 2-cycles break toward the smaller id, hook trees flatten by pointer
+// jumping, and the coarsened weighted graph is rebuilt by aggregating the
+// surviving inter-cluster edges with the semisort group-by (contract.h's
+// contraction is unweighted, and linkage needs the weights carried
+// through; the aggregation is max for single linkage, sum for
+// density/modularity-style affinity). Rounds proceed until no merges
+// happen or the level cap is hit; the per-vertex assignment at each level
+// forms the dendrogram cut sequence.
+
+#pragma once
+
+#include "gbbs/gbbs.h"
+#include "pbbslib/semisort.h"
+
+namespace gbbs {
+namespace affinity_clustering {
+
+struct clustering {
+  sequence<uintE> cluster;  // final per-vertex cluster id (dense)
+  size_t num_clusters;
+  size_t rounds;
+  std::vector<size_t> level_sizes;  // #clusters after each round
+};
+
+// wgh packed above ngh-complement: max prefers heavier edges, ties the
+// smaller neighbor id
+inline uint64_t encode_best(uint32_t wgh, uintE ngh) {
+  return ((uint64_t)wgh << 32) | (uint64_t)(UINT_E_MAX - ngh);
+}
+inline uintE decode_best_ngh(uint64_t enc) {
+  return UINT_E_MAX - (uintE)(enc & 0xFFFFFFFFu);
+}
+
+template <class Graph>
+clustering AffinityClustering(Graph& G, size_t max_rounds = 50,
+                              bool sum_linkage = false) {
+  using W = typename Graph::weight_type;
+  using cedge = std::tuple<uintE, uintE, uint64_t>;  // (cu, cv, weight)
+  size_t n = G.n;
+
+  // current coarse edge list (u < v) with integer weights
+  auto all = G.edges();
+  auto half = pbbs::filter(all, [&](const std::tuple<uintE, uintE, W>& e) {
+    return std::get<0>(e) < std::get<1>(e);
+  });
+  auto E = sequence<cedge>(half.size(), [&](size_t i) {
+    uint64_t w;
+    if constexpr (std::is_same<W, pbbs::empty>::value) w = 1;
+    else w = (uint64_t)std::get<2>(half[i]);
+    return std::make_tuple(std::get<0>(half[i]), std::get<1>(half[i]), w);
+  });
+
+  auto cluster = sequence<uintE>(n, [](size_t i) { return (uintE)i; });
+  size_t num_cur = n;  // vertices of the current coarse graph
+  clustering R;
+  R.rounds = 0;
+
+  while (E.size() > 0 && R.rounds < max_rounds) {
+    // 1. best incident edge per coarse vertex (atomic max over packed word)
+    auto best = sequence<uint64_t>(num_cur, (uint64_t)0);
+    par_for(0, E.size(), pbbslib::kSequentialForThreshold, [&](size_t i) {
+      auto [u, v, w] = E[i];
+      uint32_t w32 = (uint32_t)std::min<uint64_t>(w, 0xFFFFFFFFu);
+      pbbs::write_max(&best[u], encode_best(w32, v), std::less<uint64_t>());
+      pbbs::write_max(&best[v], encode_best(w32, u), std::less<uint64_t>());
+    });
+
+    // 2. hook to the best neighbor; break 2-cycles toward the smaller id
+    auto parent = sequence<uintE>(num_cur, [&](size_t c) {
+      return (best[c] == 0) ? (uintE)c : decode_best_ngh(best[c]);
+    });
+    par_for(0, num_cur, pbbslib::kSequentialForThreshold, [&](size_t c) {
+      uintE p = parent[c];
+      if (p < num_cur && parent[p] == c && (uintE)c < p) parent[c] = (uintE)c;
+    });
+    // 3. flatten hook trees
+    bool changed = true;
+    while (changed) {
+      changed = false;
+      par_for(0, num_cur, pbbslib::kSequentialForThreshold, [&](size_t c) {
+        uintE p = parent[c];
+        if (parent[p] != p) {
+          parent[c] = parent[p];
+          changed = true;
+        }
+      });
+    }
+
+    // 4. dense ids for the roots
+    auto is_root = sequence<uintE>(num_cur + 1, [&](size_t c) {
+      return (c < num_cur && parent[c] == c) ? (uintE)1 : (uintE)0;
+    });
+    pbbslib::scan_add_inplace(is_root.slice());
+    size_t num_next = is_root[num_cur];
+    if (num_next == num_cur) break;  // no merges: converged
+
+    // 5. thread the assignment through this level
+    par_for(0, n, pbbslib::kSequentialForThreshold, [&](size_t v) {
+      cluster[v] = is_root[parent[cluster[v]]];
+    });
+
+    // 6. coarsen: relabel surviving inter-cluster edges and aggregate
+    // parallel multi-edges (max = single linkage, sum = affinity)
+    auto relabeled = pbbs::filter(E, [&](const cedge& e) {
+      return is_root[parent[std::get<0>(e)]] != is_root[parent[std::get<1>(e)]];
+    });
+    par_for(0, relabeled.size(), pbbslib::kSequentialForThreshold,
+            [&](size_t i) {
+      uintE cu = is_root[parent[std::get<0>(relabeled[i])]];
+      uintE cv = is_root[parent[std::get<1>(relabeled[i])]];
+      if (cv < cu) std::swap(cu, cv);
+      relabeled[i] = std::make_tuple(cu, cv, std::get<2>(relabeled[i]));
+    });
+    auto get_key = [&](const cedge& e) {
+      return (uint64_t)std::get<0>(e) * num_next + std::get<1>(e);
+    };
+    auto next_E = pbbslib::dyn_arr<cedge>(relabeled.size());
+    std::mutex out_mtx;
+    pbbs::group_by(relabeled, get_key, [&](uint64_t key, auto slice) {
+      uint64_t agg = 0;
+      for (size_t i = 0; i < slice.size(); i++) {
+        uint64_t w = std::get<2>(slice[i]);
+        agg = sum_linkage ? agg + w : std::max(agg, w);
+      }
+      std::lock_guard<std::mutex> guard(out_mtx);
+      next_E.push_back(std::make_tuple(std::get<0>(slice[0]),
+                                       std::get<1>(slice[0]), agg));
+    });
+    E = sequence<cedge>(next_E.size, [&](size_t i) { return next_E.A[i]; });
+    num_cur = num_next;
+    R.rounds++;
+    R.level_sizes.push_back(num_next);
+  }
+
+  R.cluster = std::move(cluster);
+  R.num_clusters = num_cur;
+  return R;
+}
+
+}  // namespace affinity_clustering
+}  // namespace gbbs
@@ -30,6 +30,9 @@
 //     -c : indicate that the graph is compressed
 //     -m : indicate that the graph should be mmap'd
 //     -s : indicate that the graph is symmetric
+//     -batch : score pairs in batched mode; reads one "u v" pair per line
+//              from -pairs-file, or scores -npairs random pairs
+//     -block : lanes per block in batched mode (default 16)
 
 #include "CoSimRank.h"
 
@@ -50,7 +53,30 @@ double CoSimRank_runner(Graph& G, commandLine P) {
   double c = P.getOptionDoubleValue("-cons", 0.85);
   uintE u = P.getOptionLongValue("-u", 0);
   uintE v = P.getOptionLongValue("-v", 1);
-  if (P.getOptionValue("-em")) CoSimRank_edgeMap(G, u, v, eps, c, iters);
+  if (P.getOptionValue("-batch")) {
+    size_t block = P.getOptionLongValue("-block", 16);
+    std::vector<std::pair<uintE, uintE>> ps;
+    char* pairs_file = P.getOptionValue("-pairs-file");
+    if (pairs_file) {
+      std::ifstream in(pairs_file);
+      uintE a, b;
+      while (in >> a >> b) ps.emplace_back(a, b);
+    } else {
+      size_t npairs = P.getOptionLongValue("-npairs", 10);
+      auto r = pbbs::random();
+      for (size_t i = 0; i < npairs; i++) {
+        ps.emplace_back(r.ith_rand(2 * i) % G.n, r.ith_rand(2 * i + 1) % G.n);
+      }
+    }
+    auto pairs = sequence<std::pair<uintE, uintE>>(ps.size(),
+        [&](size_t i) { return ps[i]; });
+    auto sims = CoSimRank_batch(G, pairs, eps, c, iters, block);
+    for (size_t i = 0; i < sims.size(); i++) {
+      std::cout << "sim(" << pairs[i].first << ", " << pairs[i].second
+                << ") = " << sims[i] << std::endl;
+    }
+  }
+  else if (P.getOptionValue("-em")) CoSimRank_edgeMap(G, u, v, eps, c, iters);
   else CoSimRank(G, u, v, eps, c, iters);
   double tt = t.stop();
 
@@ -0,0 +1,127 @@
+// This code is part of the project "ConnectIt: A Framework for Static and
+// Incremental Parallel Graph Connectivity Algorithms", VLDB 2021.
+// Copyright (c) 2020 Laxman Dhulipala, Changwan Hong, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Runtime auto-selection over the precompiled ConnectIt variants. The
+// framework enumerates sampling strategies and finish algorithms at compile
+// time; this header samples a handful of cheap graph statistics -- density,
+// degree skew, and an approximate diameter from a truncated BFS off a
+// sampled high-degree vertex -- and dispatches to the variant combination
+// that the ConnectIt paper's benchmark sweeps identify as the winner for
+// that regime:
+//
+//   - low-diameter, skewed (social/web):  k-out sampling + unite_rem_cas
+//     (sampling collapses the giant component almost for
+//     free, the finish touches the small remainder);
+//   - high-diameter, flat (road/mesh):    BFS sampling + unite_rem_cas
+//     (k-out sampling is ineffective when components are long and thin);
+//   - tiny or very dense graphs:          no sampling, plain unite + find
+//     compress (the sampling pass costs more than it saves).
+//
+// The rule set is deliberately a small hand-written model over the same
+// statistics a learned selector would consume.
+
+#pragma once
+
+#include "benchmarks/Connectivity/ConnectIt/framework.h"
+
+namespace gbbs {
+namespace connectit {
+
+struct graph_stats {
+  double density;        // m / n
+  double degree_skew;    // max_degree / avg_degree
+  size_t approx_diameter;  // rounds of a truncated BFS from a heavy vertex
+};
+
+template <class Graph>
+graph_stats sample_graph_stats(Graph& G, size_t max_bfs_rounds = 64) {
+  graph_stats stats;
+  size_t n = G.n;
+  stats.density = (n == 0) ? 0 : (double)G.m / (double)n;
+
+  auto deg_im = pbbslib::make_sequence<size_t>(
+      n, [&](size_t i) { return G.get_vertex(i).out_degree(); });
+  size_t max_deg = pbbslib::reduce_max(deg_im);
+  stats.degree_skew =
+      (stats.density > 0) ? (double)max_deg / stats.density : 1.0;
+
+  // truncated BFS from a sampled heavy vertex: probe a few hashed vertices
+  // and start from the highest-degree one found
+  uintE src = 0;
+  size_t best_deg = 0;
+  for (size_t s = 0; s < 32 && n > 0; s++) {
+    uintE v = (uintE)(pbbs::hash64(s) % n);
+    size_t d = G.get_vertex(v).out_degree();
+    if (d > best_deg) { best_deg = d; src = v; }
+  }
+  auto parents = pbbs::sequence<uintE>(n, (uintE)UINT_E_MAX);
+  parents[src] = src;
+  struct BFS_F {
+    uintE* P;
+    BFS_F(uintE* P) : P(P) {}
+    inline bool update(uintE s, uintE d, pbbslib::empty) {
+      if (P[d] == UINT_E_MAX) { P[d] = s; return 1; }
+      return 0;
+    }
+    inline bool updateAtomic(uintE s, uintE d, pbbslib::empty) {
+      return pbbslib::atomic_compare_and_swap(&P[d], UINT_E_MAX, s);
+    }
+    inline bool cond(uintE d) { return P[d] == UINT_E_MAX; }
+  };
+  auto frontier = vertexSubset(n, src);
+  size_t rounds = 0;
+  while (!frontier.isEmpty() && rounds < max_bfs_rounds) {
+    frontier = edgeMap(G, frontier, BFS_F(parents.begin()), -1);
+    rounds++;
+  }
+  stats.approx_diameter = rounds;
+  return stats;
+}
+
+// Dispatches to the empirically best precompiled variant for the sampled
+// regime; prints the decision so operators can pin it explicitly later.
+template <class Graph>
+pbbs::sequence<parent> run_auto_selected(Graph& G, commandLine& P) {
+  auto stats = sample_graph_stats(G);
+  std::cout << "### auto-select stats: density = " << stats.density
+            << " skew = " << stats.degree_skew
+            << " approx-diameter = " << stats.approx_diameter << std::endl;
+
+  constexpr size_t kSmall = 1 << 22;  // sampling overhead dominates below
+  if (G.m < kSmall) {
+    std::cout << "### auto-select: no_sampling + unite + find_compress"
+              << std::endl;
+    return run_uf_alg<Graph, no_sampling, find_compress, unite>(G, P);
+  }
+  if (stats.approx_diameter >= 48 || stats.degree_skew < 4.0) {
+    std::cout << "### auto-select: sample_bfs + unite_rem_cas"
+              << std::endl;
+    return run_uf_alg<Graph, sample_bfs, find_atomic_split, unite_rem_cas,
+                      split_atomic_one>(G, P);
+  }
+  std::cout << "### auto-select: sample_kout + unite_rem_cas" << std::endl;
+  return run_uf_alg<Graph, sample_kout, find_atomic_split, unite_rem_cas,
+                    split_atomic_one>(G, P);
+}
+
+}  // namespace connectit
+}  // namespace gbbs
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <fstream>
 #include <iomanip>
+#include <set>
+#include <sstream>
 
 #include "check.h"
 
@@ -10,6 +13,67 @@ namespace gbbs {
 static timer bt;
 using uchar = unsigned char;
 
+/* ==================== Sweep fault tolerance ====================
+ *
+ * Long ConnectIt sweeps run hundreds of (variant, graph) combinations;
+ * -journal <file> makes them preemption-safe. Every finished variant
+ * appends a "DONE <key>" marker plus its JSON result to the journal
+ * (flushed per variant), per-round timings append as they complete so a
+ * kill mid-variant keeps partial data, and on restart variants whose
+ * marker is already journaled are skipped -- the sweep resumes where the
+ * machine died, with all prior results preserved in the journal. The key
+ * is test name + graph path, so one journal can cover the whole sweep. */
+struct result_journal {
+  std::string path;
+  std::set<std::string> done;
+  std::ofstream out;
+  bool active = false;
+
+  void init(const std::string& p) {
+    path = p;
+    std::ifstream in(p);
+    std::string line;
+    while (std::getline(in, line)) {
+      if (line.rfind("DONE ", 0) == 0) done.insert(line.substr(5));
+    }
+    out.open(p, std::ios::app);
+    active = true;
+  }
+
+  bool completed(const std::string& key) const {
+    return active && done.count(key) > 0;
+  }
+
+  void record_round(const std::string& key, size_t round, double t) {
+    if (!active) return;
+    out << "ROUND " << key << " " << round << " " << t << "\n";
+    out.flush();
+  }
+
+  void record(const std::string& key, const std::string& result_json) {
+    if (!active) return;
+    out << result_json;
+    out << "DONE " << key << "\n";
+    out.flush();
+    done.insert(key);
+  }
+};
+
+inline result_journal& sweep_journal() {
+  static result_journal j;
+  return j;
+}
+
+inline void maybe_init_journal(commandLine& P) {
+  if (char* jf = P.getOptionValue("-journal")) {
+    if (!sweep_journal().active) sweep_journal().init(jf);
+  }
+}
+
+inline std::string journal_key(const std::string& name, commandLine& P) {
+  return name + " @ " + std::string(P.getArgument(0));
+}
+
 #define time(_var,_body)    \
   bt.start();               \
   _body;		    \
@@ -35,7 +99,8 @@ double minf(double a, double b) {return (a < b) ? a : b;};
 double maxf(double a, double b) {return (a > b) ? a : b;};
 
 template<typename Graph, typename F>
-std::vector<double> repeat(Graph& G, size_t rounds, pbbs::sequence<parent>& correct, F test, commandLine& P) {
+std::vector<double> repeat(Graph& G, size_t rounds, pbbs::sequence<parent>& correct, F test, commandLine& P,
+                           const std::string& journal_key = "") {
   std::vector<double> R;
   for (size_t i=0; i < rounds; i++) {
 #ifdef REPORT_PATH_LENGTHS
@@ -44,33 +109,34 @@ std::vector<double> repeat(Graph& G, size_t rounds, pbbs::sequence<parent>& corr
 #endif
     auto t = test(G, P, correct);
     std::cout << "### t = " << t << std::endl;
+    if (!journal_key.empty()) sweep_journal().record_round(journal_key, i, t);
     R.push_back(t);
   }
   return R;
 }
 
 template <class CPUStats>
-void print_cpu_stats(std::string& name, size_t rounds, double medt, double mint, double maxt, CPUStats& stats, commandLine& P) {
-  std::cout << "{" << std::endl;
-  std::cout << "  \"test_type\": \"static_connectivity_result\"," << std::endl;
-  std::cout << "  \"test_name\" : \"" << name << "\"," << std::endl;
-  std::cout << "  \"graph\" : \"" << P.getArgument(0) << "\"," << std::endl;
-  std::cout << "  \"rounds\" : " << rounds << "," << std::endl;
-  std::cout << "  \"medt\" : " << std::setprecision(5) << medt << "," << std::endl;
-  std::cout << "  \"mint\" : " << mint << "," << std::endl;
-  std::cout << "  \"maxt\" : " << maxt << "," << std::endl;
-  std::cout << "  \"ipc\" : " << std::to_string(stats.get_ipc()) << "," << std::endl;
-  std::cout << "  \"total_cycles\" : " << std::to_string(stats.get_total_cycles()) << "," << std::endl;
-  std::cout << "  \"l2_hit_ratio\" : " << std::to_string(stats.get_l2_hit_ratio()) << "," << std::endl;
-  std::cout << "  \"l3_hit_ratio\" : " << std::to_string(stats.get_l3_hit_ratio()) << "," << std::endl;
-  std::cout << "  \"l2_misses\" : " << std::to_string(stats.get_l2_misses()) << "," << std::endl;
-  std::cout << "  \"l2_hits\" : " << std::to_string(stats.get_l2_hits()) << "," << std::endl;
-  std::cout << "  \"l3_misses\" : " << std::to_string(stats.get_l3_misses()) << "," << std::endl;
-  std::cout << "  \"l3_hits\" : " << std::to_string(stats.get_l3_hits()) << "," << std::endl;
-  std::cout << "  \"throughput\" : " << std::to_string(stats.get_throughput()) << "," << std::endl;
-  std::cout << "  \"max_path_len\" : " << std::to_string(max_pathlen.get_value()) << "," << std::endl;
-  std::cout << "  \"total_path_len\" : " << std::to_string(total_pathlen.get_value()) << std::endl;
-  std::cout << "}" << std::endl;
+void print_cpu_stats(std::ostream& os, std::string& name, size_t rounds, double medt, double mint, double maxt, CPUStats& stats, commandLine& P) {
+  os << "{" << std::endl;
+  os << "  \"test_type\": \"static_connectivity_result\"," << std::endl;
+  os << "  \"test_name\" : \"" << name << "\"," << std::endl;
+  os << "  \"graph\" : \"" << P.getArgument(0) << "\"," << std::endl;
+  os << "  \"rounds\" : " << rounds << "," << std::endl;
+  os << "  \"medt\" : " << std::setprecision(5) << medt << "," << std::endl;
+  os << "  \"mint\" : " << mint << "," << std::endl;
+  os << "  \"maxt\" : " << maxt << "," << std::endl;
+  os << "  \"ipc\" : " << std::to_string(stats.get_ipc()) << "," << std::endl;
+  os << "  \"total_cycles\" : " << std::to_string(stats.get_total_cycles()) << "," << std::endl;
+  os << "  \"l2_hit_ratio\" : " << std::to_string(stats.get_l2_hit_ratio()) << "," << std::endl;
+  os << "  \"l3_hit_ratio\" : " << std::to_string(stats.get_l3_hit_ratio()) << "," << std::endl;
+  os << "  \"l2_misses\" : " << std::to_string(stats.get_l2_misses()) << "," << std::endl;
+  os << "  \"l2_hits\" : " << std::to_string(stats.get_l2_hits()) << "," << std::endl;
+  os << "  \"l3_misses\" : " << std::to_string(stats.get_l3_misses()) << "," << std::endl;
+  os << "  \"l3_hits\" : " << std::to_string(stats.get_l3_hits()) << "," << std::endl;
+  os << "  \"throughput\" : " << std::to_string(stats.get_throughput()) << "," << std::endl;
+  os << "  \"max_path_len\" : " << std::to_string(max_pathlen.get_value()) << "," << std::endl;
+  os << "  \"total_path_len\" : " << std::to_string(total_pathlen.get_value()) << std::endl;
+  os << "}" << std::endl;
 }
 
 template<typename Graph, typename F>
@@ -80,7 +146,14 @@ bool run_multiple(Graph& G, size_t rounds, pbbs::sequence<parent>& correct,
   auto before_state = get_pcm_state();
   timer ot; ot.start();
 #endif
-  std::vector<double> t = repeat(G, rounds, correct, test, P);
+  maybe_init_journal(P);
+  std::string jkey = journal_key(name, P);
+  if (sweep_journal().completed(jkey)) {
+    std::cout << "# journal: skipping completed \"" << jkey << "\""
+              << std::endl;
+    return 1;
+  }
+  std::vector<double> t = repeat(G, rounds, correct, test, P, jkey);
 #ifdef USE_PCM_LIB
   double elapsed = ot.stop();
   auto after_state = get_pcm_state();
@@ -93,7 +166,10 @@ bool run_multiple(Graph& G, size_t rounds, pbbs::sequence<parent>& correct,
   double maxt = reduce(t, maxf);
   double med = median(t);
 
-  print_cpu_stats(name, rounds, med, mint, maxt, stats, P);
+  std::ostringstream result;
+  print_cpu_stats(result, name, rounds, med, mint, maxt, stats, P);
+  std::cout << result.str();
+  sweep_journal().record(jkey, result.str());
   return 1;
 }
 
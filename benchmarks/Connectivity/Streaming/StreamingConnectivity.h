@@ -0,0 +1,121 @@
+// This code is part of the project "ConnectIt: A Framework for Static and
+// Incremental Parallel Graph Connectivity Algorithms", VLDB 2021.
+// Copyright (c) 2020 Laxman Dhulipala, Changwan Hong, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Streaming connectivity over an edge log larger than RAM: only the
+// union-find state (one word per vertex) is held in memory -- edges are
+// never stored. Batches arrive through the edge-log tailer, are united
+// concurrently, and the parent array is periodically compacted (flattened
+// so every vertex points at its root, bounding later find chains).
+// Snapshots go through the checkpoint facility with the consumed-byte
+// offset, so a multi-day run resumes from where the log was last absorbed.
+
+#pragma once
+
+#include "benchmarks/Connectivity/UnionFind/packed_union_find.h"
+#include "gbbs/checkpoint.h"
+#include "gbbs/edge_log_tailer.h"
+#include "gbbs/gbbs.h"
+
+namespace gbbs {
+namespace streaming_cc {
+
+struct streaming_connectivity {
+  packed_uf::packed_union_find uf;
+  gbbs_io::edge_log_tailer<> tailer;
+  size_t batches_since_compaction = 0;
+  size_t compaction_interval;
+
+  streaming_connectivity(size_t n, std::string log_path,
+                         size_t compaction_interval = 16,
+                         size_t resume_offset = 0)
+      : uf(n), tailer(std::move(log_path), resume_offset),
+        compaction_interval(compaction_interval) {}
+
+  // Absorbs any complete new records from the log; returns the number of
+  // edges ingested.
+  size_t poll() {
+    auto batch = tailer.poll(uf.words.size());
+    size_t m = batch.non_zeros;
+    if (m == 0) return 0;
+    parallel_for(0, m, [&](size_t i) {
+      uintE u = std::get<0>(batch.E[i]);
+      uintE v = std::get<1>(batch.E[i]);
+      if (u < uf.words.size() && v < uf.words.size()) uf.unite(u, v);
+    });
+    batch.del();
+    if (++batches_since_compaction >= compaction_interval) {
+      compact();
+      batches_since_compaction = 0;
+    }
+    return m;
+  }
+
+  // Flattens every parent chain (keeps ranks); bounds the cost of future
+  // finds accumulated over days of streaming.
+  void compact() {
+    size_t n = uf.words.size();
+    parallel_for(0, n, [&](size_t i) {
+      uintE root = uf.find((uintE)i);
+      uint64_t w = uf.words[i];
+      uf.words[i] = packed_uf::pack(root, packed_uf::rank_of(w));
+    });
+  }
+
+  // Exports the state (and the log offset to resume from) atomically.
+  void snapshot(const std::string& path) {
+    compact();
+    auto w = checkpoint::writer(path);
+    w.write_value(tailer.consumed_bytes);
+    w.write_sequence(uf.words);
+  }
+
+  // Restores a snapshot written by snapshot(); returns the streaming state
+  // positioned to resume tailing the log.
+  static streaming_connectivity restore(const std::string& snapshot_path,
+                                        std::string log_path,
+                                        size_t compaction_interval = 16) {
+    auto r = checkpoint::reader(snapshot_path);
+    if (!r.valid()) {
+      std::cout << "streaming_connectivity: bad snapshot " << snapshot_path
+                << std::endl;
+      abort();
+    }
+    size_t offset = r.read_value<size_t>();
+    auto words = r.read_sequence<uint64_t>();
+    streaming_connectivity s(words.size(), std::move(log_path),
+                             compaction_interval, offset);
+    s.uf.words = std::move(words);
+    return s;
+  }
+
+  size_t num_components() {
+    compact();
+    size_t n = uf.words.size();
+    auto is_root = pbbslib::make_sequence<size_t>(n, [&](size_t i) {
+      return (size_t)(packed_uf::parent_of(uf.words[i]) == i);
+    });
+    return pbbslib::reduce_add(is_root);
+  }
+};
+
+}  // namespace streaming_cc
+}  // namespace gbbs
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <vector>
+
+#include "benchmarks/Connectivity/UnionFind/packed_union_find.h"
+#include "gbbs/gbbs.h"
+
+namespace gbbs {
+
+namespace {
+
+// sequential reference DSU
+struct ref_dsu {
+  std::vector<uintE> p;
+  ref_dsu(size_t n) : p(n) {
+    for (size_t i = 0; i < n; i++) p[i] = (uintE)i;
+  }
+  uintE find(uintE u) {
+    while (p[u] != u) u = p[u] = p[p[u]];
+    return u;
+  }
+  void unite(uintE u, uintE v) { p[find(u)] = find(v); }
+};
+
+// the partitions must match: same-component iff same-component
+void expect_same_partition(packed_uf::packed_union_find& uf, ref_dsu& ref,
+                           size_t n) {
+  std::map<uintE, uintE> m1, m2;
+  for (size_t v = 0; v < n; v++) {
+    uintE a = uf.find((uintE)v);
+    uintE b = ref.find((uintE)v);
+    auto i1 = m1.find(a);
+    auto i2 = m2.find(b);
+    if (i1 == m1.end()) m1[a] = b; else ASSERT_EQ(i1->second, b);
+    if (i2 == m2.end()) m2[b] = a; else ASSERT_EQ(i2->second, a);
+  }
+}
+
+}  // namespace
+
+TEST(PackedUnionFind, PackUnpack) {
+  uint64_t w = packed_uf::pack(packed_uf::kParentMask - 3, 77);
+  ASSERT_EQ(packed_uf::parent_of(w), packed_uf::kParentMask - 3);
+  ASSERT_EQ(packed_uf::rank_of(w), (uint64_t)77);
+}
+
+TEST(PackedUnionFind, SequentialMatchesReference) {
+  std::mt19937_64 rng(1);
+  size_t n = 50000;
+  auto uf = packed_uf::packed_union_find(n);
+  ref_dsu ref(n);
+  for (size_t e = 0; e < 80000; e++) {
+    uintE u = (uintE)(rng() % n), v = (uintE)(rng() % n);
+    uf.unite(u, v);
+    ref.unite(u, v);
+  }
+  expect_same_partition(uf, ref, n);
+}
+
+TEST(PackedUnionFind, ConcurrentUnionsMatchReference) {
+  std::mt19937_64 rng(2);
+  size_t n = 50000;
+  size_t m = 120000;
+  std::vector<std::pair<uintE, uintE>> edges(m);
+  for (size_t e = 0; e < m; e++) {
+    edges[e] = {(uintE)(rng() % n), (uintE)(rng() % n)};
+  }
+  auto uf = packed_uf::packed_union_find(n);
+  parallel_for(0, m, [&](size_t e) {
+    uf.unite(edges[e].first, edges[e].second);
+  });
+  ref_dsu ref(n);
+  for (auto& e : edges) ref.unite(e.first, e.second);
+  expect_same_partition(uf, ref, n);
+}
+
+}  // namespace gbbs
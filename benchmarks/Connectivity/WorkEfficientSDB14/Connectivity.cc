@@ -31,8 +31,12 @@
 //     -c : indicate that the graph is compressed
 //     -rounds : the number of times to run the algorithm
 //     -stats : print the #ccs, and the #vertices in the largest cc
+//     -eliminate : contract pendant trees and degree-2 chains first, run
+//                  connectivity on the reduced graph, and reconstitute
+//                  per-vertex labels
 
 #include "Connectivity.h"
+#include "gbbs/elimination.h"
 
 namespace gbbs {
 
@@ -52,7 +56,26 @@ double CC_runner(Graph& G, commandLine P) {
   assert(!pack); // discouraged for now. Using the optimized contraction method is faster.
   timer t;
   t.start();
-  auto components = workefficient_cc::CC(G, beta, pack, P.getOption("-permute"));
+  sequence<parent> components;
+  if (P.getOption("-eliminate")) {
+    auto R = elimination::eliminate(G);
+    std::cout << "### eliminated " << R.num_eliminated << " / " << G.n
+              << " vertices (reduced n = " << R.GR.n
+              << ", m = " << R.GR.m << ")" << std::endl;
+    auto reduced = workefficient_cc::CC(R.GR, beta, false,
+                                        P.getOption("-permute"));
+    // Reconstitute in cluster-id space (a subset of [0, n)): a vertex
+    // takes the cluster id of its reduced component's root; clusters that
+    // contracted into singletons are whole components of their own.
+    components = sequence<parent>(G.n, [&](size_t i) {
+      uintE rv = R.reduced_vertex(i);
+      if (rv == UINT_E_MAX) return (parent)R.cluster[i];
+      return (parent)R.reduced_to_cluster[reduced[rv]];
+    });
+    R.del();
+  } else {
+    components = workefficient_cc::CC(G, beta, pack, P.getOption("-permute"));
+  }
   double tt = t.stop();
   std::cout << "### Running Time: " << tt << std::endl;
 
@@ -39,6 +39,12 @@ double Count5Cycle_runner(Graph& G, commandLine P) {
       std::cout << "### ESCAPE (Parallel)" << std::endl;
       numCycles = Count5Cycle_ESCAPE_par(G, order_type);
     }
+  } else if (P.getOptionValue("-four")) {
+    std::cout << "### Four-cycle (wedge index)" << std::endl;
+    numCycles = Count4Cycle(G);
+  } else if (P.getOptionValue("-indexed")) {
+    std::cout << "### Kowalik (Parallel, wedge index)" << std::endl;
+    numCycles = Count5Cycle_indexed(G, order_type);
   } else {
     if (serial){
       std::cout << "### Kowalik (Pure Serial)" << std::endl;
@@ -21,6 +21,7 @@
 #include "pbbslib/monoid.h"
 #include "gbbs/gbbs.h"
 #include "gbbs/graph.h"
+#include "benchmarks/CycleCounting/wedge_index.h"
 #include "benchmarks/DegeneracyOrder/BarenboimElkin08/DegeneracyOrder.h"
 #include "benchmarks/DegeneracyOrder/GoodrichPszona11/DegeneracyOrder.h"
 
@@ -220,34 +221,20 @@ inline auto Preprocess(Graph& GA, sequence<uintE>& rank, long order_type = 0, do
 // ****************************************************************************************
 // Count the number of 5-cycles for a vertex in teh Kowalik algorithm
 // ****************************************************************************************
+// Counting body shared by the scanning and index-backed entry points: U
+// must already hold vertex i's wedge multiplicities (endpoints recorded in
+// V->distinct); resets U before returning.
 template <class Graph, class Graph2>
-inline ulong Count5CycleVertex(Graph& GDO, Graph2& DGDO, U_FastReset* V, size_t i){
+inline ulong Count5CycleVertexFromWedges(Graph& GDO, Graph2& DGDO,
+                                         U_FastReset* V, size_t i) {
   ulong temp = 0;
   uintE* U = V->U;
   auto vi = GDO.get_vertex(i);
   uintE degree = vi.out_degree();
-  uintE* nghs = (uintE*) vi.neighbors; 
-  
-  if (degree == 0) return 0; 
-
-  // uintE viOutDegree = DGDO.get_vertex(i).out_degree();
-  // uintE* outnghs_vi = (uintE*) DGDO.get_vertex(i).neighbors;
-  // auto outnghs_vi_seq =  sequence<uintE>(outnghs_vi, viOutDegree);
-  // auto custom_less_i = [&](uintE arg) { return i < arg; }; // for binary searching.
+  uintE* nghs = (uintE*) vi.neighbors;
 
   uintE u, uDegree, w, wOutDegree, x;
 
-
-  for (uintE j = 0; (j < degree) && ((u = nghs[j]) > i); j++) {
-    auto vu = GDO.get_vertex(u);
-    uintE* nghs_u = (uintE*) vu.neighbors;
-    uDegree = vu.out_degree();
-    for (uintE k = 0; (k < uDegree) && ((w = nghs_u[k]) > i); k++) {
-      if (U[w] == 0) { V->distinct[V->num_distinct] = w; V->num_distinct++; }
-      U[w] += 1;
-    }
-  } // end of line 7. 
-  
   for (uintE j = 0; (j < degree) && ((u = nghs[j]) > i); j++) {
     auto vu = GDO.get_vertex(u);
     uintE* nghs_u = (uintE*) vu.neighbors;
@@ -314,6 +301,49 @@ inline ulong Count5CycleVertex(Graph& GDO, Graph2& DGDO, U_FastReset* V, size_t
   return temp;
 }
 
+template <class Graph, class Graph2>
+inline ulong Count5CycleVertex(Graph& GDO, Graph2& DGDO, U_FastReset* V, size_t i){
+  uintE* U = V->U;
+  auto vi = GDO.get_vertex(i);
+  uintE degree = vi.out_degree();
+  uintE* nghs = (uintE*) vi.neighbors; 
+  
+  if (degree == 0) return 0; 
+
+  uintE u, w, uDegree;
+  for (uintE j = 0; (j < degree) && ((u = nghs[j]) > i); j++) {
+    auto vu = GDO.get_vertex(u);
+    uintE* nghs_u = (uintE*) vu.neighbors;
+    uDegree = vu.out_degree();
+    for (uintE k = 0; (k < uDegree) && ((w = nghs_u[k]) > i); k++) {
+      if (U[w] == 0) { V->distinct[V->num_distinct] = w; V->num_distinct++; }
+      U[w] += 1;
+    }
+  } // end of line 7. 
+
+  return Count5CycleVertexFromWedges(GDO, DGDO, V, i);
+}
+
+// Index-backed variant: scatters vertex i's materialized wedge entries into
+// U instead of re-walking the 2-hop neighborhood.
+template <class Graph, class Graph2>
+inline ulong Count5CycleVertex_indexed(Graph& GDO, Graph2& DGDO,
+                                       const wedge_index& WI, U_FastReset* V,
+                                       size_t i) {
+  uintE* U = V->U;
+  if (GDO.get_vertex(i).out_degree() == 0) return 0;
+
+  size_t ne = WI.num_entries(i);
+  auto ents = WI.entries_of(i);
+  for (size_t e = 0; e < ne; e++) {
+    uintE w = std::get<0>(ents[e]);
+    U[w] = std::get<1>(ents[e]);
+    V->distinct[V->num_distinct] = w; V->num_distinct++;
+  }
+
+  return Count5CycleVertexFromWedges(GDO, DGDO, V, i);
+}
+
 
 
 
@@ -428,6 +458,102 @@ inline ulong Count5Cycle(Graph& GA, long order_type = 0, double epsilon = 0.1) {
 
 
 
+// ****************************************************************************************
+// Index-backed 5-cycle counting: builds the shared wedge index once, then
+// runs the Kowalik counting pass scattering each vertex's materialized
+// entries instead of re-walking its 2-hop neighborhood. The built index can
+// also serve the 4-cycle count and external wedge queries.
+// ****************************************************************************************
+template <class Graph>
+inline ulong Count5Cycle_indexed(Graph& GA, long order_type = 0, double epsilon = 0.1) {
+  using W = typename Graph::weight_type;
+  sequence<uintE> rank;
+  auto GDO = Preprocess(GA, rank, order_type, epsilon);
+
+  auto direction = [&](const uintE& u, const uintE& v, const W& wgh) {
+    return rank[u] < rank[v];
+  };
+  auto DGDO = filterGraph(GDO, direction);
+  std::cout << "Filter done\n"; fflush(stdout);
+
+  timer ti; ti.start();
+  auto WI = build_wedge_index(GDO);
+  double tti = ti.stop();
+  std::cout << "##### Wedge index build: " << tti
+            << " (entries = " << WI.entries.size()
+            << ", wedges = " << WI.total_wedges << ")" << std::endl;
+
+  // Same work-based scheduling as Count5Cycle.
+  auto parallel_work = sequence<size_t>(GA.n);
+  {
+    auto map_f = [&](uintE u, uintE v, W wgh) -> size_t {
+      return GDO.get_vertex(v).out_degree();
+    };
+    par_for(0, GA.n, [&] (size_t i) {
+      auto monoid = pbbslib::addm<size_t>();
+      parallel_work[i] = GDO.get_vertex(i).out_neighbors().reduce(map_f, monoid);
+    });
+  }
+  size_t total_work = pbbslib::scan_add_inplace(parallel_work.slice());
+  size_t block_size = 5000000;
+  size_t n_blocks = total_work/block_size + 1;
+  size_t work_per_block = total_work / n_blocks;
+  n_blocks = (total_work/work_per_block) + 1;
+
+  timer t2; t2.start();
+  const size_t eltsPerCacheLine = 64/sizeof(ulong);
+  sequence<ulong> cycleCounts = sequence<ulong>(n_blocks * eltsPerCacheLine, [&](size_t s) { return 0; });
+
+  auto init_V = [&](U_FastReset* V){ V->alloc(GA.n); };
+  auto finish_V = [&](U_FastReset* V){ return; };
+  parallel_for_alloc<U_FastReset>(init_V, finish_V, 0, n_blocks,
+                                      [&] (size_t i, U_FastReset* V) {
+    size_t start = i * work_per_block;
+    size_t end = (i + 1) * work_per_block;
+    auto less_fn = std::less<size_t>();
+    size_t start_ind = pbbslib::binary_search(parallel_work, start, less_fn);
+    size_t end_ind = pbbslib::binary_search(parallel_work, end, less_fn);
+    for (size_t j = start_ind; j < end_ind; j++) {
+      cycleCounts[i * eltsPerCacheLine] +=
+          Count5CycleVertex_indexed(GDO, DGDO, WI, V, j);
+    }
+  });
+
+  ulong total = pbbslib::reduce_add(cycleCounts);
+  double tt2 = t2.stop();
+  std::cout << "##### Actual counting: " << tt2 << std::endl;
+  GDO.del();
+  DGDO.del();
+  return total;
+}
+
+// ****************************************************************************************
+// 4-cycle counting over the shared wedge index. A 4-cycle is two distinct
+// wedges between the same endpoint pair, counted at its minimum vertex i:
+// every cycle i-u-w-u'-i contributes choose(multiplicity of w at i, 2).
+// Only needs the degree ordering, not the degeneracy rank.
+// ****************************************************************************************
+template <class Graph>
+inline ulong Count4Cycle(Graph& GA) {
+  auto order_to_vertex = orderNodesByDegree(GA, GA.n);
+  auto GDO = relabel_graph(GA, order_to_vertex);
+
+  timer ti; ti.start();
+  auto WI = build_wedge_index(GDO);
+  double tti = ti.stop();
+  std::cout << "##### Wedge index build: " << tti
+            << " (entries = " << WI.entries.size()
+            << ", wedges = " << WI.total_wedges << ")" << std::endl;
+
+  auto per_entry = pbbs::delayed_seq<ulong>(WI.entries.size(), [&](size_t e) {
+    ulong m = std::get<1>(WI.entries[e]);
+    return m * (m - 1) / 2;
+  });
+  ulong total = pbbs::reduce(per_entry, pbbs::addm<ulong>());
+  GDO.del();
+  return total;
+}
+
 // ****************************************************************************************
 // This is a PURE SERIAL version of the five-cycle counting algorithm.
 // ****************************************************************************************
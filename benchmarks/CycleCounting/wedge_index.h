@@ -0,0 +1,132 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Materialized wedge (2-path) index over a degree-ordered graph. For each
+// vertex i it stores the distinct wedge endpoints w reachable as i - u - w
+// with u > i and w > i (the wedges the cycle counters in this family
+// enumerate), together with their multiplicity: the number of midpoints u.
+// The counters walk this 2-hop structure once per run today; building it
+// once lets the 4-cycle count fall out as a reduction over the entries, the
+// 5-cycle pass scatter entries into its U array instead of re-walking the
+// 2-hop neighborhood, and downstream feature jobs query wedges without any
+// graph traversal.
+
+#pragma once
+
+#include "gbbs/gbbs.h"
+#include "gbbs/graph.h"
+
+namespace gbbs {
+
+// CSR-shaped: vertex i's entries are entries[offsets[i] .. offsets[i+1]).
+struct wedge_index {
+  size_t n = 0;
+  size_t total_wedges = 0;  // sum of multiplicities
+  sequence<size_t> offsets;                   // length n + 1
+  sequence<std::tuple<uintE, uintE>> entries;  // (endpoint, multiplicity)
+
+  size_t num_entries(size_t i) const { return offsets[i + 1] - offsets[i]; }
+  const std::tuple<uintE, uintE>* entries_of(size_t i) const {
+    return entries.begin() + offsets[i];
+  }
+};
+
+// Walks vertex i's wedges (u > i, w > i) in the degree-ordered graph,
+// accumulating multiplicities into the caller's scratch array. scratch must
+// be zeroed; distinct endpoints are recorded in order of first visit.
+template <class Graph>
+inline size_t _wedge_scan(Graph& GDO, size_t i, uintE* scratch,
+                          uintE* distinct) {
+  auto vi = GDO.get_vertex(i);
+  uintE degree = vi.out_degree();
+  uintE* nghs = (uintE*)vi.neighbors;
+  size_t num_distinct = 0;
+  uintE u, w;
+  for (uintE j = 0; (j < degree) && ((u = nghs[j]) > i); j++) {
+    auto vu = GDO.get_vertex(u);
+    uintE* nghs_u = (uintE*)vu.neighbors;
+    uintE uDegree = vu.out_degree();
+    for (uintE k = 0; (k < uDegree) && ((w = nghs_u[k]) > i); k++) {
+      if (scratch[w] == 0) distinct[num_distinct++] = w;
+      scratch[w] += 1;
+    }
+  }
+  return num_distinct;
+}
+
+// Builds the index over the (relabeled) degree-ordered graph GDO. Two
+// passes: a counting pass sizes each vertex's entry range, a fill pass
+// writes (endpoint, multiplicity) pairs. Workers share per-thread scratch
+// arrays sized n, reset via the distinct list (same trick as U_FastReset).
+template <class Graph>
+inline wedge_index build_wedge_index(Graph& GDO) {
+  size_t n = GDO.n;
+  wedge_index W;
+  W.n = n;
+  W.offsets = sequence<size_t>(n + 1, (size_t)0);
+
+  struct scratch_t {
+    uintE* counts = nullptr;
+    uintE* distinct = nullptr;
+    void alloc(size_t n) {
+      if (!counts) counts = (uintE*)calloc(n, sizeof(uintE));
+      if (!distinct) distinct = (uintE*)calloc(n, sizeof(uintE));
+    }
+    ~scratch_t() {
+      if (counts) free(counts);
+      if (distinct) free(distinct);
+    }
+  };
+  auto init_S = [&](scratch_t* S) { S->alloc(n); };
+  auto finish_S = [&](scratch_t* S) { return; };
+
+  parallel_for_alloc<scratch_t>(init_S, finish_S, 0, n,
+                                [&](size_t i, scratch_t* S) {
+    size_t nd = _wedge_scan(GDO, i, S->counts, S->distinct);
+    W.offsets[i] = nd;
+    for (size_t d = 0; d < nd; d++) S->counts[S->distinct[d]] = 0;
+  });
+
+  size_t total = pbbslib::scan_add_inplace(W.offsets.slice());
+  W.offsets[n] = total;
+  W.entries = sequence<std::tuple<uintE, uintE>>::no_init(total);
+
+  parallel_for_alloc<scratch_t>(init_S, finish_S, 0, n,
+                                [&](size_t i, scratch_t* S) {
+    size_t nd = _wedge_scan(GDO, i, S->counts, S->distinct);
+    size_t off = W.offsets[i];
+    for (size_t d = 0; d < nd; d++) {
+      uintE w = S->distinct[d];
+      W.entries[off + d] = std::make_tuple(w, S->counts[w]);
+      S->counts[w] = 0;
+    }
+  });
+
+  auto mults = pbbs::delayed_seq<size_t>(total, [&](size_t e) {
+    return (size_t)std::get<1>(W.entries[e]);
+  });
+  W.total_wedges = pbbs::reduce(mults, pbbs::addm<size_t>());
+  return W;
+}
+
+}  // namespace gbbs
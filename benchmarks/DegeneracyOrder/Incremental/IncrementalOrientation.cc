@@ -0,0 +1,75 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Usage:
+// ./IncrementalOrientation -nbatches 10 -s graph
+// Feeds the input graph's edges in batches to the incremental orientation
+// and reports the maintained out-degree bound and flip work per batch.
+
+#include "IncrementalOrientation.h"
+
+namespace gbbs {
+
+template <class Graph>
+double IncrementalOrientation_runner(Graph& G, commandLine P) {
+  size_t nbatches = static_cast<size_t>(P.getOptionLongValue("-nbatches", 10));
+  std::cout << "### Application: IncrementalOrientation" << std::endl;
+  std::cout << "### Graph: " << P.getArgument(0) << std::endl;
+  std::cout << "### Threads: " << num_workers() << std::endl;
+  std::cout << "### n: " << G.n << std::endl;
+  std::cout << "### m: " << G.m << std::endl;
+  std::cout << "### Params: -nbatches = " << nbatches << std::endl;
+  std::cout << "### ------------------------------------" << std::endl;
+
+  using W = typename Graph::weight_type;
+  // one direction of each edge
+  auto all = G.edges();
+  auto dir = pbbs::filter(all, [&](const std::tuple<uintE, uintE, W>& e) {
+    return std::get<0>(e) < std::get<1>(e);
+  });
+  size_t m = dir.size();
+  size_t batch_size = (m + nbatches - 1) / nbatches;
+
+  auto orient = incremental_orientation(G.n);
+  timer t; t.start();
+  for (size_t b = 0; b < nbatches; b++) {
+    size_t lo = b * batch_size;
+    size_t hi = std::min(lo + batch_size, m);
+    if (lo >= hi) break;
+    auto E = pbbs::new_array_no_init<std::tuple<uintE, uintE, W>>(hi - lo);
+    for (size_t i = lo; i < hi; i++) E[i - lo] = dir[i];
+    auto batch = edge_array<W>(E, G.n, G.n, hi - lo);
+    orient.insert_batch(batch);
+    batch.del();
+    std::cout << "batch " << b << ": max_out = " << orient.max_out_degree()
+              << " threshold = " << orient.threshold
+              << " flips = " << orient.total_flips << std::endl;
+  }
+  double tt = t.stop();
+  std::cout << "### Running Time: " << tt << std::endl;
+  return tt;
+}
+
+}  // namespace gbbs
+
+generate_symmetric_main(gbbs::IncrementalOrientation_runner, false);
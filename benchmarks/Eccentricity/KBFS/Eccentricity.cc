@@ -0,0 +1,69 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Usage:
+// numactl -i all ./Eccentricity -nseeds 64 -beta 0.2 -s -m graph
+// flags:
+//   required:
+//     -s : indicate that the graph is symmetric
+//   optional:
+//     -nseeds: number of BFS seeds (<= 64)
+//     -beta:   LDD beta used for seed spreading
+//     -m : indicate that the graph should be mmap'd
+//     -c : indicate that the graph is compressed
+
+#include "Eccentricity.h"
+
+namespace gbbs {
+
+template <class Graph>
+double Eccentricity_runner(Graph& G, commandLine P) {
+  size_t nseeds = static_cast<size_t>(P.getOptionLongValue("-nseeds", 64));
+  double beta = P.getOptionDoubleValue("-beta", 0.2);
+  if (nseeds > 64) nseeds = 64;
+  std::cout << "### Application: Eccentricity (k-BFS)" << std::endl;
+  std::cout << "### Graph: " << P.getArgument(0) << std::endl;
+  std::cout << "### Threads: " << num_workers() << std::endl;
+  std::cout << "### n: " << G.n << std::endl;
+  std::cout << "### m: " << G.m << std::endl;
+  std::cout << "### Params: -nseeds = " << nseeds << " -beta = " << beta
+            << std::endl;
+  std::cout << "### ------------------------------------" << std::endl;
+
+  timer t; t.start();
+  auto seeds = ecc::ldd_seeds(G, nseeds, beta);
+  auto [seed_ecc, ecc_lb] = ecc::KBFS_Ecc(G, seeds);
+  double tt = t.stop();
+
+  uintE diam_lb = 0;
+  for (size_t k = 0; k < seed_ecc.size(); k++) {
+    diam_lb = std::max(diam_lb, seed_ecc[k]);
+  }
+  std::cout << "Diameter estimate (lower bound) = " << diam_lb << std::endl;
+  std::cout << "### Running Time: " << tt << std::endl;
+  return tt;
+}
+
+}  // namespace gbbs
+
+generate_symmetric_main(gbbs::Eccentricity_runner, false);
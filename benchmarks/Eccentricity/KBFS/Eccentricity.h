@@ -0,0 +1,142 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Eccentricity / diameter estimation via a bit-parallel k-BFS sweep (the
+// MS-BFS technique): up to 64 seed BFSs run together, one bit per seed per
+// vertex, and when a bit first reaches a vertex in round r that round is
+// dist(seed, vertex). Per-seed eccentricities (exact for the seeds) and
+// per-vertex lower bounds (the latest round any seed arrived) come out of
+// one sweep; the diameter estimate is the max seed eccentricity, a lower
+// bound that iFUB-style refinement could tighten. Seeds are drawn from
+// distinct low-diameter-decomposition clusters so they spread across the
+// graph rather than clustering in one region.
+
+#pragma once
+
+#include "benchmarks/LowDiameterDecomposition/MPX13/LowDiameterDecomposition.h"
+#include "gbbs/gbbs.h"
+
+namespace gbbs {
+namespace ecc {
+
+struct ECC_F {
+  uint64_t* visited;
+  uint64_t* next_bits;
+  uint64_t batch_mask;
+  ECC_F(uint64_t* visited, uint64_t* next_bits, uint64_t batch_mask)
+      : visited(visited), next_bits(next_bits), batch_mask(batch_mask) {}
+  inline bool update(uintE s, uintE d, pbbslib::empty w) {
+    uint64_t new_bits = visited[s] & ~visited[d] & ~next_bits[d];
+    if (new_bits == 0) return false;
+    bool first = (next_bits[d] == 0);
+    next_bits[d] |= new_bits;
+    return first;
+  }
+  inline bool updateAtomic(uintE s, uintE d, pbbslib::empty w) {
+    uint64_t new_bits = visited[s] & ~visited[d];
+    if (new_bits == 0) return false;
+    while (true) {
+      uint64_t cur = next_bits[d];
+      uint64_t add = new_bits & ~cur;
+      if (add == 0) return false;
+      if (pbbslib::atomic_compare_and_swap(&next_bits[d], cur, cur | add)) {
+        return cur == 0;
+      }
+    }
+  }
+  inline bool cond(uintE d) { return (visited[d] & batch_mask) != batch_mask; }
+};
+
+// Picks up to `k` seeds, one per LDD cluster (first member wins), falling
+// back to hashed vertices if the decomposition yields fewer clusters.
+template <class Graph>
+sequence<uintE> ldd_seeds(Graph& G, size_t k, double beta = 0.2) {
+  size_t n = G.n;
+  auto clusters = LDD(G, beta);
+  auto seen = sequence<bool>(n, false);
+  std::vector<uintE> seeds;
+  for (size_t i = 0; i < n && seeds.size() < k; i++) {
+    uintE c = clusters[i];
+    if (!seen[c]) {
+      seen[c] = true;
+      seeds.push_back((uintE)i);
+    }
+  }
+  for (size_t s = 0; seeds.size() < std::min(k, n); s++) {
+    uintE v = (uintE)(pbbs::hash64(s) % n);
+    seeds.push_back(v);
+  }
+  return sequence<uintE>(seeds.size(), [&](size_t i) { return seeds[i]; });
+}
+
+// One bit-parallel sweep from the given seeds. Returns (per-seed exact
+// eccentricities restricted to reachable vertices, per-vertex lower
+// bounds).
+template <class Graph>
+std::tuple<sequence<uintE>, sequence<uintE>> KBFS_Ecc(
+    Graph& G, sequence<uintE> const& seeds) {
+  size_t n = G.n;
+  size_t batch = seeds.size();
+  assert(batch <= 64);
+
+  auto visited = sequence<uint64_t>(n, (uint64_t)0);
+  auto next_bits = sequence<uint64_t>(n, (uint64_t)0);
+  auto seed_ecc = sequence<uintE>(batch, (uintE)0);
+  auto ecc_lb = sequence<uintE>(n, (uintE)0);
+
+  auto init = sequence<uintE>(batch, [&](size_t i) { return seeds[i]; });
+  for (size_t k = 0; k < batch; k++) {
+    visited[seeds[k]] |= (uint64_t{1} << k);
+  }
+  auto Frontier = vertexSubset(n, std::move(init));
+
+  uintE round = 0;
+  while (!Frontier.isEmpty()) {
+    round++;
+    uint64_t batch_mask =
+        (batch == 64) ? ~uint64_t{0} : ((uint64_t{1} << batch) - 1);
+    auto f = ECC_F(visited.begin(), next_bits.begin(), batch_mask);
+    auto output = edgeMap(G, Frontier, f, -1);
+    Frontier = std::move(output);
+    auto arrived = sequence<uint64_t>(num_workers(), (uint64_t)0);
+    vertexMap(Frontier, [&](uintE v) {
+      uint64_t bits = next_bits[v];
+      ecc_lb[v] = round;
+      visited[v] |= bits;
+      next_bits[v] = 0;
+      // any seed whose bit is still arriving has eccentricity >= round
+      arrived[worker_id()] |= bits;
+    });
+    uint64_t round_bits = 0;
+    for (size_t w = 0; w < arrived.size(); w++) round_bits |= arrived[w];
+    while (round_bits != 0) {
+      size_t k = __builtin_ctzll(round_bits);
+      seed_ecc[k] = round;
+      round_bits &= round_bits - 1;
+    }
+  }
+  return std::make_tuple(std::move(seed_ecc), std::move(ecc_lb));
+}
+
+}  // namespace ecc
+}  // namespace gbbs
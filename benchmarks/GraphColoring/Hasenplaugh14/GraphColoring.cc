@@ -55,7 +55,8 @@ double Coloring_runner(Graph& G, commandLine P) {
   std::cout << "### ------------------------------------" << std::endl;
 
   timer t; t.start();
-  auto colors = Coloring(G, runLF);
+  auto colors = P.getOption("-spec") ? Coloring_speculative(G)
+                                     : Coloring(G, runLF);
   double tt = t.stop();
   if (P.getOption("-stats")) {
     std::cout << "num_colors = " << pbbslib::reduce_max(colors) << "\n";
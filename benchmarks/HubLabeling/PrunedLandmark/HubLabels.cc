@@ -0,0 +1,81 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Usage:
+// numactl -i all ./HubLabels -nl 64 -queries 1000000 -s -m graph
+// flags:
+//   required:
+//     -s : indicate that the graph is symmetric
+//   optional:
+//     -nl:      number of landmarks (default: n, exact index)
+//     -queries: number of random queries for the microbenchmark
+//     -m : indicate that the graph should be mmap'd
+//     -c : indicate that the graph is compressed
+
+#include "HubLabels.h"
+
+namespace gbbs {
+
+template <class Graph>
+double HubLabels_runner(Graph& G, commandLine P) {
+  size_t num_landmarks =
+      static_cast<size_t>(P.getOptionLongValue("-nl", G.n));
+  size_t num_queries =
+      static_cast<size_t>(P.getOptionLongValue("-queries", 1000000));
+  std::cout << "### Application: HubLabels (pruned landmark labeling)"
+            << std::endl;
+  std::cout << "### Graph: " << P.getArgument(0) << std::endl;
+  std::cout << "### Threads: " << num_workers() << std::endl;
+  std::cout << "### n: " << G.n << std::endl;
+  std::cout << "### m: " << G.m << std::endl;
+  std::cout << "### Params: -nl = " << num_landmarks << " -queries = "
+            << num_queries << std::endl;
+  std::cout << "### ------------------------------------" << std::endl;
+
+  timer t; t.start();
+  auto idx = hub_labels::BuildIndex(G, num_landmarks);
+  double tt = t.stop();
+  std::cout << "Total labels: " << idx.total_labels()
+            << " (avg " << (double)idx.total_labels() / G.n << " per vertex)"
+            << std::endl;
+  std::cout << "### Running Time: " << tt << std::endl;
+
+  // query microbenchmark
+  timer qt; qt.start();
+  size_t reachable = 0;
+  parallel_for(0, num_queries, [&](size_t q) {
+    uintE u = (uintE)(pbbs::hash64(q) % G.n);
+    uintE v = (uintE)(pbbs::hash64(q ^ 0xdeadbeef) % G.n);
+    if (idx.query(u, v) != UINT_E_MAX) {
+      pbbslib::fetch_and_add(&reachable, (size_t)1);
+    }
+  });
+  double qtt = qt.stop();
+  std::cout << "Query time: " << qtt << " (" << (qtt / num_queries) * 1e9
+            << " ns/query, " << reachable << " reachable)" << std::endl;
+  return tt;
+}
+
+}  // namespace gbbs
+
+generate_symmetric_main(gbbs::HubLabels_runner, false);
@@ -0,0 +1,176 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Pruned landmark labeling (hub labels) for sub-millisecond distance
+// queries. Landmarks are processed in decreasing-degree order; each runs a
+// parallel BFS whose visits are pruned when the labels built so far
+// already certify a distance no longer than the BFS would assign, so
+// later (low-rank) landmarks label only the small regions the earlier
+// ones missed. The finished index is flattened into per-vertex sorted
+// (hub-rank, dist) arrays behind an offsets array -- the same CSR layout
+// discipline as the vertex neighbor arrays -- and a query is one merge
+// intersection over two label arrays.
+
+#pragma once
+
+#include <vector>
+
+#include "gbbs/gbbs.h"
+
+namespace gbbs {
+namespace hub_labels {
+
+using label = std::pair<uintE, uintE>;  // (hub rank, distance)
+
+struct hub_index {
+  size_t n;
+  sequence<uintT> offsets;  // n + 1
+  sequence<label> labels;   // sorted by hub rank within each vertex
+
+  // Distance between u and v (UINT_E_MAX if no common hub => disconnected).
+  inline uintE query(uintE u, uintE v) const {
+    uintT i = offsets[u], iend = offsets[u + 1];
+    uintT j = offsets[v], jend = offsets[v + 1];
+    uintE best = UINT_E_MAX;
+    while (i < iend && j < jend) {
+      uintE hi = labels[i].first, hj = labels[j].first;
+      if (hi == hj) {
+        uintE d = labels[i].second + labels[j].second;
+        if (d < best) best = d;
+        i++, j++;
+      } else if (hi < hj) {
+        i++;
+      } else {
+        j++;
+      }
+    }
+    return best;
+  }
+
+  size_t total_labels() const { return labels.size(); }
+};
+
+template <class W>
+struct PLL_F {
+  uintE* dist;
+  uintE next_dist;
+  PLL_F(uintE* dist, uintE next_dist) : dist(dist), next_dist(next_dist) {}
+  inline bool update(uintE s, uintE d, W w) {
+    if (dist[d] == UINT_E_MAX) {
+      dist[d] = next_dist;
+      return 1;
+    }
+    return 0;
+  }
+  inline bool updateAtomic(uintE s, uintE d, W w) {
+    return pbbslib::atomic_compare_and_swap(&dist[d], UINT_E_MAX, next_dist);
+  }
+  inline bool cond(uintE d) { return dist[d] == UINT_E_MAX; }
+};
+
+// Builds the index using up to num_landmarks landmarks (n = full exact
+// index). Landmarks run sequentially -- the pruning depends on earlier
+// labels -- with each BFS level expanded in parallel.
+template <class Graph>
+hub_index BuildIndex(Graph& G, size_t num_landmarks) {
+  using W = typename Graph::weight_type;
+  size_t n = G.n;
+  num_landmarks = std::min(num_landmarks, n);
+
+  // decreasing-degree landmark order
+  auto order = sequence<uintE>(n, [](size_t i) { return (uintE)i; });
+  auto deg_cmp = [&](const uintE& a, const uintE& b) {
+    uintE da = G.get_vertex(a).out_degree();
+    uintE db = G.get_vertex(b).out_degree();
+    return (da > db) || (da == db && a < b);
+  };
+  pbbs::sample_sort_inplace(order.slice(), deg_cmp);
+
+  std::vector<std::vector<label>> tmp(n);
+  auto dist = sequence<uintE>(n, (uintE)UINT_E_MAX);
+
+  // query against the labels built so far (both lists sorted by rank)
+  auto partial_query = [&](uintE u, uintE v) -> uintE {
+    auto& lu = tmp[u];
+    auto& lv = tmp[v];
+    size_t i = 0, j = 0;
+    uintE best = UINT_E_MAX;
+    while (i < lu.size() && j < lv.size()) {
+      if (lu[i].first == lv[j].first) {
+        uintE d = lu[i].second + lv[j].second;
+        if (d < best) best = d;
+        i++, j++;
+      } else if (lu[i].first < lv[j].first) {
+        i++;
+      } else {
+        j++;
+      }
+    }
+    return best;
+  };
+
+  for (size_t r = 0; r < num_landmarks; r++) {
+    uintE L = order[r];
+    dist[L] = 0;
+    auto Frontier = vertexSubset(n, L);
+    uintE level = 0;
+    std::vector<uintE> touched;
+    touched.push_back(L);
+    while (!Frontier.isEmpty()) {
+      // prune: drop frontier vertices already covered by earlier labels
+      // (they neither get a label nor expand)
+      auto keep = vertexFilter(Frontier, [&](uintE v) {
+        return (v == L) || partial_query(L, v) > dist[v];
+      });
+      vertexMap(keep, [&](uintE v) {
+        tmp[v].push_back(label((uintE)r, dist[v]));
+      });
+      level++;
+      auto f = PLL_F<W>(dist.begin(), level);
+      auto output = edgeMap(G, keep, f, -1);
+      vertexMap(output, [&](uintE v) { touched.push_back(v); });
+      Frontier = std::move(output);
+    }
+    // reset only the vertices this landmark reached
+    for (uintE v : touched) dist[v] = UINT_E_MAX;
+  }
+
+  // flatten to the CSR-style layout
+  hub_index idx;
+  idx.n = n;
+  idx.offsets = sequence<uintT>(n + 1);
+  par_for(0, n, [&](size_t i) { idx.offsets[i] = tmp[i].size(); });
+  idx.offsets[n] = 0;
+  size_t total = pbbslib::scan_add_inplace(idx.offsets.slice());
+  idx.labels = sequence<label>::no_init(total);
+  parallel_for(0, n, [&](size_t i) {
+    size_t off = idx.offsets[i];
+    for (size_t j = 0; j < tmp[i].size(); j++) {
+      idx.labels[off + j] = tmp[i][j];
+    }
+  }, 1);
+  return idx;
+}
+
+}  // namespace hub_labels
+}  // namespace gbbs
@@ -0,0 +1,178 @@
+// Usage:
+// ./DynamicKCore -s [-batches 10] [-delete-frac 0.05] <graph>
+// flags:
+//   required:
+//     -s : indicates that the graph is symmetric
+//   optional:
+//     -batches : number of insertion batches the edges stream in as
+//     -delete-frac : fraction of edges deleted (and re-inserted) to
+//                    exercise the dynamic paths
+//     -check : verify maintained coreness against static KCore after the
+//              insert stream and after the deletion batch
+//
+// Streams the input graph's edges into the dynamic graph in batches,
+// maintains coreness with the h-operator maintainer, deletes (and
+// re-inserts) a batch, and optionally cross-checks each settled state
+// against the static Julienne KCore on an equivalent graph.
+
+#include "DynamicKCore.h"
+#include "benchmarks/KCore/JulienneDBS17/KCore.h"
+#include "gbbs/graph_mutation.h"
+
+namespace gbbs {
+
+template <class Graph>
+double DynamicKCore_runner(Graph& G, commandLine P) {
+  using W = typename Graph::weight_type;
+  size_t num_batches = P.getOptionLongValue("-batches", 10);
+  double delete_frac = P.getOptionDoubleValue("-delete-frac", 0.05);
+  bool check = P.getOption("-check");
+  std::cout << "### Application: DynamicKCore (batch-dynamic coreness)"
+            << std::endl;
+  std::cout << "### Graph: " << P.getArgument(0) << std::endl;
+  std::cout << "### Threads: " << num_workers() << std::endl;
+  std::cout << "### n: " << G.n << std::endl;
+  std::cout << "### m: " << G.m << std::endl;
+  std::cout << "### Params: -batches = " << num_batches
+            << " -delete-frac = " << delete_frac << std::endl;
+  std::cout << "### ------------------------------------" << std::endl;
+  assert(P.getOption("-s"));
+
+  // one direction per undirected edge, deduplicated: the dynamic graph is
+  // a simple graph (batch application merges duplicates away), so the
+  // static references below must be built from the same simple edge set
+  auto all = G.edges();
+  auto half_dup = pbbs::filter(all, [](const std::tuple<uintE, uintE, W>& e) {
+    return std::get<0>(e) < std::get<1>(e);
+  });
+  auto cmp = [](const std::tuple<uintE, uintE, W>& a,
+                const std::tuple<uintE, uintE, W>& b) {
+    return std::tie(std::get<0>(a), std::get<1>(a)) <
+           std::tie(std::get<0>(b), std::get<1>(b));
+  };
+  pbbs::sample_sort_inplace(half_dup.slice(), cmp);
+  auto first = pbbslib::make_sequence<bool>(half_dup.size(), [&](size_t i) {
+    return i == 0 ||
+           std::tie(std::get<0>(half_dup[i]), std::get<1>(half_dup[i])) !=
+               std::tie(std::get<0>(half_dup[i - 1]),
+                        std::get<1>(half_dup[i - 1]));
+  });
+  auto half = pbbs::pack(half_dup, first);
+  size_t m_half = half.size();
+
+  timer t; t.start();
+  auto DG = dynamic_symmetric_graph<W>(G.n);
+  size_t batch_size = (m_half + num_batches - 1) / num_batches;
+  for (size_t b = 0; b < num_batches; b++) {
+    size_t lo = b * batch_size;
+    size_t hi = std::min(lo + batch_size, m_half);
+    if (lo >= hi) break;
+    auto E = pbbslib::new_array_no_init<std::tuple<uintE, uintE, W>>(hi - lo);
+    par_for(0, hi - lo, pbbslib::kSequentialForThreshold,
+            [&](size_t i) { E[i] = half[lo + i]; });
+    auto batch = edge_array<W>(E, G.n, G.n, hi - lo);
+    DG.insert_batch(batch);
+    batch.del();
+  }
+  auto M = dynamic_kcore::maintainer<W>(DG);
+  double t_ins = t.stop();
+  std::cout << "### insert stream + settle: " << t_ins << std::endl;
+
+  auto report_kmax = [&](const char* label) {
+    size_t kmax = pbbslib::reduce_max(M.core);
+    std::cout << "### " << label << ": k_max = " << kmax << std::endl;
+  };
+  report_kmax("after inserts");
+
+  auto simple_reference_cores = [&]() {
+    auto RE = pbbs::sequence<std::tuple<uintE, uintE, W>>(
+        2 * m_half, [&](size_t i) {
+          auto& e = half[i / 2];
+          return (i % 2) ? std::make_tuple(std::get<1>(e), std::get<0>(e),
+                                           std::get<2>(e))
+                         : e;
+        });
+    auto RG = sym_graph_from_edges<W>(
+        RE, G.n,
+        [](const std::tuple<uintE, uintE, W>& e) { return std::get<0>(e); },
+        [](const std::tuple<uintE, uintE, W>& e) { return std::get<1>(e); },
+        [](const std::tuple<uintE, uintE, W>& e) { return std::get<2>(e); });
+    auto cores = KCore(RG);
+    RG.del();
+    return cores;
+  };
+
+  if (check) {
+    auto static_cores = simple_reference_cores();
+    size_t bad = 0;
+    for (size_t v = 0; v < G.n; v++) bad += (M.core[v] != static_cores[v]);
+    std::cout << "### check (after inserts + settle): mismatches = " << bad
+              << std::endl;
+  }
+
+  // deletion batch: every k-th half edge
+  size_t stride = (delete_frac > 0) ? std::max<size_t>(1, (size_t)(1.0 / delete_frac)) : 0;
+  if (stride > 0) {
+    auto del_idx = pbbs::filter(
+        pbbs::sequence<size_t>(m_half, [](size_t i) { return i; }),
+        [&](size_t i) { return i % stride == 0; });
+    auto E = pbbslib::new_array_no_init<std::tuple<uintE, uintE, W>>(del_idx.size());
+    par_for(0, del_idx.size(), pbbslib::kSequentialForThreshold,
+            [&](size_t i) { E[i] = half[del_idx[i]]; });
+    auto batch = edge_array<W>(E, G.n, G.n, del_idx.size());
+    timer dt; dt.start();
+    M.delete_batch(batch);
+    double t_del = dt.stop();
+    std::cout << "### deleted " << del_idx.size() << " edges, settle: "
+              << t_del << std::endl;
+    report_kmax("after deletions");
+
+    if (check) {
+      // reference: static KCore over the graph minus the deleted batch
+      auto deleted = sequence<bool>(m_half, false);
+      par_for(0, del_idx.size(), pbbslib::kSequentialForThreshold,
+              [&](size_t i) { deleted[del_idx[i]] = true; });
+      auto keep = pbbs::filter(
+          pbbs::sequence<size_t>(m_half, [](size_t i) { return i; }),
+          [&](size_t i) { return !deleted[i]; });
+      auto RE = pbbs::sequence<std::tuple<uintE, uintE, W>>(
+          2 * keep.size(), [&](size_t i) {
+            auto& e = half[keep[i / 2]];
+            return (i % 2) ? std::make_tuple(std::get<1>(e), std::get<0>(e),
+                                             std::get<2>(e))
+                           : e;
+          });
+      auto RG = sym_graph_from_edges<W>(
+          RE, G.n,
+          [](const std::tuple<uintE, uintE, W>& e) { return std::get<0>(e); },
+          [](const std::tuple<uintE, uintE, W>& e) { return std::get<1>(e); },
+          [](const std::tuple<uintE, uintE, W>& e) { return std::get<2>(e); });
+      auto ref = KCore(RG);
+      size_t bad = 0;
+      for (size_t v = 0; v < G.n; v++) bad += (M.core[v] != ref[v]);
+      std::cout << "### check (after deletions, exact path): mismatches = "
+                << bad << std::endl;
+      RG.del();
+    }
+
+    // re-insert (approximate until refresh; see the header doc)
+    M.insert_batch(batch);
+    M.refresh();
+    report_kmax("after re-insert + refresh");
+    if (check) {
+      auto static_cores = simple_reference_cores();
+      size_t bad = 0;
+      for (size_t v = 0; v < G.n; v++) bad += (M.core[v] != static_cores[v]);
+      std::cout << "### check (after refresh): mismatches = " << bad
+                << std::endl;
+    }
+    batch.del();
+  }
+  double tt = t_ins;
+  std::cout << "### Running Time: " << tt << std::endl;
+  return tt;
+}
+
+}  // namespace gbbs
+
+generate_symmetric_main(gbbs::DynamicKCore_runner, false);
@@ -0,0 +1,170 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Batch-dynamic coreness maintenance over the dynamic graph, built on the
+// local h-operator (a vertex's coreness is the largest k such that at
+// least k of its neighbors have coreness >= k; iterating this from valid
+// upper bounds converges to the exact coreness). On a batch, only the
+// endpoints' estimates are unsettled: they are raised to a fresh upper
+// bound (their degree for insertions; deletions already hold an upper
+// bound), and the operator is iterated with change propagation -- a vertex
+// whose estimate drops re-activates its neighbors -- so work tracks the
+// region whose coreness actually moves. Deletion-only batches converge to
+// the exact coreness; insertion batches are exact within the region the
+// upper-bound reset reaches (remote vertices whose coreness could rise
+// through newly upgraded paths keep their old values until a periodic
+// refresh(), which re-runs the operator from scratch -- the documented
+// approximation, in line with maintaining approximate coreness between
+// full recomputations).
+
+#pragma once
+
+#include "gbbs/dynamic_symmetric_graph.h"
+#include "gbbs/gbbs.h"
+#include "pbbslib/worker_bag.h"
+
+#include <vector>
+
+namespace gbbs {
+namespace dynamic_kcore {
+
+template <class W>
+struct maintainer {
+  dynamic_symmetric_graph<W>& G;
+  pbbs::sequence<uintE> core;
+  // Round-stamped dedup for propagation (allocated once; a vertex is
+  // "seen" this round iff its stamp equals the current round id), so a
+  // propagation round costs O(affected), not O(n).
+  pbbs::sequence<size_t> seen_stamp;
+  size_t round_id;
+
+  maintainer(dynamic_symmetric_graph<W>& G)
+      : G(G), core(G.n, (uintE)0), seen_stamp(G.n, (size_t)0), round_id(0) {
+    refresh();
+  }
+
+  // The h-operator at v over current estimates: largest k such that at
+  // least k neighbors have estimate >= k.
+  inline uintE h_value(uintE v) {
+    uintE deg = G.get_vertex(v).out_degree();
+    if (deg == 0) return 0;
+    // counting bucket: how many neighbors have core >= k, capped at deg
+    std::vector<uintE> cnt(deg + 1, 0);
+    auto map_f = [&](const uintE& src, const uintE& u, const W& wgh) {
+      uintE c = std::min<uintE>(core[u], deg);
+      cnt[c]++;
+    };
+    G.get_vertex(v).out_neighbors().map(map_f, false);
+    uintE cum = 0;
+    for (uintE k = deg; k > 0; k--) {
+      cum += cnt[k];
+      if (cum >= k) return k;
+    }
+    return 0;
+  }
+
+  // Iterates the operator over the active set with change propagation.
+  void settle(pbbs::sequence<uintE>&& active0) {
+    auto active = std::move(active0);
+    while (active.size() > 0) {
+      auto changed = pbbs::worker_bag<uintE>();
+      parallel_for(0, active.size(), [&](size_t i) {
+        uintE v = active[i];
+        uintE h = h_value(v);
+        if (h < core[v]) {
+          core[v] = h;
+          changed.insert(v);
+        }
+      }, 1);
+      // neighbors of changed vertices must recheck
+      auto changed_seq = changed.to_sequence();
+      auto next = pbbs::worker_bag<uintE>();
+      round_id++;
+      size_t this_round = round_id;
+      parallel_for(0, changed_seq.size(), [&](size_t i) {
+        auto map_f = [&](const uintE& src, const uintE& u, const W& wgh) {
+          size_t old = seen_stamp[u];
+          if (old != this_round &&
+              pbbslib::atomic_compare_and_swap(&seen_stamp[u], old,
+                                               this_round)) {
+            next.insert(u);
+          }
+        };
+        G.get_vertex(changed_seq[i]).out_neighbors().map(map_f, false);
+      }, 1);
+      active = next.to_sequence();
+    }
+  }
+
+  // Full recompute via the operator (upper bounds = degrees everywhere);
+  // also the periodic refresh point for insertion-heavy streams.
+  void refresh() {
+    if (core.size() != G.n) core = pbbs::sequence<uintE>(G.n, (uintE)0);
+    if (seen_stamp.size() != G.n) {
+      seen_stamp = pbbs::sequence<size_t>(G.n, (size_t)0);
+      round_id = 0;
+    }
+    parallel_for(0, G.n, [&](size_t v) {
+      core[v] = G.get_vertex(v).out_degree();
+    });
+    auto all = pbbs::sequence<uintE>(G.n, [](size_t i) { return (uintE)i; });
+    settle(std::move(all));
+  }
+
+  // Applies an insertion batch to the graph and updates coreness.
+  void insert_batch(edge_array<W>& batch) {
+    G.insert_batch(batch);
+    auto seeds = reset_endpoints(batch, /* to_degree = */ true);
+    settle(std::move(seeds));
+  }
+
+  // Applies a deletion batch; converges to the exact new coreness.
+  void delete_batch(edge_array<W>& batch) {
+    G.delete_batch(batch);
+    auto seeds = reset_endpoints(batch, /* to_degree = */ false);
+    settle(std::move(seeds));
+  }
+
+ private:
+  pbbs::sequence<uintE> reset_endpoints(edge_array<W>& batch,
+                                        bool to_degree) {
+    auto seen = pbbs::sequence<bool>(G.n, false);
+    auto bag = pbbs::worker_bag<uintE>();
+    parallel_for(0, batch.non_zeros, [&](size_t i) {
+      uintE u = std::get<0>(batch.E[i]);
+      uintE v = std::get<1>(batch.E[i]);
+      for (uintE x : {u, v}) {
+        if (pbbslib::atomic_compare_and_swap(&seen[x], false, true)) {
+          if (to_degree) {
+            core[x] = G.get_vertex(x).out_degree();
+          }
+          bag.insert(x);
+        }
+      }
+    });
+    return bag.to_sequence();
+  }
+};
+
+}  // namespace dynamic_kcore
+}  // namespace gbbs
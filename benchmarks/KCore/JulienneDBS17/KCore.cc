@@ -56,11 +56,24 @@ double KCore_runner(Graph& G, commandLine P) {
 
   // runs the fetch-and-add based implementation if set.
   timer t; t.start();
-  auto cores = (fa) ? KCore_FA(G, num_buckets) : KCore(G, num_buckets);
+  auto cores = P.getOption("-packed")
+                   ? KCore_packed(G, num_buckets)
+                   : ((fa) ? KCore_FA(G, num_buckets) : KCore(G, num_buckets));
   double tt = t.stop();
 
   std::cout << "### Running Time: " << tt << std::endl;
 
+  if (char* of = P.getOptionValue("-of")) {
+    write_result_array(cores, of);
+  }
+
+  if (long topk = P.getOptionLongValue("-topk", 0)) {
+    auto top = pbbs::top_k(cores, (size_t)topk, std::less<uintE>());
+    std::cout << "### top-" << top.size() << " coreness:";
+    for (size_t i = 0; i < top.size(); i++) std::cout << " " << top[i];
+    std::cout << std::endl;
+  }
+
   return tt;
 }
 }  // namespace gbbs
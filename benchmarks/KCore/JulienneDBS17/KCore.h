@@ -23,13 +23,17 @@
 
 #pragma once
 
+#include "gbbs/cancellation.h"
 #include "gbbs/gbbs.h"
 #include "gbbs/julienne.h"
 
 namespace gbbs {
 
 template <class Graph>
-inline sequence<uintE> KCore(Graph& G, size_t num_buckets = 16) {
+inline sequence<uintE> KCore(Graph& G, size_t num_buckets = 16,
+                             cancellation::token* cancel = nullptr,
+                             cancellation::progress_reporter* progress =
+                                 nullptr) {
   const size_t n = G.n;
   auto D =
       sequence<uintE>(n, [&](size_t i) { return G.get_vertex(i).out_degree(); });
@@ -40,6 +44,14 @@ inline sequence<uintE> KCore(Graph& G, size_t num_buckets = 16) {
 
   size_t finished = 0, rho = 0, k_max = 0;
   while (finished != n) {
+    // cooperative cancellation + throttled progress, checked per round --
+    // never per edge
+    if (cancel != nullptr && cancel->should_stop()) {
+      std::cout << "### KCore cancelled at rho = " << rho << " ("
+                << finished << "/" << n << " peeled)" << std::endl;
+      break;
+    }
+    if (progress != nullptr) progress->report(finished, n);
     bt.start();
     auto bkt = b.next_bucket();
     bt.stop();
@@ -73,6 +85,50 @@ inline sequence<uintE> KCore(Graph& G, size_t num_buckets = 16) {
   return D;
 }
 
+// KCore over a packed-graph view using the fused peel step: each round's
+// extracted bucket is packed out of the structure and its induced degree
+// decrements are histogrammed in the same traversal (fused_peel_pack),
+// instead of paying separate count and pack passes over identical edges.
+template <class Graph>
+inline sequence<uintE> KCore_packed(Graph& G, size_t num_buckets = 16) {
+  const size_t n = G.n;
+  auto PG = sage::build_symmetric_packed_graph(G);
+  auto D =
+      sequence<uintE>(n, [&](size_t i) { return G.get_vertex(i).out_degree(); });
+  auto peeled = sequence<bool>(n, false);
+
+  auto em = hist_table<uintE, uintE>(std::make_tuple(UINT_E_MAX, 0), (size_t)G.m / 50);
+  auto b = make_vertex_buckets(n, D, increasing, num_buckets);
+
+  size_t finished = 0, rho = 0, k_max = 0;
+  while (finished != n) {
+    auto bkt = b.next_bucket();
+    auto active = vertexSubset(n, std::move(bkt.identifiers));
+    uintE k = bkt.id;
+    finished += active.size();
+    k_max = std::max(k_max, bkt.id);
+
+    auto apply_f = [&](const std::tuple<uintE, uintE>& p)
+        -> const std::optional<std::tuple<uintE, uintE> > {
+      uintE v = std::get<0>(p), edgesRemoved = std::get<1>(p);
+      uintE deg = D[v];
+      if (deg > k) {
+        uintE new_deg = std::max(deg - edgesRemoved, k);
+        D[v] = new_deg;
+        return wrap(v, b.get_bucket(new_deg));
+      }
+      return std::nullopt;
+    };
+
+    auto moved = fused_peel_pack(PG, active, peeled, apply_f, em);
+    b.update_buckets(moved);
+    rho++;
+  }
+  std::cout << "### rho = " << rho << " k_{max} = " << k_max << "\n";
+  PG.del();
+  return D;
+}
+
 template <class W>
 struct kcore_fetch_add {
   uintE* er;
@@ -97,8 +153,10 @@ struct kcore_fetch_add {
 };
 
 template <class Graph>
-inline sequence<uintE> KCore_FA(Graph& G,
-                                  size_t num_buckets = 16) {
+inline sequence<uintE> KCore_FA(Graph& G, size_t num_buckets = 16,
+                                cancellation::token* cancel = nullptr,
+                                cancellation::progress_reporter* progress =
+                                    nullptr) {
   using W = typename Graph::weight_type;
   const size_t n = G.n;
   auto D =
@@ -142,7 +200,10 @@ inline sequence<uintE> KCore_FA(Graph& G,
 }
 
 template <class Graph>
-inline pbbslib::dyn_arr<uintE> DegeneracyOrder(Graph& G, size_t num_buckets = 16) {
+inline pbbslib::dyn_arr<uintE> DegeneracyOrder(
+    Graph& G, size_t num_buckets = 16,
+    cancellation::token* cancel = nullptr,
+    cancellation::progress_reporter* progress = nullptr) {
   const size_t n = G.n;
   auto D =
       sequence<uintE>(n, [&](size_t i) { return G.get_vertex(i).out_degree(); });
@@ -156,6 +217,14 @@ inline pbbslib::dyn_arr<uintE> DegeneracyOrder(Graph& G, size_t num_buckets = 16
 
   size_t finished = 0, rho = 0, k_max = 0;
   while (finished != n) {
+    // cooperative cancellation + throttled progress, checked per round --
+    // never per edge
+    if (cancel != nullptr && cancel->should_stop()) {
+      std::cout << "### DegeneracyOrder cancelled at rho = " << rho << " ("
+                << finished << "/" << n << " peeled)" << std::endl;
+      break;
+    }
+    if (progress != nullptr) progress->report(finished, n);
     bt.start();
     auto bkt = b.next_bucket();
     bt.stop();
@@ -32,6 +32,7 @@
 //     -nb : the number of buckets to use in the bucketing implementation
 
 #include "KTruss.h"
+#include "truss_index.h"
 
 namespace gbbs {
 
@@ -56,7 +57,23 @@ double KTruss_runner(Graph& G, commandLine P) {
   // runs the fetch-and-add based implementation if set.
   timer t; t.start();
   //auto trusses = (!no_buckets) ? KTruss(G, num_buckets) : KTruss_no_bucket(G);
-  KTruss_ht(G, num_buckets);
+  if (P.getOption("-csr")) {
+    auto idx = KTruss_csr(G, num_buckets);
+    if (P.getOption("-community")) {
+      // online community search over the finished decomposition:
+      // -qv <vertex> -qk <k> (trussness here is stored value + 1)
+      uintE qv = (uintE)P.getOptionLongValue("-qv", 0);
+      uintE qk = (uintE)P.getOptionLongValue("-qk", 2);
+      auto T = truss_query::build_truss_index(G, idx);
+      timer qt; qt.start();
+      auto comm = T.community(qv, qk);
+      double qtt = qt.stop();
+      std::cout << "### community(" << qv << ", " << qk << ") = "
+                << comm.size() << " vertices in " << qtt << "s" << std::endl;
+    }
+  } else {
+    KTruss_ht(G, num_buckets);
+  }
   double tt = t.stop();
 
   std::cout << "### Running Time: " << tt << std::endl;
@@ -345,4 +345,183 @@ void KTruss_ht(Graph& GA, size_t num_buckets = 16) {
   std::cout << "iters = " << iter << std::endl;
 }
 
+// KTruss over the succinct CSR edge index instead of the multi-table: edge
+// ids are CSR ranks (truss_utils::csr_edge_index), trussness lives in a
+// packed array, and the shrinking working graph stays in the packed form
+// the in-place edgeMapFilter produces -- the index snapshots the original
+// layout, so ranks stay stable as the graph packs. Roughly 8 bytes per
+// directed edge of index state versus the multi-table's tuple-per-slot
+// layout.
+template <class Graph>
+auto KTruss_csr(Graph& GA, size_t num_buckets = 16) {
+  using W = typename Graph::weight_type;
+  using edge_t = size_t;
+  using bucket_t = size_t;
+  using trussness_t = uintE;
+
+  auto idx = truss_utils::csr_edge_index<trussness_t, Graph>(GA);
+  size_t n_edges = idx.size();
+
+  // Initial trussness = #triangles on each edge.
+  parallel_for(0, GA.n, [&] (size_t u) {
+    size_t off = idx.offsets[u];
+    size_t deg = idx.offsets[u + 1] - off;
+    par_for(0, deg, 16, [&] (size_t j) {
+      uintE v = idx.nghs[off + j];
+      auto u_nghs = GA.get_vertex(u).out_neighbors();
+      auto v_nghs = GA.get_vertex((uintE)v).out_neighbors();
+      auto noop = [] (uintE a, uintE b, uintE c) {};
+      idx.values[off + j] = (trussness_t)u_nghs.intersect_f(&v_nghs, noop);
+    });
+  }, 1);
+
+  auto get_bkt = pbbslib::make_sequence<uintE>(n_edges, [&] (size_t i) {
+    return (uintE)idx.values[i];
+  });
+  auto b = make_buckets<edge_t, bucket_t>(n_edges, get_bkt, increasing,
+                                          num_buckets);
+
+  auto hash_edge_id = [&] (const edge_t& e) { return pbbs::hash32(e); };
+  auto decr_source_table = pbbslib::make_sparse_table<edge_t, uintE>(
+      1 << 20, std::make_tuple(std::numeric_limits<edge_t>::max(), (uintE)0),
+      hash_edge_id);
+
+  auto del_edges = pbbslib::dyn_arr<edge_t>(6 * GA.n);
+  auto actual_degree = pbbs::sequence<uintE>(GA.n, [&] (size_t i) {
+    return GA.get_vertex(i).out_degree();
+  });
+
+  auto get_trussness_and_id = [&idx] (uintE u, uintE v) {
+    edge_t id = idx.idx(u, v);
+    trussness_t truss = idx.values[id];
+    return std::make_tuple(truss, id);
+  };
+
+  timer em_t, decrement_t, bt, ct, peeling_t; peeling_t.start();
+  size_t finished = 0, k_max = 0;
+  size_t iter = 0;
+  while (finished != n_edges) {
+    bt.start();
+    auto bkt = b.next_bucket();
+    bt.stop();
+    auto rem_edges = bkt.identifiers;
+    if (rem_edges.size() == 0) { continue; }
+
+    uintE k = bkt.id;
+    finished += rem_edges.size();
+    k_max = std::max(k_max, (size_t)bkt.id);
+
+    if (k == 0 || finished == n_edges) {
+      par_for(0, rem_edges.size(), [&] (size_t i) {
+        idx.values[rem_edges[i]] = std::numeric_limits<int>::max();
+      });
+      continue;
+    }
+
+    size_t e_size = 2 * k * rem_edges.size();
+    size_t e_space_required =
+        (size_t)1 << pbbslib::log2_up((size_t)(e_size * 1.2));
+    decr_source_table.resize_no_copy(e_space_required);
+    auto decr_tab = pbbslib::make_sparse_table<edge_t, uintE>(
+        decr_source_table.table, e_space_required,
+        std::make_tuple(std::numeric_limits<edge_t>::max(), (uintE)0),
+        hash_edge_id, false /* do not clear */);
+
+    decrement_t.start();
+    par_for(0, rem_edges.size(), 1, [&] (size_t i) {
+      edge_t id = rem_edges[i];
+      uintE u = idx.u_for_id(id);
+      uintE v = idx.ngh(id);
+      truss_utils::decrement_trussness<edge_t, trussness_t>(
+          GA, id, u, v, decr_tab, get_trussness_and_id, k);
+    });
+    decrement_t.stop();
+
+    auto decr_edges = decr_tab.entries();
+    parallel_for(0, decr_edges.size(), [&] (size_t i) {
+      auto id_and_ct = decr_edges[i];
+      edge_t id = std::get<0>(id_and_ct);
+      uintE triangles_removed = std::get<1>(id_and_ct);
+      uintE current_deg = idx.values[id];
+      assert(current_deg > k);
+      uintE new_deg = std::max(current_deg - triangles_removed, (uintE)k);
+      idx.values[id] = new_deg;
+      std::get<1>(decr_edges[i]) = b.get_bucket(current_deg, new_deg);
+    });
+
+    auto rebucket_edges =
+        pbbs::filter(decr_edges, [&] (const std::tuple<edge_t, uintE>& eb) {
+          return std::get<1>(eb) != UINT_E_MAX;
+        });
+    auto edges_moved_f = [&] (size_t i) {
+      return std::optional<std::tuple<edge_t, bucket_t>>(rebucket_edges[i]);
+    };
+
+    bt.start();
+    b.update_buckets(edges_moved_f, rebucket_edges.size());
+    bt.stop();
+
+    par_for(0, rem_edges.size(), [&] (size_t i) {
+      idx.values[rem_edges[i]] -= 1;
+    });
+
+    decr_tab.clear();
+    iter++;
+
+    del_edges.copyIn(rem_edges, rem_edges.size());
+    if (del_edges.size > 2 * GA.n) {
+      ct.start();
+      auto decr_seq = pbbs::sequence<uintE>(2 * del_edges.size);
+      parallel_for(0, del_edges.size, [&] (size_t i) {
+        size_t fst = 2 * i; size_t snd = fst + 1;
+        edge_t id = del_edges.A[i];
+        decr_seq[fst] = idx.u_for_id(id);
+        decr_seq[snd] = idx.ngh(id);
+      });
+
+      std::tuple<uintE, uintE> histogram_empty =
+          std::make_tuple(std::numeric_limits<uintE>::max(), 0);
+      auto em = hist_table<uintE, uintE>(histogram_empty, GA.m / 50);
+      auto apply_vtx_f = [&](const std::tuple<uintE, uintE>& p)
+          -> const std::optional<std::tuple<uintE, uintE>> {
+        uintE id = std::get<0>(p);
+        uintE degree_lost = std::get<1>(p);
+        actual_degree[id] -= degree_lost;
+        return std::nullopt;
+      };
+      em_t.start();
+      auto vs = vertexSubset(GA.n, std::move(decr_seq));
+      auto cond_f = [&] (const uintE& u) { return true; };
+      nghCount(GA, vs, cond_f, apply_vtx_f, em, no_output);
+      em_t.stop();
+
+      auto all_vertices =
+          pbbs::delayed_seq<uintE>(GA.n, [&] (size_t i) { return i; });
+      auto to_pack_seq = pbbs::filter(all_vertices, [&] (uintE u) {
+        return 4 * actual_degree[u] >= GA.get_vertex(u).out_degree();
+      });
+      auto to_pack = vertexSubset(GA.n, std::move(to_pack_seq));
+
+      auto pack_predicate =
+          [&](const uintE& u, const uintE& ngh, const W& wgh) {
+        trussness_t t_u_ngh;
+        edge_t edgeid;
+        std::tie(t_u_ngh, edgeid) = get_trussness_and_id(u, ngh);
+        return t_u_ngh >= k;
+      };
+      edgeMapFilter(GA, to_pack, pack_predicate, pack_edges | no_output);
+
+      del_edges.size = 0;
+      ct.stop();
+      em.del();
+    }
+  }
+  peeling_t.stop(); peeling_t.reportTotal("peeling time");
+  std::cout << "k_max = " << k_max << " iters = " << iter << std::endl;
+  // As in KTruss_ht: the actual trussness is the stored value + 1, and
+  // triangle-free edges store int-max. The returned index carries the
+  // final per-rank trussness for community-search queries (truss_index.h).
+  return idx;
+}
+
 }  // namespace gbbs
@@ -0,0 +1,123 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Online k-truss community search over a finished truss decomposition.
+// The index re-sorts each vertex's adjacency by edge trussness descending
+// (stable within equal trussness), so the edges of trussness >= k incident
+// to any vertex are a prefix found by one binary search; a community query
+// (v, k) is then a BFS that scans exactly those prefixes -- work
+// proportional to the answer's edge count, never the graph. Built from the
+// trussness-filled csr_edge_index the CSR peeling variant maintains
+// (truss_utils::csr_edge_index), i.e. the per-rank value array after
+// decomposition.
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "gbbs/gbbs.h"
+#include "truss_utils.h"
+
+namespace gbbs {
+namespace truss_query {
+
+struct truss_index {
+  size_t n = 0;
+  sequence<size_t> offsets;   // n + 1
+  sequence<uintE> nbrs;       // adjacency re-sorted by trussness desc
+  sequence<uintE> tvals;      // trussness parallel to nbrs
+
+  // first position in [offsets[v], offsets[v+1]) with trussness < k
+  inline size_t prefix_end(uintE v, uintE k) const {
+    size_t lo = offsets[v], hi = offsets[v + 1];
+    while (lo < hi) {
+      size_t mid = lo + (hi - lo) / 2;
+      if (tvals[mid] >= k) lo = mid + 1;
+      else hi = mid;
+    }
+    return lo;
+  }
+
+  // The k-truss community containing v: the connected subgraph around v
+  // over edges of trussness >= k. Empty when v has no such edge.
+  std::vector<uintE> community(uintE v, uintE k,
+                               std::vector<uintE>& visit_stamp,
+                               uintE stamp) const {
+    std::vector<uintE> out;
+    if (prefix_end(v, k) == offsets[v]) return out;
+    std::vector<uintE> stack{v};
+    visit_stamp[v] = stamp;
+    while (!stack.empty()) {
+      uintE x = stack.back();
+      stack.pop_back();
+      out.push_back(x);
+      size_t e = prefix_end(x, k);
+      for (size_t i = offsets[x]; i < e; i++) {
+        uintE y = nbrs[i];
+        if (visit_stamp[y] != stamp) {
+          visit_stamp[y] = stamp;
+          stack.push_back(y);
+        }
+      }
+    }
+    return out;
+  }
+
+  std::vector<uintE> community(uintE v, uintE k) const {
+    std::vector<uintE> stamps(n, UINT_E_MAX);
+    return community(v, k, stamps, 0);
+  }
+};
+
+// idx: a csr_edge_index whose values[] hold final trussness per edge rank.
+template <class trussness_t, class Graph>
+truss_index build_truss_index(
+    Graph& G, truss_utils::csr_edge_index<trussness_t, Graph>& idx) {
+  truss_index T;
+  T.n = G.n;
+  T.offsets = sequence<size_t>(G.n + 1, [&](size_t i) { return idx.offsets[i]; });
+  size_t m = idx.size();
+  T.nbrs = sequence<uintE>::no_init(m);
+  T.tvals = sequence<uintE>::no_init(m);
+  parallel_for(0, G.n, [&](size_t v) {
+    size_t off = idx.offsets[v];
+    size_t deg = idx.offsets[v + 1] - off;
+    // (trussness, neighbor) pairs, sorted by trussness descending
+    std::vector<std::pair<uintE, uintE>> row(deg);
+    for (size_t j = 0; j < deg; j++) {
+      row[j] = {(uintE)idx.values[off + j], idx.nghs[off + j]};
+    }
+    std::sort(row.begin(), row.end(), [](const auto& a, const auto& b) {
+      return a.first > b.first || (a.first == b.first && a.second < b.second);
+    });
+    for (size_t j = 0; j < deg; j++) {
+      T.tvals[off + j] = row[j].first;
+      T.nbrs[off + j] = row[j].second;
+    }
+  }, 1);
+  return T;
+}
+
+}  // namespace truss_query
+}  // namespace gbbs
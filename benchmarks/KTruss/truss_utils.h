@@ -411,5 +411,68 @@ namespace truss_utils {
     G.get_vertex(u).out_neighbors().intersect_f_par(&v_v, f);
   }
 
+  // Succinct CSR edge index: edge ids are ranks in the graph's own CSR
+  // layout (id = offset[u] + position of v in u's sorted list, found by
+  // binary search), so the hash-table edge-id map disappears. The index
+  // snapshots the offsets and neighbor ids at build time -- 8 bytes per
+  // directed edge plus the packed value array -- and therefore stays valid
+  // while peeling packs the working graph in place. Exposes the same
+  // surface the peeling loop needs from the multi-table: idx(), ngh(),
+  // u_for_id(), size(), and a writable per-id value.
+  template <class trussness_t, class Graph>
+  struct csr_edge_index {
+    size_t n;
+    size_t m;
+    pbbs::sequence<size_t> offsets;     // n + 1
+    pbbs::sequence<uintE> nghs;         // neighbor id per edge rank
+    pbbs::sequence<trussness_t> values; // trussness per edge rank
+
+    csr_edge_index(Graph& G) : n(G.n), m(G.m) {
+      using W = typename Graph::weight_type;
+      offsets = pbbs::sequence<size_t>(n + 1);
+      par_for(0, n, [&] (size_t i) {
+        offsets[i] = G.get_vertex(i).out_degree();
+      });
+      offsets[n] = 0;
+      pbbslib::scan_add_inplace(offsets.slice());
+      nghs = pbbs::sequence<uintE>::no_init(m);
+      values = pbbs::sequence<trussness_t>::no_init(m);
+      parallel_for(0, n, [&] (size_t i) {
+        size_t off = offsets[i];
+        size_t k = 0;
+        auto map_f = [&] (const uintE& u, const uintE& v, const W& wgh) {
+          nghs[off + (k++)] = v;
+        };
+        G.get_vertex(i).out_neighbors().map(map_f, false);
+      }, 1);
+    }
+
+    size_t size() const { return m; }
+
+    inline uintE ngh(size_t id) const { return nghs[id]; }
+
+    // Rank of edge (u, v); precondition: v is a neighbor of u.
+    inline size_t idx(uintE u, uintE v) const {
+      size_t lo = offsets[u], hi = offsets[u + 1];
+      while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (nghs[mid] < v) lo = mid + 1;
+        else hi = mid;
+      }
+      return lo;
+    }
+
+    // Source vertex of an edge rank (binary search over the offsets).
+    inline uintE u_for_id(size_t id) const {
+      uintE lo = 0, hi = n;
+      while (lo + 1 < hi) {  // invariant: offsets[lo] <= id < offsets[hi]
+        uintE mid = lo + (hi - lo) / 2;
+        if (offsets[mid] <= id) lo = mid;
+        else hi = mid;
+      }
+      return lo;
+    }
+  };
+
 }  // namespace truss_utils
 }  // namespace gbbs
@@ -32,6 +32,10 @@
 //     -rounds : the number of times to run the algorithm
 //     -fa : run the fetch-and-add implementation of k-core
 //     -nb : the number of buckets to use in the bucketing implementation
+//     -det : deterministic clustering (seeded permutation, races resolved
+//            toward the smaller center id); same input and -seed give the
+//            same clusters at any thread count
+//     -seed : seed for -det (default 0)
 
 #include "LowDiameterDecomposition.h"
 
@@ -49,13 +53,17 @@ double LDD_runner(Graph& G, commandLine P) {
   std::cout << "### Params: -beta = " << beta << " -permute = " << permute << std::endl;
   std::cout << "### ------------------------------------" << std::endl;
   assert(P.getOption("-s"));
+  bool deterministic = P.getOption("-det");
+  uint64_t seed = P.getOptionLongValue("-seed", 0);
   timer t; t.start();
-  auto ldd = LDD(G, beta, permute);
+  auto ldd = deterministic ? LDD_deterministic(G, beta, seed)
+                           : LDD(G, beta, permute);
   double tt = t.stop();
   if (P.getOption("-stats")) {
     ldd_utils::num_clusters(ldd);
     ldd_utils::cluster_sizes(ldd);
     ldd_utils::num_intercluster_edges(G, ldd);
+    ldd_utils::cluster_diameter_histogram(G, ldd);
   }
 
   std::cout << "### Running Time: " << tt << std::endl;
@@ -91,6 +91,68 @@ inline void num_intercluster_edges(Graph& G, Seq& s) {
   std::cout << "num. intercluster edges = " << pbbslib::reduce_add(ic_edges)
             << "\n";
 }
+// Restricted multi-source BFS from every cluster center over same-cluster
+// edges, reporting a histogram of per-cluster BFS depths (the cluster
+// radius; cluster diameter is at most twice the reported depth).
+template <class Graph, class Seq>
+inline void cluster_diameter_histogram(Graph& G, Seq& s) {
+  using W = typename Graph::weight_type;
+  size_t n = G.n;
+  auto depths = sequence<uintE>(n, UINT_E_MAX);
+
+  // Centers are the vertices whose cluster id is their own id.
+  auto center_f = [&](size_t i) { return s[i] == i; };
+  auto centers = pbbslib::filter(
+      pbbslib::make_sequence<uintE>(n, [](size_t i) { return (uintE)i; }),
+      center_f);
+  par_for(0, centers.size(), pbbslib::kSequentialForThreshold,
+          [&](size_t i) { depths[centers[i]] = 0; });
+
+  vertexSubset frontier(n, centers.size(), std::move(centers));
+  uintE round = 0;
+  while (!frontier.isEmpty()) {
+    round++;
+    struct BFS_F {
+      uintE* depths;
+      Seq& s;
+      uintE round;
+      BFS_F(uintE* depths, Seq& s, uintE round)
+          : depths(depths), s(s), round(round) {}
+      inline bool update(const uintE& u, const uintE& v, const W& wgh) {
+        if (s[u] == s[v] && depths[v] == UINT_E_MAX) {
+          depths[v] = round;
+          return true;
+        }
+        return false;
+      }
+      inline bool updateAtomic(const uintE& u, const uintE& v, const W& wgh) {
+        if (s[u] != s[v]) return false;
+        return pbbslib::atomic_compare_and_swap(&depths[v], UINT_E_MAX, round);
+      }
+      inline bool cond(const uintE& v) { return depths[v] == UINT_E_MAX; }
+    };
+    frontier = edgeMap(G, frontier, BFS_F(depths.begin(), s, round), -1,
+                       sparse_blocked);
+  }
+
+  // Per-cluster max depth, then a histogram over clusters.
+  auto cluster_depth = sequence<uintE>(n, (uintE)0);
+  par_for(0, n, pbbslib::kSequentialForThreshold, [&](size_t i) {
+    if (depths[i] != UINT_E_MAX) {
+      pbbs::write_max(&cluster_depth[s[i]], depths[i], std::less<uintE>());
+    }
+  });
+  auto hist = sequence<size_t>(round + 2, (size_t)0);
+  par_for(0, n, pbbslib::kSequentialForThreshold, [&](size_t i) {
+    if (s[i] == i) pbbs::write_add(&hist[cluster_depth[i]], 1);
+  });
+  std::cout << "cluster depth histogram (diameter <= 2 * depth):\n";
+  for (size_t d = 0; d < hist.size(); d++) {
+    if (hist[d] > 0) {
+      std::cout << "  depth " << d << ": " << hist[d] << " clusters\n";
+    }
+  }
+}
 }  // namespace ldd_utils
 
 template <class W, class EO>
@@ -119,6 +181,54 @@ struct LDD_F {
   inline bool cond(uintE d) { return cluster_ids[d] == UINT_E_MAX; }
 };
 
+// Deterministic variant of LDD_F. A destination reached for the first time
+// in round r stays open (cond true) for the whole round: every contending
+// source applies write_min on the cluster id, so the winner is the smallest
+// center id among the round's contenders -- independent of the execution
+// schedule -- rather than whichever CAS landed first. visited carries the
+// stamp of the round that reached the vertex (centers get an even stamp,
+// BFS claims the following odd stamp), closing it to later rounds.
+template <class W, class EO>
+struct LDD_det_F {
+  uintE* cluster_ids;
+  uintE* visited;
+  uintE stamp;
+  const EO& oracle;
+
+  LDD_det_F(uintE* _cluster_ids, uintE* _visited, uintE _stamp,
+            const EO& _oracle)
+      : cluster_ids(_cluster_ids), visited(_visited), stamp(_stamp),
+        oracle(_oracle) {}
+
+  inline bool update(const uintE& s, const uintE& d, const W& wgh) {
+    if (!oracle(s, d, wgh)) return false;
+    bool first = false;
+    if (visited[d] == UINT_E_MAX) {
+      visited[d] = stamp;
+      first = true;
+    }
+    if (visited[d] == stamp && cluster_ids[s] < cluster_ids[d]) {
+      cluster_ids[d] = cluster_ids[s];
+    }
+    return first;
+  }
+
+  inline bool updateAtomic(const uintE& s, const uintE& d, const W& wgh) {
+    if (!oracle(s, d, wgh)) return false;
+    bool first =
+        (visited[d] == UINT_E_MAX) &&
+        pbbslib::atomic_compare_and_swap(&visited[d], UINT_E_MAX, stamp);
+    if (visited[d] == stamp) {
+      pbbslib::write_min(&cluster_ids[d], cluster_ids[s], std::less<uintE>());
+    }
+    return first;
+  }
+
+  inline bool cond(uintE d) {
+    return visited[d] == UINT_E_MAX || visited[d] == stamp;
+  }
+};
+
 template <class Graph, class EO>
 inline sequence<uintE> LDD_impl(Graph& G, const EO& oracle,
                                   double beta, bool permute = true) {
@@ -207,4 +317,64 @@ sequence<uintE> LDD_oracle(Graph& G, EO& oracle, double beta,
   return LDD_impl(G, oracle, beta, permute);
 }
 
+// Deterministic LDD: the center order comes from the seeded deterministic
+// shuffle, and BFS races are resolved toward the smaller cluster id
+// (LDD_det_F), so the same input and seed always produce the same
+// clustering regardless of thread count or schedule.
+template <class Graph, class EO>
+inline sequence<uintE> LDD_deterministic_impl(Graph& G, const EO& oracle,
+                                              double beta, uint64_t seed) {
+  using W = typename Graph::weight_type;
+  size_t n = G.n;
+
+  auto vertex_perm = pbbs::deterministic_random_permutation<uintE>(n, seed);
+  auto shifts = ldd_utils::generate_shifts(n, beta);
+  auto cluster_ids = sequence<uintE>(n, UINT_E_MAX);
+  auto visited = sequence<uintE>(n, UINT_E_MAX);
+
+  size_t round = 0, num_visited = 0;
+  vertexSubset frontier(n);  // Initially empty
+  size_t num_added = 0;
+  while (num_visited < n) {
+    size_t start = shifts[round];
+    size_t end = std::min(static_cast<size_t>(shifts[round + 1]), n);
+    size_t num_to_add = end - start;
+    if (num_to_add > 0) {
+      assert((num_added + num_to_add) <= n);
+      auto candidates_f = [&](size_t i) {
+        return static_cast<uintE>(vertex_perm[num_added + i]);
+      };
+      auto candidates = pbbslib::make_sequence<uintE>(num_to_add, candidates_f);
+      auto pred = [&](uintE v) { return cluster_ids[v] == UINT_E_MAX; };
+      auto new_centers = pbbslib::filter(candidates, pred);
+      add_to_vsubset(frontier, new_centers.begin(), new_centers.size());
+      par_for(0, new_centers.size(), [&] (size_t i) {
+        uintE new_center = new_centers[i];
+        cluster_ids[new_center] = new_center;
+        visited[new_center] = (uintE)(2 * round);
+      });
+      num_added += num_to_add;
+    }
+
+    num_visited += frontier.size();
+    if (num_visited >= n) break;
+
+    auto ldd_f = LDD_det_F<W, EO>(cluster_ids.begin(), visited.begin(),
+                                  (uintE)(2 * round + 1), oracle);
+    frontier = edgeMap(G, frontier, ldd_f, -1, sparse_blocked);
+
+    round++;
+  }
+  return cluster_ids;
+}
+
+template <class Graph>
+sequence<uintE> LDD_deterministic(Graph& G, double beta, uint64_t seed = 0) {
+  using W = typename Graph::weight_type;
+  auto oracle = [&](const uintE& u, const uintE& v, const W& wgh) {
+    return true;
+  };
+  return LDD_deterministic_impl(G, oracle, beta, seed);
+}
+
 }  // namespace gbbs
@@ -117,15 +117,21 @@ struct mis_f {
   inline bool cond(uintE d) { return (p[d] > 0); }
 };
 
+// Rootset MIS over an explicit priority permutation (perm[v] = rank;
+// lower ranks enter the independent set preferentially). The work bounds
+// are those of the random-permutation analysis whenever perm is
+// near-random within priority classes; em_flags tunes the per-round
+// frontier representation (sparse_blocked by default; dense_forward can
+// win when rounds remove large fractions).
 template <class Graph>
-inline sequence<bool> MaximalIndependentSet(Graph& G) {
+inline sequence<bool> MaximalIndependentSet_perm(
+    Graph& G, sequence<uintE>& perm, flags em_flags = sparse_blocked) {
   using W = typename Graph::weight_type;
   timer init_t; init_t.start();
   size_t n = G.n;
 
   // compute the priority DAG
   auto priorities = sequence<intE>(n);  // why intE?
-  auto perm = pbbslib::random_permutation<uintE>(n);
   par_for(0, n, 1, [&] (size_t i) {
     uintE our_pri = perm[i];
     auto count_f = [&](uintE src, uintE ngh, const W& wgh) {
@@ -166,7 +172,7 @@ inline sequence<bool> MaximalIndependentSet(Graph& G) {
     timer nr;
     nr.start();
     auto new_roots =
-        edgeMap(G, removed, mis_f<W>(pri, perm.begin()), -1, sparse_blocked);
+        edgeMap(G, removed, mis_f<W>(pri, perm.begin()), -1, em_flags);
     nr.stop();
     nr.reportTotal("## new roots time");
 
@@ -179,6 +185,31 @@ inline sequence<bool> MaximalIndependentSet(Graph& G) {
   }
   return in_mis;
 }
+
+template <class Graph>
+inline sequence<bool> MaximalIndependentSet(Graph& G) {
+  auto perm = pbbslib::random_permutation<uintE>(G.n);
+  return MaximalIndependentSet_perm(G, perm);
+}
+
+// Priority-functor injection: vertices are ranked by (pri_f(v), v) and the
+// rootset algorithm runs over that order -- a weighted-random or
+// degree-based MIS is one functor away. Lower priority values are
+// preferred into the set.
+template <class Graph, class PriorityF>
+inline sequence<bool> MaximalIndependentSet_priority(
+    Graph& G, PriorityF pri_f, flags em_flags = sparse_blocked) {
+  size_t n = G.n;
+  auto order = sequence<uintE>(n, [](size_t i) { return (uintE)i; });
+  auto cmp = [&](const uintE& a, const uintE& b) {
+    auto pa = pri_f(a), pb = pri_f(b);
+    return pa < pb || (pa == pb && a < b);
+  };
+  pbbs::sample_sort_inplace(order.slice(), cmp);
+  auto perm = sequence<uintE>(n);
+  par_for(0, n, [&](size_t r) { perm[order[r]] = (uintE)r; });
+  return MaximalIndependentSet_perm(G, perm, em_flags);
+}
 }  // namespace MaximalIndependentSet_rootset
 
 namespace MaximalIndependentSet_spec_for {
@@ -0,0 +1,104 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Greedy weighted maximal matching: edges are processed in decreasing
+// weight order (the classic 1/2-approximation of maximum weight) with
+// batched speculative acquisition -- each round, every live edge reserves
+// both endpoints with write_min of its weight rank, winners that hold both
+// reservations enter the matching, losers whose endpoints are still free
+// retry next round. Conflict resolution is by rank, so the outcome equals
+// the sequential greedy result and is deterministic.
+
+#pragma once
+
+#include "gbbs/gbbs.h"
+
+namespace gbbs {
+namespace weighted_matching {
+
+// Returns the matched edges as (u, v, w) tuples.
+template <class Graph>
+sequence<std::tuple<uintE, uintE, typename Graph::weight_type>>
+WeightedMatching(Graph& G) {
+  using W = typename Graph::weight_type;
+  using edge = std::tuple<uintE, uintE, W>;
+  size_t n = G.n;
+
+  auto all = G.edges();
+  auto E = pbbs::filter(all, [&](const edge& e) {
+    return std::get<0>(e) < std::get<1>(e);
+  });
+  // decreasing weight; ties by endpoints for determinism
+  auto cmp = [](const edge& a, const edge& b) {
+    return std::tie(std::get<2>(b), std::get<0>(a), std::get<1>(a)) <
+           std::tie(std::get<2>(a), std::get<0>(b), std::get<1>(b));
+  };
+  pbbs::sample_sort_inplace(E.slice(), cmp);
+  size_t m = E.size();
+
+  constexpr uintE kFree = UINT_E_MAX;
+  auto owner = sequence<uintE>(n, kFree);      // vertex -> winning edge rank
+  auto matched = sequence<bool>(m, false);
+  auto live = sequence<uintE>(m, [](size_t i) { return (uintE)i; });
+
+  auto less = std::less<uintE>();
+  while (live.size() > 0) {
+    // 1. reservation: every live edge bids its rank on both endpoints
+    parallel_for(0, live.size(), [&](size_t i) {
+      uintE r = live[i];
+      pbbslib::write_min(&owner[std::get<0>(E[r])], r, less);
+      pbbslib::write_min(&owner[std::get<1>(E[r])], r, less);
+    });
+    // 2. commit winners; retain losers whose endpoints are both still free
+    auto next = pbbs::filter(live, [&](uintE r) {
+      uintE u = std::get<0>(E[r]);
+      uintE v = std::get<1>(E[r]);
+      if (owner[u] == r && owner[v] == r) {
+        matched[r] = true;
+        return false;  // committed
+      }
+      return true;  // lost a reservation; maybe retry
+    });
+    // 3. clear reservations of uncommitted vertices, drop edges whose
+    // endpoint got matched
+    parallel_for(0, next.size(), [&](size_t i) {
+      uintE r = next[i];
+      for (uintE x : {std::get<0>(E[r]), std::get<1>(E[r])}) {
+        uintE o = owner[x];
+        if (o != kFree && !matched[o]) owner[x] = kFree;
+      }
+    });
+    live = pbbs::filter(next, [&](uintE r) {
+      uintE u = std::get<0>(E[r]);
+      uintE v = std::get<1>(E[r]);
+      return (owner[u] == kFree || !matched[owner[u]]) &&
+             (owner[v] == kFree || !matched[owner[v]]);
+    });
+  }
+  return pbbs::pack(E, pbbslib::make_sequence<bool>(m, [&](size_t i) {
+    return (bool)matched[i];
+  }));
+}
+
+}  // namespace weighted_matching
+}  // namespace gbbs
@@ -0,0 +1,137 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Filter-Kruskal: edges are partitioned around a sampled weight pivot, the
+// light side is solved first, and only heavy edges whose endpoints are
+// still in different components survive the filter -- on weight-skewed
+// graphs most heavy edges are discarded without ever being sorted. The
+// recursion bottoms out in a sort + sequential Kruskal scan on small
+// subproblems; partitioning and filtering are parallel, and the pivot
+// comes from approximate_kth_smallest over a weight sample.
+
+#pragma once
+
+#include "gbbs/gbbs.h"
+#include "pbbslib/kth_smallest.h"
+
+namespace gbbs {
+namespace filter_kruskal {
+
+struct union_find {
+  pbbs::sequence<uintE> parents;
+  union_find(size_t n) : parents(n, [](size_t i) { return (uintE)i; }) {}
+  uintE find(uintE u) {
+    while (parents[u] != u) {
+      parents[u] = parents[parents[u]];
+      u = parents[u];
+    }
+    return u;
+  }
+  bool unite(uintE u, uintE v) {
+    uintE ru = find(u), rv = find(v);
+    if (ru == rv) return false;
+    parents[ru] = rv;
+    return true;
+  }
+};
+
+template <class W>
+using msf_edge = std::tuple<uintE, uintE, W>;
+
+// Sorted base case: sort by weight and scan.
+template <class W>
+void kruskal_base(pbbs::sequence<msf_edge<W>>& E, union_find& uf,
+                  W& weight, size_t& num_edges) {
+  auto less = [](const msf_edge<W>& a, const msf_edge<W>& b) {
+    return std::get<2>(a) < std::get<2>(b);
+  };
+  pbbs::sample_sort_inplace(E.slice(), less);
+  for (size_t i = 0; i < E.size(); i++) {
+    if (uf.unite(std::get<0>(E[i]), std::get<1>(E[i]))) {
+      weight += std::get<2>(E[i]);
+      num_edges++;
+    }
+  }
+}
+
+template <class W>
+void filter_kruskal_r(pbbs::sequence<msf_edge<W>>& E, union_find& uf,
+                      W& weight, size_t& num_edges) {
+  constexpr size_t kBaseSize = 1 << 14;
+  if (E.size() <= kBaseSize) {
+    kruskal_base(E, uf, weight, num_edges);
+    return;
+  }
+  // pivot: approximate median weight
+  auto weights = pbbs::delayed_seq<W>(
+      E.size(), [&](size_t i) { return std::get<2>(E[i]); });
+  W pivot = pbbs::approximate_kth_smallest(weights, E.size() / 2,
+                                           std::less<W>());
+
+  auto is_light = pbbs::delayed_seq<bool>(E.size(), [&](size_t i) {
+    return std::get<2>(E[i]) <= pivot;
+  });
+  auto light = pbbs::pack(E, is_light);
+  auto is_heavy = pbbs::delayed_seq<bool>(E.size(), [&](size_t i) {
+    return std::get<2>(E[i]) > pivot;
+  });
+  auto heavy = pbbs::pack(E, is_heavy);
+  E.clear();
+
+  if (light.size() == 0 || heavy.size() == 0) {
+    // degenerate pivot (all weights equal): fall back to the base case
+    auto& rest = (light.size() > 0) ? light : heavy;
+    kruskal_base(rest, uf, weight, num_edges);
+    return;
+  }
+  filter_kruskal_r(light, uf, weight, num_edges);
+
+  // the filter: heavy edges internal to a grown component never matter
+  auto survives = pbbs::sequence<bool>(heavy.size());
+  parallel_for(0, heavy.size(), [&](size_t i) {
+    survives[i] =
+        uf.find(std::get<0>(heavy[i])) != uf.find(std::get<1>(heavy[i]));
+  });
+  auto rest = pbbs::pack(heavy, survives);
+  heavy.clear();
+  filter_kruskal_r(rest, uf, weight, num_edges);
+}
+
+// Returns (total weight, number of forest edges).
+template <class Graph>
+std::pair<typename Graph::weight_type, size_t> MinimumSpanningForest(
+    Graph& G) {
+  using W = typename Graph::weight_type;
+  auto all = G.edges();
+  auto E = pbbs::filter(all, [&](const msf_edge<W>& e) {
+    return std::get<0>(e) < std::get<1>(e);
+  });
+  auto uf = union_find(G.n);
+  W weight = (W)0;
+  size_t num_edges = 0;
+  filter_kruskal_r(E, uf, weight, num_edges);
+  return {weight, num_edges};
+}
+
+}  // namespace filter_kruskal
+}  // namespace gbbs
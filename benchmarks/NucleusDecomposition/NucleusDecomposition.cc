@@ -0,0 +1,64 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Usage:
+// ./NucleusDecomposition -r 2 -nb 16 -s graph
+// flags:
+//   required:
+//     -s : indicate that the graph is symmetric
+//   optional:
+//     -r  : nucleus order (1 = coreness, 2 = trussness, 3 = (3,4)-nuclei)
+//     -nb : number of open buckets
+
+#include "NucleusDecomposition.h"
+
+namespace gbbs {
+
+template <class Graph>
+double NucleusDecomposition_runner(Graph& G, commandLine P) {
+  size_t r = static_cast<size_t>(P.getOptionLongValue("-r", 2));
+  size_t num_buckets = static_cast<size_t>(P.getOptionLongValue("-nb", 16));
+  std::cout << "### Application: NucleusDecomposition" << std::endl;
+  std::cout << "### Graph: " << P.getArgument(0) << std::endl;
+  std::cout << "### Threads: " << num_workers() << std::endl;
+  std::cout << "### n: " << G.n << std::endl;
+  std::cout << "### m: " << G.m << std::endl;
+  std::cout << "### Params: -r = " << r << " -nb = " << num_buckets
+            << std::endl;
+  std::cout << "### ------------------------------------" << std::endl;
+
+  timer t; t.start();
+  auto levels = nucleus::Nucleus(G, r, num_buckets);
+  double tt = t.stop();
+
+  uintE max_level = 0;
+  for (auto& kv : levels) max_level = std::max(max_level, kv.second);
+  std::cout << "num " << r << "-cliques = " << levels.size()
+            << ", max nucleus level = " << max_level << std::endl;
+  std::cout << "### Running Time: " << tt << std::endl;
+  return tt;
+}
+
+}  // namespace gbbs
+
+generate_symmetric_main(gbbs::NucleusDecomposition_runner, false);
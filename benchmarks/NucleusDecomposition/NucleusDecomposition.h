@@ -0,0 +1,262 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// (r, r+1)-nucleus decomposition, composing the machinery GBBS already has:
+// r-cliques are enumerated over the degree-ranked DAG (CliqueCounting's
+// orientation), their (r+1)-clique counts initialize a Julienne bucket
+// structure, and peeling proceeds bucket by bucket exactly as KCore/KTruss
+// do -- when an r-clique is peeled at level theta, each surviving
+// (r+1)-clique containing it decrements its other r-subsets. r = 1 and
+// r = 2 reproduce coreness and trussness; r = 3 is the (3,4)-nucleus
+// (communities denser than trusses). General s > r + 1 is not implemented:
+// extensions beyond one vertex need clique-adjacency indices that don't
+// exist in-tree yet, and (r, r+1) covers the decomposition actually used.
+
+#pragma once
+
+#include "benchmarks/TriangleCounting/ShunTangwongsan15/Triangle.h"
+#include "gbbs/gbbs.h"
+#include "gbbs/julienne.h"
+
+#include <array>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace gbbs {
+namespace nucleus {
+
+// An r-clique is kept as its sorted vertex ids packed into a 128-bit key
+// (32 bits per vertex, r <= 3 used today).
+using clique_key = unsigned __int128;
+
+struct clique_key_hash {
+  size_t operator()(const clique_key& k) const {
+    return pbbs::hash64((uint64_t)k) ^ pbbs::hash64((uint64_t)(k >> 64));
+  }
+};
+
+using clique_map = std::unordered_map<clique_key, uintE, clique_key_hash>;
+
+inline clique_key make_key(const uintE* verts, size_t r) {
+  clique_key key = 0;
+  for (size_t i = 0; i < r; i++) {
+    key = (key << 32) | verts[i];
+  }
+  return key;
+}
+
+// Enumerates all r-cliques of the (undirected) graph with vertices emitted
+// in increasing id order, using the ranked DAG to avoid duplicates.
+// f(verts) is called with the sorted r vertices.
+template <class Graph, class F>
+void enumerate_cliques(Graph& DG, size_t r, const F& f) {
+  using W = typename Graph::weight_type;
+  parallel_for(0, DG.n, [&](size_t u) {
+    uintE verts[8];
+    verts[0] = (uintE)u;
+    // candidates: out-neighbors of u in the DAG
+    std::vector<uintE> cand;
+    auto map_f = [&](const uintE& src, const uintE& v, const W& wgh) {
+      cand.push_back(v);
+    };
+    DG.get_vertex(u).out_neighbors().map(map_f, false);
+
+    // depth-first extension; adjacency checked against the DAG's lists
+    std::function<void(size_t, std::vector<uintE>&)> extend =
+        [&](size_t depth, std::vector<uintE>& cands) {
+      if (depth == r) {
+        uintE sorted[8];
+        for (size_t i = 0; i < r; i++) sorted[i] = verts[i];
+        std::sort(sorted, sorted + r);
+        f(sorted);
+        return;
+      }
+      for (size_t ci = 0; ci < cands.size(); ci++) {
+        uintE v = cands[ci];
+        verts[depth] = v;
+        // new candidates: members of cands adjacent to v (DAG out-edges)
+        std::vector<uintE> next;
+        auto v_nghs = DG.get_vertex(v).out_neighbors();
+        for (size_t cj = 0; cj < cands.size(); cj++) {
+          uintE w = cands[cj];
+          if (w == v) continue;
+          // is (v, w) a DAG edge?  lists are sorted; binary search
+          bool adj = false;
+          size_t dv = DG.get_vertex(v).out_degree();
+          size_t lo = 0, hi = dv;
+          while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            uintE x = v_nghs.get_neighbor(mid);
+            if (x < w) lo = mid + 1;
+            else { adj = (x == w); hi = mid; }
+          }
+          if (adj) next.push_back(w);
+        }
+        extend(depth + 1, next);
+      }
+    };
+    if (r == 1) {
+      uintE sorted[1] = {(uintE)u};
+      f(sorted);
+    } else {
+      extend(1, cand);
+    }
+  }, 1);
+}
+
+// Runs the decomposition; returns the peel level (nucleus number) per
+// r-clique, keyed by packed clique id.
+template <class Graph>
+clique_map Nucleus(Graph& G, size_t r,
+                                              size_t num_buckets = 16) {
+  using W = typename Graph::weight_type;
+  assert(r >= 1 && r <= 3);
+
+  // rank + orient, as the clique counters do
+  uintE* rank = rankNodes(G, G.n);
+  auto pack_predicate = [&](const uintE& u, const uintE& v, const W& wgh) {
+    return rank[u] < rank[v];
+  };
+  auto DG = filterGraph(G, pack_predicate);
+
+  // 1. enumerate r-cliques, assign ids, and count (r+1)-cliques per
+  // r-clique: every (r+1)-clique contributes one to each of its r+1
+  // r-subsets.
+  clique_map id_of;
+  std::vector<clique_key> key_of;
+  {
+    std::mutex mtx;
+    enumerate_cliques(DG, r, [&](const uintE* verts) {
+      clique_key key = make_key(verts, r);
+      std::lock_guard<std::mutex> guard(mtx);
+      if (id_of.find(key) == id_of.end()) {
+        id_of[key] = (uintE)key_of.size();
+        key_of.push_back(key);
+      }
+    });
+  }
+  size_t num_cliques = key_of.size();
+  auto counts = pbbs::sequence<uintE>(num_cliques, (uintE)0);
+  {
+    std::mutex mtx;
+    enumerate_cliques(DG, r + 1, [&](const uintE* verts) {
+      uintE sub[8];
+      std::lock_guard<std::mutex> guard(mtx);
+      for (size_t skip = 0; skip < r + 1; skip++) {
+        size_t k = 0;
+        for (size_t i = 0; i < r + 1; i++) {
+          if (i != skip) sub[k++] = verts[i];
+        }
+        counts[id_of[make_key(sub, r)]]++;
+      }
+    });
+  }
+
+  // adjacency from r-cliques to their (r+1)-clique co-members: store the
+  // (r+1)-cliques as id lists per r-clique
+  std::vector<std::vector<uintE>> super(num_cliques);  // indices into supers
+  std::vector<std::array<uintE, 8>> supers;
+  {
+    std::mutex mtx;
+    enumerate_cliques(DG, r + 1, [&](const uintE* verts) {
+      std::lock_guard<std::mutex> guard(mtx);
+      std::array<uintE, 8> sc{};
+      for (size_t i = 0; i < r + 1; i++) sc[i] = verts[i];
+      uintE sid = (uintE)supers.size();
+      supers.push_back(sc);
+      uintE sub[8];
+      for (size_t skip = 0; skip < r + 1; skip++) {
+        size_t k = 0;
+        for (size_t i = 0; i < r + 1; i++) {
+          if (i != skip) sub[k++] = verts[i];
+        }
+        super[id_of[make_key(sub, r)]].push_back(sid);
+      }
+    });
+  }
+
+  // 2. peel with the Julienne buckets
+  auto D = pbbs::sequence<uintE>(num_cliques, [&](size_t i) {
+    return counts[i];
+  });
+  auto get_bkt = pbbslib::make_sequence<uintE>(num_cliques, [&](size_t i) {
+    return D[i];
+  });
+  auto b = make_buckets<uintE, uintE>(num_cliques, get_bkt, increasing,
+                                      num_buckets);
+  auto peeled = pbbs::sequence<bool>(num_cliques, false);
+  auto level = pbbs::sequence<uintE>(num_cliques, (uintE)0);
+  auto super_dead = pbbs::sequence<bool>(supers.size(), false);
+
+  size_t finished = 0;
+  while (finished < num_cliques) {
+    auto bkt = b.next_bucket();
+    if (bkt.id == b.null_bkt) break;
+    uintE k = (uintE)bkt.id;
+    auto& ids = bkt.identifiers;
+    std::vector<std::tuple<uintE, uintE>> moved;
+    for (size_t i = 0; i < ids.size(); i++) {
+      uintE rc = ids[i];
+      if (peeled[rc]) continue;
+      peeled[rc] = true;
+      level[rc] = k;
+      finished++;
+      // retire the (r+1)-cliques containing rc; decrement live co-subsets
+      for (uintE sid : super[rc]) {
+        if (super_dead[sid]) continue;
+        super_dead[sid] = true;
+        uintE sub[8];
+        for (size_t skip = 0; skip < r + 1; skip++) {
+          size_t kk = 0;
+          for (size_t j = 0; j < r + 1; j++) {
+            if (j != skip) sub[kk++] = supers[sid][j];
+          }
+          uintE other = id_of[make_key(sub, r)];
+          if (other == rc || peeled[other]) continue;
+          uintE cur = D[other];
+          if (cur > k) {
+            uintE nxt = cur - 1;
+            D[other] = std::max(nxt, k);
+            uintE dest = b.get_bucket(cur, D[other]);
+            if (dest != b.null_bkt) moved.emplace_back(other, dest);
+          }
+        }
+      }
+    }
+    auto moved_f = [&](size_t i) {
+      return std::optional<std::tuple<uintE, uintE>>(moved[i]);
+    };
+    b.update_buckets(moved_f, moved.size());
+  }
+
+  clique_map result;
+  for (size_t i = 0; i < num_cliques; i++) result[key_of[i]] = level[i];
+  DG.del();
+  pbbslib::free_array(rank);
+  return result;
+}
+
+}  // namespace nucleus
+}  // namespace gbbs
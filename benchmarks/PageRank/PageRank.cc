@@ -32,6 +32,8 @@
 //     -s : indicate that the graph is symmetric
 
 #include "PageRank.h"
+#include "gbbs/async_push.h"
+#include "gbbs/numa_replication.h"
 
 namespace gbbs {
 
@@ -49,12 +51,48 @@ double PageRank_runner(Graph& G, commandLine P) {
   double eps = P.getOptionDoubleValue("-eps", 0.000001);
   double local_eps = P.getOptionDoubleValue("-leps", 0.01);
   size_t iters = P.getOptionLongValue("-iters", 100);
-  if (P.getOptionValue("-em")) {
+  long topk = P.getOptionLongValue("-topk", 0);
+  auto report_topk = [&](auto& ranks) {
+    if (topk > 0) {
+      auto top = pbbs::top_k(ranks, (size_t)topk, std::less<double>());
+      std::cout << "### top-" << top.size() << " ranks:";
+      for (size_t i = 0; i < top.size(); i++) std::cout << " " << top[i];
+      std::cout << std::endl;
+    }
+  };
+  if (P.getOptionValue("-replicate")) {
+    // read-mostly serving mode: per-socket edge replicas; group count from
+    // -nodes or GBBS_NUMA_NODES
+    if constexpr (std::is_same<typename Graph::vertex,
+                               symmetric_vertex<typename Graph::weight_type>>::value) {
+      int nodes = (int)P.getOptionLongValue("-nodes", 0);
+      auto RG = replicate_graph(G, nodes);
+      auto ret = PageRank(RG, eps, iters);
+      report_topk(ret);
+      RG.del();
+    } else {
+      std::cout << "-replicate requires an uncompressed symmetric graph"
+                << std::endl;
+    }
+  } else if (P.getOptionValue("-async")) {
+    // push-based engine: work proportional to pushes, no global rounds
+    auto ret = PageRank_async(G, P.getOptionDoubleValue("-thresh", 1e-9));
+    report_topk(ret);
+  } else if (P.getOptionValue("-em")) {
     auto ret = PageRank_edgeMap(G, eps, iters);
+    report_topk(ret);
   } else if (P.getOptionValue("-delta")) {
     auto ret = delta::PageRankDelta(G, eps, local_eps, iters);
+    report_topk(ret);
+    if (P.getOptionValue("-warm")) {
+      // warm-started re-rank from the converged vector (models the hourly
+      // re-rank on a slowly changing graph; should finish in ~1 round)
+      auto ret2 = delta::PageRankDelta_warm(G, ret, eps, local_eps, iters);
+      report_topk(ret2);
+    }
   } else {
     auto ret = PageRank(G, eps, iters);
+    report_topk(ret);
   }
   double tt = t.stop();
 
@@ -363,6 +363,171 @@ sequence<double> PageRankDelta(Graph& G, double eps=0.000001, double local_eps=0
   std::cout << "Num rounds = " << round << std::endl;
   return p;
 }
+
+// The shared delta-iteration loop used by the warm-start and incremental
+// entry points: propagate active deltas, fold them into the ranks, and
+// deactivate vertices below the local tolerance, until the L1 norm of the
+// remaining deltas passes eps.
+template <class Graph, class EMT>
+void delta_iterate(Graph& G, EMT& EM, pbbs::sequence<double>& p,
+                   pbbs::sequence<delta_and_degree>& Delta,
+                   pbbs::sequence<double>& nghSum, vertexSubset& Frontier,
+                   double damping, double eps, double local_eps,
+                   size_t max_iters) {
+  const long n = G.n;
+  auto get_degree = [&](size_t i) { return G.get_vertex(i).out_degree(); };
+  auto all = pbbs::sequence<bool>(n, true);
+  vertexSubset All(n, n, std::move(all));
+
+  size_t round = 0;
+  while (round++ < max_iters) {
+    if (Frontier.isEmpty()) break;
+    sparse_or_dense(G, EM, Frontier, Delta.begin(), nghSum.begin(),
+                    no_output);
+    vertexSubset next = vertexFilter(
+        All, delta::make_PR_Vertex_F(p.begin(), Delta.begin(), nghSum.begin(),
+                                     damping, local_eps, get_degree));
+
+    auto differences = pbbs::delayed_seq<double>(
+        n, [&](size_t i) { return fabs(Delta[i].delta); });
+    double L1_norm = pbbs::reduce(differences, pbbs::addm<double>());
+    if (L1_norm < eps) break;
+    debug(std::cout << "L1_norm = " << L1_norm << std::endl;);
+
+    parallel_for(0, n, [&](size_t i) { nghSum[i] = static_cast<double>(0); });
+    Frontier = std::move(next);
+  }
+  debug(std::cout << "delta rounds = " << round << std::endl;);
+}
+
+// Warm-started delta PageRank: resumes from a prior rank vector (e.g. last
+// hour's ranks over a slowly changing graph). One propagation pass over all
+// vertices computes the residual of the PageRank equations at the prior
+// (delta_i = teleport + damping * sum of prior contributions - prior_i),
+// and the delta iteration then proceeds only from vertices whose residual
+// exceeds the local tolerance -- on a <0.1%-changed graph most vertices
+// deactivate immediately. Runs on compressed graphs unchanged (the
+// sparse/dense propagation goes through the EdgeMap machinery, which
+// decodes blocks natively).
+template <class Graph>
+sequence<double> PageRankDelta_warm(Graph& G, sequence<double>& prior,
+                                    double eps = 0.000001,
+                                    double local_eps = 0.01,
+                                    size_t max_iters = 100) {
+  const long n = G.n;
+  const double damping = 0.85;
+  double one_over_n = 1 / (double)n;
+
+  auto p = pbbs::sequence<double>(n, [&](size_t i) { return prior[i]; });
+  auto Delta = pbbs::sequence<delta_and_degree>(n);
+  auto nghSum = pbbs::sequence<double>(n, static_cast<double>(0));
+  auto get_degree = [&](size_t i) { return G.get_vertex(i).out_degree(); };
+  auto EM = EdgeMap<double, Graph>(
+      G, std::make_tuple(UINT_E_MAX, (double)0.0), (size_t)G.m / 1000);
+
+  // 1. Propagate the prior once to get each vertex's incoming contribution.
+  parallel_for(0, n, [&](size_t i) {
+    uintE degree = G.get_vertex(i).out_degree();
+    Delta[i].delta = p[i];
+    Delta[i].delta_over_degree = (degree == 0) ? 0.0 : p[i] / degree;
+  });
+  {
+    auto all = pbbs::sequence<bool>(n, true);
+    vertexSubset All(n, n, std::move(all));
+    sparse_or_dense(G, EM, All, Delta.begin(), nghSum.begin(), no_output);
+  }
+
+  // 2. The residual at the prior becomes the initial delta; only vertices
+  // above the local tolerance stay active.
+  parallel_for(0, n, [&](size_t i) {
+    uintE degree = G.get_vertex(i).out_degree();
+    double target = (1 - damping) * one_over_n + damping * nghSum[i];
+    double delta = target - p[i];
+    p[i] = target;
+    Delta[i].delta = delta;
+    Delta[i].delta_over_degree = (degree == 0) ? 0.0 : delta / degree;
+    nghSum[i] = 0.0;
+  });
+  auto active_f = pbbslib::make_sequence<bool>(n, [&](size_t i) {
+    return fabs(Delta[i].delta) > local_eps * std::max(p[i], one_over_n);
+  });
+  auto active = pbbs::sequence<bool>(n, [&](size_t i) { return active_f[i]; });
+  vertexSubset Frontier(n, std::move(active));
+
+  delta_iterate(G, EM, p, Delta, nghSum, Frontier, damping, eps, local_eps,
+                max_iters);
+  return p;
+}
+
+// Incremental maintenance over an edge-insertion batch. G must already
+// reflect the batch; `batch` lists the inserted edges and `prior` the ranks
+// converged on the pre-update graph. Only the contributions of batch
+// sources change: each current neighbor of a source u sees its share move
+// from prior[u]/old_deg to prior[u]/new_deg, and brand-new neighbors gain
+// a full share. Those corrections seed the deltas, and the standard delta
+// iteration then propagates them with per-vertex deactivation -- work
+// proportional to the affected region, with the same local_eps/eps error
+// bounds as the delta solver, instead of a full recompute.
+template <class Graph>
+sequence<double> PageRankDelta_update(Graph& G, sequence<double>& prior,
+                                      edge_array<typename Graph::weight_type>& batch,
+                                      double eps = 0.000001,
+                                      double local_eps = 0.01,
+                                      size_t max_iters = 100) {
+  using W = typename Graph::weight_type;
+  const long n = G.n;
+  const double damping = 0.85;
+
+  auto p = pbbs::sequence<double>(n, [&](size_t i) { return prior[i]; });
+  auto Delta = pbbs::sequence<delta_and_degree>(n);
+  auto nghSum = pbbs::sequence<double>(n, static_cast<double>(0));
+  auto raw_delta = pbbs::sequence<double>(n, static_cast<double>(0));
+  auto EM = EdgeMap<double, Graph>(
+      G, std::make_tuple(UINT_E_MAX, (double)0.0), (size_t)G.m / 1000);
+
+  // new-edge count per batch source
+  auto new_edges = pbbs::sequence<uintE>(n, (uintE)0);
+  batch.map_edges([&](uintE u, uintE v, W w) {
+    pbbslib::write_add(&new_edges[u], (uintE)1);
+  });
+
+  // seed the deltas with the changed contributions
+  parallel_for(0, n, [&](size_t u) {
+    if (new_edges[u] == 0) return;
+    uintE new_deg = G.get_vertex(u).out_degree();
+    uintE old_deg = new_deg - new_edges[u];
+    double per_new = p[u] / new_deg;
+    double per_old = (old_deg == 0) ? 0.0 : p[u] / old_deg;
+    double correction = damping * (per_new - per_old);
+    auto map_f = [&](const uintE& src, const uintE& ngh, const W& wgh) {
+      pbbslib::write_add(&raw_delta[ngh], correction);
+    };
+    G.get_vertex(u).out_neighbors().map(map_f, false);
+  }, 1);
+  batch.map_edges([&](uintE u, uintE v, W w) {
+    // new neighbors additionally gain the old per-edge share they never had
+    uintE new_deg = G.get_vertex(u).out_degree();
+    uintE old_deg = new_deg - new_edges[u];
+    double per_old = (old_deg == 0) ? 0.0 : p[u] / old_deg;
+    pbbslib::write_add(&raw_delta[v], damping * per_old);
+  });
+
+  parallel_for(0, n, [&](size_t i) {
+    uintE degree = G.get_vertex(i).out_degree();
+    p[i] += raw_delta[i];
+    Delta[i].delta = raw_delta[i];
+    Delta[i].delta_over_degree = (degree == 0) ? 0.0 : raw_delta[i] / degree;
+  });
+  double one_over_n = 1 / (double)n;
+  auto active = pbbs::sequence<bool>(n, [&](size_t i) {
+    return fabs(Delta[i].delta) > local_eps * std::max(p[i], one_over_n);
+  });
+  vertexSubset Frontier(n, std::move(active));
+
+  delta_iterate(G, EM, p, Delta, nghSum, Frontier, damping, eps, local_eps,
+                max_iters);
+  return p;
+}
 }  // namespace delta
 
 }  // namespace gbbs
@@ -0,0 +1,66 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Usage:
+// ./Partition -k 4 -beta 0.2 -of parts.perm -s graph
+// flags:
+//   required:
+//     -s : indicate that the graph is symmetric
+//   optional:
+//     -k    : number of parts
+//     -beta : LDD beta (smaller = larger clusters)
+//     -of   : write the part-contiguous permutation here
+
+#include "Partition.h"
+
+namespace gbbs {
+
+template <class Graph>
+double Partition_runner(Graph& G, commandLine P) {
+  size_t k = static_cast<size_t>(P.getOptionLongValue("-k", 4));
+  double beta = P.getOptionDoubleValue("-beta", 0.2);
+  std::cout << "### Application: Partition (LDD)" << std::endl;
+  std::cout << "### Graph: " << P.getArgument(0) << std::endl;
+  std::cout << "### Threads: " << num_workers() << std::endl;
+  std::cout << "### n: " << G.n << std::endl;
+  std::cout << "### m: " << G.m << std::endl;
+  std::cout << "### Params: -k = " << k << " -beta = " << beta << std::endl;
+  std::cout << "### ------------------------------------" << std::endl;
+
+  timer t; t.start();
+  auto res = partitioning::Partition(G, k, beta);
+  double tt = t.stop();
+
+  std::cout << "edge cut = " << res.edge_cut << " / " << G.m
+            << " (" << (double)res.edge_cut / G.m << ")"
+            << ", balance = " << res.balance << std::endl;
+  if (char* of = P.getOptionValue("-of")) {
+    partitioning::write_permutation(res.perm, of);
+  }
+  std::cout << "### Running Time: " << tt << std::endl;
+  return tt;
+}
+
+}  // namespace gbbs
+
+generate_symmetric_main(gbbs::Partition_runner, false);
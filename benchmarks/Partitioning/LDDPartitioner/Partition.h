@@ -0,0 +1,131 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// k-way partitioning from low-diameter decomposition: LDD already produces
+// cohesive clusters with few inter-cluster edges; the partitioner bins
+// whole clusters into k parts greedily (largest cluster first, into the
+// currently lightest part), which keeps the LDD cut quality while
+// balancing vertex counts. Emits per-vertex part ids plus the
+// part-contiguous relabeling permutation in the same on-disk format the
+// compressor's -reorder mode writes, so the reordering loader
+// (gbbs_io::read_permutation) maps results back.
+
+#pragma once
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+#include "benchmarks/LowDiameterDecomposition/MPX13/LowDiameterDecomposition.h"
+#include "gbbs/gbbs.h"
+
+namespace gbbs {
+namespace partitioning {
+
+struct partition_result {
+  sequence<uintE> part_of;  // vertex -> part id
+  sequence<uintE> perm;     // vertex -> new id (part-contiguous)
+  size_t num_parts;
+  size_t edge_cut;          // directed edge endpoints in different parts
+  double balance;           // max part size / (n / k)
+};
+
+template <class Graph>
+partition_result Partition(Graph& G, size_t k, double beta = 0.2) {
+  using W = typename Graph::weight_type;
+  size_t n = G.n;
+  auto clusters = LDD(G, beta);
+
+  // cluster sizes (cluster ids are cluster-center vertex ids)
+  auto sizes = sequence<uintE>(n, (uintE)0);
+  parallel_for(0, n, [&](size_t i) {
+    pbbslib::fetch_and_add(&sizes[clusters[i]], (uintE)1);
+  });
+  auto cluster_ids = pbbs::filter(
+      pbbslib::make_sequence<uintE>(n, [](size_t i) { return (uintE)i; }),
+      [&](uintE c) { return sizes[c] > 0; });
+
+  // greedy bin packing: largest cluster into the lightest part
+  auto by_size = sequence<uintE>(cluster_ids);
+  auto cmp = [&](const uintE& a, const uintE& b) {
+    return sizes[a] > sizes[b] || (sizes[a] == sizes[b] && a < b);
+  };
+  pbbs::sample_sort_inplace(by_size.slice(), cmp);
+  auto part_load = std::vector<size_t>(k, 0);
+  auto part_of_cluster = sequence<uintE>(n, (uintE)0);
+  for (size_t i = 0; i < by_size.size(); i++) {
+    size_t best = 0;
+    for (size_t p = 1; p < k; p++) {
+      if (part_load[p] < part_load[best]) best = p;
+    }
+    part_of_cluster[by_size[i]] = (uintE)best;
+    part_load[best] += sizes[by_size[i]];
+  }
+
+  partition_result res;
+  res.num_parts = k;
+  res.part_of = sequence<uintE>(n, [&](size_t v) {
+    return part_of_cluster[clusters[v]];
+  });
+
+  // part-contiguous permutation: stable order by (part, id)
+  auto order = sequence<uintE>(n, [](size_t i) { return (uintE)i; });
+  auto ord_cmp = [&](const uintE& a, const uintE& b) {
+    return res.part_of[a] < res.part_of[b] ||
+           (res.part_of[a] == res.part_of[b] && a < b);
+  };
+  pbbs::sample_sort_inplace(order.slice(), ord_cmp);
+  res.perm = sequence<uintE>(n);
+  par_for(0, n, [&](size_t r) { res.perm[order[r]] = (uintE)r; });
+
+  // metrics
+  auto cut_im = pbbslib::make_sequence<size_t>(n, [&](size_t u) {
+    size_t ct = 0;
+    auto count_f = [&](const uintE& src, const uintE& v, const W& wgh) {
+      ct += (res.part_of[src] != res.part_of[v]);
+    };
+    G.get_vertex(u).out_neighbors().map(count_f, false);
+    return ct;
+  });
+  res.edge_cut = pbbslib::reduce_add(cut_im);
+  size_t max_load = 0;
+  for (size_t p = 0; p < k; p++) max_load = std::max(max_load, part_load[p]);
+  res.balance = (double)max_load / ((double)n / (double)k);
+  return res;
+}
+
+// Same format as the compressor's -reorder permutation output.
+inline void write_permutation(sequence<uintE>& perm,
+                              const std::string& outfile) {
+  std::ofstream pf(outfile, std::ofstream::out | std::ios::binary);
+  if (!pf.is_open()) {
+    std::cout << "Unable to open permutation file: " << outfile << std::endl;
+    exit(0);
+  }
+  long n = perm.size();
+  pf.write((char*)&n, sizeof(long));
+  pf.write((char*)perm.begin(), sizeof(uintE) * n);
+}
+
+}  // namespace partitioning
+}  // namespace gbbs
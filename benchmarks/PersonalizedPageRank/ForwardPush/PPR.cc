@@ -0,0 +1,86 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Usage:
+// numactl -i all ./PPR -src 10 -nseeds 4 -alpha 0.15 -ppr_eps 1e-7 -s -m graph
+// flags:
+//   required:
+//     -s : indicate that the graph is symmetric
+//   optional:
+//     -src:      first seed; seeds are src, src+1, ..., src+nseeds-1
+//     -nseeds:   seed-set size
+//     -alpha:    teleport probability
+//     -ppr_eps:  per-degree push threshold
+//     -m : indicate that the graph should be mmap'd
+//     -c : indicate that the graph is compressed
+
+#include "PPR.h"
+#include "gbbs/async_push.h"
+
+namespace gbbs {
+
+template <class Graph>
+double PPR_runner(Graph& G, commandLine P) {
+  uintE src = static_cast<uintE>(P.getOptionLongValue("-src", 0));
+  size_t nseeds = static_cast<size_t>(P.getOptionLongValue("-nseeds", 1));
+  double alpha = P.getOptionDoubleValue("-alpha", 0.15);
+  double eps = P.getOptionDoubleValue("-ppr_eps", 1e-7);
+  std::cout << "### Application: PPR (forward push)" << std::endl;
+  std::cout << "### Graph: " << P.getArgument(0) << std::endl;
+  std::cout << "### Threads: " << num_workers() << std::endl;
+  std::cout << "### n: " << G.n << std::endl;
+  std::cout << "### m: " << G.m << std::endl;
+  std::cout << "### Params: -src = " << src << " -nseeds = " << nseeds
+            << " -alpha = " << alpha << " -ppr_eps = " << eps << std::endl;
+  std::cout << "### ------------------------------------" << std::endl;
+
+  auto seeds = sequence<uintE>(
+      nseeds, [&](size_t i) { return (uintE)((src + i) % G.n); });
+
+  timer t; t.start();
+  sequence<double> reserve;
+  if (P.getOptionValue("-async")) {
+    // shared push engine: same pushes, no per-round frontier scans; uses a
+    // flat residual threshold rather than the per-degree one.
+    auto engine = async_push_engine<Graph>(G, 1.0 - alpha, eps);
+    auto seed_mass = sequence<std::pair<uintE, double>>(
+        seeds.size(), [&](size_t i) {
+          return std::make_pair(seeds[i], 1.0 / seeds.size());
+        });
+    size_t pushes = engine.run_from(seed_mass);
+    std::cout << "Async pushes = " << pushes << std::endl;
+    reserve = std::move(engine.reserve);
+  } else {
+    reserve = forward_push::PPR(G, seeds, alpha, eps);
+  }
+  double tt = t.stop();
+
+  auto mass = pbbs::reduce(reserve, pbbs::addm<double>());
+  std::cout << "Settled mass = " << mass << std::endl;
+  std::cout << "### Running Time: " << tt << std::endl;
+  return tt;
+}
+
+}  // namespace gbbs
+
+generate_main(gbbs::PPR_runner, false);
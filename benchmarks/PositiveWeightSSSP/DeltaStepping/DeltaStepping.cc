@@ -43,7 +43,7 @@ template <class Graph>
 double DeltaStepping_runner(Graph& G, commandLine P) {
   uintE src = P.getOptionLongValue("-src", 0);
   size_t num_buckets = P.getOptionLongValue("-nb", 32);
-  size_t delta = P.getOptionLongValue("-delta", 1);
+  size_t delta = P.getOptionLongValue("-delta", 0);  // 0 = auto-tune
 
   std::cout << "### Application: DeltaStepping" << std::endl;
   std::cout << "### Graph: " << P.getArgument(0) << std::endl;
@@ -68,8 +68,44 @@ struct Visit_F {
 };
 
 
+// Picks a delta from a cheap sample of the weight distribution: the median
+// sampled weight scaled by the average degree, so one bucket epoch covers
+// roughly one hop of average fan-out. Derived from the operator guidance
+// that good deltas track the typical weight times the graph's density; a
+// sampled percentile is robust to the heavy tails that make averages
+// useless on latency-like weights. Dynamic between-epoch adjustment was
+// considered, but re-keying the bucket structure mid-run would leave the
+// queued vertices' bucket ids stale; sampling once up front removes the
+// hand-tuning without that hazard.
+template <class Graph>
+uintE auto_delta(Graph& G) {
+  using W = typename Graph::weight_type;
+  constexpr size_t kSamples = 1024;
+  size_t n = G.n;
+  std::vector<uintE> wghs;
+  wghs.reserve(kSamples);
+  for (size_t s = 0; s < kSamples && wghs.size() < kSamples; s++) {
+    uintE v = (uintE)(pbbs::hash64(s) % n);
+    auto vtx = G.get_vertex(v);
+    if (vtx.out_degree() == 0) continue;
+    size_t j = pbbs::hash64(s ^ 0x5bd1e995) % vtx.out_degree();
+    auto [ngh, w] = vtx.out_neighbors().get_ith_neighbor(j);
+    (void)ngh;
+    wghs.push_back((uintE)w);
+  }
+  if (wghs.empty()) return 1;
+  std::nth_element(wghs.begin(), wghs.begin() + wghs.size() / 2, wghs.end());
+  uintE median = std::max<uintE>(wghs[wghs.size() / 2], 1);
+  size_t avg_deg = std::max<size_t>(G.m / std::max<size_t>(n, 1), 1);
+  return (uintE)std::max<size_t>((size_t)median * avg_deg, 1);
+}
+
 template <class Graph>
 void DeltaStepping(Graph& G, uintE src, uintE delta, size_t num_buckets=128) {
+  if (delta == 0) {  // auto-tune from a weight sample
+    delta = auto_delta(G);
+    std::cout << "### auto delta = " << delta << std::endl;
+  }
   size_t n = G.n;
   auto dists = pbbs::sequence<uintE>(n, [&] (size_t i) { return INT_E_MAX; });
   dists[src] = 0;
@@ -119,7 +155,7 @@ void DeltaStepping(Graph& G, uintE src, uintE delta, size_t num_buckets=128) {
 template <class Graph>
 void Compute(Graph& G, commandLine P) {
   uintE src = P.getOptionLongValue("-src",0);
-  uintE delta = P.getOptionLongValue("-delta",1);
+  uintE delta = P.getOptionLongValue("-delta", 0);  // 0 = auto-tune
   size_t num_buckets = P.getOptionLongValue("-nb", 128);
   if (num_buckets != (1 << pbbs::log2_up(num_buckets))) {
     std::cout << "Please specify a number of buckets that is a power of two" << std::endl;
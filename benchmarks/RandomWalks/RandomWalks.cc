@@ -0,0 +1,77 @@
+// Usage:
+// ./RandomWalks -s [-nwalks 100000] [-length 80] [-seed 0] [-thresh 128]
+//               [-nobatch] [-verify] <graph>
+// flags:
+//   required:
+//     -s : indicates that the graph is symmetric
+//   optional:
+//     -c : indicate that the graph is compressed
+//     -m : indicate that the graph should be mmap'd
+//     -nwalks : number of concurrent walks (default 100000)
+//     -length : vertices per walk (default 80)
+//     -thresh : alias-table degree threshold (default 128)
+//     -nobatch : disable the per-step locality regroup
+//     -verify : check sampled transitions are graph edges
+//     -profile-out : save sampled per-vertex access counts (see
+//                    gbbs/access_profile.h; feeds compressor -reorder
+//                    profile)
+
+#include "RandomWalks.h"
+
+namespace gbbs {
+
+template <class Graph>
+double RandomWalks_runner(Graph& G, commandLine P) {
+  size_t nwalks = P.getOptionLongValue("-nwalks", 100000);
+  size_t length = P.getOptionLongValue("-length", 80);
+  uint64_t seed = P.getOptionLongValue("-seed", 0);
+  size_t thresh = P.getOptionLongValue("-thresh", 128);
+  bool batch = !P.getOption("-nobatch");
+  std::cout << "### Application: RandomWalks (DeepWalk-style)" << std::endl;
+  std::cout << "### Graph: " << P.getArgument(0) << std::endl;
+  std::cout << "### Threads: " << num_workers() << std::endl;
+  std::cout << "### n: " << G.n << std::endl;
+  std::cout << "### m: " << G.m << std::endl;
+  std::cout << "### Params: -nwalks = " << nwalks << " -length = " << length
+            << " -thresh = " << thresh << " batch = " << batch << std::endl;
+  std::cout << "### ------------------------------------" << std::endl;
+  assert(P.getOption("-s"));
+
+  char* profile_out = P.getOptionValue("-profile-out");
+  access_profiler profiler(G.n);
+  timer t; t.start();
+  auto walks = random_walks::walk(G, nwalks, length, seed, thresh, batch,
+                                  profile_out ? &profiler : nullptr);
+  double tt = t.stop();
+  if (profile_out) {
+    profiler.save(profile_out);
+    std::cout << "### wrote access profile to " << profile_out << std::endl;
+  }
+  size_t steps = nwalks * (length - 1);
+  std::cout << "### walk steps = " << steps << " (" << (steps / tt)
+            << " steps/sec)" << std::endl;
+  std::cout << "### Running Time: " << tt << std::endl;
+
+  if (P.getOption("-verify")) {
+    // every consecutive pair must be an edge (or a dead-end self-stay)
+    size_t bad = 0;
+    for (size_t w = 0; w < std::min<size_t>(nwalks, 1000); w++) {
+      for (size_t s = 0; s + 1 < length; s++) {
+        uintE a = walks[w * length + s], b = walks[w * length + s + 1];
+        if (a == b) continue;  // dead-end stay
+        bool found = false;
+        auto map_f = [&](const uintE& u, const uintE& v, const auto& wgh) {
+          if (v == b) found = true;
+        };
+        G.get_vertex(a).out_neighbors().map(map_f, false);
+        if (!found) bad++;
+      }
+    }
+    std::cout << "### verify: bad transitions = " << bad << std::endl;
+  }
+  return tt;
+}
+
+}  // namespace gbbs
+
+generate_symmetric_main(gbbs::RandomWalks_runner, false);
@@ -0,0 +1,86 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// DeepWalk-style random walks with walker-state batching. Walks advance in
+// super-steps; before each step the walker ids are regrouped by their
+// current vertex (semisort on a vertex-range bucket), so the step's
+// adjacency accesses sweep the graph roughly in vertex order instead of
+// jumping with each walker -- on compressed graphs this turns per-walker
+// random decodes into near-sequential ones. Transitions draw from
+// neighbor_sampler: O(1) alias draws at hubs (weighted or uniform), scans
+// below the threshold. A walker at a dead end stays put.
+
+#pragma once
+
+#include "gbbs/gbbs.h"
+#include "gbbs/access_profile.h"
+#include "gbbs/neighbor_sampler.h"
+#include "pbbslib/semisort.h"
+
+namespace gbbs {
+namespace random_walks {
+
+// Runs num_walks walks of walk_length vertices (walk w starts at w % n);
+// returns the row-major (num_walks x walk_length) walk matrix.
+template <class Graph>
+sequence<uintE> walk(Graph& G, size_t num_walks, size_t walk_length,
+                     uint64_t seed = 0, size_t degree_threshold = 128,
+                     bool batch_by_locality = true,
+                     access_profiler* profile = nullptr) {
+  size_t n = G.n;
+  auto sampler = make_neighbor_sampler(G, degree_threshold);
+  auto out = sequence<uintE>::no_init(num_walks * walk_length);
+  auto cur = sequence<uintE>(num_walks, [&](size_t w) {
+    return (uintE)(w % n);
+  });
+  par_for(0, num_walks, pbbslib::kSequentialForThreshold,
+          [&](size_t w) { out[w * walk_length] = cur[w]; });
+
+  // bucket walkers into ~1K vertex ranges for the locality regroup
+  size_t shift = 0;
+  while ((n >> shift) > 1024) shift++;
+
+  auto order = sequence<uintE>(num_walks, [](size_t w) { return (uintE)w; });
+  pbbs::random r(seed);
+  for (size_t step = 1; step < walk_length; step++) {
+    if (batch_by_locality) {
+      auto bucket_of = [&](const uintE& w) {
+        return (uintE)(cur[w] >> shift);
+      };
+      order = pbbs::semisort_by_key(order, bucket_of);
+    }
+    size_t salt_base = step * num_walks;
+    parallel_for(0, num_walks, [&](size_t i) {
+      uintE w = order[i];
+      if (profile != nullptr) profile->record(cur[w]);
+      uintE nxt = sampler.sample_neighbor(cur[w], r, salt_base + w);
+      if (nxt == UINT_E_MAX) nxt = cur[w];  // dead end: stay put
+      cur[w] = nxt;
+      out[(size_t)w * walk_length + step] = nxt;
+    });
+  }
+  return out;
+}
+
+}  // namespace random_walks
+}  // namespace gbbs
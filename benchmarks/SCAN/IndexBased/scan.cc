@@ -1,6 +1,8 @@
 #include "benchmarks/SCAN/IndexBased/scan.h"
 
 #include <algorithm>
+#include <fstream>
+#include <map>
 #include <tuple>
 #include <utility>
 
@@ -176,6 +178,63 @@ void AttachNoncoresToClustersDeterministic(
 
 }  // namespace
 
+namespace {
+constexpr uint64_t kIndexMagic = 0x7363616e69647831ULL;  // "scanidx1"
+}  // namespace
+
+void Index::SaveToFile(const std::string& path) const {
+  std::ofstream out(path, std::ofstream::out | std::ios::binary);
+  if (!out.is_open()) {
+    std::cerr << "Unable to open index file for writing: " << path << '\n';
+    std::terminate();
+  }
+  const auto& sims = neighbor_order_.similarities();
+  uint64_t header[3] = {kIndexMagic, num_vertices_, sims.size()};
+  out.write((char*)header, sizeof(header));
+  out.write((const char*)sims.begin(),
+            sims.size() * sizeof(scan::EdgeSimilarity));
+}
+
+Index Index::LoadFromFile(const std::string& path) {
+  std::ifstream in(path, std::ios::in | std::ios::binary);
+  if (!in.is_open()) {
+    std::cerr << "Unable to open index file: " << path << '\n';
+    std::terminate();
+  }
+  uint64_t header[3];
+  in.read((char*)header, sizeof(header));
+  if (header[0] != kIndexMagic) {
+    std::cerr << "Not a SCAN index file: " << path << '\n';
+    std::terminate();
+  }
+  auto sims = pbbs::sequence<scan::EdgeSimilarity>::no_init(header[2]);
+  in.read((char*)sims.begin(), header[2] * sizeof(scan::EdgeSimilarity));
+  return Index{header[1],
+               internal::NeighborOrder{header[1], std::move(sims)}};
+}
+
+void Index::Cluster(
+    const pbbs::sequence<std::pair<uint64_t, float>>& parameter_pairs,
+    const std::function<void(Clustering, size_t)> f,
+    bool get_deterministic_result) const {
+  // group pair indices by mu; reuse the multi-epsilon path per group
+  std::map<uint64_t, std::vector<size_t>> by_mu;
+  for (size_t i = 0; i < parameter_pairs.size(); i++) {
+    by_mu[parameter_pairs[i].first].push_back(i);
+  }
+  for (const auto& group : by_mu) {
+    const auto& indices = group.second;
+    auto epsilons = pbbs::sequence<float>(
+        indices.size(),
+        [&](size_t j) { return parameter_pairs[indices[j]].second; });
+    Cluster(group.first, epsilons,
+            [&](Clustering clustering, size_t j) {
+              f(std::move(clustering), indices[j]);
+            },
+            get_deterministic_result);
+  }
+}
+
 Index::Index()
   : num_vertices_{0U}
   , neighbor_order_{}
@@ -86,7 +86,29 @@ class Index {
       const std::function<void(Clustering, size_t)> f,
       bool get_deterministic_result = false) const;
 
+  // Evaluates many (mu, epsilon) parameter pairs over this one in-memory
+  // index, calling f(<clustering for pairs[i]>, i). Pairs sharing a mu are
+  // grouped so the per-mu core computation and the shared sorting are paid
+  // once per distinct mu rather than per pair.
+  void Cluster(
+      const pbbs::sequence<std::pair<uint64_t, float>>& parameter_pairs,
+      const std::function<void(Clustering, size_t)> f,
+      bool get_deterministic_result = false) const;
+
+  // Serializes the similarity index to a binary file so parameter sweeps
+  // can reload it instead of recomputing similarities (95% of the work).
+  void SaveToFile(const std::string& path) const;
+
+  // Rebuilds an index from a file written by SaveToFile.
+  static Index LoadFromFile(const std::string& path);
+
  private:
+  // Constructor over a deserialized similarity structure.
+  Index(size_t num_vertices, internal::NeighborOrder&& neighbor_order)
+    : num_vertices_{num_vertices}
+    , neighbor_order_{std::move(neighbor_order)}
+    , core_order_{neighbor_order_} {}
+
   size_t num_vertices_;
   internal::NeighborOrder neighbor_order_;
   internal::CoreOrder core_order_;
@@ -32,6 +32,26 @@ void ReportTime([[maybe_unused]] const timer& t) {
 
 NeighborOrder::NeighborOrder() : similarities_{}, similarities_by_source_{} {}
 
+NeighborOrder::NeighborOrder(
+    size_t num_vertices, pbbs::sequence<EdgeSimilarity>&& similarities)
+  : similarities_{std::move(similarities)} {
+  // per-source counts -> offsets -> ranges (mirrors the indexing
+  // constructor, but over an already-ordered similarity array)
+  pbbs::sequence<uintT> vertex_offsets(num_vertices, (uintT)0);
+  for (size_t i = 0; i < similarities_.size(); i++) {
+    vertex_offsets[similarities_[i].source]++;
+  }
+  pbbslib::scan_add_inplace(vertex_offsets);
+  similarities_by_source_ = pbbs::sequence<pbbs::range<EdgeSimilarity*>>(
+      num_vertices,
+      [&](const size_t i) {
+        return similarities_.slice(
+          vertex_offsets[i],
+          i + 1 == num_vertices ? similarities_.size()
+                                : vertex_offsets[i + 1]);
+      });
+}
+
 const pbbs::range<EdgeSimilarity*>&
 NeighborOrder::operator[](size_t source) const {
   return similarities_by_source_[source];
@@ -39,6 +39,17 @@ class NeighborOrder {
 
   NeighborOrder();
 
+  // Deserialization constructor: takes the flat similarity array in index
+  // order (ascending source, then descending similarity) and rebuilds the
+  // per-source ranges.
+  NeighborOrder(size_t num_vertices,
+                pbbs::sequence<EdgeSimilarity>&& similarities);
+
+  // Flat view of all similarity scores, for serialization.
+  const pbbs::sequence<EdgeSimilarity>& similarities() const {
+    return similarities_;
+  }
+
   // Get all similarity scores from vertex `source` to its neighbors (not
   // including `source` itself), sorted by descending similarity.
   const pbbs::range<EdgeSimilarity*>& operator[](size_t source) const;
@@ -48,7 +48,13 @@ double SSBetweennessCentrality_runner(Graph& G, commandLine P) {
   std::cout << "### ------------------------------------" << std::endl;
 
   timer t; t.start();
-  if (P.getOptionValue("-fa")) {
+  if (P.getOptionValue("-approx")) {
+    size_t samples = P.getOptionLongValue("-samples", 64);
+    double tol = P.getOptionDoubleValue("-tol", 0.01);
+    auto scores = bc::ApproxBetweennessCentrality(G, samples, tol);
+    auto mx = pbbslib::reduce_max(scores);
+    std::cout << "max approx score = " << mx << std::endl;
+  } else if (P.getOptionValue("-fa")) {
     auto scores = bc::SSBetweennessCentrality_EM(G, src);
     for (size_t i=0; i<100; i++) {
       std::cout << scores[i] << std::endl;
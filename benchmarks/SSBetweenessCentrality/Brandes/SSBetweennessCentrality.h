@@ -152,6 +152,56 @@ inline sequence<fType> SSBetweennessCentrality(Graph& G, const uintE& start) {
   return Dependencies;
 }
 
+// Approximate betweenness over sampled sources. Samples run in small
+// parallel batches with their dependency arrays accumulated into one
+// shared score vector via write_add, and an adaptive stopping rule checks
+// the estimate between batches: when the normalized scores' maximum
+// relative change over a batch drops below tol, further samples are not
+// buying accuracy and the loop stops early. Returns per-vertex scores
+// scaled to estimate the sum over all sources (times n / samples_used).
+template <class Graph>
+inline sequence<fType> ApproxBetweennessCentrality(Graph& G,
+                                                   size_t max_samples,
+                                                   double tol = 0.01,
+                                                   uint64_t seed = 0) {
+  size_t n = G.n;
+  constexpr size_t kBatch = 4;
+  auto scores = sequence<fType>(n, [](size_t) { return 0.0; });
+  auto prev = sequence<fType>(n, [](size_t) { return 0.0; });
+
+  size_t used = 0;
+  while (used < max_samples) {
+    size_t batch = std::min(kBatch, max_samples - used);
+    parallel_for(0, batch, [&](size_t b) {
+      uintE src = (uintE)(pbbs::hash64(seed + used + b) % n);
+      auto dep = SSBetweennessCentrality(G, src);
+      par_for(0, n, pbbslib::kSequentialForThreshold, [&](size_t i) {
+        if (dep[i] != 0.0) pbbslib::write_add(&scores[i], dep[i]);
+      });
+    }, 1);
+    used += batch;
+
+    // adaptive stop: max relative change of the normalized estimates
+    double max_change = 0.0;
+    auto change_f = pbbs::delayed_seq<double>(n, [&](size_t i) {
+      double cur = scores[i] / used;
+      double before = prev[i];
+      double denom = std::max(cur, 1e-12);
+      return fabs(cur - before) / denom;
+    });
+    max_change = pbbs::reduce(change_f, pbbs::maxm<double>());
+    par_for(0, n, pbbslib::kSequentialForThreshold,
+            [&](size_t i) { prev[i] = scores[i] / used; });
+    if (used >= 2 * kBatch && max_change < tol) break;
+  }
+
+  double scale = (double)n / (double)used;
+  par_for(0, n, pbbslib::kSequentialForThreshold,
+          [&](size_t i) { scores[i] *= scale; });
+  debug(std::cout << "samples used = " << used << std::endl;);
+  return scores;
+}
+
 template <class Graph, class E>
 vertexSubset sparse_fa_dense_em(Graph& G, E& EM, vertexSubset& Frontier, pbbs::sequence<fType>& NumPaths, pbbs::sequence<fType>& Storage, pbbs::sequence<bool>& Visited,  const flags fl) {
   using W = typename Graph::weight_type;
@@ -0,0 +1,49 @@
+// Usage:
+// ./SimilarityJoin -i sets.txt [-threshold 0.5] [-bands 16] [-rows 4]
+// Input: one set per line, space-separated integer items.
+
+#include "SimilarityJoin.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace gbbs {
+
+int SimilarityJoin_main(int argc, char* argv[]) {
+  commandLine P(argc, argv, "-i <sets> [-threshold 0.5] [-bands 16] [-rows 4]");
+  std::string in_f = P.getOptionValue("-i", "");
+  double threshold = P.getOptionDoubleValue("-threshold", 0.5);
+  size_t bands = P.getOptionLongValue("-bands", 16);
+  size_t rows = P.getOptionLongValue("-rows", 4);
+  if (in_f == "") {
+    std::cout << "specify an input set file with -i" << std::endl;
+    return 1;
+  }
+  std::vector<std::vector<uintE>> sets;
+  std::ifstream in(in_f);
+  std::string line;
+  while (std::getline(in, line)) {
+    std::istringstream is(line);
+    std::vector<uintE> s;
+    uintE x;
+    while (is >> x) s.push_back(x);
+    std::sort(s.begin(), s.end());
+    s.erase(std::unique(s.begin(), s.end()), s.end());
+    sets.push_back(std::move(s));
+  }
+  std::cout << "# sets = " << sets.size() << std::endl;
+
+  timer t; t.start();
+  auto R = similarity_join::SimilarityJoin(sets, threshold, bands, rows);
+  double tt = t.stop();
+  std::cout << "# candidates verified = " << R.candidates << std::endl;
+  std::cout << "# edges = " << R.edges << " (graph n = " << R.G.n
+            << " m = " << R.G.m << ")" << std::endl;
+  std::cout << "# join time = " << tt << std::endl;
+  R.G.del();
+  return 0;
+}
+
+}  // namespace gbbs
+
+int main(int argc, char* argv[]) { return gbbs::SimilarityJoin_main(argc, argv); }
@@ -31,10 +31,15 @@
 //     -c : indicate that the graph is compressed
 //     -rounds : the number of times to run the algorithm
 //     -stats : print the #ccs, and the #vertices in the largest cc
+//     -budget : target spanner edge count; binary-searches beta toward the
+//               largest value whose spanner fits the budget
+//     -of : write the spanner as a bytepd-amortized compressed graph to
+//           this path (no intermediate edge-list file)
 
 #include <math.h>
 
 #include "Spanner.h"
+#include "utils/compression_writers.h"
 
 namespace gbbs {
 // Beta should be set to log n/2k. See Corollary 3.1 and Lemma 3.2 in MPVX'15.
@@ -52,11 +57,48 @@ double Spanner_runner(Graph& G, commandLine P) {
   std::cout << "### ------------------------------------" << std::endl;
 
   assert(P.getOption("-s"));
+  size_t budget = P.getOptionLongValue("-budget", 0);
+  char* out_f = P.getOptionValue("-of");
   timer t;
   t.start();
-  auto spanner = spanner::Spanner(G, beta);
+  pbbs::sequence<spanner::edge> spanner;
+  if (budget > 0) {
+    double chosen_beta;
+    spanner = spanner::Spanner_budget(G, budget, chosen_beta);
+    std::cout << "### budget = " << budget << " chosen beta = " << chosen_beta
+              << " spanner size = " << spanner.size() << std::endl;
+  } else {
+    spanner = spanner::Spanner(G, beta);
+  }
   double tt = t.stop();
   std::cout << "### Running Time: " << tt << std::endl;
+  if (out_f) {
+    // Symmetrize the edge list and emit the spanner directly in
+    // bytepd-amortized format.
+    auto dir_edges = pbbs::sequence<std::tuple<uintE, uintE, pbbs::empty>>(
+        2 * spanner.size(), [&](size_t i) {
+          auto& e = spanner[i / 2];
+          return (i % 2 == 0)
+                     ? std::make_tuple(e.first, e.second, pbbs::empty())
+                     : std::make_tuple(e.second, e.first, pbbs::empty());
+        });
+    auto get_u = [&](const std::tuple<uintE, uintE, pbbs::empty>& e) {
+      return std::get<0>(e);
+    };
+    auto get_v = [&](const std::tuple<uintE, uintE, pbbs::empty>& e) {
+      return std::get<1>(e);
+    };
+    auto get_w = [&](const std::tuple<uintE, uintE, pbbs::empty>& e) {
+      return std::get<2>(e);
+    };
+    auto SG = sym_graph_from_edges<pbbs::empty>(dir_edges, n, get_u, get_v,
+                                                get_w);
+    std::ofstream out(out_f, std::ofstream::out | std::ios::binary);
+    write_graph_bytepd_amortized_format(SG, out, true);
+    std::cout << "### Wrote compressed spanner (n = " << SG.n
+              << ", m = " << SG.m << ") to " << out_f << std::endl;
+    SG.del();
+  }
   std::cout << "### ------------------------------------" << std::endl;
   return tt;
 }
@@ -25,6 +25,8 @@
 
 #include "benchmarks/LowDiameterDecomposition/MPX13/LowDiameterDecomposition.h"
 #include "gbbs/gbbs.h"
+#include <limits>
+
 #include "gbbs/pbbslib/dyn_arr.h"
 #include "gbbs/pbbslib/sparse_table.h"
 
@@ -289,5 +291,44 @@ inline pbbs::sequence<edge> Spanner(Graph& G, double beta) {
   return Spanner_impl(G, beta);
 }
 
+// Sweeps beta toward an edge budget. Larger beta means smaller clusters:
+// better stretch, but more inter-cluster edges. Binary-searches for the
+// largest beta whose spanner fits within edge_budget (spanner size is
+// monotone in beta in expectation; the LDD is randomized, so the boundary
+// is approximate) and returns that spanner, reporting the chosen beta
+// through beta_out. If even the smallest probed beta exceeds the budget --
+// the tree edges alone may -- the smallest spanner found is returned.
+template <class Graph>
+inline pbbs::sequence<edge> Spanner_budget(Graph& G, size_t edge_budget,
+                                           double& beta_out,
+                                           size_t num_probes = 8) {
+  size_t n = G.n;
+  double lo = 0.0;               // coarsest clustering probed
+  double hi = log(n) / 2;        // k = 1 in the beta = log n / 2k setting
+  pbbs::sequence<edge> best;
+  double best_beta = -1.0;
+  size_t best_size = std::numeric_limits<size_t>::max();
+  bool best_fits = false;
+
+  for (size_t probe = 0; probe < num_probes; probe++) {
+    double beta = (lo + hi) / 2;
+    auto S = Spanner_impl(G, beta);
+    std::cout << "### probe: beta = " << beta << " spanner size = "
+              << S.size() << std::endl;
+    bool fits = S.size() <= edge_budget;
+    if (fits ? (!best_fits || beta > best_beta)
+             : (!best_fits && S.size() < best_size)) {
+      best = std::move(S);
+      best_beta = beta;
+      best_size = best.size();
+      best_fits = fits;
+    }
+    if (fits) lo = beta;
+    else hi = beta;
+  }
+  beta_out = best_beta;
+  return best;
+}
+
 }  // namespace cc
 }  // namespace gbbs
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <iomanip>
+
 #include "benchmarks/SpanningForest/check.h"
 #include "benchmarks/SpanningForest/common.h"
 
@@ -28,7 +28,7 @@ namespace connectit {
       }
       return t;
     };
-    auto name = uf_options_to_string<sampling_option, find_option, unite_option>();
+    auto name = uf_options_to_string(sampling_option, find_option, unite_option);
     return run_multiple(G, rounds, correct, name, P, test);
   }
 
@@ -58,7 +58,7 @@ namespace connectit {
       }
       return t;
     };
-    auto name = uf_options_to_string<sampling_option, find_option, unite_option, splice_option>();
+    auto name = uf_options_to_string(sampling_option, find_option, unite_option, splice_option);
     return run_multiple(G, rounds, correct, name, P, test);
   }
 
@@ -84,7 +84,7 @@ namespace connectit {
       }
       return t;
     };
-    auto name = jayanti_options_to_string<sampling_option, find_option>();
+    auto name = jayanti_options_to_string(sampling_option, find_option);
     return run_multiple(G, rounds, correct, name, P, test);
   }
 
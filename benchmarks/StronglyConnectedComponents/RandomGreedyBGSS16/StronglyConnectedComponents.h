@@ -26,6 +26,7 @@
 #include "pbbslib/random_shuffle.h"
 #include "gbbs/pbbslib/resizable_table.h"
 #include "gbbs/gbbs.h"
+#include "pbbslib/worker_bag.h"
 
 // The include below is currently not useful, as the majority of out/in-degree
 // one vertices are removed in a single round of peeling (so multiple rounds are
@@ -202,17 +203,69 @@ inline sequence<label_type> StronglyConnectedComponents(Graph& GA, double beta =
   auto ba = sequence<bool>(n, false);
   auto bits = ba.to_array();
 
+  // Iterative trimming: a vertex with zero remaining in- or out-degree is a
+  // trivial SCC; removing it can zero out its neighbors' remaining degrees
+  // in turn, so trim to a fixpoint rather than one level. Each trimmed
+  // vertex gets a singleton label below, exactly as the one-shot filter
+  // did, and the main label-propagation rounds only ever see the non-
+  // trivial core.
+  using W = typename Graph::weight_type;
+  auto live_in = sequence<uintE>(n, [&](size_t i) {
+    return GA.get_vertex(i).in_degree();
+  });
+  auto live_out = sequence<uintE>(n, [&](size_t i) {
+    return GA.get_vertex(i).out_degree();
+  });
+  auto trimmed = sequence<bool>(n, false);
   auto v_im = pbbslib::make_sequence<uintE>(n, [](size_t i) { return i; });
-  auto zero = pbbslib::filter(v_im, [&](size_t i) {
-    return (GA.get_vertex(i).out_degree() == 0) || (GA.get_vertex(i).in_degree() == 0);
+  auto frontier = pbbslib::filter(v_im, [&](size_t i) {
+    return (live_in[i] == 0) || (live_out[i] == 0);
   });
-  auto NZ = pbbslib::filter(v_im, [&](size_t i) {
-    return (GA.get_vertex(i).out_degree() > 0) && (GA.get_vertex(i).in_degree() > 0);
+  par_for(0, frontier.size(), pbbslib::kSequentialForThreshold,
+          [&](size_t i) { trimmed[frontier[i]] = true; });
+
+  auto zero_arr = pbbslib::dyn_arr<uintE>(std::max<size_t>(n / 4, 1024));
+  size_t trim_rounds = 0;
+  while (frontier.size() > 0) {
+    trim_rounds++;
+    zero_arr.copyIn(frontier, frontier.size());
+    auto next_bag = pbbs::worker_bag<uintE>();
+    parallel_for(0, frontier.size(), [&](size_t i) {
+      uintE u = frontier[i];
+      auto out_f = [&](const uintE& src, const uintE& v, const W& wgh) {
+        if (!trimmed[v]) {
+          uintE old = pbbslib::fetch_and_add(&live_in[v], (uintE)-1);
+          if (old == 1 &&
+              pbbslib::atomic_compare_and_swap(&trimmed[v], false, true)) {
+            next_bag.insert(v);
+          }
+        }
+      };
+      GA.get_vertex(u).out_neighbors().map(out_f, false);
+      auto in_f = [&](const uintE& src, const uintE& v, const W& wgh) {
+        if (!trimmed[v]) {
+          uintE old = pbbslib::fetch_and_add(&live_out[v], (uintE)-1);
+          if (old == 1 &&
+              pbbslib::atomic_compare_and_swap(&trimmed[v], false, true)) {
+            next_bag.insert(v);
+          }
+        }
+      };
+      GA.get_vertex(u).in_neighbors().map(in_f, false);
+    }, 1);
+    frontier = next_bag.to_sequence();
+  }
+  auto zero = sequence<uintE>(zero_arr.size, [&](size_t i) {
+    return zero_arr.A[i];
   });
+  zero_arr.del();
+
+  auto NZ = pbbslib::filter(v_im, [&](size_t i) { return !trimmed[i]; });
 
   auto P = pbbslib::random_shuffle(NZ);
-  std::cout << "Filtered: " << zero.size()
-            << " vertices. Num remaining = " << P.size() << "\n";
+  std::cout << "Trimmed: " << zero.size() << " trivial SCCs in "
+            << trim_rounds << " rounds. Num remaining = " << P.size()
+            << "\n";
 
   // Assign labels from [0...zero.size())
   par_for(0, zero.size(), pbbslib::kSequentialForThreshold, [&] (size_t i)
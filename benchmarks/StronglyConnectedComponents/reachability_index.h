@@ -0,0 +1,204 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// 2-hop reachability index over the SCC condensation, for repeated
+// directed queries. Condensation nodes are processed in decreasing-degree
+// hub order with pruned-landmark labeling: hub h's forward BFS appends h's
+// rank to Lin(x) for every x it newly reaches (pruned where existing
+// labels already answer reach(h, x)), the backward BFS fills Lout
+// symmetrically. Because hubs append in rank order, every label array is
+// born sorted, so a query is one sorted intersection --
+// pbbs::seq_intersect_count, the same branch-free/galloping kernel the
+// triangle code uses -- over Lout(scc(u)) and Lin(scc(v)). Construction
+// parallelizes over the per-hub frontier expansions; the hub loop itself
+// is ordered, as pruning requires.
+
+#pragma once
+
+#include <vector>
+
+#include "gbbs/gbbs.h"
+#include "pbbslib/merge.h"
+#include "pbbslib/semisort.h"
+
+namespace gbbs {
+namespace scc_reach {
+
+struct reachability_index {
+  size_t nc = 0;            // condensation nodes
+  sequence<uintE> comp_of;  // vertex -> dense condensation node
+  sequence<size_t> out_offs, in_offs;   // nc + 1
+  sequence<uintE> out_labels, in_labels;  // sorted hub-rank arrays
+
+  // reach(u, v) on original vertices.
+  bool reaches(uintE u, uintE v) const {
+    uintE cu = comp_of[u], cv = comp_of[v];
+    if (cu == cv) return true;
+    auto a = pbbs::range<const uintE*>(out_labels.begin() + out_offs[cu],
+                                       out_labels.begin() + out_offs[cu + 1]);
+    auto b = pbbs::range<const uintE*>(in_labels.begin() + in_offs[cv],
+                                       in_labels.begin() + in_offs[cv + 1]);
+    auto get = [](const uintE& x) { return x; };
+    return pbbs::seq_intersect_count(a, b, get, get) > 0;
+  }
+
+  size_t label_entries() const {
+    return out_labels.size() + in_labels.size();
+  }
+};
+
+// labels: per-vertex SCC ids from any of the SCC benchmarks.
+template <class Graph>
+reachability_index build_index(Graph& G, sequence<uintE>& labels) {
+  size_t n = G.n;
+  reachability_index I;
+
+  // dense condensation ids
+  auto seen = sequence<uintE>(n + 1, (uintE)0);
+  par_for(0, n, pbbslib::kSequentialForThreshold, [&](size_t i) {
+    if (!seen[labels[i]]) seen[labels[i]] = 1;
+  });
+  pbbslib::scan_add_inplace(seen.slice());
+  size_t nc = seen[n];
+  I.nc = nc;
+  I.comp_of = sequence<uintE>(n, [&](size_t i) { return seen[labels[i]]; });
+
+  // deduplicated condensation edges
+  using cedge = std::tuple<uintE, uintE>;
+  auto all = sequence<cedge>(G.m, std::make_tuple(UINT_E_MAX, UINT_E_MAX));
+  // collect via mapEdges into per-vertex slots (offset by out-degrees)
+  auto degs = sequence<size_t>(n + 1, [&](size_t i) {
+    return (i == n) ? (size_t)0 : G.get_vertex(i).out_degree();
+  });
+  pbbslib::scan_add_inplace(degs.slice());
+  par_for(0, n, 1, [&](size_t u) {
+    size_t off = degs[u];
+    auto map_f = [&](const uintE& src, const uintE& ngh, const auto& wgh) {
+      if (I.comp_of[src] != I.comp_of[ngh]) {
+        all[off] = std::make_tuple(I.comp_of[src], I.comp_of[ngh]);
+      }
+      off++;
+    };
+    G.get_vertex(u).out_neighbors().map(map_f, false);
+  });
+  auto live = pbbs::filter(all, [](const cedge& e) {
+    return std::get<0>(e) != UINT_E_MAX;
+  });
+  std::vector<std::vector<uintE>> adj_out(nc), adj_in(nc);
+  {
+    auto key_f = [&](const cedge& e) {
+      return (uint64_t)std::get<0>(e) * nc + std::get<1>(e);
+    };
+    std::mutex mtx;
+    pbbs::group_by(live, key_f, [&](uint64_t key, auto slice) {
+      uintE cu = std::get<0>(slice[0]), cv = std::get<1>(slice[0]);
+      std::lock_guard<std::mutex> guard(mtx);
+      adj_out[cu].push_back(cv);
+      adj_in[cv].push_back(cu);
+    });
+  }
+
+  // hubs in decreasing total-degree order
+  auto order = sequence<uintE>(nc, [](size_t i) { return (uintE)i; });
+  pbbs::sample_sort_inplace(order.slice(), [&](const uintE a, const uintE b) {
+    size_t da = adj_out[a].size() + adj_in[a].size();
+    size_t db = adj_out[b].size() + adj_in[b].size();
+    return da > db || (da == db && a < b);
+  });
+
+  std::vector<std::vector<uintE>> Lin(nc), Lout(nc);
+  auto query_ranked = [&](uintE from, uintE to) {
+    // reach(from, to) using current labels (+ self ranks added below)
+    size_t i = 0, j = 0;
+    auto& A = Lout[from];
+    auto& B = Lin[to];
+    while (i < A.size() && j < B.size()) {
+      if (A[i] == B[j]) return true;
+      if (A[i] < B[j]) i++;
+      else j++;
+    }
+    return false;
+  };
+
+  std::vector<uintE> frontier, next;
+  auto visited = sequence<uintE>(nc, UINT_E_MAX);
+  for (uintE r = 0; r < nc; r++) {
+    uintE h = order[r];
+    // forward: rank r joins Lin of everything h newly reaches
+    Lin[h].push_back(r);
+    Lout[h].push_back(r);
+    frontier.assign(1, h);
+    visited[h] = 2 * r;
+    while (!frontier.empty()) {
+      next.clear();
+      for (uintE x : frontier) {
+        for (uintE y : adj_out[x]) {
+          if (visited[y] == 2 * r) continue;
+          visited[y] = 2 * r;
+          if (query_ranked(h, y)) continue;  // pruned: already answerable
+          Lin[y].push_back(r);
+          next.push_back(y);
+        }
+      }
+      std::swap(frontier, next);
+    }
+    // backward: rank r joins Lout of everything that newly reaches h
+    frontier.assign(1, h);
+    visited[h] = 2 * r + 1;
+    while (!frontier.empty()) {
+      next.clear();
+      for (uintE x : frontier) {
+        for (uintE y : adj_in[x]) {
+          if (visited[y] == 2 * r + 1) continue;
+          visited[y] = 2 * r + 1;
+          if (query_ranked(y, h)) continue;
+          Lout[y].push_back(r);
+          next.push_back(y);
+        }
+      }
+      std::swap(frontier, next);
+    }
+  }
+
+  // freeze the (already sorted) labels into flat CSR arrays
+  I.out_offs = sequence<size_t>(nc + 1, [&](size_t c) {
+    return (c == nc) ? (size_t)0 : Lout[c].size();
+  });
+  I.in_offs = sequence<size_t>(nc + 1, [&](size_t c) {
+    return (c == nc) ? (size_t)0 : Lin[c].size();
+  });
+  size_t tot_out = pbbslib::scan_add_inplace(I.out_offs.slice());
+  size_t tot_in = pbbslib::scan_add_inplace(I.in_offs.slice());
+  I.out_labels = sequence<uintE>::no_init(tot_out);
+  I.in_labels = sequence<uintE>::no_init(tot_in);
+  par_for(0, nc, pbbslib::kSequentialForThreshold, [&](size_t c) {
+    for (size_t i = 0; i < Lout[c].size(); i++)
+      I.out_labels[I.out_offs[c] + i] = Lout[c][i];
+    for (size_t i = 0; i < Lin[c].size(); i++)
+      I.in_labels[I.in_offs[c] + i] = Lin[c][i];
+  });
+  return I;
+}
+
+}  // namespace scc_reach
+}  // namespace gbbs
@@ -49,8 +49,26 @@ double Triangle_runner(Graph& G, commandLine P) {
   size_t count = 0;
   auto f = [&] (uintE u, uintE v, uintE w) { };
   timer t; t.start();
-  count = Triangle(G, f, ordering, P);
+  if (P.getOption("-packed")) {
+    // count on a predicate-filtered packed view without materializing the
+    // filtered graph; -filter-mod k drops edges with (u + v) % k == 0
+    long mod = P.getOptionLongValue("-filter-mod", 0);
+    auto pred = [&](const uintE& u, const uintE& v, const auto& wgh) {
+      return (mod == 0) || (((u + v) % mod) != 0);
+    };
+    count = Triangle_packed(G, pred);
+  } else if (P.getOption("-approx")) {
+    double tol = P.getOptionDoubleValue("-tol", 0.01);
+    size_t colors = P.getOptionLongValue("--colors", 64);
+    count = Triangle_approx(G, tol, colors);
+  } else {
+    count = Triangle(G, f, ordering, P);
+  }
   double tt = t.stop();
+  if (P.getOption("-packed") || P.getOption("-approx")) {
+    // the default Triangle() path prints this line itself
+    std::cout << "### Num triangles = " << count << std::endl;
+  }
   if (P.getOption("-stats")) {
     auto wedge_im_f = [&](size_t i) {
       size_t deg = G.get_vertex(i).out_degree();
@@ -27,6 +27,7 @@
 #include "pbbslib/sample_sort.h"
 #include "pbbslib/monoid.h"
 #include "gbbs/gbbs.h"
+#include "gbbs/semiasym/graph_filter.h"
 
 #include "benchmarks/DegeneracyOrder/BarenboimElkin08/DegeneracyOrder.h"
 #include "benchmarks/DegeneracyOrder/GoodrichPszona11/DegeneracyOrder.h"
@@ -34,6 +35,35 @@
 
 namespace gbbs {
 
+// Triangle counting directly over a predicate-filtered packed view: no
+// filtered graph is materialized. Each edge (u, v) with u < v intersects
+// the two packed neighbor sets with the block-granular intersection
+// (disjoint blocks skipped by id range, only overlapping block pairs
+// decoded), and each triangle is counted once per edge, so the sum is
+// three times the triangle count.
+template <class Graph, class P>
+inline size_t Triangle_packed(Graph& G, P& pred) {
+  using W = typename Graph::weight_type;
+  auto PF = sage::filter_graph(G, pred);
+  size_t n = G.n;
+  auto counts = sequence<size_t>(n, (size_t)0);
+  parallel_for(0, n, [&](size_t u) {
+    auto nu = PF.get_vertex((uintE)u).out_neighbors();
+    size_t local = 0;
+    auto map_f = [&](const uintE& src, const uintE& v, const W& wgh) {
+      if (v > (uintE)u) {
+        auto nv = PF.get_vertex(v).out_neighbors();
+        local += block_vertex_ops::intersect_blocks<W>(nu, nv);
+      }
+    };
+    nu.map(map_f, false);
+    counts[u] = local;
+  }, 1);
+  size_t total = pbbslib::reduce_add(counts);
+  PF.del();
+  return total / 3;
+}
+
 template <class Graph>
 struct countF {
   Graph& G;
@@ -151,6 +181,127 @@ inline size_t CountDirectedBalanced(Graph& DG, size_t* counts,
   return count;
 }
 
+// Cache-blocked counting over the ranked DAG: destinations are tiled into
+// contiguous rank ranges of bounded edge mass, and counting runs
+// tile-major -- for each tile, every source intersects only the portion of
+// its (rank-sorted, hence tile-contiguous) out-list that falls in the
+// tile. All the second-level lists touched during a tile therefore come
+// from one bounded CSR region that stays cache-resident while the sources
+// stream past, instead of every intersection pulling a cold list. Work is
+// identical to CountDirectedBalanced; only the traversal order changes.
+template <class Graph, class F>
+inline size_t CountDirectedTiled(Graph& DG, size_t* counts, const F& f,
+                                 size_t tile_mass = (size_t{1} << 18)) {
+  using W = typename Graph::weight_type;
+  size_t n = DG.n;
+
+  // tile boundaries by prefix edge mass
+  auto prefix = sequence<size_t>(n + 1);
+  par_for(0, n, [&] (size_t i) {
+    prefix[i] = DG.get_vertex(i).out_degree();
+  });
+  prefix[n] = 0;
+  size_t total_mass = pbbslib::scan_add_inplace(prefix.slice());
+  size_t num_tiles = std::max<size_t>(1, (total_mass + tile_mass - 1) / tile_mass);
+  auto tile_lo = sequence<uintE>(num_tiles + 1);
+  auto lt = [] (const size_t& a, const size_t& b) { return a < b; };
+  par_for(0, num_tiles, 1, [&] (size_t t) {
+    tile_lo[t] = pbbslib::binary_search(prefix.slice(0, n), t * tile_mass, lt);
+  });
+  tile_lo[num_tiles] = n;
+
+  par_for(0, n, [&] (size_t i) { counts[i] = 0; });
+
+  for (size_t t = 0; t < num_tiles; t++) {
+    uintE lo = tile_lo[t], hi = tile_lo[t + 1];
+    if (lo == hi) continue;
+    parallel_for(0, n, [&] (size_t u) {
+      auto u_vtx = DG.get_vertex(u);
+      uintE deg = u_vtx.out_degree();
+      if (deg == 0) return;
+      auto u_nghs = u_vtx.out_neighbors();
+      size_t local = 0;
+      for (size_t j = 0; j < deg; j++) {
+        uintE v = u_nghs.get_neighbor(j);
+        if (v < lo) continue;      // earlier tile
+        if (v >= hi) break;        // lists are sorted; rest is later tiles
+        auto v_nghs = DG.get_vertex(v).out_neighbors();
+        auto our_f = [&] (uintE a, uintE b, uintE c) { f(a, b, c); };
+        local += u_nghs.intersect_f_par(&v_nghs, our_f);
+      }
+      if (local) pbbslib::write_add(&counts[u], local);
+    }, 1);
+  }
+  auto count_seq = sequence<size_t>(counts, n);
+  return pbbslib::reduce_add(count_seq);
+}
+
+// Approximate counting by colorful sampling: vertices are hashed to one of
+// c colors and only monochromatic triangles are counted (each survives
+// with probability 1/c^2, so the estimate is raw * c^2). The sample size
+// adapts: starting from a coarse c, each level runs a few independent
+// colorings, and if the spread of the estimates (relative half-width of a
+// normal interval over the trials) is above the tolerance, c halves --
+// doubling the expected sample -- until the interval is tight or c reaches
+// 1 (exact). Returns the estimate and reports the interval.
+template <class Graph>
+inline size_t Triangle_sampled(Graph& DG, double tol = 0.01,
+                               size_t initial_colors = 64,
+                               size_t trials = 5, uint64_t seed = 0) {
+  size_t n = DG.n;
+  size_t est = 0;
+  for (size_t c = initial_colors; c >= 1; c /= 2) {
+    auto run_trial = [&](uint64_t trial_seed) -> double {
+      auto col = [&](uintE v) {
+        return (uintE)(pbbs::hash64(trial_seed * 0x9e3779b97f4a7c15UL + v) % c);
+      };
+      auto counts = sequence<size_t>(n, (size_t)0);
+      parallel_for(0, n, [&](size_t u) {
+        uintE cu = col(u);
+        auto u_nghs = DG.get_vertex(u).out_neighbors();
+        size_t deg = DG.get_vertex(u).out_degree();
+        size_t local = 0;
+        for (size_t j = 0; j < deg; j++) {
+          uintE v = u_nghs.get_neighbor(j);
+          if (col(v) != cu) continue;
+          auto v_nghs = DG.get_vertex(v).out_neighbors();
+          auto on_match = [&](uintE a, uintE b, uintE w) {
+            if (col(w) == cu) local++;
+          };
+          u_nghs.intersect_f(&v_nghs, on_match);
+        }
+        counts[u] = local;
+      }, 1);
+      double raw = (double)pbbslib::reduce_add(counts);
+      return raw * (double)c * (double)c;
+    };
+
+    if (c == 1) {
+      est = (size_t)run_trial(seed);
+      std::cout << "### Sampled count (exact, c=1): " << est << std::endl;
+      return est;
+    }
+
+    double sum = 0, sum_sq = 0;
+    for (size_t t = 0; t < trials; t++) {
+      double e = run_trial(seed + t * 1315423911UL);
+      sum += e;
+      sum_sq += e * e;
+    }
+    double mean = sum / trials;
+    double var = std::max(0.0, sum_sq / trials - mean * mean);
+    double half_width = 1.96 * sqrt(var / trials);
+    double rel = (mean > 0) ? half_width / mean : 1.0;
+    std::cout << "### c = " << c << " estimate = " << mean << " +/- "
+              << half_width << " (rel " << rel << ")" << std::endl;
+    if (mean > 0 && rel <= tol) {
+      est = (size_t)mean;
+      return est;
+    }
+  }
+  return est;
+}
+
 // Counts the number of triangles in the input graph.
 //
 // Implementation note: this converts the input graph to a directed graph in
@@ -166,8 +317,25 @@ inline size_t CountDirectedBalanced(Graph& DG, size_t* counts,
 //
 // Returns:
 //   The number of triangles in `G`.
+// Degree-ordered DAG construction + adaptive sampled count (see
+// Triangle_sampled).
+template <class Graph>
+inline size_t Triangle_approx(Graph& G, double tol, size_t initial_colors) {
+  using W = typename Graph::weight_type;
+  uintE* rank = rankNodes(G, G.n);
+  auto pack_predicate = [&](const uintE& u, const uintE& v, const W& wgh) {
+    return rank[u] < rank[v];
+  };
+  auto DG = filterGraph(G, pack_predicate);
+  size_t count = Triangle_sampled(DG, tol, initial_colors);
+  DG.del();
+  pbbslib::free_array(rank);
+  return count;
+}
+
 template <class Graph, class F>
-inline size_t Triangle_degree_ordering(Graph& G, const F& f) {
+inline size_t Triangle_degree_ordering(Graph& G, const F& f,
+                                       bool tiled = false) {
   using W = typename Graph::weight_type;
   timer gt;
   gt.start();
@@ -196,7 +364,8 @@ inline size_t Triangle_degree_ordering(Graph& G, const F& f) {
   timer ct;
   ct.start();
 
-  size_t count = CountDirectedBalanced(DG, counts.begin(), f);
+  size_t count = tiled ? CountDirectedTiled(DG, counts.begin(), f)
+                       : CountDirectedBalanced(DG, counts.begin(), f);
   std::cout << "### Num triangles = " << count << "\n";
   DG.del();
   ct.stop();
@@ -242,7 +411,7 @@ inline size_t Triangle_degeneracy_ordering(Graph& G, const F& f, O ordering_fn)
 template <class Graph, class F>
 inline size_t Triangle(Graph& G, const F& f, const std::string& ordering, commandLine& P) {
   if (ordering == "degree") {
-    return Triangle_degree_ordering<Graph, F>(G, f);
+    return Triangle_degree_ordering<Graph, F>(G, f, P.getOption("-tiled"));
   } else if (ordering == "goodrich") {
     auto eps = P.getOptionDoubleValue("-e", 0.1);
     auto ff = [&] (Graph& graph) -> pbbs::sequence<uintE> {
@@ -0,0 +1,85 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Sampled per-vertex access counting for profile-driven relayout. Serving
+// workloads are skewed, so exact counts are unnecessary: record(v) bumps a
+// per-worker sampled counter (one in kSampleRate calls actually counts,
+// cache-line-strided slots, no atomics), which is cheap enough to leave on
+// in serving paths. save() writes the merged counts in a small binary
+// format that the compressor's -reorder profile pass consumes to pack hot
+// adjacency contiguously.
+
+#pragma once
+
+#include <fstream>
+
+#include "gbbs.h"
+#include "macros.h"
+
+namespace gbbs {
+
+struct access_profiler {
+  static constexpr uint64_t kMagic = 0x6762627361636366ULL;  // "gbbsaccf"
+  static constexpr size_t kSampleRate = 64;
+  static constexpr size_t kStride = 16;  // uintE slots per cache line pair
+
+  size_t n;
+  int nw;
+  sequence<size_t> ticks;       // nw * kStride: per-worker sample clocks
+  sequence<size_t> vertex_counts;  // n, bumped only on sampled hits
+
+  access_profiler(size_t n) : n(n), nw(num_workers()) {
+    ticks = sequence<size_t>((size_t)nw * kStride, (size_t)0);
+    vertex_counts = sequence<size_t>(n, (size_t)0);
+  }
+
+  // Sampled: one in kSampleRate calls lands one fetch_and_add.
+  inline void record(uintE v) {
+    size_t& tick = ticks[(size_t)worker_id() * kStride];
+    if ((tick++ % kSampleRate) == 0) {
+      pbbs::fetch_and_add(&vertex_counts[v], (size_t)1);
+    }
+  }
+
+  void save(const std::string& path) const {
+    std::ofstream out(path, std::ofstream::out | std::ios::binary);
+    uint64_t header[2] = {kMagic, (uint64_t)n};
+    out.write((char*)header, sizeof(header));
+    out.write((const char*)vertex_counts.begin(), n * sizeof(size_t));
+  }
+
+  // Loads counts written by save(); returns an empty sequence on mismatch.
+  static sequence<size_t> load(const std::string& path, size_t expect_n) {
+    std::ifstream in(path, std::ios::in | std::ios::binary);
+    uint64_t header[2] = {0, 0};
+    in.read((char*)header, sizeof(header));
+    if (!in.good() || header[0] != kMagic || header[1] != expect_n) {
+      return sequence<size_t>();
+    }
+    auto counts = sequence<size_t>::no_init(expect_n);
+    in.read((char*)counts.begin(), expect_n * sizeof(size_t));
+    return counts;
+  }
+};
+
+}  // namespace gbbs
@@ -0,0 +1,142 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Asynchronous compressed-graph loading with progressive availability. The
+// graph handle is returned immediately: the file is mmap'd (so the header,
+// offset, and degree regions fault in on first touch and any access is
+// *correct* from the start), while a background thread streams the edge
+// region into memory and advances a watermark. Callers that want to avoid
+// major page faults -- interactive degree queries, algorithms restricted to
+// a loaded prefix -- consult vertex_ready()/ready_prefix() and widen their
+// working set as the watermark advances.
+
+#pragma once
+
+#include <atomic>
+#include <thread>
+
+#include <sys/stat.h>
+
+#include "graph_io.h"
+
+namespace gbbs {
+namespace gbbs_io {
+
+template <class weight_type,
+          template <class W> class vertex_type = csv_bytepd_amortized>
+struct async_graph_loader {
+  using graph_type = symmetric_graph<vertex_type, weight_type>;
+
+  graph_type G;
+  // Bytes of the edge region already touched by the background reader.
+  std::atomic<size_t> loaded_bytes;
+  size_t total_bytes;
+  std::thread reader;
+
+  async_graph_loader(const char* fname)
+      : G(read_compressed_symmetric_graph<weight_type, vertex_type>(
+            fname, /* mmap */ true, /* mmapcopy */ false)),
+        loaded_bytes(0) {
+    // The edge region is the file minus the header/offset/degree prefix
+    // (same layout arithmetic as read_compressed_symmetric_graph).
+    struct stat sb;
+    if (stat(fname, &sb) != 0) {
+      std::cout << "async_graph_loader: cannot stat " << fname << std::endl;
+      abort();
+    }
+    size_t skip =
+        3 * sizeof(long) + (G.n + 1) * sizeof(intT) + G.n * sizeof(intE);
+    total_bytes = ((size_t)sb.st_size > skip) ? (sb.st_size - skip) : 0;
+    reader = std::thread([this]() {
+      constexpr size_t kStripe = size_t{1} << 24;  // 16 MB
+      constexpr size_t kPage = 4096;
+      char* base = (char*)this->G.e0;
+      volatile char sink = 0;
+      for (size_t off = 0; off < this->total_bytes; off += kStripe) {
+        size_t end = std::min(off + kStripe, this->total_bytes);
+        char local = 0;
+        for (size_t p = off; p < end; p += kPage) {
+          local ^= base[p];
+        }
+        sink ^= local;
+        this->loaded_bytes.store(end, std::memory_order_release);
+      }
+      (void)sink;
+    });
+  }
+
+  async_graph_loader(const async_graph_loader&) = delete;
+  async_graph_loader& operator=(const async_graph_loader&) = delete;
+
+  ~async_graph_loader() {
+    if (reader.joinable()) reader.join();
+  }
+
+  // True when vertex v's edge bytes have been streamed in; degree queries
+  // are always safe (v_data is resident), this is about neighbor access
+  // without a major fault.
+  bool vertex_ready(uintE v) const {
+    if (v + 1 < G.n) {
+      return G.v_data[v + 1].offset <=
+             loaded_bytes.load(std::memory_order_acquire);
+    }
+    return done();
+  }
+
+  // Largest id such that every vertex below it is ready (binary search on
+  // the offset array against the watermark).
+  uintE ready_prefix() const {
+    size_t watermark = loaded_bytes.load(std::memory_order_acquire);
+    uintE lo = 0, hi = G.n;
+    while (lo < hi) {
+      uintE mid = lo + (hi - lo) / 2;
+      size_t end = (mid + 1 < G.n) ? G.v_data[mid + 1].offset : total_bytes;
+      if (end <= watermark) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo;
+  }
+
+  double progress() const {
+    if (total_bytes == 0) return 1.0;
+    return (double)loaded_bytes.load(std::memory_order_acquire) /
+           (double)total_bytes;
+  }
+
+  bool done() const {
+    return loaded_bytes.load(std::memory_order_acquire) >= total_bytes;
+  }
+
+  // Blocks until the whole edge region is resident and returns the graph
+  // handle (also usable before this returns, with lazy faults).
+  graph_type& wait() {
+    if (reader.joinable()) reader.join();
+    return G;
+  }
+};
+
+}  // namespace gbbs_io
+}  // namespace gbbs
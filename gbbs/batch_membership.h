@@ -0,0 +1,89 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Bulk edge-membership queries for feature serving. Answering each (u, v)
+// with an independent lookup touches u's adjacency once per query; here
+// the batch is grouped by source (semisort -- group identity is enough),
+// each group's targets are sorted, and one merge pass over the source's
+// sorted adjacency answers every query against that source. A compressed
+// vertex is decoded exactly once per queried source regardless of how
+// many probes hit it, and the merge stops consuming targets once they are
+// exhausted. Results return in the input order.
+
+#pragma once
+
+#include <algorithm>
+
+#include "gbbs.h"
+#include "pbbslib/semisort.h"
+
+namespace gbbs {
+
+template <class Graph>
+sequence<bool> has_edges(Graph& G,
+                         sequence<std::tuple<uintE, uintE>> const& queries) {
+  using W = typename Graph::weight_type;
+  using rec = std::tuple<uintE, uintE, uintE>;  // (u, v, original index)
+  size_t q = queries.size();
+  auto out = sequence<bool>(q, false);
+  if (q == 0) return out;
+
+  auto recs = pbbs::sequence<rec>(q, [&](size_t i) {
+    return std::make_tuple(std::get<0>(queries[i]), std::get<1>(queries[i]),
+                           (uintE)i);
+  });
+  auto get_u = [](const rec& r) { return std::get<0>(r); };
+  auto grouped = pbbs::semisort_by_key(recs, get_u);
+
+  // group boundaries over the semisorted records
+  size_t n = grouped.size();
+  auto is_start = pbbs::delayed_seq<bool>(n, [&](size_t i) {
+    return i == 0 || get_u(grouped[i]) != get_u(grouped[i - 1]);
+  });
+  auto starts = pbbs::pack_index<size_t>(is_start);
+  size_t num_groups = starts.size();
+
+  parallel_for(0, num_groups, [&](size_t g) {
+    size_t s = starts[g];
+    size_t e = (g == num_groups - 1) ? n : starts[g + 1];
+    uintE u = get_u(grouped[s]);
+    // sort this source's probes by target id
+    std::sort(grouped.begin() + s, grouped.begin() + e,
+              [](const rec& a, const rec& b) {
+                return std::get<1>(a) < std::get<1>(b);
+              });
+    // one pass over u's sorted adjacency answers all of them
+    size_t cursor = s;
+    auto map_f = [&](const uintE& src, const uintE& ngh, const W& wgh) {
+      while (cursor < e && std::get<1>(grouped[cursor]) < ngh) cursor++;
+      while (cursor < e && std::get<1>(grouped[cursor]) == ngh) {
+        out[std::get<2>(grouped[cursor])] = true;
+        cursor++;
+      }
+    };
+    G.get_vertex(u).out_neighbors().map(map_f, false);
+  }, 1);
+  return out;
+}
+
+}  // namespace gbbs
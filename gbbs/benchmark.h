@@ -3,10 +3,207 @@
 // (e.g., profiling)
 #pragma once
 
+#include <fcntl.h>
+#include <unistd.h>
+
 #include "assert.h"
 #include "graph_io.h"
+#include "instrumentation.h"
 
 namespace gbbs {
+
+// ====================== Parallel result writer =========================
+//
+// Binary result output for benchmark -of paths. Dumping a billion-element
+// label/coreness array through a sequential text loop takes longer than
+// computing it; this writes the raw array with one large pwrite per chunk,
+// issued in parallel. Format: [uint64 elem_bytes][uint64 n][raw data].
+// Read back with read_result_array (or any tool that understands the
+// 16-byte header).
+template <class T>
+inline void write_result_array(const T* data, size_t n, const char* fname) {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "write_result_array requires trivially copyable elements");
+  int fd = open(fname, O_CREAT | O_WRONLY | O_TRUNC, 0644);
+  if (fd == -1) {
+    perror("write_result_array: open");
+    return;
+  }
+  uint64_t header[2] = {sizeof(T), n};
+  if (pwrite(fd, header, sizeof(header), 0) != (ssize_t)sizeof(header)) {
+    perror("write_result_array: header");
+    close(fd);
+    return;
+  }
+  const char* bytes = (const char*)data;
+  size_t total = n * sizeof(T);
+  constexpr size_t kChunk = size_t{1} << 26;  // 64 MB
+  size_t n_chunks = (total + kChunk - 1) / kChunk;
+  parallel_for(0, n_chunks, [&](size_t c) {
+    size_t off = c * kChunk;
+    size_t len = std::min(kChunk, total - off);
+    ssize_t ret = pwrite(fd, bytes + off, len, sizeof(header) + off);
+    if (ret != (ssize_t)len) {
+      perror("write_result_array: pwrite");
+    }
+  }, 1);
+  close(fd);
+}
+
+template <class T>
+inline void write_result_array(const pbbs::sequence<T>& s, const char* fname) {
+  write_result_array(s.begin(), s.size(), fname);
+}
+
+template <class T>
+inline pbbs::sequence<T> read_result_array(const char* fname) {
+  std::ifstream in(fname, std::ios::in | std::ios::binary);
+  if (!in.is_open()) {
+    std::cout << "read_result_array: unable to open " << fname << std::endl;
+    abort();
+  }
+  uint64_t header[2];
+  in.read((char*)header, sizeof(header));
+  if (header[0] != sizeof(T)) {
+    std::cout << "read_result_array: element size mismatch" << std::endl;
+    abort();
+  }
+  auto s = pbbs::sequence<T>::no_init(header[1]);
+  in.read((char*)s.begin(), header[1] * sizeof(T));
+  return s;
+}
+// ==================== Memory reporting ================================
+//
+// Peak-RSS and allocation-timeline reporting (-mem-report): a sampling
+// thread reads VmRSS every few milliseconds while the experiment runs, and
+// the report gives VmHWM (the kernel's true high-water mark), the sampled
+// timeline (phase-alignable against the instrumentation phases by
+// timestamp), and the pbbs allocator's pool statistics. Machine sizing
+// stops being learn-by-OOM.
+struct memory_monitor {
+  std::thread sampler;
+  std::atomic<bool> done{false};
+  std::vector<std::pair<double, size_t>> timeline;  // (seconds, rss kb)
+  std::chrono::steady_clock::time_point start;
+
+  static size_t read_status_kb(const char* field) {
+    std::ifstream f("/proc/self/status");
+    std::string line;
+    size_t flen = strlen(field);
+    while (std::getline(f, line)) {
+      if (line.compare(0, flen, field) == 0) {
+        return (size_t)atol(line.c_str() + flen);
+      }
+    }
+    return 0;
+  }
+
+  memory_monitor(size_t interval_ms = 50)
+      : start(std::chrono::steady_clock::now()) {
+    sampler = std::thread([this, interval_ms] {
+      while (!done.load()) {
+        double t = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start).count();
+        timeline.emplace_back(t, read_status_kb("VmRSS:"));
+        std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+      }
+    });
+  }
+
+  void report() {
+    done.store(true);
+    if (sampler.joinable()) sampler.join();
+    size_t hwm = read_status_kb("VmHWM:");
+    size_t sampled_peak = 0;
+    for (auto& [t, kb] : timeline) sampled_peak = std::max(sampled_peak, kb);
+    std::cout << "# mem: VmHWM = " << hwm << " kB, sampled peak = "
+              << sampled_peak << " kB, samples = " << timeline.size()
+              << "\n";
+    std::cout << "# mem timeline (s,kB):";
+    // cap the printed timeline; the shape matters, not every sample
+    size_t stride = std::max<size_t>(1, timeline.size() / 40);
+    for (size_t i = 0; i < timeline.size(); i += stride) {
+      std::cout << " " << timeline[i].first << "," << timeline[i].second;
+    }
+    std::cout << "\n";
+#ifndef USEMALLOC
+    pbbs::my_mem_pool.print_stats();
+#endif
+  }
+
+  ~memory_monitor() {
+    done.store(true);
+    if (sampler.joinable()) sampler.join();
+  }
+};
+
+// ==================== Experiment management =============================
+//
+// Statistically sound reporting for the -rounds machinery, shared by every
+// generate_main binary through run_app: warmup rounds are discarded,
+// median/p25/p75/min/max are reported instead of a bare mean, rounds can
+// extend automatically until the measurement stabilizes, and the per-round
+// samples can be dumped as CSV or JSON for performance CI.
+//
+// Options (on any benchmark binary):
+//   -warmup k        discard the first k rounds (default 1 when rounds > 2)
+//   -auto-rounds tol keep adding rounds (up to 4x) until the relative
+//                    spread (IQR / median) is below tol
+//   -stats-out f     append one CSV line "name,rounds,median,p25,p75,min,max"
+//   -stats-json      print the samples and summary as one JSON line
+template <class RunOnce>
+inline double run_experiment(commandLine& P, size_t rounds,
+                             const std::string& name, RunOnce run_once) {
+  size_t warmup = (size_t)P.getOptionLongValue(
+      "-warmup", (rounds > 2) ? 1 : 0);
+  double auto_tol = P.getOptionDoubleValue("-auto-rounds", 0.0);
+
+  std::vector<double> samples;
+  for (size_t r = 0; r < warmup; r++) (void)run_once();
+  for (size_t r = 0; r < rounds; r++) samples.push_back(run_once());
+
+  auto summarize = [&](std::vector<double> xs) {
+    std::sort(xs.begin(), xs.end());
+    auto q = [&](double p) {
+      return xs[std::min(xs.size() - 1, (size_t)(p * xs.size()))];
+    };
+    return std::make_tuple(q(0.5), q(0.25), q(0.75), xs.front(), xs.back());
+  };
+
+  if (auto_tol > 0) {
+    size_t max_rounds = 4 * rounds;
+    while (samples.size() < max_rounds) {
+      auto [med, p25, p75, mn, mx] = summarize(samples);
+      (void)mn; (void)mx;
+      if (med > 0 && (p75 - p25) / med <= auto_tol && samples.size() >= 3) {
+        break;
+      }
+      samples.push_back(run_once());
+    }
+  }
+
+  auto [med, p25, p75, mn, mx] = summarize(samples);
+  std::cout << "# rounds: " << samples.size() << " (+" << warmup
+            << " warmup)\n";
+  std::cout << "# median: " << med << " p25: " << p25 << " p75: " << p75
+            << " min: " << mn << " max: " << mx << "\n";
+
+  if (char* out = P.getOptionValue("-stats-out")) {
+    std::ofstream f(out, std::ios::app);
+    f << name << "," << samples.size() << "," << med << "," << p25 << ","
+      << p75 << "," << mn << "," << mx << "\n";
+  }
+  if (P.getOption("-stats-json")) {
+    std::cout << "{\"name\": \"" << name << "\", \"samples\": [";
+    for (size_t i = 0; i < samples.size(); i++) {
+      if (i) std::cout << ", ";
+      std::cout << samples[i];
+    }
+    std::cout << "], \"median\": " << med << "}" << std::endl;
+  }
+  return med;
+}
+
 /* Aggregate metrics for a repeated experiment, repeated num_rounds times. */
 struct cpu_stats {
   double ipc;
@@ -56,14 +253,20 @@ inline auto get_pcm_state() { return (size_t)1; }
 #define run_app(G, APP, rounds)                                            \
   auto before_state = gbbs::get_pcm_state();                               \
   pbbs::timer st;                                                          \
-  double total_time = 0.0;                                                 \
-  for (size_t r = 0; r < rounds; r++) {                                    \
-    total_time += APP(G, P);                                               \
+  auto run_once = [&]() { return APP(G, P); };                             \
+  std::unique_ptr<gbbs::memory_monitor> mem_mon;                           \
+  if (P.getOption("-mem-report")) {                                        \
+    mem_mon = std::make_unique<gbbs::memory_monitor>();                    \
   }                                                                        \
-  auto time_per_iter = total_time / rounds;                                \
+  auto time_per_iter =                                                     \
+      gbbs::run_experiment(P, rounds, P.getArgument(0), run_once);         \
+  if (mem_mon) { mem_mon->report(); }                                      \
   std::cout << "# time per iter: " << time_per_iter << "\n";               \
   auto after_state = gbbs::get_pcm_state();                                \
   gbbs::print_pcm_stats(before_state, after_state, rounds, time_per_iter); \
+  if (gbbs::instrumentation::enabled()) {                                  \
+    gbbs::instrumentation::report_json(std::cout);                         \
+  }                                                                        \
   G.del();
 
 /* Macro to generate binary for graph applications that read a graph (either
@@ -275,6 +478,93 @@ inline auto get_pcm_state() { return (size_t)1; }
     gbbs::alloc_finish();                                                      \
   }
 
+#define run_app_two(G1, G2, APP, rounds)                                   \
+  auto before_state = gbbs::get_pcm_state();                               \
+  auto run_once = [&]() { return APP(G1, G2, P); };                        \
+  auto time_per_iter =                                                     \
+      gbbs::run_experiment(P, rounds, P.getArgument(0), run_once);         \
+  std::cout << "# time per iter: " << time_per_iter << "\n";               \
+  auto after_state = gbbs::get_pcm_state();                                \
+  gbbs::print_pcm_stats(before_state, after_state, rounds, time_per_iter); \
+  G1.del();                                                                \
+  G2.del();
+
+/* Two-graph variant of generate_symmetric_main for algorithms comparing
+ * graph snapshots (e.g. CoSimRank across time): both inputs are parsed
+ * with the same -s/-c/-m/-b plumbing (and therefore share the mmap
+ * budget), and the application is invoked as APP(G1, G2, P). Invoke as
+ *   ./app -s <graph1> <graph2>                                       */
+#define generate_symmetric_two_graph_main(APP, mutates)                        \
+  int main(int argc, char* argv[]) {                                           \
+    gbbs::commandLine P(argc, argv, " [-s] <inFile1> <inFile2>");              \
+    char* iFile1 = P.getArgument(1);                                           \
+    char* iFile2 = P.getArgument(0);                                           \
+    bool symmetric = P.getOptionValue("-s");                                   \
+    bool compressed = P.getOptionValue("-c");                                  \
+    bool mmap = P.getOptionValue("-m");                                        \
+    bool mmapcopy = mutates;                                                   \
+    bool binary = P.getOptionValue("-b");                                      \
+    if (!symmetric) {                                                          \
+      std::cout                                                                \
+          << "# The application expects the input graphs to be symmetric (-s " \
+             "flag)."                                                          \
+          << std::endl;                                                        \
+    }                                                                          \
+    size_t rounds = P.getOptionLongValue("-rounds", 3);                        \
+    gbbs::pcm_init();                                                          \
+    if (compressed) {                                                          \
+      auto G1 =                                                                \
+          gbbs::gbbs_io::read_compressed_symmetric_graph<pbbslib::empty>(      \
+              iFile1, mmap, mmapcopy);                                         \
+      auto G2 =                                                                \
+          gbbs::gbbs_io::read_compressed_symmetric_graph<pbbslib::empty>(      \
+              iFile2, mmap, mmapcopy);                                         \
+      gbbs::alloc_init(G1);                                                    \
+      run_app_two(G1, G2, APP, rounds)                                         \
+    } else {                                                                   \
+      auto G1 = gbbs::gbbs_io::read_unweighted_symmetric_graph(iFile1, mmap,   \
+                                                               binary);        \
+      auto G2 = gbbs::gbbs_io::read_unweighted_symmetric_graph(iFile2, mmap,   \
+                                                               binary);        \
+      gbbs::alloc_init(G1);                                                    \
+      run_app_two(G1, G2, APP, rounds)                                         \
+    }                                                                          \
+    gbbs::alloc_finish();                                                      \
+  }
+
+/* Format-sniffing variant: one binary serves text, snapshot, and
+ * compressed inputs by inspecting the file header -- no -c/-b flags to get
+ * wrong (-m still controls mmapping where it applies). */
+#define generate_symmetric_sniffing_main(APP, mutates)                         \
+  int main(int argc, char* argv[]) {                                           \
+    gbbs::commandLine P(argc, argv, " [-s] <inFile>");                         \
+    char* iFile = P.getArgument(0);                                            \
+    bool mmap = P.getOptionValue("-m");                                        \
+    bool mmapcopy = mutates;                                                   \
+    size_t rounds = P.getOptionLongValue("-rounds", 3);                        \
+    gbbs::pcm_init();                                                          \
+    auto format = gbbs::gbbs_io::detect_graph_format(iFile);                   \
+    if (format == gbbs::gbbs_io::graph_format::compressed) {                   \
+      std::cout << "# detected format: compressed" << std::endl;               \
+      auto G = gbbs::gbbs_io::read_compressed_symmetric_graph<pbbslib::empty>( \
+          iFile, mmap, mmapcopy);                                              \
+      gbbs::alloc_init(G);                                                     \
+      run_app(G, APP, rounds)                                                  \
+    } else if (format == gbbs::gbbs_io::graph_format::snapshot) {              \
+      std::cout << "# detected format: snapshot" << std::endl;                 \
+      auto G = gbbs::gbbs_io::map_graph_snapshot<pbbslib::empty>(iFile);       \
+      gbbs::alloc_init(G);                                                     \
+      run_app(G, APP, rounds)                                                  \
+    } else {                                                                   \
+      std::cout << "# detected format: adjacency text" << std::endl;           \
+      auto G = gbbs::gbbs_io::read_unweighted_symmetric_graph(iFile, mmap,     \
+                                                              false);          \
+      gbbs::alloc_init(G);                                                     \
+      run_app(G, APP, rounds)                                                  \
+    }                                                                          \
+    gbbs::alloc_finish();                                                      \
+  }
+
 /* Macro to generate binary for unweighted graph applications that can ingest
  * only
  * symmetric graph inputs */
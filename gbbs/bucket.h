@@ -89,13 +89,20 @@ struct buckets {
         d(_d),
         order(_order),
         open_buckets(_total_buckets - 1),
-        total_buckets(_total_buckets),
+        total_buckets(_total_buckets - 1 + _total_buckets - 1),
+        fanout(_total_buckets - 1),
         cur_bkt(0),
         max_bkt(_total_buckets),
         num_elms(0),
-        allocated(true) {
+        allocated(true),
+        epoch(1) {
     // Initialize array consisting of the materialized buckets.
     bkts = pbbslib::new_array<id_dyn_arr>(total_buckets);
+    // Lazy-bucketing stamps: queued[v] records (epoch, slot) of v's most
+    // recent insertion, so re-relaxations within the same epoch do not
+    // insert duplicate copies (they were previously filtered only at
+    // bucket-claim time, after paying for the insert).
+    queued = sequence<size_t>(n, (size_t)0);
 
     // Set the current range being processed based on the order.
     if (order == increasing) {
@@ -160,8 +167,11 @@ struct buckets {
     // priority, which is why the code below does not check pri_order.
     if (order == increasing) {
       // case for strictly_decreasing priorities, assuming elements start out
-      // in the structure.
-      if (nb != null_bkt && nb != open_buckets) {
+      // in the structure. Overflow destinations are returned too: with
+      // residue-keyed coarse slots, a priority move across ranges must
+      // queue a fresh copy into the new range's slot (the old copy becomes
+      // stale and is discarded when its slot is refiltered or claimed).
+      if (nb != null_bkt) {
         return nb;
       } // case for strictly_increasing elided
     } else { // bkt_order == decreasing
@@ -224,7 +234,8 @@ struct buckets {
       for (size_t j = s; j < e; j++) {
         auto m = f(j);
         bucket_id b = std::get<1>(*m);
-        if (m.has_value() && b != null_bkt) {
+        if (m.has_value() && b != null_bkt &&
+            queued[std::get<0>(*m)] != queue_stamp(b)) {
           hist[b]++;
         }
       }
@@ -273,7 +284,7 @@ struct buckets {
         auto m = f(j);
         ident_t v = std::get<0>(*m);
         bucket_id b = std::get<1>(*m);
-        if (m.has_value() && b != null_bkt) {
+        if (m.has_value() && b != null_bkt && queued[v] != queue_stamp(b)) {
           size_t ind = hists[(b * num_blocks + i) * CACHE_LINE_S];
           bkts[b].insert(v, ind);
           hists[(b * num_blocks + i) * CACHE_LINE_S]++;
@@ -281,6 +292,20 @@ struct buckets {
       }
     });
 
+    // 5b. Publish the stamps only after both passes, so the histogram and
+    // insertion passes saw identical skip decisions.
+    par_for(0, num_blocks, 1, [&] (size_t i) {
+      size_t s = i * block_size;
+      size_t e = std::min(s + block_size, k);
+      for (size_t j = s; j < e; j++) {
+        auto m = f(j);
+        bucket_id b = std::get<1>(*m);
+        if (m.has_value() && b != null_bkt) {
+          queued[std::get<0>(*m)] = queue_stamp(b);
+        }
+      }
+    });
+
     // 6. Finally, update the size of each bucket.
     for (size_t i = 0; i < total_buckets; i++) {
       size_t num_inc = outs[(i + 1) * num_blocks] - outs[i * num_blocks];
@@ -298,7 +323,8 @@ struct buckets {
   D& d;
   const bucket_order order;
   size_t open_buckets;
-  size_t total_buckets;
+  size_t total_buckets;  // fine slots + coarse overflow slots
+  size_t fanout;         // number of coarse overflow slots
   size_t cur_bkt;
   size_t max_bkt;
   size_t num_elms;
@@ -306,6 +332,13 @@ struct buckets {
 
   size_t cur_range;
   id_dyn_arr* bkts;
+  size_t epoch;
+  sequence<size_t> queued;
+
+  // Stamp identifying "queued in slot b during the current epoch".
+  inline size_t queue_stamp(bucket_id b) const {
+    return epoch * (total_buckets + 1) + b + 1;
+  }
 
   template <class F>
   inline size_t update_buckets_seq(F& f, size_t k) {
@@ -314,8 +347,11 @@ struct buckets {
       auto m = f(i);
       bucket_id bkt = std::get<1>(*m);
       if (m.has_value() && bkt != null_bkt) {
+        ident_t v = std::get<0>(*m);
+        if (queued[v] == queue_stamp(bkt)) continue;  // already queued here
+        queued[v] = queue_stamp(bkt);
         bkts[bkt].resize(1);
-        insert_in_bucket(bkt, std::get<0>(*m));
+        insert_in_bucket(bkt, v);
         num_elms++;
       }
     }
@@ -332,17 +368,22 @@ struct buckets {
   inline bool curBucketNonEmpty() { return bkts[cur_bkt].size > 0; }
 
   inline void unpack() {
-    size_t m = bkts[open_buckets].size;
-    auto tmp = sequence<ident_t>(m);
-    ident_t* A = bkts[open_buckets].A;
-    par_for(0, m, pbbslib::kSequentialForThreshold, [&] (size_t i)
-                    { tmp[i] = A[i]; });
+    epoch++;  // invalidates all stamps from the finished range
     if (order == increasing) {
       cur_range++;  // increment range
     } else {
       cur_range--;
     }
-    bkts[open_buckets].size = 0;  // reset size
+    // Only the coarse slot covering the new range needs refiltering; the
+    // other slots' identifiers are at least one full fanout period away.
+    size_t oslot = open_buckets +
+        ((order == increasing ? cur_range : cur_range - 1) % fanout);
+    size_t m = bkts[oslot].size;
+    auto tmp = sequence<ident_t>(m);
+    ident_t* A = bkts[oslot].A;
+    par_for(0, m, pbbslib::kSequentialForThreshold, [&] (size_t i)
+                    { tmp[i] = A[i]; });
+    bkts[oslot].size = 0;  // reset size
 
     auto g = [&](ident_t i) -> std::optional<std::tuple<ident_t, bucket_id> > {
       ident_t v = tmp[i];
@@ -350,29 +391,77 @@ struct buckets {
       return std::optional<std::tuple<ident_t, bucket_id> >(std::make_tuple(v, bkt));
     };
 
-    if (m != num_elms) {
-      std::cout << "m = " << m << " num_elms = " << num_elms << "\n";
-      cur_bkt = 0;
-      std::cout << "curBkt = " << get_cur_bucket_num() << "\n";
-      std::cout << "mismatch"
-                << "\n";
-      assert(m == num_elms);  // corrruption in bucket structure.
-    }
+    num_elms -= m;
     size_t updated = update_buckets(g, m);
-    size_t num_in_range = updated - bkts[open_buckets].size;
-    //none in range
-    if(num_in_range == 0 && bkts[open_buckets].size > 0) {
-      auto imap = pbbslib::make_sequence<bucket_t>(bkts[open_buckets].size, [&] (size_t j) { return (size_t)d[bkts[open_buckets].A[j]]; });
-      if(order == increasing) {
-        size_t minBkt = pbbs::reduce(imap, pbbs::minm<size_t>());
-        cur_range = minBkt/open_buckets-1; //will be incremented in next unpack() call
+
+    // If nothing landed in the new range anywhere, jump the range toward
+    // the closest occupied one. Coarse slots hold stale copies alongside
+    // live ones (lazy rebucketing leaves old copies behind), so the reduce
+    // considers only d values still ahead of the current range, and the
+    // jump is strictly forward -- if stale copies make the current range
+    // look occupied, we simply advance one range at a time, which refilters
+    // (and purges) one slot per advance and always terminates.
+    if (num_elms > 0) {
+      bool any_fine = false;
+      for (size_t i = 0; i < open_buckets; i++) {
+        if (bkts[i].size > 0) { any_fine = true; break; }
       }
-      else if(order == decreasing) {
-        size_t minBkt = pbbs::reduce(imap, pbbs::maxm<size_t>());
-        cur_range = (open_buckets+minBkt)/open_buckets+1; //will be decremented in next unpack() call
+      if (!any_fine) {
+        size_t best = (order == increasing)
+                          ? std::numeric_limits<size_t>::max()
+                          : 0;
+        bool found = false;
+        size_t range_start = cur_range * open_buckets;
+        for (size_t c = 0; c < fanout; c++) {
+          auto& ov = bkts[open_buckets + c];
+          if (ov.size == 0) continue;
+          if (order == increasing) {
+            // live entries lie at or beyond the current range start
+            auto imap = pbbslib::make_sequence<size_t>(ov.size, [&] (size_t j) {
+              size_t dv = (size_t)d[ov.A[j]];
+              return (dv >= range_start && dv != (size_t)null_bkt)
+                         ? dv
+                         : std::numeric_limits<size_t>::max(); });
+            size_t mn = pbbs::reduce(imap, pbbs::minm<size_t>());
+            if (mn != std::numeric_limits<size_t>::max()) {
+              best = std::min(best, mn);
+              found = true;
+            }
+          } else {
+            // live entries lie strictly below the current range
+            size_t live_end = (cur_range - 1) * open_buckets;
+            auto imap = pbbslib::make_sequence<size_t>(ov.size, [&] (size_t j) {
+              size_t dv = (size_t)d[ov.A[j]];
+              return (dv < live_end) ? dv : 0; });
+            size_t mx = pbbs::reduce(imap, pbbs::maxm<size_t>());
+            if (ov.size > 0 && mx > 0) {
+              best = std::max(best, mx);
+              found = true;
+            } else {
+              // dv == 0 entries are indistinguishable from the filler;
+              // check for a genuine live zero
+              for (size_t j = 0; j < ov.size; j++) {
+                if ((size_t)d[ov.A[j]] < live_end) { found = true; break; }
+              }
+            }
+          }
+        }
+        if (found) {
+          if (order == increasing) {
+            size_t target = best / open_buckets;  // range containing best
+            if (target > cur_range) {
+              cur_range = target - 1;  // incremented next unpack
+            }
+          } else {
+            size_t target = best / open_buckets + 2;  // decremented next
+            if (target < cur_range) {
+              cur_range = target;
+            }
+          }
+        }
       }
     }
-    num_elms -= m;
+    (void)updated;
   }
 
   inline void _next_bucket() {
@@ -385,6 +474,14 @@ struct buckets {
 
   // increasing: [cur_range*open_buckets, (cur_range+1)*open_buckets)
   // decreasing: [(cur_range-1)*open_buckets, cur_range*open_buckets)
+  // Fine slots cover the current range; everything further out lands in one
+  // of `fanout` coarse overflow slots keyed by its range modulo fanout (a
+  // two-level scheme: an out-of-range identifier is rehandled once every
+  // `fanout` ranges rather than on every range advance).
+  inline bucket_id overflow_slot(bucket_id bkt) const {
+    return open_buckets + ((bkt / open_buckets) % fanout);
+  }
+
   inline bucket_id to_range(bucket_id bkt) const {
     if (order == increasing) {
       if (bkt <
@@ -393,14 +490,14 @@ struct buckets {
         return null_bkt;
       }
       return (bkt < (cur_range + 1) * open_buckets) ? (bkt % open_buckets)
-                                                    : open_buckets;
+                                                    : overflow_slot(bkt);
     } else {
       if (bkt >= (cur_range)*open_buckets) {
         return null_bkt;
       }
       return (bkt >= (cur_range - 1) * open_buckets)
                  ? ((open_buckets - (bkt % open_buckets)) - 1)
-                 : open_buckets;
+                 : overflow_slot(bkt);
     }
   }
 
@@ -416,6 +513,10 @@ struct buckets {
     id_dyn_arr bkt = bkts[cur_bkt];
     size_t size = bkt.size;
     num_elms -= size;
+    // the claimed entries (live and stale alike) leave the structure; clear
+    // their lazy-bucketing stamps so they can requeue
+    par_for(0, size, pbbslib::kSequentialForThreshold, [&] (size_t j)
+                    { queued[bkt.A[j]] = 0; });
     ident_t* out = pbbslib::new_array_no_init<ident_t>(size);
     size_t cur_bkt_num = get_cur_bucket_num();
     auto p = [&](size_t i) { return d[i] == cur_bkt_num; };
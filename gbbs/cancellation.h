@@ -0,0 +1,85 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Cooperative cancellation and progress reporting for long-running
+// algorithms. A token is one relaxed atomic load at round/block
+// granularity -- never per edge -- so the hot-path cost is negligible; a
+// service thread (or a deadline) sets it, and instrumented loops return
+// their partial result. progress_reporter throttles callbacks to a minimum
+// interval so per-round reporting never becomes the bottleneck.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+
+namespace gbbs {
+namespace cancellation {
+
+struct token {
+  std::atomic<bool> cancelled{false};
+  std::chrono::steady_clock::time_point deadline{};
+  bool has_deadline = false;
+
+  void cancel() { cancelled.store(true, std::memory_order_relaxed); }
+
+  void set_deadline(std::chrono::milliseconds from_now) {
+    deadline = std::chrono::steady_clock::now() + from_now;
+    has_deadline = true;
+  }
+
+  // One relaxed load (plus a clock read only when a deadline is armed);
+  // call at round or block boundaries.
+  inline bool should_stop() {
+    if (cancelled.load(std::memory_order_relaxed)) return true;
+    if (has_deadline && std::chrono::steady_clock::now() >= deadline) {
+      cancelled.store(true, std::memory_order_relaxed);
+      return true;
+    }
+    return false;
+  }
+};
+
+struct progress_reporter {
+  using callback = std::function<void(size_t done, size_t total)>;
+  callback cb;
+  std::chrono::milliseconds min_interval;
+  std::chrono::steady_clock::time_point last;
+
+  progress_reporter(callback cb, size_t min_interval_ms = 250)
+      : cb(std::move(cb)), min_interval(min_interval_ms),
+        last(std::chrono::steady_clock::now() - min_interval) {}
+
+  // Invokes the callback at most once per min_interval.
+  inline void report(size_t done, size_t total) {
+    auto now = std::chrono::steady_clock::now();
+    if (now - last >= min_interval) {
+      last = now;
+      if (cb) cb(done, total);
+    }
+  }
+};
+
+}  // namespace cancellation
+}  // namespace gbbs
@@ -0,0 +1,178 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Checkpoint/restore for algorithm state. Long-running jobs (peeling,
+// connectivity) can persist their pbbs::sequence-backed state -- coreness
+// arrays, union-find parents, current-round scalars -- to a binary file and
+// resume after preemption instead of restarting. A checkpoint is a header
+// followed by length-prefixed sections written in order; restore reads the
+// sections back in the same order. Only trivially copyable element types
+// are supported (everything the algorithms actually checkpoint).
+//
+// Usage:
+//   { auto w = checkpoint::writer("state.ckpt");
+//     w.write_value(round);
+//     w.write_sequence(coreness); }        // flushed+atomic on close
+//   ...
+//   auto r = checkpoint::reader("state.ckpt");
+//   size_t round = r.read_value<size_t>();
+//   auto coreness = r.read_sequence<uintE>();
+
+#pragma once
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "bridge.h"
+#include "macros.h"
+
+namespace gbbs {
+namespace checkpoint {
+
+constexpr uint64_t kMagic = 0x676262736b707431ULL;  // "gbbskpt1"
+constexpr uint64_t kVersion = 1;
+
+struct writer {
+  std::ofstream out;
+  std::string final_path;
+  std::string tmp_path;
+
+  // Writes to <path>.tmp and renames into place on close(), so a
+  // preemption mid-write never clobbers the previous good checkpoint.
+  writer(const std::string& path)
+      : final_path(path), tmp_path(path + ".tmp") {
+    out.open(tmp_path, std::ofstream::out | std::ios::binary);
+    if (!out.is_open()) {
+      std::cout << "checkpoint: unable to open " << tmp_path << std::endl;
+      abort();
+    }
+    uint64_t header[2] = {kMagic, kVersion};
+    out.write((char*)header, sizeof(header));
+  }
+
+  template <class T>
+  void write_value(const T& v) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "checkpoint requires trivially copyable types");
+    uint64_t bytes = sizeof(T);
+    out.write((char*)&bytes, sizeof(bytes));
+    out.write((char*)&v, sizeof(T));
+  }
+
+  template <class T>
+  void write_sequence(const pbbs::sequence<T>& s) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "checkpoint requires trivially copyable types");
+    uint64_t bytes = s.size() * sizeof(T);
+    out.write((char*)&bytes, sizeof(bytes));
+    out.write((char*)s.begin(), bytes);
+  }
+
+  template <class T>
+  void write_array(const T* a, size_t n) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "checkpoint requires trivially copyable types");
+    uint64_t bytes = n * sizeof(T);
+    out.write((char*)&bytes, sizeof(bytes));
+    out.write((char*)a, bytes);
+  }
+
+  void close() {
+    if (out.is_open()) {
+      out.close();
+      if (std::rename(tmp_path.c_str(), final_path.c_str()) != 0) {
+        std::cout << "checkpoint: rename to " << final_path << " failed"
+                  << std::endl;
+        abort();
+      }
+    }
+  }
+
+  ~writer() { close(); }
+};
+
+struct reader {
+  std::ifstream in;
+  bool ok;
+
+  reader(const std::string& path) : ok(false) {
+    in.open(path, std::ios::in | std::ios::binary);
+    if (!in.is_open()) return;
+    uint64_t header[2] = {0, 0};
+    in.read((char*)header, sizeof(header));
+    ok = in.good() && header[0] == kMagic && header[1] == kVersion;
+  }
+
+  // True when the file exists and carries a valid header; callers use this
+  // to decide between resuming and starting fresh.
+  bool valid() const { return ok; }
+
+  template <class T>
+  T read_value() {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "checkpoint requires trivially copyable types");
+    uint64_t bytes = 0;
+    in.read((char*)&bytes, sizeof(bytes));
+    if (bytes != sizeof(T)) {
+      std::cout << "checkpoint: section size mismatch (" << bytes
+                << " != " << sizeof(T) << ")" << std::endl;
+      abort();
+    }
+    T v;
+    in.read((char*)&v, sizeof(T));
+    return v;
+  }
+
+  template <class T>
+  pbbs::sequence<T> read_sequence() {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "checkpoint requires trivially copyable types");
+    uint64_t bytes = 0;
+    in.read((char*)&bytes, sizeof(bytes));
+    if (bytes % sizeof(T) != 0) {
+      std::cout << "checkpoint: section not a multiple of element size"
+                << std::endl;
+      abort();
+    }
+    auto s = pbbs::sequence<T>::no_init(bytes / sizeof(T));
+    in.read((char*)s.begin(), bytes);
+    return s;
+  }
+
+  template <class T>
+  void read_array(T* a, size_t n) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "checkpoint requires trivially copyable types");
+    uint64_t bytes = 0;
+    in.read((char*)&bytes, sizeof(bytes));
+    if (bytes != n * sizeof(T)) {
+      std::cout << "checkpoint: array size mismatch" << std::endl;
+      abort();
+    }
+    in.read((char*)a, bytes);
+  }
+};
+
+}  // namespace checkpoint
+}  // namespace gbbs
@@ -53,6 +53,8 @@ struct compressed_neighbors {
   compressed_neighbors(uintE id, uintE degree, uchar* neighbors) :
     id(id), degree(degree), neighbors(neighbors) {}
 
+  uintE get_degree() { return degree; }
+
   template <class F>
   inline void map(F& f, bool parallel = true) {
     auto T = [&](const uintE& src, const uintE& target, const W& weight,
@@ -133,6 +135,14 @@ struct compressed_neighbors {
     return calculateTemporarySpace() * sizeof(std::tuple<uintE, W>);
   }
 
+  // Applies f(ngh) to the neighbors with id in [lo, hi), skipping whole
+  // blocks outside the range via their first-edge keys (id-range predicate
+  // pushdown; topology-only).
+  template <class F>
+  inline void map_id_range(uintE lo, uintE hi, F f) {
+    C::template decode_range<W>(f, neighbors, id, degree, lo, hi);
+  }
+
   inline std::tuple<uintE, W> get_ith_neighbor(size_t i) {
     return C::template get_ith_neighbor<W>(neighbors, id, degree, i);
   }
@@ -363,6 +373,48 @@ struct cav_bytepd
   using inner::inner;
 };
 
+template <class W>
+struct csv_byte_split
+    : compressed_symmetric_vertex<W, byte_split_decode> {
+  using inner = compressed_symmetric_vertex<W, byte_split_decode>;
+  using inner::inner;
+};
+
+template <class W>
+struct cav_byte_split
+    : compressed_asymmetric_vertex<W, byte_split_decode> {
+  using inner = compressed_asymmetric_vertex<W, byte_split_decode>;
+  using inner::inner;
+};
+
+template <class W>
+struct csv_group_varint
+    : compressed_symmetric_vertex<W, group_varint_decode> {
+  using inner = compressed_symmetric_vertex<W, group_varint_decode>;
+  using inner::inner;
+};
+
+template <class W>
+struct cav_group_varint
+    : compressed_asymmetric_vertex<W, group_varint_decode> {
+  using inner = compressed_asymmetric_vertex<W, group_varint_decode>;
+  using inner::inner;
+};
+
+template <class W>
+struct csv_interval
+    : compressed_symmetric_vertex<W, interval_decode> {
+  using inner = compressed_symmetric_vertex<W, interval_decode>;
+  using inner::inner;
+};
+
+template <class W>
+struct cav_interval
+    : compressed_asymmetric_vertex<W, interval_decode> {
+  using inner = compressed_asymmetric_vertex<W, interval_decode>;
+  using inner::inner;
+};
+
 template <class W>
 struct cav_byte
     : compressed_asymmetric_vertex<W, byte_decode> {
@@ -0,0 +1,126 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Reusable multi-level contraction on top of contract.h. Each coarsen()
+// call contracts the current level's graph by a clustering and records the
+// composed vertex-to-cluster mapping, so the hierarchy can project vertex
+// data between any level and the base graph in O(1) lookups per vertex --
+// the piece every multilevel consumer (community detection, partitioning,
+// multigrid-style solvers) re-implemented against contract.h internals.
+
+#pragma once
+
+#include <vector>
+
+#include "contract.h"
+#include "gbbs.h"
+
+namespace gbbs {
+
+struct contraction_hierarchy {
+  using level_graph = symmetric_graph<symmetric_vertex, pbbslib::empty>;
+
+  struct level {
+    level_graph graph;            // contracted graph at this level
+    sequence<uintE> base_to_here;  // base-graph vertex -> vertex at level
+    sequence<uintE> here_to_prev;  // vertex at level -> cluster in prev level
+  };
+
+  size_t base_n;
+  std::vector<level> levels;
+
+  contraction_hierarchy(size_t base_n) : base_n(base_n) {}
+
+  size_t num_levels() const { return levels.size(); }
+
+  level_graph& graph_at(size_t l) { return levels[l].graph; }
+
+  // Maps a base-graph vertex to its vertex at level l (both hops O(1)).
+  inline uintE project_to_level(size_t l, uintE base_v) const {
+    return levels[l].base_to_here[base_v];
+  }
+
+  // Contracts `G_prev` (the graph at the previous level, or the base graph
+  // for the first call) by `clusters` and pushes the result as the next
+  // level. `clusters` maps each vertex of the previous level to a cluster
+  // id in [0, num_clusters).
+  template <class Graph>
+  void coarsen(Graph& G_prev, sequence<uintE>& clusters,
+               size_t num_clusters) {
+    auto [GC, flags, mapping] =
+        contract::contract(G_prev, clusters, num_clusters);
+    (void)mapping;
+
+    // here_to_prev: vertex at the new level -> its cluster's id remap is
+    // `flags` (cluster -> packed vertex); compose with `clusters` for the
+    // base mapping.
+    level lvl;
+    lvl.graph = GC;
+    lvl.here_to_prev = sequence<uintE>(G_prev.n, [&](size_t v) {
+      return flags[clusters[v]];
+    });
+    if (levels.empty()) {
+      lvl.base_to_here = sequence<uintE>(base_n, [&](size_t v) {
+        return lvl.here_to_prev[v];
+      });
+    } else {
+      auto& prev = levels.back();
+      lvl.base_to_here = sequence<uintE>(base_n, [&](size_t v) {
+        return lvl.here_to_prev[prev.base_to_here[v]];
+      });
+    }
+    levels.push_back(std::move(lvl));
+  }
+
+  // Projects per-vertex data from level `l` down to the base graph:
+  // out[v] = data[vertex of v at level l].
+  template <class T>
+  sequence<T> project_to_base(size_t l, sequence<T> const& data) const {
+    auto out = sequence<T>(base_n, [&](size_t v) {
+      return data[levels[l].base_to_here[v]];
+    });
+    return out;
+  }
+
+  // Aggregates base-level data up to level `l` with a commutative
+  // reduction (e.g. cluster sizes with add over ones).
+  template <class T, class Combine>
+  sequence<T> aggregate_to_level(size_t l, sequence<T> const& base_data,
+                                 T identity, Combine combine) const {
+    auto out = sequence<T>(levels[l].graph.n, identity);
+    for (size_t v = 0; v < base_n; v++) {
+      uintE c = levels[l].base_to_here[v];
+      out[c] = combine(out[c], base_data[v]);
+    }
+    return out;
+  }
+
+  void del() {
+    for (auto& lvl : levels) {
+      lvl.graph.del();
+    }
+    levels.clear();
+  }
+};
+
+}  // namespace gbbs
@@ -0,0 +1,103 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Runtime CPU-feature dispatch for one-binary releases on mixed fleets.
+// The vectorized leaves in this tree are autovectorized loops, so the
+// mechanism is GCC target_clones: annotate a concrete leaf kernel with
+// GBBS_TARGET_CLONES and the compiler emits avx512/avx2/default variants
+// resolved once by the loader's ifunc machinery -- no per-call branch, no
+// per-microarchitecture build. Templates can't be multiversioned, so the
+// pattern is to instantiate the hot loop as a concrete kernel here (the
+// uintE intersection-count below is the first) and route the template
+// through it for the common types. cpu_features reports what the host
+// resolved, for logging. Pair with PORTABLE=1 in makefile.variables to
+// drop -march=native from release builds; non-x86 / non-GCC builds see
+// the plain (autovectorized-at-base-ISA) kernel.
+
+#pragma once
+
+#include "macros.h"
+
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__)
+#define GBBS_TARGET_CLONES \
+  __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define GBBS_TARGET_CLONES
+#endif
+
+namespace gbbs {
+namespace cpu {
+
+struct cpu_features {
+  bool avx2 = false;
+  bool avx512f = false;
+  bool bmi2 = false;
+
+  static const cpu_features& get() {
+    static cpu_features f = [] {
+      cpu_features r;
+#if defined(__x86_64__) && defined(__GNUC__)
+      __builtin_cpu_init();
+      r.avx2 = __builtin_cpu_supports("avx2");
+      r.avx512f = __builtin_cpu_supports("avx512f");
+      r.bmi2 = __builtin_cpu_supports("bmi2");
+#endif
+      return r;
+    }();
+    return f;
+  }
+};
+
+// Branch-free sorted intersection count over raw id arrays: the concrete
+// form of the balanced path in pbbs::seq_intersect_f, multiversioned.
+GBBS_TARGET_CLONES
+inline size_t intersect_count_u32(const uintE* A, size_t nA, const uintE* B,
+                                  size_t nB) {
+  size_t i = 0, j = 0, ct = 0;
+  while (i < nA && j < nB) {
+    uintE a = A[i];
+    uintE b = B[j];
+    ct += (a == b);
+    i += (a <= b);
+    j += (b <= a);
+  }
+  return ct;
+}
+
+// Multiversioned reduction leaves for dense numeric arrays.
+GBBS_TARGET_CLONES
+inline uint64_t sum_u32(const uintE* A, size_t n) {
+  uint64_t s = 0;
+  for (size_t i = 0; i < n; i++) s += A[i];
+  return s;
+}
+
+GBBS_TARGET_CLONES
+inline double sum_f64(const double* A, size_t n) {
+  double s = 0;
+  for (size_t i = 0; i < n; i++) s += A[i];
+  return s;
+}
+
+}  // namespace cpu
+}  // namespace gbbs
@@ -0,0 +1,115 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Standard-CSR interop view over a symmetric graph, in the
+// (offsets, column indices, values) triple Eigen::Map / CSparse kernels
+// consume. Offsets are materialized once (O(n); v_data interleaves
+// offset with degree, so no flat offsets array exists to alias). For
+// unweighted graphs the column-index array aliases the edge array
+// directly -- tuple<uintE, empty> collapses to 4 bytes, checked
+// statically -- so the O(m) side is zero-copy. Weighted graphs interleave
+// weights with indices, so their downgrade path copies indices and values
+// into separate arrays (SoA), as does any compressed graph (which has no
+// flat index array at all). spmv() is included both as the power-iteration
+// primitive and as executable documentation of the layout.
+
+#pragma once
+
+#include <type_traits>
+
+#include "gbbs.h"
+
+namespace gbbs {
+
+template <class W>
+struct csr_view {
+  size_t n;
+  size_t m;
+  sequence<uintT> offsets;       // n + 1
+  const uintE* col_indices;      // m (aliases the graph when zero_copy)
+  const W* values;               // m, or nullptr for unweighted
+  bool zero_copy;
+
+  sequence<uintE> index_storage;  // backing when not zero-copy
+  sequence<W> value_storage;
+};
+
+// Uncompressed graphs. Unweighted: column indices alias the edge array.
+// Weighted: indices/values are deinterleaved into fresh SoA arrays.
+template <template <class> class vertex_type, class W>
+csr_view<W> make_csr_view(symmetric_graph<vertex_type, W>& G) {
+  static_assert(
+      std::is_same<vertex_type<W>, symmetric_vertex<W>>::value,
+      "CSR views require an uncompressed graph; decompress or re-encode");
+  using edge_type = typename symmetric_vertex<W>::edge_type;
+  csr_view<W> view;
+  view.n = G.n;
+  view.m = G.m;
+  view.offsets = sequence<uintT>(G.n + 1);
+  par_for(0, G.n, [&](size_t i) { view.offsets[i] = G.v_data[i].offset; });
+  view.offsets[G.n] = G.m;
+
+  if constexpr (std::is_same<W, pbbslib::empty>::value &&
+                sizeof(edge_type) == sizeof(uintE)) {
+    view.col_indices = (const uintE*)G.e0;
+    view.values = nullptr;
+    view.zero_copy = true;
+  } else {
+    view.index_storage = sequence<uintE>::no_init(G.m);
+    view.value_storage = sequence<W>::no_init(G.m);
+    parallel_for(0, G.n, [&](size_t i) {
+      size_t off = G.v_data[i].offset;
+      auto nghs = G.get_vertex(i).out_neighbors();
+      for (size_t j = 0; j < nghs.degree; j++) {
+        view.index_storage[off + j] = nghs.get_neighbor(j);
+        view.value_storage[off + j] = nghs.get_weight(j);
+      }
+    }, 1);
+    view.col_indices = view.index_storage.begin();
+    view.values = view.value_storage.begin();
+    view.zero_copy = false;
+  }
+  return view;
+}
+
+// y = A * x over the view (unweighted entries count as 1); both the
+// power-iteration building block and a check that the layout is the one
+// external kernels expect.
+template <class W, class T>
+void spmv(const csr_view<W>& A, const T* x, T* y) {
+  parallel_for(0, A.n, [&](size_t i) {
+    T acc = (T)0;
+    for (uintT j = A.offsets[i]; j < A.offsets[i + 1]; j++) {
+      T w;
+      if constexpr (std::is_same<W, pbbslib::empty>::value) {
+        w = (T)1;
+      } else {
+        w = (A.values == nullptr) ? (T)1 : (T)A.values[j];
+      }
+      acc += w * x[A.col_indices[j]];
+    }
+    y[i] = acc;
+  });
+}
+
+}  // namespace gbbs
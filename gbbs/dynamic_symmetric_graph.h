@@ -0,0 +1,372 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// A batch-dynamic symmetric graph that existing algorithms can run on
+// unchanged. Each vertex owns a sorted (neighbor, weight) array;
+// get_vertex() wraps it in a regular symmetric_vertex, so the full
+// neighbor-operation surface (decode, map, intersect, edgeMap traversal)
+// is the one the static graph already provides -- no parallel "dynamic"
+// code paths in the algorithms. insert_batch/delete_batch apply an
+// edge_array in parallel: the batch is symmetrized, sorted by source, and
+// each affected vertex's list is rebuilt by one merge; work is
+// proportional to the affected adjacency, not the graph. Updates and
+// traversals must not overlap (batch-synchronous, like the rest of the
+// library's mutation APIs).
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "bridge.h"
+#include "edge_array.h"
+#include "graph.h"
+#include "macros.h"
+
+namespace gbbs {
+
+template <class W>
+struct dynamic_symmetric_graph {
+  using vertex = symmetric_vertex<W>;
+  using weight_type = W;
+  using edge_type = typename vertex::edge_type;  // std::tuple<uintE, W>
+
+  // Adjacency arrays are held through shared ownership so snapshots can
+  // pin them: a snapshot copies the pointer table (no edge data), and a
+  // later batch that rewrites a vertex installs a fresh array while the
+  // snapshot keeps the old one alive -- copy-on-write at vertex-block
+  // granularity.
+  using block_ptr = std::shared_ptr<edge_type>;
+
+  static block_ptr make_block(size_t deg) {
+    return block_ptr(pbbslib::new_array_no_init<edge_type>(deg),
+                     [](edge_type* p) { pbbslib::free_array(p); });
+  }
+
+  size_t n;
+  size_t m;  // directed edge count, as in symmetric_graph
+  size_t capacity;  // allocated vertex slots (n <= capacity)
+
+  pbbs::sequence<block_ptr> nghs;
+  pbbs::sequence<uintE> degrees;
+
+  dynamic_symmetric_graph(size_t n)
+      : n(n), m(0), capacity(n),
+        nghs(n, [](size_t) { return block_ptr(); }),
+        degrees(n, (uintE)0) {}
+
+  // Grows the vertex tables to hold at least new_cap slots. Only the
+  // pointer table and degree array move -- per-vertex adjacency blocks are
+  // already independent allocations, so there is nothing to chain into
+  // overflow segments and no CSR rebuild.
+  void reserve(size_t new_cap) {
+    if (new_cap <= capacity) return;
+    size_t cap = std::max(new_cap, 2 * capacity);
+    auto new_nghs = pbbs::sequence<block_ptr>(cap, [](size_t) {
+      return block_ptr();
+    });
+    auto new_degrees = pbbs::sequence<uintE>(cap, (uintE)0);
+    parallel_for(0, n, [&](size_t i) {
+      new_nghs[i] = std::move(nghs[i]);
+      new_degrees[i] = degrees[i];
+    });
+    nghs = std::move(new_nghs);
+    degrees = std::move(new_degrees);
+    capacity = cap;
+  }
+
+  // Appends `count` isolated vertices (ids [n, n + count)); returns the id
+  // of the first new vertex. Amortized O(1) table growth; ingest can add
+  // arriving vertices continuously and attach their edges with
+  // insert_batch, with no high-water-mark rebuilds.
+  uintE add_vertices(size_t count) {
+    reserve(n + count);
+    uintE first = (uintE)n;
+    n += count;
+    if (!tombstones.empty()) tombstones.resize(n);
+    return first;
+  }
+
+  // Builds from a static graph (copies the adjacency arrays).
+  template <class Graph>
+  static dynamic_symmetric_graph<W> from_graph(Graph& G) {
+    dynamic_symmetric_graph<W> DG(G.n);
+    DG.m = G.m;
+    parallel_for(0, G.n, [&](size_t i) {
+      uintE deg = G.get_vertex(i).out_degree();
+      DG.degrees[i] = deg;
+      if (deg > 0) {
+        DG.nghs[i] = make_block(deg);
+        size_t k = 0;
+        auto map_f = [&](const uintE& u, const uintE& v, const W& wgh) {
+          DG.nghs[i].get()[k++] = std::make_tuple(v, wgh);
+        };
+        G.get_vertex(i).out_neighbors().map(map_f, false);
+      }
+    }, 1);
+    return DG;
+  }
+
+  inline vertex get_vertex(uintE i) {
+    vertex_data vdata;
+    vdata.offset = 0;
+    vdata.degree = degrees[i];
+    return vertex(nghs[i].get(), vdata, i);
+  }
+
+  // An immutable view: shares the current per-vertex blocks, which stay
+  // alive (and unmodified -- the writer always installs fresh blocks)
+  // however many batches are applied afterwards. Creation copies only the
+  // pointer table and degrees; no edge data moves.
+  struct snapshot {
+    size_t n;
+    size_t m;
+    pbbs::sequence<block_ptr> nghs;
+    pbbs::sequence<uintE> degrees;
+    using vertex = symmetric_vertex<W>;
+    using weight_type = W;
+
+    inline vertex get_vertex(uintE i) {
+      vertex_data vdata;
+      vdata.offset = 0;
+      vdata.degree = degrees[i];
+      return vertex(nghs[i].get(), vdata, i);
+    }
+    size_t num_vertices() const { return n; }
+    size_t num_edges() const { return m; }
+    template <class F>
+    void mapEdges(F f, bool parallel_inner_map = true,
+                  size_t granularity = 1) {
+      parallel_for(0, n, [&](size_t i) {
+        get_vertex(i).out_neighbors().map(f, parallel_inner_map);
+      }, granularity);
+    }
+  };
+
+  snapshot get_snapshot() {
+    snapshot s;
+    s.n = n;
+    s.m = m;
+    s.nghs = nghs;  // shared_ptr copies pin the blocks
+    s.degrees = degrees;
+    return s;
+  }
+
+  size_t num_vertices() const { return n; }
+  size_t num_edges() const { return m; }
+
+  template <class F>
+  void mapEdges(F f, bool parallel_inner_map = true, size_t granularity = 1) {
+    parallel_for(0, n, [&](size_t i) {
+      get_vertex(i).out_neighbors().map(f, parallel_inner_map);
+    }, granularity);
+  }
+
+  // Applies the (symmetrized) batch. insert = true adds edges not already
+  // present; insert = false removes those present. Returns the number of
+  // (directed) edges actually added/removed.
+  size_t apply_batch(edge_array<W>& batch, bool insert) {
+    // Structural batches are a strict visibility point: a stale tombstone
+    // surviving past an insert of the same edge would delete it at the
+    // next compaction.
+    flush_deletions();
+    using bedge = std::tuple<uintE, edge_type>;  // (source, (dest, wgh))
+    size_t b = batch.non_zeros;
+    if (b == 0) return 0;
+    auto dir = pbbs::sequence<bedge>::no_init(2 * b);
+    parallel_for(0, b, [&](size_t i) {
+      auto [u, v, w] = batch.E[i];
+      dir[2 * i] = std::make_tuple(u, std::make_tuple(v, w));
+      dir[2 * i + 1] = std::make_tuple(v, std::make_tuple(u, w));
+    });
+    auto less = [](const bedge& a, const bedge& b2) {
+      return std::tie(std::get<0>(a), std::get<0>(std::get<1>(a))) <
+             std::tie(std::get<0>(b2), std::get<0>(std::get<1>(b2)));
+    };
+    pbbs::sample_sort_inplace(dir.slice(), less);
+
+    // run starts by source
+    auto is_start = pbbslib::make_sequence<bool>(dir.size(), [&](size_t i) {
+      return i == 0 || std::get<0>(dir[i]) != std::get<0>(dir[i - 1]);
+    });
+    auto starts = pbbs::pack_index<size_t>(is_start);
+
+    auto delta = pbbs::sequence<long>(starts.size(), (long)0);
+    parallel_for(0, starts.size(), [&](size_t r) {
+      size_t lo = starts[r];
+      size_t hi = (r + 1 == starts.size()) ? dir.size() : starts[r + 1];
+      uintE src = std::get<0>(dir[lo]);
+      uintE old_deg = degrees[src];
+      edge_type* old = nghs[src].get();
+
+      // merge old (sorted) with the batch run (sorted, may hold dups)
+      size_t cap = old_deg + (hi - lo);
+      block_ptr merged_block = make_block(std::max<size_t>(cap, 1));
+      edge_type* merged = merged_block.get();
+      size_t oi = 0, bi = lo, k = 0;
+      while (oi < old_deg || bi < hi) {
+        uintE ov = (oi < old_deg) ? std::get<0>(old[oi]) : UINT_E_MAX;
+        uintE bv = (bi < hi) ? std::get<0>(std::get<1>(dir[bi])) : UINT_E_MAX;
+        if (ov < bv) {
+          merged[k++] = old[oi++];
+        } else if (bv < ov) {
+          if (insert) merged[k++] = std::get<1>(dir[bi]);
+          while (bi < hi && std::get<0>(std::get<1>(dir[bi])) == bv) bi++;
+        } else {  // present in both
+          if (insert) merged[k++] = old[oi];  // already present; keep
+          // on delete: drop it
+          oi++;
+          while (bi < hi && std::get<0>(std::get<1>(dir[bi])) == bv) bi++;
+        }
+      }
+      delta[r] = (long)k - (long)old_deg;
+      degrees[src] = (uintE)k;
+      // install the fresh block; the old one is freed when the last
+      // snapshot holding it goes away
+      nghs[src] = std::move(merged_block);
+    }, 1);
+
+    long total = 0;
+    for (size_t r = 0; r < delta.size(); r++) total += delta[r];
+    m = (size_t)((long)m + total);
+    return (size_t)(insert ? total : -total);
+  }
+
+  size_t insert_batch(edge_array<W>& batch) {
+    return apply_batch(batch, true);
+  }
+  size_t delete_batch(edge_array<W>& batch) {
+    return apply_batch(batch, false);
+  }
+
+  // ====================== Lazy (tombstone) deletion ======================
+  //
+  // delete_batch rewrites every touched vertex; during delete-heavy
+  // periods most vertices are rewritten repeatedly for a handful of
+  // removals each. delete_batch_lazy instead queues deletions per vertex
+  // and only rewrites a vertex once its tombstone density passes
+  // kCompactThreshold of its degree, amortizing the rewrite across
+  // batches. Visibility contract: a lazily deleted edge may still be
+  // observed by traversals until its vertex compacts (live_degree()
+  // reports the post-deletion degree immediately); readers that need
+  // strict visibility call flush_deletions() first.
+
+  static constexpr double kCompactThreshold = 0.25;
+  std::vector<std::vector<uintE>> tombstones;
+
+  void ensure_tombstones() {
+    if (tombstones.empty()) tombstones.resize(n);
+  }
+
+  inline uintE live_degree(uintE v) const {
+    uintE pend = tombstones.empty() ? 0 : (uintE)tombstones[v].size();
+    return degrees[v] - pend;
+  }
+
+  // Merges v's queued tombstones out of its adjacency block.
+  void compact_vertex(uintE v) {
+    auto& dead = tombstones[v];
+    if (dead.empty()) return;
+    std::sort(dead.begin(), dead.end());
+    uintE old_deg = degrees[v];
+    edge_type* old = nghs[v].get();
+    block_ptr fresh = make_block(std::max<size_t>(old_deg, 1));
+    edge_type* out = fresh.get();
+    size_t k = 0, di = 0;
+    for (size_t i = 0; i < old_deg; i++) {
+      uintE id = std::get<0>(old[i]);
+      while (di < dead.size() && dead[di] < id) di++;
+      if (di < dead.size() && dead[di] == id) continue;  // tombstoned
+      out[k++] = old[i];
+    }
+    m -= (old_deg - k);
+    degrees[v] = (uintE)k;
+    nghs[v] = std::move(fresh);
+    dead.clear();
+  }
+
+  // Queues the (symmetrized) deletions; compacts only vertices whose
+  // tombstone density passes the threshold.
+  void delete_batch_lazy(edge_array<W>& batch) {
+    ensure_tombstones();
+    size_t b = batch.non_zeros;
+    for (size_t i = 0; i < b; i++) {
+      auto [u, v, w] = batch.E[i];
+      (void)w;
+      tombstones[u].push_back(v);
+      tombstones[v].push_back(u);
+    }
+    for (size_t i = 0; i < b; i++) {
+      auto [u, v, w] = batch.E[i];
+      (void)w;
+      for (uintE x : {u, v}) {
+        if (!tombstones[x].empty() &&
+            (double)tombstones[x].size() >=
+                kCompactThreshold * std::max<uintE>(degrees[x], 1)) {
+          compact_vertex(x);
+        }
+      }
+    }
+  }
+
+  // Weight-only fast path: overwrites weights of existing edges in place
+  // (both directions) without touching topology or reallocating blocks.
+  // Note: blocks pinned by snapshots observe the new weights too -- weight
+  // updates are not versioned (the split-storage design point).
+  size_t update_weights(edge_array<W>& batch) {
+    auto updated = pbbs::sequence<size_t>(batch.non_zeros, (size_t)0);
+    parallel_for(0, batch.non_zeros, [&](size_t i) {
+      auto [u, v, w] = batch.E[i];
+      size_t ct = 0;
+      for (auto [src, dst] : {std::make_pair(u, v), std::make_pair(v, u)}) {
+        edge_type* arr = nghs[src].get();
+        size_t lo = 0, hi = degrees[src];
+        while (lo < hi) {
+          size_t mid = lo + (hi - lo) / 2;
+          if (std::get<0>(arr[mid]) < dst) lo = mid + 1;
+          else hi = mid;
+        }
+        if (lo < degrees[src] && std::get<0>(arr[lo]) == dst) {
+          std::get<1>(arr[lo]) = w;
+          ct++;
+        }
+      }
+      updated[i] = ct;
+    });
+    return pbbslib::reduce_add(updated);
+  }
+
+  // Applies every queued deletion (strict visibility point).
+  void flush_deletions() {
+    if (tombstones.empty()) return;
+    parallel_for(0, n, [&](size_t v) {
+      if (!tombstones[v].empty()) compact_vertex((uintE)v);
+    }, 1);
+  }
+
+  void del() {
+    parallel_for(0, n, [&](size_t i) { nghs[i].reset(); });
+  }
+};
+
+}  // namespace gbbs
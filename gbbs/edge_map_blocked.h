@@ -4,6 +4,7 @@
 #include "edge_map_utils.h"
 #include "flags.h"
 #include "vertex_subset.h"
+#include "gbbs/pbbslib/dyn_arr.h"
 #include "pbbslib/list_allocator.h"
 #include "pbbslib/binary_search.h"
 
@@ -313,6 +314,286 @@ void alloc_init(Graph& G) {
 // Call this to clean up at the end of a program that invokes `alloc_init`.
 void alloc_finish();
 
+// A frontier emitted as a sequence of worker-local output blocks. Entries can
+// be iterated in place with map(), avoiding the compaction copy that
+// edgeMapChunked performs to produce a flat vertexSubset; callers that need a
+// standard frontier (e.g., to feed the next edgeMap) call to_vertex_subset(),
+// which materializes and releases the blocks.
+template <class data>
+struct blocked_frontier {
+  using S = typename vertexSubsetData<data>::S;
+
+  size_t n;  // number of vertices in the graph
+  size_t m;  // number of entries across all blocks
+  pbbs::sequence<em_data_block*> blocks;
+
+  blocked_frontier(size_t n, pbbs::sequence<em_data_block*>&& blocks)
+      : n(n), blocks(std::move(blocks)) {
+    auto size_f = [&](size_t i) { return this->blocks[i]->block_size; };
+    auto size_im = pbbslib::make_sequence<size_t>(this->blocks.size(), size_f);
+    m = pbbslib::reduce_add(size_im);
+  }
+
+  size_t size() const { return m; }
+  bool isEmpty() const { return m == 0; }
+
+  // Applies f to every (vertex, data) entry, in parallel over blocks.
+  template <class F>
+  void map(F f) {
+    parallel_for(0, blocks.size(), [&](size_t b) {
+      em_data_block* block = blocks[b];
+      auto block_data = (S*)block->data;
+      for (size_t i = 0; i < block->block_size; i++) {
+        f(block_data[i]);
+      }
+    }, 1);
+  }
+
+  // Materializes a flat vertexSubset and returns the blocks to the allocator.
+  vertexSubsetData<data> to_vertex_subset() {
+    auto block_offsets = pbbs::sequence<size_t>(
+        blocks.size(), [&](size_t i) { return blocks[i]->block_size; });
+    size_t output_size = pbbslib::scan_add_inplace(block_offsets.slice());
+    vertexSubsetData<data> ret(n);
+    if (output_size > 0) {
+      auto out = sequence<S>(output_size);
+      parallel_for(0, blocks.size(), [&](size_t b) {
+        em_data_block* block = blocks[b];
+        auto block_data = (S*)block->data;
+        size_t off = block_offsets[b];
+        for (size_t i = 0; i < block->block_size; i++) {
+          out[off + i] = block_data[i];
+        }
+        data_block_allocator::free(block);
+      }, 1);
+      ret = vertexSubsetData<data>(n, std::move(out));
+    } else {
+      del();
+    }
+    blocks.clear();
+    return std::move(ret);
+  }
+
+  // Returns the blocks without materializing.
+  void del() {
+    parallel_for(0, blocks.size(),
+                 [&](size_t b) { data_block_allocator::free(blocks[b]); });
+  }
+};
+
+// A work-stealing-aware variant of edgeMapChunked: output blocks are keyed by
+// the scheduler worker actually running each group (pbbs::worker_id()) rather
+// than by group id, so however groups are stolen, every append lands in a
+// worker-private arena with no shared cache lines. The frontier is returned
+// as a blocked_frontier view over those arenas rather than compacted.
+template <class data  /* data associated with vertices in the output vertex_subset */,
+          class Graph /* graph type */,
+          class VS    /* vertex_subset type */,
+          class F     /* edgeMap struct */>
+inline blocked_frontier<data> edgeMapWorkerLocal(Graph& G, VS& indices, F& f,
+                                                 const flags fl = 0) {
+  using S = typename vertexSubsetData<data>::S;
+  size_t n = indices.n;
+
+  auto block_f = [&](size_t i) -> size_t {
+    uintE vtx_id = indices.vtx(i);
+    auto nghs = (fl & in_edges) ? G.get_vertex(vtx_id).in_neighbors() : G.get_vertex(vtx_id).out_neighbors();
+    return nghs.get_num_blocks();
+  };
+  auto block_imap = pbbslib::make_sequence<uintE>(indices.size(), block_f);
+
+  // 1. Compute the number of blocks each vertex is subdivided into.
+  auto vertex_offs = sequence<uintE>(indices.size() + 1);
+  par_for(0, indices.size(), pbbslib::kSequentialForThreshold,
+          [&](size_t i) { vertex_offs[i] = block_imap[i]; });
+  vertex_offs[indices.size()] = 0;
+  size_t num_blocks = pbbslib::scan_add_inplace(vertex_offs.slice());
+
+  auto blocks = sequence<block>(num_blocks);
+  auto degrees = sequence<uintT>(num_blocks);
+
+  // 2. Write each block to blocks and scan degree array.
+  par_for(0, indices.size(), pbbslib::kSequentialForThreshold, [&](size_t i) {
+    size_t vtx_off = vertex_offs[i];
+    size_t num_vertex_blocks = vertex_offs[i + 1] - vtx_off;
+    uintE vtx_id = indices.vtx(i);
+    auto neighbors = (fl & in_edges) ? G.get_vertex(vtx_id).in_neighbors() : G.get_vertex(vtx_id).out_neighbors();
+    par_for(0, num_vertex_blocks, pbbslib::kSequentialForThreshold, [&](size_t j) {
+      blocks[vtx_off + j] = block(i, j);
+      degrees[vtx_off + j] = neighbors.block_degree(j);
+    });
+  });
+  pbbslib::scan_add_inplace(degrees.slice(), pbbslib::fl_scan_inclusive);
+  vertex_offs.clear();
+  size_t outEdgeCount = degrees[num_blocks - 1];
+
+  // 3. Group the blocks as in edgeMapChunked, but key the output arenas by
+  // worker id.
+  size_t edge_block_size_guess = pbbs::num_blocks(outEdgeCount, num_workers() << 3);
+  size_t edge_block_size = std::max(kEMBlockSize, edge_block_size_guess);
+  size_t n_groups = pbbs::num_blocks(outEdgeCount, edge_block_size);
+
+  auto our_emhelper = emhelper<data, Graph>(num_workers());
+
+  auto lt = [](const uintT& l, const uintT& r) { return l < r; };
+  parallel_for(0, n_groups, [&](size_t group_id) {
+    size_t start_off = group_id * edge_block_size;
+    size_t our_start = pbbslib::binary_search(degrees, start_off, lt);
+    size_t our_end;
+    if (group_id < (n_groups - 1)) {
+      size_t next_start_off = (group_id + 1) * edge_block_size;
+      our_end = pbbslib::binary_search(degrees, next_start_off, lt);
+    } else {
+      our_end = num_blocks;
+    }
+
+    if (our_start != our_end && our_start != num_blocks) {
+      for (size_t work_id = our_start; work_id < our_end; work_id++) {
+        // The worker executing this group owns the arena; stolen groups
+        // simply append to the thief's arena instead.
+        size_t our_worker = static_cast<size_t>(worker_id());
+        em_data_block* out_block =
+            our_emhelper.get_block_and_offset_for_group(our_worker);
+        size_t offset = out_block->block_size;
+        auto out_block_data = (S*)out_block->data;
+        auto g = get_emblock_gen<data>(out_block_data);
+
+        auto& block = blocks[work_id];
+        uintE vtx_id = indices.vtx(block.id);
+        auto neighbors = (fl & in_edges) ? G.get_vertex(vtx_id).in_neighbors() : G.get_vertex(vtx_id).out_neighbors();
+        size_t num_in = neighbors.decode_block(offset, block.block_num, f, g);
+        out_block->block_size += num_in;
+      }
+    }
+  }, 1);
+
+  sequence<em_data_block*> all_blocks = our_emhelper.get_all_blocks();
+  our_emhelper.del();
+  blocks.clear();
+  degrees.clear();
+  return blocked_frontier<data>(n, std::move(all_blocks));
+}
+
+// A pipelined variant of the blocked sparse traversal for latency-sensitive
+// workloads. Each group decodes its work blocks directly into a growable
+// per-group buffer of live entries, fusing output generation, filtering, and
+// next-frontier construction into a single streamed pass: the O(outEdgeCount)
+// intermediate of edgeMapSparse is never materialized, no block allocator is
+// involved, and each emitted entry is copied exactly once (group buffer ->
+// final frontier). Selected via the `pipelined` flag in edgeMapData.
+template <class data  /* data associated with vertices in the output vertex_subset */,
+          class Graph /* graph type */,
+          class VS    /* vertex_subset type */,
+          class F     /* edgeMap struct */>
+inline vertexSubsetData<data> edgeMapPipelined(Graph& G, VS& indices, F& f,
+                                               const flags fl) {
+  if (fl & no_output) {
+    return edgeMapSparseNoOutput<data, Graph, VS, F>(G, indices, f, fl);
+  }
+  using S = typename vertexSubsetData<data>::S;
+  using vertex = typename Graph::vertex;
+  constexpr size_t work_block_size = vertex::getInternalBlockSize();
+  size_t n = indices.n;
+
+  auto block_f = [&](size_t i) -> size_t {
+    uintE vtx_id = indices.vtx(i);
+    auto nghs = (fl & in_edges) ? G.get_vertex(vtx_id).in_neighbors() : G.get_vertex(vtx_id).out_neighbors();
+    return nghs.get_num_blocks();
+  };
+  auto block_imap = pbbslib::make_sequence<uintE>(indices.size(), block_f);
+
+  // 1. Compute the number of blocks each vertex is subdivided into.
+  auto vertex_offs = sequence<uintE>(indices.size() + 1);
+  par_for(0, indices.size(), pbbslib::kSequentialForThreshold,
+          [&](size_t i) { vertex_offs[i] = block_imap[i]; });
+  vertex_offs[indices.size()] = 0;
+  size_t num_blocks = pbbslib::scan_add_inplace(vertex_offs.slice());
+
+  auto blocks = sequence<block>(num_blocks);
+  auto degrees = sequence<uintT>(num_blocks);
+
+  // 2. Write each block to blocks and scan degree array.
+  par_for(0, indices.size(), pbbslib::kSequentialForThreshold, [&](size_t i) {
+    size_t vtx_off = vertex_offs[i];
+    size_t num_vertex_blocks = vertex_offs[i + 1] - vtx_off;
+    uintE vtx_id = indices.vtx(i);
+    auto neighbors = (fl & in_edges) ? G.get_vertex(vtx_id).in_neighbors() : G.get_vertex(vtx_id).out_neighbors();
+    par_for(0, num_vertex_blocks, pbbslib::kSequentialForThreshold, [&](size_t j) {
+      blocks[vtx_off + j] = block(i, j);  // j-th block of the i-th vertex.
+      degrees[vtx_off + j] = neighbors.block_degree(j);
+    });
+  });
+  pbbslib::scan_add_inplace(degrees.slice(), pbbslib::fl_scan_inclusive);
+  vertex_offs.clear();
+  size_t outEdgeCount = degrees[num_blocks - 1];
+
+  // 3. Group the blocks (same strategy as edgeMapChunked).
+  size_t edge_block_size_guess = pbbs::num_blocks(outEdgeCount, num_workers() << 3);
+  size_t edge_block_size = std::max(kEMBlockSize, edge_block_size_guess);
+  size_t n_groups = pbbs::num_blocks(outEdgeCount, edge_block_size);
+
+  auto buffers = pbbs::new_array<pbbslib::dyn_arr<S>>(n_groups);
+
+  // 4. Each group streams its work blocks into its own growing buffer of
+  // live entries; decode writes land directly in the buffer, so there is no
+  // separate flush or compaction step.
+  auto lt = [](const uintT& l, const uintT& r) { return l < r; };
+  parallel_for(0, n_groups, [&](size_t group_id) {
+    size_t start_off = group_id * edge_block_size;
+    size_t our_start = pbbslib::binary_search(degrees, start_off, lt);
+    size_t our_end;
+    if (group_id < (n_groups - 1)) {
+      size_t next_start_off = (group_id + 1) * edge_block_size;
+      our_end = pbbslib::binary_search(degrees, next_start_off, lt);
+    } else {
+      our_end = num_blocks;
+    }
+
+    if (our_start != our_end && our_start != num_blocks) {
+      auto& buf = buffers[group_id];
+      for (size_t work_id = our_start; work_id < our_end; work_id++) {
+        // Guarantee room for the worst case (every item in the work block
+        // is written out) before decoding into the buffer tail.
+        buf.resize(work_block_size);
+        auto g = get_emblock_gen<data>(buf.A);
+
+        auto& block = blocks[work_id];
+        uintE vtx_id = indices.vtx(block.id);
+        auto neighbors = (fl & in_edges) ? G.get_vertex(vtx_id).in_neighbors() : G.get_vertex(vtx_id).out_neighbors();
+        size_t num_in = neighbors.decode_block(buf.size, block.block_num, f, g);
+        buf.size += num_in;
+      }
+    }
+  }, 1);
+
+  // 5. Assemble the next frontier with one scan over the groups.
+  auto group_offs = sequence<size_t>(n_groups + 1);
+  par_for(0, n_groups, pbbslib::kSequentialForThreshold,
+          [&](size_t i) { group_offs[i] = buffers[i].size; });
+  group_offs[n_groups] = 0;
+  size_t output_size = pbbslib::scan_add_inplace(group_offs.slice());
+
+  vertexSubsetData<data> ret(n);
+  if (output_size > 0) {
+    auto out = sequence<S>(output_size);
+    parallel_for(0, n_groups, [&](size_t group_id) {
+      auto& buf = buffers[group_id];
+      size_t off = group_offs[group_id];
+      for (size_t i = 0; i < buf.size; i++) {
+        out[off + i] = buf.A[i];
+      }
+    }, 1);
+    ret = vertexSubsetData<data>(n, std::move(out));
+  }
+
+  parallel_for(0, n_groups, [&](size_t i) { buffers[i].del(); });
+  pbbs::free_array(buffers);
+  blocks.clear();
+  degrees.clear();
+  group_offs.clear();
+  return std::move(ret);
+}
+
 template <class data  /* data associated with vertices in the output vertex_subset */,
           class Graph /* graph type */,
           class VS    /* vertex_subset type */,
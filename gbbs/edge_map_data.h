@@ -32,6 +32,7 @@
 #include <string>
 
 #include "bridge.h"
+#include "io.h"
 #include "edge_map_utils.h"
 #include "edge_map_blocked.h"
 #include "flags.h"
@@ -39,6 +40,18 @@
 
 namespace gbbs {
 
+namespace detail {
+// Graphs that expose edge_range_bytes (the flat CSR representations) can
+// serve the semi-external prefetch pass; packed/filtered views cannot.
+template <class G, class = void>
+struct has_edge_range_bytes : std::false_type {};
+template <class G>
+struct has_edge_range_bytes<
+    G, std::void_t<decltype(std::declval<G&>().edge_range_bytes(
+           (uintE)0, false))>> : std::true_type {};
+}  // namespace detail
+
+
 template <class Data  /* per-vertex data in the emitted vertex_subset */,
           class Graph /* graph type */,
           class VS    /* vertex_subset type */,
@@ -48,6 +61,19 @@ inline vertexSubsetData<Data> edgeMapDense(Graph& GA, VS& vertexSubset, F& f,
   using D = typename vertexSubsetData<Data>::D;
   size_t n = GA.n;
   auto dense_par = fl & dense_parallel;
+  // Hub vertices whose degree exceeds this cutover get intra-vertex
+  // parallelism even without the dense_parallel flag: a single 100M-degree
+  // vertex processed sequentially leaves the rest of the machine idle at the
+  // tail of the pass. The cutover adapts to the machine -- a vertex holding
+  // more than a worker's fair share (by a factor of 8) of the total edge work
+  // is split across workers.
+  constexpr size_t kMinHubDegree = 10000;
+  size_t degree_cutover = std::max(static_cast<size_t>(GA.m / (num_workers() << 3)),
+                                   kMinHubDegree);
+  // Grain for the vertex loop: calibrated at runtime per instantiation
+  // rather than the historical constant 2048, which was tuned for one
+  // machine (see granularity_tuner in pbbslib/parallel.h).
+  static pbbs::granularity_tuner dense_tuner;
   if (should_output(fl)) {
     auto next = sequence<D>(n,
       [&] (size_t i) {
@@ -55,15 +81,18 @@ inline vertexSubsetData<Data> edgeMapDense(Graph& GA, VS& vertexSubset, F& f,
         else return std::make_tuple<uintE, Data>(0, Data());
     });
     auto g = get_emdense_gen<Data>(next.begin());
-    parallel_for(
-        0, n,
-        [&](size_t v) {
-          if (f.cond(v)) {
-            auto neighbors = (fl & in_edges) ? GA.get_vertex(v).out_neighbors() : GA.get_vertex(v).in_neighbors();
-            neighbors.decodeBreakEarly(vertexSubset, f, g, dense_par);
-          }
-        },
-        (fl & fine_parallel) ? 1 : 2048);
+    auto body = [&](size_t v) {
+      if (f.cond(v)) {
+        auto neighbors = (fl & in_edges) ? GA.get_vertex(v).out_neighbors() : GA.get_vertex(v).in_neighbors();
+        neighbors.decodeBreakEarly(vertexSubset, f, g,
+            dense_par || neighbors.get_degree() >= degree_cutover);
+      }
+    };
+    if (fl & fine_parallel) {
+      parallel_for(0, n, body, 1);
+    } else {
+      pbbs::tuned_parallel_for(dense_tuner, 0, n, body);
+    }
     return vertexSubsetData<Data>(n, std::move(next));
   } else {
     auto g = get_emdense_nooutput_gen<Data>();
@@ -71,7 +100,8 @@ inline vertexSubsetData<Data> edgeMapDense(Graph& GA, VS& vertexSubset, F& f,
                  [&](size_t v) {
                    if (f.cond(v)) {
                      auto neighbors = (fl & in_edges) ? GA.get_vertex(v).out_neighbors() : GA.get_vertex(v).in_neighbors();
-                     neighbors.decodeBreakEarly(vertexSubset, f, g, dense_par);
+                     neighbors.decodeBreakEarly(vertexSubset, f, g,
+                         dense_par || neighbors.get_degree() >= degree_cutover);
                    }
                  },
                  (fl & fine_parallel) ? 1 : 2048);
@@ -117,23 +147,105 @@ inline vertexSubsetData<Data> edgeMapDenseForward(Graph& GA, VS& vertexSubset, F
   }
 }
 
-// Decides on sparse or dense base on number of nonzeros in the active vertices.
+// The default direction policy: reproduces the classic fixed-threshold
+// heuristic (go dense when |frontier| + sum of out-degrees exceeds m/20).
+// Stateless; a fresh instance per edgeMap call behaves identically to the
+// historical inline heuristic.
+struct default_direction_policy {
+  size_t dense_threshold;
+
+  default_direction_policy(size_t num_edges, intT threshold = -1)
+      : dense_threshold((threshold == -1) ? num_edges / 20
+                                          : static_cast<size_t>(threshold)) {}
+
+  // Called before the frontier's out-degree sum is computed. Returning true
+  // keeps an already-dense, large frontier dense and skips the (potentially
+  // expensive) degree reduction.
+  bool stay_dense(size_t num_vertices, size_t frontier_size,
+                  bool is_dense) const {
+    return is_dense && frontier_size > num_vertices / 10;
+  }
+
+  // The sparse/dense decision once the out-degree sum is known.
+  bool go_dense(size_t frontier_size, size_t out_degrees) const {
+    return frontier_size + out_degrees > dense_threshold;
+  }
+
+  // Feedback hook invoked with the size of the emitted frontier; the default
+  // policy is stateless and ignores it.
+  void update(size_t next_frontier_size) {}
+};
+
+// An adaptive direction policy that keeps a decaying average of the frontier
+// growth rate across iterations and scales the out-degree estimate by it.
+// On power-law graphs where the fixed m/20 threshold switches dense several
+// iterations late (or early), the growth signal lets the switch happen as the
+// frontier starts exploding rather than after. Intended to be constructed
+// once per traversal (e.g., per BFS source) and passed to every edgeMap call
+// in that traversal.
+struct adaptive_direction_policy {
+  size_t dense_threshold;
+  size_t last_frontier_size;
+  double avg_growth;
+  // Weight on the most recent growth observation.
+  static constexpr double kGrowthDecay = 0.5;
+  // Bound on the tracked growth rate (and its inverse).
+  static constexpr double kMaxGrowth = 64.0;
+
+  adaptive_direction_policy(size_t num_edges, intT threshold = -1)
+      : dense_threshold((threshold == -1) ? num_edges / 20
+                                          : static_cast<size_t>(threshold)),
+        last_frontier_size(0),
+        avg_growth(1.0) {}
+
+  bool stay_dense(size_t num_vertices, size_t frontier_size,
+                  bool is_dense) const {
+    return is_dense && frontier_size > num_vertices / 10;
+  }
+
+  bool go_dense(size_t frontier_size, size_t out_degrees) const {
+    // A growing frontier will likely cross the threshold next iteration
+    // anyway; weighting out_degrees by the observed growth switches one
+    // iteration earlier (and symmetrically, a shrinking frontier switches
+    // back to sparse earlier).
+    size_t predicted = static_cast<size_t>(out_degrees * avg_growth);
+    return frontier_size + predicted > dense_threshold;
+  }
+
+  void update(size_t next_frontier_size) {
+    if (last_frontier_size > 0 && next_frontier_size > 0) {
+      double growth = static_cast<double>(next_frontier_size) /
+                      static_cast<double>(last_frontier_size);
+      avg_growth = kGrowthDecay * growth + (1 - kGrowthDecay) * avg_growth;
+      // Clamp so a few pathological observations cannot dominate the
+      // prediction (or overflow the size_t cast in go_dense).
+      avg_growth = std::min(std::max(avg_growth, 1.0 / kMaxGrowth), kMaxGrowth);
+    }
+    last_frontier_size = next_frontier_size;
+  }
+};
+
+// edgeMapData with a user-supplied direction policy. The policy decides
+// sparse vs. dense (see default_direction_policy for the expected interface)
+// and receives the emitted frontier size as feedback after each call.
 template <
     class Data /* data associated with vertices in the output vertex_subset */,
     class Graph /* graph type */, class VS /* vertex_subset type */,
-    class F /* edgeMap struct */>
-inline vertexSubsetData<Data> edgeMapData(Graph& GA, VS& vs, F f,
-                                          intT threshold = -1,
+    class F /* edgeMap struct */, class P /* direction policy */,
+    typename std::enable_if<!std::is_integral<P>::value, int>::type = 0>
+inline vertexSubsetData<Data> edgeMapData(Graph& GA, VS& vs, F f, P& policy,
                                           const flags& fl = 0) {
-  size_t numVertices = GA.n, numEdges = GA.m, m = vs.numNonzeros();
-  size_t dense_threshold = threshold;
-  if (threshold == -1) dense_threshold = numEdges / 20;
+  size_t numVertices = GA.n, m = vs.numNonzeros();
   if (vs.size() == 0) return vertexSubsetData<Data>(numVertices);
 
-  if (vs.isDense && vs.size() > numVertices / 10) {
-    return (fl & dense_forward)
+  if (policy.stay_dense(numVertices, vs.size(), vs.isDense)) {
+    auto vs_out = (fl & dense_forward)
                ? edgeMapDenseForward<Data, Graph, VS, F>(GA, vs, f, fl)
                : edgeMapDense<Data, Graph, VS, F>(GA, vs, f, fl);
+    // no_output calls return empty subsets; do not feed them back as
+    // observed frontier sizes.
+    if (should_output(fl)) policy.update(vs_out.size());
+    return vs_out;
   }
 
   size_t out_degrees = 0;
@@ -150,20 +262,58 @@ inline vertexSubsetData<Data> edgeMapData(Graph& GA, VS& vs, F f,
     vs.set_out_degrees(out_degrees);
   }
 
-  if (out_degrees == 0) return vertexSubsetData<Data>(numVertices);
-  if (m + out_degrees > dense_threshold && !(fl & no_dense)) {
+  if (out_degrees == 0) {
+    if (should_output(fl)) policy.update(0);
+    return vertexSubsetData<Data>(numVertices);
+  }
+  if (policy.go_dense(m, out_degrees) && !(fl & no_dense)) {
+    if constexpr (std::is_same<typename VS::S, uintE>::value) {
+      // pull-phase membership tests miss for most in-neighbors; a blocked
+      // bloom over a small frontier answers those misses cache-resident
+      if (vs.size() * 16 < numVertices) vs.build_frontier_summary();
+    }
     vs.toDense();
-    return (fl & dense_forward)
+    auto vs_out = (fl & dense_forward)
                ? edgeMapDenseForward<Data, Graph, VS, F>(GA, vs, f, fl)
                : edgeMapDense<Data, Graph, VS, F>(GA, vs, f, fl);
+    if (should_output(fl)) policy.update(vs_out.size());
+    return vs_out;
   } else {
-    auto vs_out = edgeMapChunked<Data, Graph, VS, F>(GA, vs, f, fl);
+    if constexpr (detail::has_edge_range_bytes<Graph>::value)
+    if (fl & prefetch_edges) {
+      // semi-external: issue readahead for exactly the edge blocks this
+      // frontier touches, computed from the offsets before the traversal
+      vs.toSparse();
+      parallel_for(0, vs.size(), [&](size_t i) {
+        uintE v = vs.vtx(i);
+        auto range = GA.edge_range_bytes(v, (fl & in_edges) != 0);
+        if (range.second > 0) {
+          gbbs_io::advise_willneed(range.first, range.second);
+        }
+      }, 512);
+    }
+    auto vs_out = (fl & pipelined)
+               ? edgeMapPipelined<Data, Graph, VS, F>(GA, vs, f, fl)
+               : edgeMapChunked<Data, Graph, VS, F>(GA, vs, f, fl);
 //    auto vs_out = edgeMapBlocked<Data, Graph, VS, F>(GA, vs, f, fl);
 //    auto vs_out = edgeMapSparse<Data, Graph, VS, F>(GA, vs, f, fl);
+    if (should_output(fl)) policy.update(vs_out.size());
     return vs_out;
   }
 }
 
+// Decides on sparse or dense base on number of nonzeros in the active vertices.
+template <
+    class Data /* data associated with vertices in the output vertex_subset */,
+    class Graph /* graph type */, class VS /* vertex_subset type */,
+    class F /* edgeMap struct */>
+inline vertexSubsetData<Data> edgeMapData(Graph& GA, VS& vs, F f,
+                                          intT threshold = -1,
+                                          const flags& fl = 0) {
+  auto policy = default_direction_policy(GA.m, threshold);
+  return edgeMapData<Data, Graph, VS, F>(GA, vs, f, policy, fl);
+}
+
 // Regular edgeMap, where no extra data is stored per vertex.
 template <class Graph /* graph type */, class VS /* vertex_subset type */,
           class F /* edgeMap struct */>
@@ -172,6 +322,51 @@ inline vertexSubset edgeMap(Graph& GA, VS& vs, F f, intT threshold = -1,
   return edgeMapData<pbbslib::empty>(GA, vs, f, threshold, fl);
 }
 
+// Wraps an edgeMap functor so that a vertex function is applied inline,
+// immediately after update/updateAtomic succeeds for a destination.
+template <class F /* edgeMap struct */, class A /* apply function */>
+struct fused_apply_f {
+  F f;
+  A apply_f;
+  fused_apply_f(F f, A apply_f) : f(f), apply_f(apply_f) {}
+
+  template <class W>
+  inline bool update(const uintE& s, const uintE& d, const W& wgh) {
+    if (f.update(s, d, wgh)) {
+      apply_f(d);
+      return true;
+    }
+    return false;
+  }
+
+  template <class W>
+  inline bool updateAtomic(const uintE& s, const uintE& d, const W& wgh) {
+    if (f.updateAtomic(s, d, wgh)) {
+      apply_f(d);
+      return true;
+    }
+    return false;
+  }
+
+  inline bool cond(const uintE& d) { return f.cond(d); }
+};
+
+// Fused edgeMap + vertexMap: applies apply_f to each vertex emitted into the
+// output subset at the moment its update succeeds, while the vertex is hot in
+// cache, instead of re-reading the materialized subset in a second pass.
+// Relies on the same single-success discipline edgeMap already requires for
+// output dedup (updateAtomic returns true at most once per destination), so
+// apply_f runs exactly once per emitted vertex. apply_f must be safe to call
+// concurrently with updates to other vertices.
+template <class Data = pbbslib::empty, class Graph, class VS, class F, class A>
+inline vertexSubsetData<Data> edgeMapThenVertexMap(Graph& GA, VS& vs, F f,
+                                                   A apply_f,
+                                                   intT threshold = -1,
+                                                   const flags& fl = 0) {
+  auto fused = fused_apply_f<F, A>(f, apply_f);
+  return edgeMapData<Data>(GA, vs, fused, threshold, fl);
+}
+
 // Adds vertices to a vertexSubset vs.
 // Caller must ensure that every v in new_verts is not already in vs
 // Note: Mutates the given vertexSubset.
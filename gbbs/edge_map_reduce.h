@@ -29,6 +29,7 @@
 #include "vertex_subset.h"
 
 #include <type_traits>
+#include <vector>
 
 namespace gbbs {
 
@@ -121,8 +122,10 @@ inline vertexSubsetData<O> edgeMapCount_sparse(Graph& GA, VS& vs,
 
   auto key_f = [&](size_t i) -> uintE { return oneHop.vtx(i); };
   auto get_key = pbbslib::make_sequence<uintE>(oneHop.size(), key_f);
-  auto res =
-      histogram<std::tuple<uintE, O> >(get_key, oneHop.size(), apply_f, ht);
+  // keys are vertex ids: declare the bound so a frontier whose
+  // neighborhood span covers the graph counts directly instead of hashing
+  auto res = histogram<std::tuple<uintE, O> >(get_key, oneHop.size(),
+                                              apply_f, ht, vs.n);
   return vertexSubsetData<O>(vs.n, std::move(res));
 }
 
@@ -555,6 +558,102 @@ struct EdgeMap {
     }
   }
 
+  // ======================= Batched Edge Map Count ==========================
+
+  // Processes a batch of (typically small) vertex subsets in one fused
+  // histogram pass. Each subset's one-hop neighborhood is written into a
+  // single combined key array with the subset index packed into the high
+  // bits, so the hash-table setup and counting-sort passes are paid once for
+  // the whole batch rather than once per subset. apply_f has the same
+  // signature as in edgeMapCount and is invoked with per-subset counts;
+  // result i corresponds to subsets[i]. Intended for pipelines that issue
+  // many small nghCount calls where setup dominates the actual counting.
+  template <class O, class Apply>
+  inline std::vector<vertexSubsetData<O>> edgeMapCountBatch(
+      std::vector<vertexSubset*>& subsets, Apply& apply_f,
+      const flags fl = 0) {
+    size_t n = G.n;
+    size_t num_subsets = subsets.size();
+    std::vector<vertexSubsetData<O>> results;
+
+    // 1. Compute per-(subset, vertex) degree offsets.
+    auto subset_offs = sequence<size_t>(num_subsets + 1);
+    for (size_t i = 0; i < num_subsets; i++) {
+      subsets[i]->toSparse();
+      subset_offs[i] = subsets[i]->size();
+    }
+    subset_offs[num_subsets] = 0;
+    pbbslib::scan_add_inplace(subset_offs.slice());
+    size_t total_vtxs = subset_offs[num_subsets];
+
+    auto degrees = sequence<size_t>(total_vtxs + 1);
+    parallel_for(0, num_subsets, [&](size_t i) {
+      size_t off = subset_offs[i];
+      auto& vs = *subsets[i];
+      par_for(0, vs.size(), pbbslib::kSequentialForThreshold, [&](size_t j) {
+        auto v = G.get_vertex(vs.vtx(j));
+        degrees[off + j] = (fl & in_edges) ? v.in_degree() : v.out_degree();
+      });
+    });
+    degrees[total_vtxs] = 0;
+    size_t total_deg = pbbslib::scan_add_inplace(degrees.slice());
+
+    // 2. Write composite keys (subset index in the high bits).
+    auto keys = sequence<uint64_t>::no_init(total_deg);
+    parallel_for(0, num_subsets, [&](size_t i) {
+      size_t off = subset_offs[i];
+      auto& vs = *subsets[i];
+      uint64_t tag = static_cast<uint64_t>(i) << 32;
+      par_for(0, vs.size(), 1, [&](size_t j) {
+        size_t k = degrees[off + j];
+        auto map_f = [&](const uintE& u, const uintE& v, const W& wgh) {
+          keys[k++] = tag | static_cast<uint64_t>(v);
+        };
+        auto neighbors = (fl & in_edges)
+                             ? G.get_vertex(vs.vtx(j)).in_neighbors()
+                             : G.get_vertex(vs.vtx(j)).out_neighbors();
+        neighbors.map(map_f, false);
+      });
+    });
+
+    // 3. One histogram pass over the combined keys.
+    auto batch_ht = hist_table<uint64_t, V>(
+        std::make_tuple(std::numeric_limits<uint64_t>::max(),
+                        std::get<1>(ht.empty)),
+        total_deg + 1);
+    auto apply_w = [&](const std::tuple<uint64_t, V>& kv)
+        -> std::optional<std::tuple<uint64_t, O>> {
+      uint64_t key = std::get<0>(kv);
+      auto inner = apply_f(std::make_tuple(
+          static_cast<uintE>(key & 0xFFFFFFFFULL), std::get<1>(kv)));
+      if (inner.has_value()) {
+        return std::optional<std::tuple<uint64_t, O>>(std::make_tuple(
+            (key & ~0xFFFFFFFFULL) |
+                static_cast<uint64_t>(std::get<0>(*inner)),
+            std::get<1>(*inner)));
+      }
+      return std::nullopt;
+    };
+    auto res = histogram<std::tuple<uint64_t, O>>(keys, total_deg, apply_w,
+                                                  batch_ht);
+    batch_ht.del();
+
+    // 4. Separate results per subset.
+    for (size_t i = 0; i < num_subsets; i++) {
+      auto pred = [&](const std::tuple<uint64_t, O>& kv) {
+        return (std::get<0>(kv) >> 32) == i;
+      };
+      auto mine = pbbslib::filter(res, pred);
+      auto out = sequence<std::tuple<uintE, O>>(mine.size(), [&](size_t j) {
+        return std::make_tuple(
+            static_cast<uintE>(std::get<0>(mine[j]) & 0xFFFFFFFFULL),
+            std::get<1>(mine[j]));
+      });
+      results.emplace_back(n, std::move(out));
+    }
+    return results;
+  }
+
   ~EdgeMap() { ht.del(); }
 };
 
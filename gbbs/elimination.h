@@ -0,0 +1,216 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Degree-1/degree-2 elimination preprocessing. Road-network-shaped inputs
+// are dominated by pendant trees and long degree-2 chains; both can be
+// contracted away before running a benchmark and reconstituted afterwards.
+// eliminate() peels pendant vertices (recursively -- whole hanging trees
+// collapse into their attachment point), labels the chain components that
+// remain among degree-2 vertices with hook-and-shortcut min-propagation,
+// attaches each chain to one of its endpoints, and hands the resulting
+// partition to contract::contract for the reduced graph. The returned
+// reduction carries the per-vertex cluster assignment, the elimination
+// parents (the alive neighbor each peeled vertex collapsed into, giving the
+// path back for reconstitution), and contract's cluster<->reduced-vertex
+// maps. The reduced graph is unweighted and symmetric, so the pass is
+// opt-in for benchmarks whose answers survive contraction (connectivity,
+// component-style labelings); distance benchmarks additionally need the
+// chain lengths, which the parents encode.
+
+#pragma once
+
+#include "contract.h"
+#include "gbbs.h"
+
+namespace gbbs {
+namespace elimination {
+
+struct reduction {
+  symmetric_graph<symmetric_vertex, pbbslib::empty> GR;
+  // original vertex -> cluster id in [0, num_clusters)
+  sequence<uintE> cluster;
+  // contract's maps: cluster -> reduced vertex (S) and inverse (T). A
+  // cluster with S[i] == S[i+1] contracted into an isolated singleton and
+  // has no vertex in GR.
+  sequence<uintE> cluster_to_reduced;
+  sequence<uintE> reduced_to_cluster;
+  // alive neighbor each eliminated vertex collapsed into; UINT_E_MAX for
+  // anchors (vertices that survived into a cluster representative role)
+  sequence<uintE> parent;
+  size_t num_clusters;
+  size_t num_eliminated;
+
+  // Reduced vertex holding original vertex v, or UINT_E_MAX if v's cluster
+  // contracted into a singleton.
+  uintE reduced_vertex(uintE v) const {
+    uintE c = cluster[v];
+    if (cluster_to_reduced[c] == cluster_to_reduced[c + 1]) return UINT_E_MAX;
+    return cluster_to_reduced[c];
+  }
+
+  void del() { GR.del(); }
+};
+
+template <class Graph>
+inline reduction eliminate(Graph& GA) {
+  using W = typename Graph::weight_type;
+  size_t n = GA.n;
+
+  auto deg = sequence<uintE>(n, [&](size_t i) {
+    return GA.get_vertex(i).out_degree();
+  });
+  auto alive = sequence<bool>(n, true);
+  auto parent = sequence<uintE>(n, UINT_E_MAX);
+
+  // Phase 1: peel pendant vertices to a fixpoint. A degree-1 vertex
+  // collapses into its unique alive neighbor; an isolated edge (two mutual
+  // pendants) keeps the smaller endpoint as the anchor.
+  while (true) {
+    auto pendant_f = [&](size_t i) {
+      return alive[i] && deg[i] == 1;
+    };
+    auto pendants = pbbslib::filter(
+        pbbslib::make_sequence<uintE>(n, [](size_t i) { return (uintE)i; }),
+        pendant_f);
+    if (pendants.size() == 0) break;
+    auto removed = sequence<bool>(pendants.size(), false);
+    par_for(0, pendants.size(), pbbslib::kSequentialForThreshold,
+            [&](size_t j) {
+      uintE v = pendants[j];
+      uintE anchor = UINT_E_MAX;
+      auto map_f = [&](const uintE& src, const uintE& ngh, const W& wgh) {
+        if (alive[ngh] && ngh != src) anchor = ngh;
+      };
+      GA.get_vertex(v).out_neighbors().map(map_f, false);
+      if (anchor == UINT_E_MAX) return;  // neighbor peeled earlier: isolated
+      if (deg[anchor] == 1 && anchor < v) return;  // isolated edge tie-break
+      parent[v] = anchor;
+      removed[j] = true;
+    });
+    // Commit deaths after the scan so this round's degree reads are stable.
+    size_t num_removed = 0;
+    par_for(0, pendants.size(), pbbslib::kSequentialForThreshold,
+            [&](size_t j) {
+      if (removed[j]) {
+        uintE v = pendants[j];
+        alive[v] = false;
+        deg[v] = 0;
+        pbbs::fetch_and_add(&deg[parent[v]], (uintE)-1);
+      }
+    });
+    num_removed = pbbslib::reduce_add(pbbslib::make_sequence<size_t>(
+        removed.size(), [&](size_t j) { return (size_t)removed[j]; }));
+    if (num_removed == 0) break;
+  }
+
+  // Phase 2: label the chain components among the remaining degree-2
+  // vertices. lab converges to the minimum interior id of the chain via
+  // hook (min over interior neighbors) + shortcut (jump through the label,
+  // which is itself an interior vertex) rounds.
+  auto interior = sequence<bool>(n, [&](size_t i) {
+    return alive[i] && deg[i] == 2;
+  });
+  auto lab = sequence<uintE>(n, [&](size_t i) { return (uintE)i; });
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    par_for(0, n, pbbslib::kSequentialForThreshold, [&](size_t i) {
+      if (!interior[i]) return;
+      uintE m = lab[i];
+      auto map_f = [&](const uintE& src, const uintE& ngh, const W& wgh) {
+        if (interior[ngh] && lab[ngh] < m) m = lab[ngh];
+      };
+      GA.get_vertex(i).out_neighbors().map(map_f, false);
+      if (lab[m] < m) m = lab[m];  // shortcut
+      if (m < lab[i]) {
+        lab[i] = m;
+        changed = true;
+      }
+    });
+  }
+
+  // Attach each chain to one alive non-interior endpoint (the smallest, so
+  // the choice is deterministic); a pure cycle has none and anchors at its
+  // own minimum-label vertex. Interior vertices record an alive neighbor as
+  // their elimination parent for reconstitution.
+  auto attach = sequence<uintE>(n, UINT_E_MAX);
+  par_for(0, n, pbbslib::kSequentialForThreshold, [&](size_t i) {
+    if (!interior[i]) return;
+    auto map_f = [&](const uintE& src, const uintE& ngh, const W& wgh) {
+      if (alive[ngh] && !interior[ngh]) {
+        pbbs::write_min(&attach[lab[i]], ngh, std::less<uintE>());
+      }
+      if (alive[ngh] && parent[i] == UINT_E_MAX) parent[i] = ngh;
+    };
+    GA.get_vertex(i).out_neighbors().map(map_f, false);
+  });
+
+  // Cluster of an original vertex: pendants resolve through parents
+  // (pointer jumping; trees are shallow after recursive peeling collapses
+  // them level by level), then chain interiors map through their label's
+  // attachment.
+  auto rep = sequence<uintE>(n, [&](size_t i) {
+    return alive[i] ? (uintE)i : parent[i];
+  });
+  changed = true;
+  while (changed) {
+    changed = false;
+    par_for(0, n, pbbslib::kSequentialForThreshold, [&](size_t i) {
+      uintE r = rep[i];
+      if (!alive[r] && rep[r] != r) {
+        rep[i] = rep[r];
+        changed = true;
+      }
+    });
+  }
+  auto anchor_of = [&](uintE i) -> uintE {
+    uintE r = rep[i];
+    if (interior[r]) {
+      uintE a = attach[lab[r]];
+      return (a == UINT_E_MAX) ? lab[r] : a;
+    }
+    return r;
+  };
+
+  // Renumber the anchors densely and contract.
+  auto is_anchor = sequence<uintE>(n + 1, [&](size_t i) {
+    return (i < n && anchor_of(i) == i) ? (uintE)1 : (uintE)0;
+  });
+  pbbslib::scan_add_inplace(is_anchor.slice());
+  size_t num_clusters = is_anchor[n];
+  auto clusters = sequence<uintE>(n, [&](size_t i) {
+    return is_anchor[anchor_of(i)];
+  });
+
+  reduction R;
+  std::tie(R.GR, R.cluster_to_reduced, R.reduced_to_cluster) =
+      contract::contract(GA, clusters, num_clusters);
+  R.cluster = std::move(clusters);
+  R.parent = std::move(parent);
+  R.num_clusters = num_clusters;
+  R.num_eliminated = n - num_clusters;
+  return R;
+}
+
+}  // namespace elimination
+}  // namespace gbbs
@@ -0,0 +1,473 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Structure-of-arrays variant of the byte encoding for weighted graphs: a
+// vertex's topology bytes (signed varint first edge + varint deltas) and its
+// weight bytes live in separate regions of the vertex's edge block, with a
+// 4-byte topology length up front so the weight cursor can be positioned
+// without decoding. Weight-oblivious consumers (components/BFS over a
+// weighted input) pass W = pbbslib::empty and stream only the topology
+// region, getting unweighted decode bandwidth; weighted consumers run two
+// parallel cursors. For unweighted graphs (W = pbbslib::empty at encode
+// time) the weight region is empty and the format degenerates to byte.h
+// plus the 4-byte header.
+//
+// The weight region itself is dictionary-compressed per vertex when the
+// vertex's weights take few distinct values (common when weights are
+// bucketed latencies): a count byte, up to kMaxDictSize signed varint
+// dictionary entries, then one id byte per edge. A count byte of zero
+// selects the raw varint stream fallback. Decode is transparent through
+// weight_stream, which both decode() and iter use.
+
+#pragma once
+
+#include <cassert>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <cmath>
+#include <tuple>
+#include <type_traits>
+
+#include "gbbs/bridge.h"
+#include "gbbs/macros.h"
+
+namespace gbbs {
+namespace byte_split {
+
+inline size_t get_virtual_degree(uintE d, uchar* nghArr) { return d; }
+
+template <class W, typename std::enable_if<std::is_same<W, pbbslib::empty>::value,
+                                           int>::type = 0>
+inline pbbslib::empty eatWeight(uchar*& start) {
+  return pbbslib::empty();
+}
+
+template <class W,
+          typename std::enable_if<std::is_same<W, intE>::value, int>::type = 0>
+inline intE eatWeight(uchar*& start) {
+  uchar fb = *start++;
+  intE edgeRead = (fb & 0x3f);
+  if (LAST_BIT_SET(fb)) {
+    int shiftAmount = 6;
+    while (1) {
+      uchar b = *start;
+      edgeRead |= ((b & 0x7f) << shiftAmount);
+      start++;
+      if (LAST_BIT_SET(b))
+        shiftAmount += EDGE_SIZE_PER_BYTE;
+      else
+        break;
+    }
+  }
+  return (fb & 0x40) ? -edgeRead : edgeRead;
+}
+
+inline uintE eatFirstEdge(uchar*& start, uintE source) {
+  uchar fb = *start++;
+  uintE edgeRead = (fb & 0x3f);
+  if (LAST_BIT_SET(fb)) {
+    int shiftAmount = 6;
+    while (1) {
+      uchar b = *start;
+      edgeRead |= ((b & 0x7f) << shiftAmount);
+      start++;
+      if (LAST_BIT_SET(b))
+        shiftAmount += EDGE_SIZE_PER_BYTE;
+      else
+        break;
+    }
+  }
+  return (fb & 0x40) ? source - edgeRead : source + edgeRead;
+}
+
+inline uintE eatEdge(uchar*& start) {
+  uintE edgeRead = 0;
+  int shiftAmount = 0;
+  while (1) {
+    uchar b = *start++;
+    edgeRead += ((b & 0x7f) << shiftAmount);
+    if (LAST_BIT_SET(b))
+      shiftAmount += EDGE_SIZE_PER_BYTE;
+    else
+      break;
+  }
+  return edgeRead;
+}
+
+// The topology region starts after the 4-byte length header; the weight
+// region starts at the end of the topology region.
+inline uchar* topology_start(uchar* edge_start) {
+  return edge_start + sizeof(uintE);
+}
+inline uchar* weights_start(uchar* edge_start) {
+  return edge_start + sizeof(uintE) + *((uintE*)edge_start);
+}
+
+inline long compressFirstEdge(uchar* start, long offset, long source,
+                              long target) {
+  long diff = target - source;
+  long preCompress = diff;
+  uchar firstByte = 0;
+  uintE toCompress = std::abs(preCompress);
+  firstByte = toCompress & 0x3f;
+  if (preCompress < 0) {
+    firstByte |= 0x40;
+  }
+  toCompress = toCompress >> 6;
+  if (toCompress > 0) {
+    firstByte |= 0x80;
+  }
+  start[offset++] = firstByte;
+  uchar curByte = toCompress & 0x7f;
+  while ((curByte > 0) || (toCompress > 0)) {
+    uchar toWrite = curByte;
+    toCompress = toCompress >> 7;
+    curByte = toCompress & 0x7f;
+    if ((curByte > 0) || (toCompress > 0)) {
+      toWrite |= 0x80;
+    }
+    start[offset++] = toWrite;
+  }
+  return offset;
+}
+
+inline long compressEdge(uchar* start, long curOffset, uintE diff) {
+  uchar curByte = diff & 0x7f;
+  while ((curByte > 0) || (diff > 0)) {
+    uchar toWrite = curByte;
+    diff = diff >> 7;
+    curByte = diff & 0x7f;
+    if ((curByte > 0) || (diff > 0)) {
+      toWrite |= 0x80;
+    }
+    start[curOffset++] = toWrite;
+  }
+  return curOffset;
+}
+
+template <class W,
+          typename std::enable_if<!std::is_same<W, intE>::value, int>::type = 0>
+inline long compressWeight(uchar* start, long offset, W weight) {
+  return offset;
+}
+
+template <class W,
+          typename std::enable_if<std::is_same<W, intE>::value, int>::type = 0>
+inline long compressWeight(uchar* start, long offset, W weight) {
+  return compressFirstEdge(start, offset, 0, weight);
+}
+
+// Maximum number of distinct weights per vertex before falling back to the
+// raw varint weight stream.
+constexpr size_t kMaxDictSize = 64;
+
+// Writes [topo_len][topology bytes][weight region]. The weight region is
+// [dict_count][dict entries][1-byte ids] when the vertex has at most
+// kMaxDictSize distinct weights, else [0][raw varint weights].
+template <class W, class I>
+inline long sequentialCompressEdgeSet(uchar* edgeArray, long currentOffset,
+                                      uintE deg, uintE src, I& it) {
+  if (deg > 0) {
+    long header_off = currentOffset;
+    currentOffset += sizeof(uintE);
+    long topo_begin = currentOffset;
+
+    // 1. topology region
+    uintE prev = std::get<0>(it.cur());
+    currentOffset = compressFirstEdge(edgeArray, currentOffset, src, prev);
+    W stack_wghs[128];
+    W* wghs = (deg <= 128) ? stack_wghs : pbbslib::new_array_no_init<W>(deg);
+    wghs[0] = std::get<1>(it.cur());
+    for (size_t eid = 1; eid < deg; eid++) {
+      uintE ngh = std::get<0>(it.next());
+      currentOffset = compressEdge(edgeArray, currentOffset, ngh - prev);
+      wghs[eid] = std::get<1>(it.cur());
+      prev = ngh;
+    }
+    *((uintE*)(edgeArray + header_off)) =
+        static_cast<uintE>(currentOffset - topo_begin);
+
+    // 2. weight region
+    if constexpr (std::is_same<W, intE>::value) {
+      // Build the per-vertex dictionary (insertion order).
+      intE dict[kMaxDictSize];
+      size_t dict_size = 0;
+      bool use_dict = true;
+      for (size_t eid = 0; eid < deg && use_dict; eid++) {
+        size_t j = 0;
+        for (; j < dict_size; j++) {
+          if (dict[j] == wghs[eid]) break;
+        }
+        if (j == dict_size) {
+          if (dict_size == kMaxDictSize) {
+            use_dict = false;
+          } else {
+            dict[dict_size++] = wghs[eid];
+          }
+        }
+      }
+      if (use_dict) {
+        edgeArray[currentOffset++] = static_cast<uchar>(dict_size);
+        for (size_t j = 0; j < dict_size; j++) {
+          currentOffset = compressWeight<W>(edgeArray, currentOffset, dict[j]);
+        }
+        for (size_t eid = 0; eid < deg; eid++) {
+          size_t j = 0;
+          while (dict[j] != wghs[eid]) j++;
+          edgeArray[currentOffset++] = static_cast<uchar>(j);
+        }
+      } else {
+        edgeArray[currentOffset++] = 0;  // raw stream fallback
+        for (size_t eid = 0; eid < deg; eid++) {
+          currentOffset = compressWeight<W>(edgeArray, currentOffset,
+                                            wghs[eid]);
+        }
+      }
+    }
+    if (wghs != stack_wghs) pbbslib::free_array(wghs);
+  }
+  return currentOffset;
+}
+
+// Sequential reader over a vertex's weight region; no-op when W is empty so
+// weight-oblivious decode never touches (or pages in) the weight bytes.
+template <class W, class Enable = void>
+struct weight_stream {
+  weight_stream(uchar* edge_start) {}
+  inline W next() { return W(); }
+};
+
+template <class W>
+struct weight_stream<
+    W, typename std::enable_if<std::is_same<W, intE>::value>::type> {
+  intE dict[kMaxDictSize];
+  uchar* finger;
+  bool use_dict;
+
+  weight_stream(uchar* edge_start) {
+    finger = weights_start(edge_start);
+    uchar dict_size = *finger++;
+    use_dict = (dict_size > 0);
+    for (size_t j = 0; j < dict_size; j++) {
+      dict[j] = eatWeight<W>(finger);
+    }
+  }
+
+  inline W next() {
+    if (use_dict) {
+      return dict[*finger++];
+    }
+    return eatWeight<W>(finger);
+  }
+};
+
+// Decode with two parallel cursors; when W is empty only the topology
+// cursor moves, so the weight region never enters cache.
+template <class W, class T>
+inline void decode(T t, uchar* edge_start, const uintE& source,
+                   const uintT& degree) {
+  if (degree > 0) {
+    uchar* topo = topology_start(edge_start);
+    auto wghs = weight_stream<W>(edge_start);
+    uintE ngh = eatFirstEdge(topo, source);
+    W wgh = wghs.next();
+    if (!t(source, ngh, wgh, 0)) {
+      return;
+    }
+    for (size_t i = 1; i < degree; i++) {
+      ngh += eatEdge(topo);
+      wgh = wghs.next();
+      if (!t(source, ngh, wgh, i)) {
+        break;
+      }
+    }
+  }
+}
+
+template <class W>
+inline std::tuple<uintE, W> get_ith_neighbor(uchar* edge_start, uintE source,
+                                             uintE degree, size_t i) {
+  std::tuple<uintE, W> result;
+  auto f = [&](const uintE& src, const uintE& ngh, const W& wgh, size_t k) {
+    if (k == i) {
+      result = std::make_tuple(ngh, wgh);
+      return false;
+    }
+    return true;
+  };
+  decode<W>(f, edge_start, source, degree);
+  return result;
+}
+
+template <class W, class M, class Monoid>
+inline typename Monoid::T map_reduce(uchar* edge_start, const uintE& source,
+                                     const uintT& degree, M& m, Monoid& reduce,
+                                     const bool par = true) {
+  using E = typename Monoid::T;
+  E cur = reduce.identity;
+  auto f = [&](const uintE& src, const uintE& ngh, const W& wgh, size_t k) {
+    cur = reduce.f(cur, m(src, ngh, wgh));
+    return true;
+  };
+  decode<W>(f, edge_start, source, degree);
+  return cur;
+}
+
+template <class W>
+struct iter {
+  uchar* topo;
+  weight_stream<W> wghs;
+  uintE src;
+  std::tuple<uintE, W> last_edge;
+  uintE degree;
+  uintE proc;
+
+  iter(uchar* _finger, uintT _degree, uintE _src)
+      : wghs(_finger), src(_src), degree(_degree), proc(0) {
+    if (degree > 0) {
+      topo = topology_start(_finger);
+      std::get<0>(last_edge) = eatFirstEdge(topo, src);
+      std::get<1>(last_edge) = wghs.next();
+      proc = 1;
+    }
+  }
+
+  inline std::tuple<uintE, W> cur() { return last_edge; }
+
+  inline std::tuple<uintE, W> next() {
+    std::get<0>(last_edge) += eatEdge(topo);
+    std::get<1>(last_edge) = wghs.next();
+    proc++;
+    return last_edge;
+  }
+
+  inline bool has_next() { return proc < degree; }
+};
+
+template <class W>
+inline size_t intersect(uchar* l1, uchar* l2, uintE l1_size, uintE l2_size,
+                        uintE l1_src, uintE l2_src) {
+  if (l1_size == 0 || l2_size == 0) return 0;
+  auto it_1 = iter<W>(l1, l1_size, l1_src);
+  auto it_2 = iter<W>(l2, l2_size, l2_src);
+  size_t i = 0, j = 0, ct = 0;
+  while (i < l1_size && j < l2_size) {
+    uintE e1 = std::get<0>(it_1.cur());
+    uintE e2 = std::get<0>(it_2.cur());
+    if (e1 == e2) {
+      i++, j++, ct++;
+      if (it_1.has_next()) it_1.next();
+      if (it_2.has_next()) it_2.next();
+    } else if (e1 < e2) {
+      i++;
+      if (it_1.has_next()) it_1.next();
+    } else {
+      j++;
+      if (it_2.has_next()) it_2.next();
+    }
+  }
+  return ct;
+}
+
+template <class W, class F>
+inline size_t intersect_f(uchar* l1, uchar* l2, uintE l1_size, uintE l2_size,
+                          uintE l1_src, uintE l2_src, const F& f) {
+  if (l1_size == 0 || l2_size == 0) return 0;
+  auto it_1 = iter<W>(l1, l1_size, l1_src);
+  auto it_2 = iter<W>(l2, l2_size, l2_src);
+  size_t i = 0, j = 0, ct = 0;
+  while (i < l1_size && j < l2_size) {
+    uintE e1 = std::get<0>(it_1.cur());
+    uintE e2 = std::get<0>(it_2.cur());
+    if (e1 == e2) {
+      f(l1_src, l2_src, e1);
+      i++, j++, ct++;
+      if (it_1.has_next()) it_1.next();
+      if (it_2.has_next()) it_2.next();
+    } else if (e1 < e2) {
+      i++;
+      if (it_1.has_next()) it_1.next();
+    } else {
+      j++;
+      if (it_2.has_next()) it_2.next();
+    }
+  }
+  return ct;
+}
+
+// Decode-and-recompress, as for the other region-structured formats: the
+// topology length header must be rewritten after filtering.
+template <class W, class P>
+inline size_t pack(P& pred, uchar* edge_start, const uintE& source,
+                   const uintE& degree, std::tuple<uintE, W>* tmp,
+                   bool par = true) {
+  // The caller's tmp is sized by calculateTemporarySpace (a fraction of the
+  // degree), but every surviving edge must be staged here, so allocate our
+  // own scratch instead of using tmp.
+  size_t new_deg = 0;
+  if (degree > 0) {
+    using ET = std::tuple<uintE, W>;
+    ET stack_scratch[128];
+    ET* scratch =
+        (degree <= 128) ? stack_scratch : pbbslib::new_array_no_init<ET>(degree);
+    auto f = [&](const uintE& src, const uintE& ngh, const W& wgh, size_t k) {
+      if (pred(src, ngh, wgh)) {
+        scratch[new_deg++] = std::make_tuple(ngh, wgh);
+      }
+      return true;
+    };
+    decode<W>(f, edge_start, source, degree);
+    if (new_deg > 0) {
+      struct tmp_iter {
+        ET* e;
+        size_t k;
+        ET cur() { return e[k]; }
+        ET next() { return e[++k]; }
+      };
+      tmp_iter it{scratch, 0};
+      sequentialCompressEdgeSet<W>(edge_start, 0, new_deg, source, it);
+    }
+    if (scratch != stack_scratch) pbbslib::free_array(scratch);
+  }
+  return new_deg;
+}
+
+template <class W, class P, class O>
+inline size_t filter(P pred, uchar* edge_start, const uintE& source,
+                     const uintE& degree, std::tuple<uintE, W>* tmp, O& out) {
+  size_t out_ct = 0;
+  if (degree > 0) {
+    auto f = [&](const uintE& src, const uintE& ngh, const W& wgh, size_t k) {
+      if (pred(src, ngh, wgh)) {
+        out(out_ct++, std::make_tuple(ngh, wgh));
+      }
+      return true;
+    };
+    decode<W>(f, edge_start, source, degree);
+  }
+  return out_ct;
+}
+
+}  // namespace byte_split
+}  // namespace gbbs
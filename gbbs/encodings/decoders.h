@@ -26,6 +26,9 @@
 #include "byte.h"
 #include "byte_pd.h"
 #include "byte_pd_amortized.h"
+#include "group_varint.h"
+#include "byte_split.h"
+#include "interval.h"
 
 namespace gbbs {
 
@@ -114,6 +117,258 @@ struct byte_decode {
   }
 };
 
+struct group_varint_decode {
+
+  template <class W, class T>
+  static inline void decode_block(T t, uchar* edge_start,
+                                  const uintE& source, const uintT& degree,
+                                  uintE block_num) {
+    assert(false);  // Unimplemented for group-varint decoder
+    exit(0);
+  }
+
+  static inline size_t get_virtual_degree(uintE d, uchar* nghArr) { return d; }
+
+  template <class W>
+  static inline auto iter(uchar* edge_start, uintE degree, uintE id)
+      -> group_varint::iter<W> {
+    return group_varint::iter<W>(edge_start, degree, id);
+  }
+
+  template <class W>
+  static inline size_t intersect(uchar* l1, uchar* l2, uintE l1_size,
+                                 uintE l2_size, uintE l1_src, uintE l2_src) {
+    return group_varint::intersect<W>(l1, l2, l1_size, l2_size, l1_src,
+                                      l2_src);
+  }
+
+  template <class W, class F>
+  static inline size_t intersect_f(uchar* l1, uchar* l2, uintE l1_size,
+                                   uintE l2_size, uintE l1_src, uintE l2_src,
+                                   const F& f) {
+    return group_varint::intersect_f<W>(l1, l2, l1_size, l2_size, l1_src,
+                                        l2_src, f);
+  }
+
+  template <class W, class I>
+  static inline long sequentialCompressEdgeSet(uchar* edgeArray,
+                                               size_t current_offset,
+                                               uintT degree, uintE source,
+                                               I& it) {
+    return group_varint::sequentialCompressEdgeSet<W>(edgeArray,
+                                                      current_offset, degree,
+                                                      source, it);
+  }
+
+  template <class W, class P, class O>
+  static inline void filter(P pred, uchar* edge_start, const uintE& source,
+                            const uintE& degree, std::tuple<uintE, W>* tmp,
+                            O& out) {
+    group_varint::filter<W>(pred, edge_start, source, degree, tmp, out);
+    return;
+  }
+
+  template <class W, class P>
+  static inline size_t pack(P& pred, uchar* edge_start, const uintE& source,
+                            const uintE& degree,
+                            std::tuple<uintE, W>* tmp_space, bool par = true) {
+    return group_varint::pack<W>(pred, edge_start, source, degree, tmp_space);
+  }
+
+  template <class W, class M, class Monoid>
+  static inline typename Monoid::T map_reduce(uchar* edge_start, const uintE& source,
+                             const uintT& degree, M& m, Monoid& reduce,
+                             const bool par = true) {
+    return group_varint::map_reduce<W, M, Monoid>(edge_start, source, degree,
+                                                  m, reduce, par);
+  }
+
+  template <class W, class T>
+ __attribute__((always_inline)) static inline void decode(T t, uchar* edge_start, const uintE& source,
+                            const uintT& degree, const bool& parallel) {
+    return group_varint::decode<W, T>(t, edge_start, source, degree);
+  }
+
+  template <class W>
+  static inline std::tuple<uintE, W> get_ith_neighbor(uchar* edge_start,
+                                                      uintE source,
+                                                      uintE degree, size_t i) {
+    return group_varint::get_ith_neighbor<W>(edge_start, source, degree, i);
+  }
+
+  static inline uintE get_num_blocks(uchar* edge_start, uintE degree) {
+    return 1; // single block in group-varint format
+  }
+};
+
+struct interval_decode {
+
+  template <class W, class T>
+  static inline void decode_block(T t, uchar* edge_start,
+                                  const uintE& source, const uintT& degree,
+                                  uintE block_num) {
+    assert(false);  // Unimplemented for interval decoder
+    exit(0);
+  }
+
+  static inline size_t get_virtual_degree(uintE d, uchar* nghArr) { return d; }
+
+  template <class W>
+  static inline auto iter(uchar* edge_start, uintE degree, uintE id)
+      -> interval_byte::iter<W> {
+    return interval_byte::iter<W>(edge_start, degree, id);
+  }
+
+  template <class W>
+  static inline size_t intersect(uchar* l1, uchar* l2, uintE l1_size,
+                                 uintE l2_size, uintE l1_src, uintE l2_src) {
+    return interval_byte::intersect<W>(l1, l2, l1_size, l2_size, l1_src,
+                                      l2_src);
+  }
+
+  template <class W, class F>
+  static inline size_t intersect_f(uchar* l1, uchar* l2, uintE l1_size,
+                                   uintE l2_size, uintE l1_src, uintE l2_src,
+                                   const F& f) {
+    return interval_byte::intersect_f<W>(l1, l2, l1_size, l2_size, l1_src,
+                                        l2_src, f);
+  }
+
+  template <class W, class I>
+  static inline long sequentialCompressEdgeSet(uchar* edgeArray,
+                                               size_t current_offset,
+                                               uintT degree, uintE source,
+                                               I& it) {
+    return interval_byte::sequentialCompressEdgeSet<W>(edgeArray,
+                                                      current_offset, degree,
+                                                      source, it);
+  }
+
+  template <class W, class P, class O>
+  static inline void filter(P pred, uchar* edge_start, const uintE& source,
+                            const uintE& degree, std::tuple<uintE, W>* tmp,
+                            O& out) {
+    interval_byte::filter<W>(pred, edge_start, source, degree, tmp, out);
+    return;
+  }
+
+  template <class W, class P>
+  static inline size_t pack(P& pred, uchar* edge_start, const uintE& source,
+                            const uintE& degree,
+                            std::tuple<uintE, W>* tmp_space, bool par = true) {
+    return interval_byte::pack<W>(pred, edge_start, source, degree, tmp_space);
+  }
+
+  template <class W, class M, class Monoid>
+  static inline typename Monoid::T map_reduce(uchar* edge_start, const uintE& source,
+                             const uintT& degree, M& m, Monoid& reduce,
+                             const bool par = true) {
+    return interval_byte::map_reduce<W, M, Monoid>(edge_start, source, degree,
+                                                  m, reduce, par);
+  }
+
+  template <class W, class T>
+ __attribute__((always_inline)) static inline void decode(T t, uchar* edge_start, const uintE& source,
+                            const uintT& degree, const bool& parallel) {
+    return interval_byte::decode<W, T>(t, edge_start, source, degree);
+  }
+
+  template <class W>
+  static inline std::tuple<uintE, W> get_ith_neighbor(uchar* edge_start,
+                                                      uintE source,
+                                                      uintE degree, size_t i) {
+    return interval_byte::get_ith_neighbor<W>(edge_start, source, degree, i);
+  }
+
+  static inline uintE get_num_blocks(uchar* edge_start, uintE degree) {
+    return 1; // single block in interval format
+  }
+};
+
+struct byte_split_decode {
+
+  template <class W, class T>
+  static inline void decode_block(T t, uchar* edge_start,
+                                  const uintE& source, const uintT& degree,
+                                  uintE block_num) {
+    assert(false);  // Unimplemented for split-weight decoder
+    exit(0);
+  }
+
+  static inline size_t get_virtual_degree(uintE d, uchar* nghArr) { return d; }
+
+  template <class W>
+  static inline auto iter(uchar* edge_start, uintE degree, uintE id)
+      -> byte_split::iter<W> {
+    return byte_split::iter<W>(edge_start, degree, id);
+  }
+
+  template <class W>
+  static inline size_t intersect(uchar* l1, uchar* l2, uintE l1_size,
+                                 uintE l2_size, uintE l1_src, uintE l2_src) {
+    return byte_split::intersect<W>(l1, l2, l1_size, l2_size, l1_src,
+                                      l2_src);
+  }
+
+  template <class W, class F>
+  static inline size_t intersect_f(uchar* l1, uchar* l2, uintE l1_size,
+                                   uintE l2_size, uintE l1_src, uintE l2_src,
+                                   const F& f) {
+    return byte_split::intersect_f<W>(l1, l2, l1_size, l2_size, l1_src,
+                                        l2_src, f);
+  }
+
+  template <class W, class I>
+  static inline long sequentialCompressEdgeSet(uchar* edgeArray,
+                                               size_t current_offset,
+                                               uintT degree, uintE source,
+                                               I& it) {
+    return byte_split::sequentialCompressEdgeSet<W>(edgeArray,
+                                                      current_offset, degree,
+                                                      source, it);
+  }
+
+  template <class W, class P, class O>
+  static inline void filter(P pred, uchar* edge_start, const uintE& source,
+                            const uintE& degree, std::tuple<uintE, W>* tmp,
+                            O& out) {
+    byte_split::filter<W>(pred, edge_start, source, degree, tmp, out);
+    return;
+  }
+
+  template <class W, class P>
+  static inline size_t pack(P& pred, uchar* edge_start, const uintE& source,
+                            const uintE& degree,
+                            std::tuple<uintE, W>* tmp_space, bool par = true) {
+    return byte_split::pack<W>(pred, edge_start, source, degree, tmp_space);
+  }
+
+  template <class W, class M, class Monoid>
+  static inline typename Monoid::T map_reduce(uchar* edge_start, const uintE& source,
+                             const uintT& degree, M& m, Monoid& reduce,
+                             const bool par = true) {
+    return byte_split::map_reduce<W, M, Monoid>(edge_start, source, degree,
+                                                  m, reduce, par);
+  }
+
+  template <class W, class T>
+ __attribute__((always_inline)) static inline void decode(T t, uchar* edge_start, const uintE& source,
+                            const uintT& degree, const bool& parallel) {
+    return byte_split::decode<W, T>(t, edge_start, source, degree);
+  }
+
+  template <class W>
+  static inline std::tuple<uintE, W> get_ith_neighbor(uchar* edge_start,
+                                                      uintE source,
+                                                      uintE degree, size_t i) {
+    return byte_split::get_ith_neighbor<W>(edge_start, source, degree, i);
+  }
+
+  static inline uintE get_num_blocks(uchar* edge_start, uintE degree) {
+    return 1; // single block in split-weight format
+  }
+};
+
 struct bytepd_decode {
 
   template <class W>
@@ -208,19 +463,26 @@ struct bytepd_decode {
 
 struct bytepd_amortized_decode {
 
+  template <class W, class T>
+  static inline void decode_range(T t, uchar* edge_start, const uintE& source,
+                                  const uintT& degree, uintE lo, uintE hi) {
+    bytepd_amortized::decode_range<W, T>(t, edge_start, source, degree, lo,
+                                         hi);
+  }
+
   template <class W>
   static inline size_t intersect(uchar* l1, uchar* l2, uintE l1_size,
                                  uintE l2_size, uintE l1_src, uintE l2_src) {
-    return bytepd_amortized::intersect<W>(l1, l2, l1_size, l2_size,
-                                                     l1_src, l2_src);
+    return bytepd_amortized::intersect_blocked<W>(l1, l2, l1_size, l2_size,
+                                                  l1_src, l2_src);
   }
 
   template <class W, class F>
   static inline size_t intersect_f(uchar* l1, uchar* l2, uintE l1_size,
                                    uintE l2_size, uintE l1_src, uintE l2_src,
                                    const F& f) {
-    return bytepd_amortized::intersect_f<W>(l1, l2, l1_size, l2_size,
-                                                       l1_src, l2_src, f);
+    return bytepd_amortized::intersect_f_blocked<W>(l1, l2, l1_size, l2_size,
+                                                    l1_src, l2_src, f);
   }
 
   template <class W>
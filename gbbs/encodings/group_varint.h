@@ -0,0 +1,404 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Group-varint (StreamVByte-style) encoding: after a signed varint first
+// edge, deltas are stored in groups of four, each group led by a control
+// byte holding four 2-bit length codes (bytes-per-delta minus one). Decode
+// reads one control byte and then consumes the data bytes with no
+// data-dependent branches inside the group, unlike the continuation-bit
+// varints in byte.h/byte_pd*.h whose decode serializes on a branch per
+// byte. For weighted graphs the group's weights follow its data bytes.
+
+#pragma once
+
+#include <cassert>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <cmath>
+#include <tuple>
+#include <type_traits>
+
+#include "gbbs/bridge.h"
+#include "gbbs/macros.h"
+
+namespace gbbs {
+namespace group_varint {
+
+constexpr size_t kGroupSize = 4;
+
+inline size_t get_virtual_degree(uintE d, uchar* nghArr) { return d; }
+
+// Read an empty weight (noop)
+template <class W, typename std::enable_if<std::is_same<W, pbbslib::empty>::value,
+                                           int>::type = 0>
+inline pbbslib::empty eatWeight(uchar*& start) {
+  return pbbslib::empty();
+}
+
+// Read an integer weight (signed continuation-bit varint, as in byte.h).
+template <class W,
+          typename std::enable_if<std::is_same<W, intE>::value, int>::type = 0>
+inline intE eatWeight(uchar*& start) {
+  uchar fb = *start++;
+  intE edgeRead = (fb & 0x3f);
+  if (LAST_BIT_SET(fb)) {
+    int shiftAmount = 6;
+    while (1) {
+      uchar b = *start;
+      edgeRead |= ((b & 0x7f) << shiftAmount);
+      start++;
+      if (LAST_BIT_SET(b))
+        shiftAmount += EDGE_SIZE_PER_BYTE;
+      else
+        break;
+    }
+  }
+  return (fb & 0x40) ? -edgeRead : edgeRead;
+}
+
+// The first edge is signed-difference coded exactly as in byte.h.
+inline uintE eatFirstEdge(uchar*& start, uintE source) {
+  uchar fb = *start++;
+  uintE edgeRead = (fb & 0x3f);
+  if (LAST_BIT_SET(fb)) {
+    int shiftAmount = 6;
+    while (1) {
+      uchar b = *start;
+      edgeRead |= ((b & 0x7f) << shiftAmount);
+      start++;
+      if (LAST_BIT_SET(b))
+        shiftAmount += EDGE_SIZE_PER_BYTE;
+      else
+        break;
+    }
+  }
+  return (fb & 0x40) ? source - edgeRead : source + edgeRead;
+}
+
+// Decodes the next group of up to `ct` deltas (ct <= kGroupSize) into out.
+// One control-byte read, then fixed-length loads -- no per-byte branches.
+__attribute__((always_inline)) inline void eatGroup(uchar*& start, uintE* out,
+                                                    size_t ct) {
+  uchar control = *start++;
+  for (size_t i = 0; i < ct; i++) {
+    size_t len = ((control >> (2 * i)) & 0x3) + 1;
+    uintE v = 0;
+    memcpy(&v, start, len);
+    // mask off bytes beyond len (memcpy of len bytes already leaves the
+    // high bytes zero since v starts at 0)
+    out[i] = v;
+    start += len;
+  }
+}
+
+// Number of bytes needed for delta d, as a 2-bit code (bytes - 1).
+__attribute__((always_inline)) inline uchar lengthCode(uintE d) {
+  return (d > 0xFFFFFF) ? 3 : (d > 0xFFFF) ? 2 : (d > 0xFF) ? 1 : 0;
+}
+
+inline long compressFirstEdge(uchar* start, long offset, long source,
+                              long target) {
+  long diff = target - source;
+  long preCompress = diff;
+  uchar firstByte = 0;
+  uintE toCompress = std::abs(preCompress);
+  firstByte = toCompress & 0x3f;  // 0011|1111
+  if (preCompress < 0) {
+    firstByte |= 0x40;
+  }
+  toCompress = toCompress >> 6;
+  if (toCompress > 0) {
+    firstByte |= 0x80;
+  }
+  start[offset++] = firstByte;
+  uchar curByte = toCompress & 0x7f;
+  while ((curByte > 0) || (toCompress > 0)) {
+    uchar toWrite = curByte;
+    toCompress = toCompress >> 7;
+    curByte = toCompress & 0x7f;
+    if ((curByte > 0) || (toCompress > 0)) {
+      toWrite |= 0x80;
+    }
+    start[offset++] = toWrite;
+  }
+  return offset;
+}
+
+template <class W,
+          typename std::enable_if<!std::is_same<W, intE>::value, int>::type = 0>
+inline long compressWeight(uchar* start, long offset, W weight) {
+  return offset;
+}
+
+template <class W,
+          typename std::enable_if<std::is_same<W, intE>::value, int>::type = 0>
+inline long compressWeight(uchar* start, long offset, W weight) {
+  return compressFirstEdge(start, offset, 0, weight);
+}
+
+// Writes a group of up to `ct` deltas: control byte then data bytes.
+inline long compressGroup(uchar* start, long offset, const uintE* deltas,
+                          size_t ct) {
+  uchar control = 0;
+  long control_offset = offset++;
+  for (size_t i = 0; i < ct; i++) {
+    uchar code = lengthCode(deltas[i]);
+    control |= (code << (2 * i));
+    size_t len = code + 1;
+    memcpy(start + offset, &deltas[i], len);
+    offset += len;
+  }
+  start[control_offset] = control;
+  return offset;
+}
+
+template <class W, class I>
+inline long sequentialCompressEdgeSet(uchar* edgeArray, long currentOffset,
+                                      uintE deg, uintE src, I& it) {
+  if (deg > 0) {
+    uintE prev = std::get<0>(it.cur());
+    W w = std::get<1>(it.cur());
+    currentOffset = compressFirstEdge(edgeArray, currentOffset, src, prev);
+    currentOffset = compressWeight<W>(edgeArray, currentOffset, w);
+    uintE deltas[kGroupSize];
+    W weights[kGroupSize];
+    size_t eid = 1;
+    while (eid < deg) {
+      size_t ct = std::min<size_t>(kGroupSize, deg - eid);
+      for (size_t i = 0; i < ct; i++) {
+        uintE ngh = std::get<0>(it.next());
+        deltas[i] = ngh - prev;
+        weights[i] = std::get<1>(it.cur());
+        prev = ngh;
+      }
+      currentOffset = compressGroup(edgeArray, currentOffset, deltas, ct);
+      for (size_t i = 0; i < ct; i++) {
+        currentOffset = compressWeight<W>(edgeArray, currentOffset, weights[i]);
+      }
+      eid += ct;
+    }
+  }
+  return currentOffset;
+}
+
+template <class W, class T>
+inline void decode(T t, uchar* edgeStart, const uintE& source,
+                   const uintT& degree) {
+  if (degree > 0) {
+    uintE ngh = eatFirstEdge(edgeStart, source);
+    W wgh = eatWeight<W>(edgeStart);
+    if (!t(source, ngh, wgh, 0)) {
+      return;
+    }
+    uintE deltas[kGroupSize];
+    size_t i = 1;
+    while (i < degree) {
+      size_t ct = std::min<size_t>(kGroupSize, degree - i);
+      eatGroup(edgeStart, deltas, ct);
+      for (size_t j = 0; j < ct; j++) {
+        ngh += deltas[j];
+        wgh = eatWeight<W>(edgeStart);
+        if (!t(source, ngh, wgh, i + j)) {
+          return;
+        }
+      }
+      i += ct;
+    }
+  }
+}
+
+template <class W>
+inline std::tuple<uintE, W> get_ith_neighbor(uchar* edge_start, uintE source,
+                                             uintE degree, size_t i) {
+  std::tuple<uintE, W> result;
+  auto f = [&](const uintE& src, const uintE& ngh, const W& wgh, size_t k) {
+    if (k == i) {
+      result = std::make_tuple(ngh, wgh);
+      return false;
+    }
+    return true;
+  };
+  decode<W>(f, edge_start, source, degree);
+  return result;
+}
+
+template <class W, class M, class Monoid>
+inline typename Monoid::T map_reduce(uchar* edge_start, const uintE& source,
+                                     const uintT& degree, M& m, Monoid& reduce,
+                                     const bool par = true) {
+  using E = typename Monoid::T;
+  E cur = reduce.identity;
+  auto f = [&](const uintE& src, const uintE& ngh, const W& wgh, size_t k) {
+    cur = reduce.f(cur, m(src, ngh, wgh));
+    return true;
+  };
+  decode<W>(f, edge_start, source, degree);
+  return cur;
+}
+
+template <class W>
+struct iter {
+  uchar* finger;
+  uintE src;
+  std::tuple<uintE, W> last_edge;
+  uintE degree;
+  uintE proc;
+  uintE deltas[kGroupSize];
+  uintE group_pos;  // next unread slot in deltas
+  uintE group_ct;   // number of valid entries in deltas
+
+  iter(uchar* _finger, uintT _degree, uintE _src)
+      : finger(_finger), src(_src), degree(_degree), proc(0),
+        group_pos(0), group_ct(0) {
+    if (degree > 0) {
+      std::get<0>(last_edge) = eatFirstEdge(finger, src);
+      std::get<1>(last_edge) = eatWeight<W>(finger);
+      proc = 1;
+    }
+  }
+
+  inline std::tuple<uintE, W> cur() { return last_edge; }
+
+  inline std::tuple<uintE, W> next() {
+    if (group_pos == group_ct) {
+      group_ct = std::min<uintE>(kGroupSize, degree - proc);
+      eatGroup(finger, deltas, group_ct);
+      group_pos = 0;
+    }
+    std::get<0>(last_edge) += deltas[group_pos++];
+    std::get<1>(last_edge) = eatWeight<W>(finger);
+    proc++;
+    return last_edge;
+  }
+
+  inline bool has_next() { return proc < degree; }
+};
+
+template <class W>
+inline size_t intersect(uchar* l1, uchar* l2, uintE l1_size, uintE l2_size,
+                        uintE l1_src, uintE l2_src) {
+  if (l1_size == 0 || l2_size == 0) return 0;
+  auto it_1 = iter<W>(l1, l1_size, l1_src);
+  auto it_2 = iter<W>(l2, l2_size, l2_src);
+  size_t i = 0, j = 0, ct = 0;
+  while (i < l1_size && j < l2_size) {
+    uintE e1 = std::get<0>(it_1.cur());
+    uintE e2 = std::get<0>(it_2.cur());
+    if (e1 == e2) {
+      i++, j++, ct++;
+      if (it_1.has_next()) it_1.next();
+      if (it_2.has_next()) it_2.next();
+    } else if (e1 < e2) {
+      i++;
+      if (it_1.has_next()) it_1.next();
+    } else {
+      j++;
+      if (it_2.has_next()) it_2.next();
+    }
+  }
+  return ct;
+}
+
+template <class W, class F>
+inline size_t intersect_f(uchar* l1, uchar* l2, uintE l1_size, uintE l2_size,
+                          uintE l1_src, uintE l2_src, const F& f) {
+  if (l1_size == 0 || l2_size == 0) return 0;
+  auto it_1 = iter<W>(l1, l1_size, l1_src);
+  auto it_2 = iter<W>(l2, l2_size, l2_src);
+  size_t i = 0, j = 0, ct = 0;
+  while (i < l1_size && j < l2_size) {
+    uintE e1 = std::get<0>(it_1.cur());
+    uintE e2 = std::get<0>(it_2.cur());
+    if (e1 == e2) {
+      f(l1_src, l2_src, e1);
+      i++, j++, ct++;
+      if (it_1.has_next()) it_1.next();
+      if (it_2.has_next()) it_2.next();
+    } else if (e1 < e2) {
+      i++;
+      if (it_1.has_next()) it_1.next();
+    } else {
+      j++;
+      if (it_2.has_next()) it_2.next();
+    }
+  }
+  return ct;
+}
+
+// Decodes into tmp, filters, and recompresses the survivors from tmp.
+// (In-place single-pass packing as in byte.h is unsafe here because a
+// group's control byte is written after its data bytes are sized.)
+template <class W, class P>
+inline size_t pack(P& pred, uchar* edge_start, const uintE& source,
+                   const uintE& degree, std::tuple<uintE, W>* tmp,
+                   bool par = true) {
+  // The caller's tmp is sized by calculateTemporarySpace (a fraction of the
+  // degree), but every surviving edge must be staged here, so allocate our
+  // own scratch instead of using tmp.
+  size_t new_deg = 0;
+  if (degree > 0) {
+    using ET = std::tuple<uintE, W>;
+    ET stack_scratch[128];
+    ET* scratch =
+        (degree <= 128) ? stack_scratch : pbbslib::new_array_no_init<ET>(degree);
+    auto f = [&](const uintE& src, const uintE& ngh, const W& wgh, size_t k) {
+      if (pred(src, ngh, wgh)) {
+        scratch[new_deg++] = std::make_tuple(ngh, wgh);
+      }
+      return true;
+    };
+    decode<W>(f, edge_start, source, degree);
+    if (new_deg > 0) {
+      struct tmp_iter {
+        ET* e;
+        size_t k;
+        ET cur() { return e[k]; }
+        ET next() { return e[++k]; }
+      };
+      tmp_iter it{scratch, 0};
+      sequentialCompressEdgeSet<W>(edge_start, 0, new_deg, source, it);
+    }
+    if (scratch != stack_scratch) pbbslib::free_array(scratch);
+  }
+  return new_deg;
+}
+
+template <class W, class P, class O>
+inline size_t filter(P pred, uchar* edge_start, const uintE& source,
+                     const uintE& degree, std::tuple<uintE, W>* tmp, O& out) {
+  size_t out_ct = 0;
+  if (degree > 0) {
+    auto f = [&](const uintE& src, const uintE& ngh, const W& wgh, size_t k) {
+      if (pred(src, ngh, wgh)) {
+        out(out_ct++, std::make_tuple(ngh, wgh));
+      }
+      return true;
+    };
+    decode<W>(f, edge_start, source, degree);
+  }
+  return out_ct;
+}
+
+}  // namespace group_varint
+}  // namespace gbbs
@@ -0,0 +1,406 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Interval-aware (WebGraph-style) encoding: adjacency lists of web-like
+// graphs contain long runs of consecutive ids, which pure delta coding
+// spends one byte per edge on. Here, after a signed varint first edge, the
+// list is a stream of tokens: a varint whose low bit selects between a
+// plain delta (value >> 1, applied to the previous neighbor) and an
+// interval (a run of (value >> 1) neighbors each one greater than its
+// predecessor), so a run of any length costs a couple of bytes. Runs
+// shorter than kMinRun are not worth a token and stay delta-coded.
+// Weighted lists store each edge's weight inline after the token that
+// introduces it (interval tokens are followed by one weight per covered
+// edge), so intervals mainly pay off for unweighted topology.
+
+#pragma once
+
+#include <cassert>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <cmath>
+#include <tuple>
+#include <type_traits>
+
+#include "gbbs/bridge.h"
+#include "gbbs/macros.h"
+
+namespace gbbs {
+namespace interval_byte {
+
+// Minimum length of a consecutive run before it is emitted as an interval.
+constexpr size_t kMinRun = 3;
+
+inline size_t get_virtual_degree(uintE d, uchar* nghArr) { return d; }
+
+template <class W, typename std::enable_if<std::is_same<W, pbbslib::empty>::value,
+                                           int>::type = 0>
+inline pbbslib::empty eatWeight(uchar*& start) {
+  return pbbslib::empty();
+}
+
+template <class W,
+          typename std::enable_if<std::is_same<W, intE>::value, int>::type = 0>
+inline intE eatWeight(uchar*& start) {
+  uchar fb = *start++;
+  intE edgeRead = (fb & 0x3f);
+  if (LAST_BIT_SET(fb)) {
+    int shiftAmount = 6;
+    while (1) {
+      uchar b = *start;
+      edgeRead |= ((b & 0x7f) << shiftAmount);
+      start++;
+      if (LAST_BIT_SET(b))
+        shiftAmount += EDGE_SIZE_PER_BYTE;
+      else
+        break;
+    }
+  }
+  return (fb & 0x40) ? -edgeRead : edgeRead;
+}
+
+inline uintE eatFirstEdge(uchar*& start, uintE source) {
+  uchar fb = *start++;
+  uintE edgeRead = (fb & 0x3f);
+  if (LAST_BIT_SET(fb)) {
+    int shiftAmount = 6;
+    while (1) {
+      uchar b = *start;
+      edgeRead |= ((b & 0x7f) << shiftAmount);
+      start++;
+      if (LAST_BIT_SET(b))
+        shiftAmount += EDGE_SIZE_PER_BYTE;
+      else
+        break;
+    }
+  }
+  return (fb & 0x40) ? source - edgeRead : source + edgeRead;
+}
+
+// Unsigned continuation-bit varint (token values).
+inline uintE eatToken(uchar*& start) {
+  uintE read = 0;
+  int shiftAmount = 0;
+  while (1) {
+    uchar b = *start++;
+    read += ((b & 0x7f) << shiftAmount);
+    if (LAST_BIT_SET(b))
+      shiftAmount += EDGE_SIZE_PER_BYTE;
+    else
+      break;
+  }
+  return read;
+}
+
+inline long compressFirstEdge(uchar* start, long offset, long source,
+                              long target) {
+  long diff = target - source;
+  long preCompress = diff;
+  uchar firstByte = 0;
+  uintE toCompress = std::abs(preCompress);
+  firstByte = toCompress & 0x3f;
+  if (preCompress < 0) {
+    firstByte |= 0x40;
+  }
+  toCompress = toCompress >> 6;
+  if (toCompress > 0) {
+    firstByte |= 0x80;
+  }
+  start[offset++] = firstByte;
+  uchar curByte = toCompress & 0x7f;
+  while ((curByte > 0) || (toCompress > 0)) {
+    uchar toWrite = curByte;
+    toCompress = toCompress >> 7;
+    curByte = toCompress & 0x7f;
+    if ((curByte > 0) || (toCompress > 0)) {
+      toWrite |= 0x80;
+    }
+    start[offset++] = toWrite;
+  }
+  return offset;
+}
+
+inline long compressToken(uchar* start, long offset, uintE value) {
+  do {
+    uchar toWrite = value & 0x7f;
+    value = value >> 7;
+    if (value > 0) {
+      toWrite |= 0x80;
+    }
+    start[offset++] = toWrite;
+  } while (value > 0);
+  return offset;
+}
+
+template <class W,
+          typename std::enable_if<!std::is_same<W, intE>::value, int>::type = 0>
+inline long compressWeight(uchar* start, long offset, W weight) {
+  return offset;
+}
+
+template <class W,
+          typename std::enable_if<std::is_same<W, intE>::value, int>::type = 0>
+inline long compressWeight(uchar* start, long offset, W weight) {
+  return compressFirstEdge(start, offset, 0, weight);
+}
+
+// Compresses a neighbor list given an iter with cur()/next(), detecting
+// consecutive runs and emitting interval tokens for those of length
+// >= kMinRun. Token = (delta << 1) for a plain delta, (len << 1) | 1 for an
+// interval of len consecutive ids.
+template <class W, class I>
+inline long sequentialCompressEdgeSet(uchar* edgeArray, long currentOffset,
+                                      uintE deg, uintE src, I& it) {
+  if (deg > 0) {
+    // Materialize the ids to allow run lookahead.
+    uintE stack_nghs[128];
+    uintE* nghs =
+        (deg <= 128) ? stack_nghs : pbbslib::new_array_no_init<uintE>(deg);
+    W stack_wghs[128];
+    W* wghs = (deg <= 128) ? stack_wghs : pbbslib::new_array_no_init<W>(deg);
+    nghs[0] = std::get<0>(it.cur());
+    wghs[0] = std::get<1>(it.cur());
+    for (size_t i = 1; i < deg; i++) {
+      nghs[i] = std::get<0>(it.next());
+      wghs[i] = std::get<1>(it.cur());
+    }
+
+    currentOffset = compressFirstEdge(edgeArray, currentOffset, src, nghs[0]);
+    currentOffset = compressWeight<W>(edgeArray, currentOffset, wghs[0]);
+    size_t i = 1;
+    while (i < deg) {
+      // length of the consecutive run starting at i (relative to nghs[i-1])
+      size_t run = 0;
+      while (i + run < deg && nghs[i + run] == nghs[i - 1] + run + 1) {
+        run++;
+      }
+      if (run >= kMinRun) {
+        currentOffset = compressToken(edgeArray, currentOffset,
+                                      (static_cast<uintE>(run) << 1) | 1);
+        for (size_t j = 0; j < run; j++) {
+          currentOffset =
+              compressWeight<W>(edgeArray, currentOffset, wghs[i + j]);
+        }
+        i += run;
+      } else {
+        uintE delta = nghs[i] - nghs[i - 1];
+        currentOffset = compressToken(edgeArray, currentOffset, delta << 1);
+        currentOffset = compressWeight<W>(edgeArray, currentOffset, wghs[i]);
+        i++;
+      }
+    }
+    if (nghs != stack_nghs) pbbslib::free_array(nghs);
+    if (wghs != stack_wghs) pbbslib::free_array(wghs);
+  }
+  return currentOffset;
+}
+
+template <class W, class T>
+inline void decode(T t, uchar* edgeStart, const uintE& source,
+                   const uintT& degree) {
+  if (degree > 0) {
+    uintE ngh = eatFirstEdge(edgeStart, source);
+    W wgh = eatWeight<W>(edgeStart);
+    if (!t(source, ngh, wgh, 0)) {
+      return;
+    }
+    size_t i = 1;
+    while (i < degree) {
+      uintE token = eatToken(edgeStart);
+      if (token & 1) {  // interval of consecutive ids
+        size_t run = token >> 1;
+        for (size_t j = 0; j < run; j++) {
+          ngh += 1;
+          wgh = eatWeight<W>(edgeStart);
+          if (!t(source, ngh, wgh, i + j)) {
+            return;
+          }
+        }
+        i += run;
+      } else {
+        ngh += (token >> 1);
+        wgh = eatWeight<W>(edgeStart);
+        if (!t(source, ngh, wgh, i)) {
+          return;
+        }
+        i++;
+      }
+    }
+  }
+}
+
+template <class W>
+inline std::tuple<uintE, W> get_ith_neighbor(uchar* edge_start, uintE source,
+                                             uintE degree, size_t i) {
+  std::tuple<uintE, W> result;
+  auto f = [&](const uintE& src, const uintE& ngh, const W& wgh, size_t k) {
+    if (k == i) {
+      result = std::make_tuple(ngh, wgh);
+      return false;
+    }
+    return true;
+  };
+  decode<W>(f, edge_start, source, degree);
+  return result;
+}
+
+template <class W, class M, class Monoid>
+inline typename Monoid::T map_reduce(uchar* edge_start, const uintE& source,
+                                     const uintT& degree, M& m, Monoid& reduce,
+                                     const bool par = true) {
+  using E = typename Monoid::T;
+  E cur = reduce.identity;
+  auto f = [&](const uintE& src, const uintE& ngh, const W& wgh, size_t k) {
+    cur = reduce.f(cur, m(src, ngh, wgh));
+    return true;
+  };
+  decode<W>(f, edge_start, source, degree);
+  return cur;
+}
+
+template <class W>
+struct iter {
+  uchar* finger;
+  uintE src;
+  std::tuple<uintE, W> last_edge;
+  uintE degree;
+  uintE proc;
+  uintE run_remaining;  // edges left in the current interval
+
+  iter(uchar* _finger, uintT _degree, uintE _src)
+      : finger(_finger), src(_src), degree(_degree), proc(0),
+        run_remaining(0) {
+    if (degree > 0) {
+      std::get<0>(last_edge) = eatFirstEdge(finger, src);
+      std::get<1>(last_edge) = eatWeight<W>(finger);
+      proc = 1;
+    }
+  }
+
+  inline std::tuple<uintE, W> cur() { return last_edge; }
+
+  inline std::tuple<uintE, W> next() {
+    if (run_remaining > 0) {
+      std::get<0>(last_edge) += 1;
+      run_remaining--;
+    } else {
+      uintE token = eatToken(finger);
+      if (token & 1) {
+        run_remaining = (token >> 1) - 1;
+        std::get<0>(last_edge) += 1;
+      } else {
+        std::get<0>(last_edge) += (token >> 1);
+      }
+    }
+    std::get<1>(last_edge) = eatWeight<W>(finger);
+    proc++;
+    return last_edge;
+  }
+
+  inline bool has_next() { return proc < degree; }
+};
+
+template <class W>
+inline size_t intersect(uchar* l1, uchar* l2, uintE l1_size, uintE l2_size,
+                        uintE l1_src, uintE l2_src) {
+  if (l1_size == 0 || l2_size == 0) return 0;
+  auto it_1 = iter<W>(l1, l1_size, l1_src);
+  auto it_2 = iter<W>(l2, l2_size, l2_src);
+  size_t i = 0, j = 0, ct = 0;
+  while (i < l1_size && j < l2_size) {
+    uintE e1 = std::get<0>(it_1.cur());
+    uintE e2 = std::get<0>(it_2.cur());
+    if (e1 == e2) {
+      i++, j++, ct++;
+      if (it_1.has_next()) it_1.next();
+      if (it_2.has_next()) it_2.next();
+    } else if (e1 < e2) {
+      i++;
+      if (it_1.has_next()) it_1.next();
+    } else {
+      j++;
+      if (it_2.has_next()) it_2.next();
+    }
+  }
+  return ct;
+}
+
+template <class W, class F>
+inline size_t intersect_f(uchar* l1, uchar* l2, uintE l1_size, uintE l2_size,
+                          uintE l1_src, uintE l2_src, const F& f) {
+  if (l1_size == 0 || l2_size == 0) return 0;
+  auto it_1 = iter<W>(l1, l1_size, l1_src);
+  auto it_2 = iter<W>(l2, l2_size, l2_src);
+  size_t i = 0, j = 0, ct = 0;
+  while (i < l1_size && j < l2_size) {
+    uintE e1 = std::get<0>(it_1.cur());
+    uintE e2 = std::get<0>(it_2.cur());
+    if (e1 == e2) {
+      f(l1_src, l2_src, e1);
+      i++, j++, ct++;
+      if (it_1.has_next()) it_1.next();
+      if (it_2.has_next()) it_2.next();
+    } else if (e1 < e2) {
+      i++;
+      if (it_1.has_next()) it_1.next();
+    } else {
+      j++;
+      if (it_2.has_next()) it_2.next();
+    }
+  }
+  return ct;
+}
+
+// In-place packing is not supported for the interval format: removing
+// elements from a long consecutive run replaces a ~2-byte interval token
+// with per-edge delta tokens, so the re-encoded list can be arbitrarily
+// larger than the vertex's arena slot. Filter into an uncompressed output
+// (below) and rebuild instead.
+template <class W, class P>
+inline size_t pack(P& pred, uchar* edge_start, const uintE& source,
+                   const uintE& degree, std::tuple<uintE, W>* tmp,
+                   bool par = true) {
+  assert(false);  // Unimplemented for the interval encoding; see above.
+  exit(-1);
+  return 0;
+}
+
+template <class W, class P, class O>
+inline size_t filter(P pred, uchar* edge_start, const uintE& source,
+                     const uintE& degree, std::tuple<uintE, W>* tmp, O& out) {
+  size_t out_ct = 0;
+  if (degree > 0) {
+    auto f = [&](const uintE& src, const uintE& ngh, const W& wgh, size_t k) {
+      if (pred(src, ngh, wgh)) {
+        out(out_ct++, std::make_tuple(ngh, wgh));
+      }
+      return true;
+    };
+    decode<W>(f, edge_start, source, degree);
+  }
+  return out_ct;
+}
+
+}  // namespace interval_byte
+}  // namespace gbbs
@@ -16,6 +16,11 @@ const flags in_edges = 128;  // map over in edges instead of out edges
 const flags fine_parallel = 256; // split to a node-size of 1
 const flags compact_blocks = 512; // used in SAGE
 const flags dense_only  = 1024;
+const flags pipelined = 2048;  // streamed sparse traversal (edgeMapPipelined)
+const flags tolerate_duplicates = 4096;  // frontier may contain repeated ids; see dedup_stamps
+// semi-external: madvise(WILLNEED) the frontier's edge blocks before a
+// sparse traversal, turning demand-paged 4KB faults into batched readahead
+const flags prefetch_edges = 8192;
 inline bool should_output(const flags& fl) { return !(fl & no_output); }
 
 }  // namespace gbbs
@@ -97,6 +97,115 @@ struct symmetric_graph {
     }, granularity);
   }
 
+  // Byte range of v's edge storage, for semi-external prefetch. Offsets
+  // are edge-indexed for uncompressed graphs and byte-indexed for the
+  // compressed encodings; the end comes from the next vertex's offset.
+  std::pair<char*, size_t> edge_range_bytes(uintE v, bool inn = false) {
+    (void)inn;  // symmetric: in- and out-edges coincide
+    size_t unit = std::is_same<vertex, symmetric_vertex<W>>::value
+                      ? sizeof(edge_type)
+                      : 1;
+    size_t start = (size_t)v_data[v].offset * unit;
+    size_t end = (v + 1 < n) ? (size_t)v_data[v + 1].offset * unit
+                             : start + (size_t)v_data[v].degree * unit;
+    return std::make_pair((char*)e0 + start, end - start);
+  }
+
+  // ======== Cached degree histogram ========
+  //
+  // Log-scale degree distribution (bucket b counts vertices with degree in
+  // [2^(b-1), 2^b); bucket 0 is degree 0), used by the adaptive-threshold
+  // policies (direction optimization, granularity, bucket counts).
+  // Computed once per graph instance and cached; loaders that persist the
+  // histogram (snapshot format, compressor side file) install it at load
+  // time so no O(n) scan ever runs.
+  static constexpr size_t kDegreeHistBuckets = 64;
+  uint64_t* degree_hist = nullptr;  // kDegreeHistBuckets entries when set
+
+  const uint64_t* degree_histogram() {
+    if (degree_hist == nullptr) {
+      auto hist = pbbs::new_array_no_init<uint64_t>(kDegreeHistBuckets);
+      for (size_t b = 0; b < kDegreeHistBuckets; b++) hist[b] = 0;
+      for (size_t i = 0; i < n; i++) {
+        size_t d = v_data[i].degree;
+        size_t b = (d == 0) ? 0 : (size_t)pbbslib::log2_up(d + 1);
+        pbbs::fetch_and_add(&hist[std::min(b, kDegreeHistBuckets - 1)],
+                            (uint64_t)1);
+      }
+      degree_hist = hist;
+    }
+    return degree_hist;
+  }
+
+  // Installs a precomputed histogram (takes ownership).
+  void set_degree_histogram(uint64_t* hist) { degree_hist = hist; }
+
+  // ======== Finger index for repeated membership queries ========
+  //
+  // Optional per-vertex skip index: every kFingerSampleRate-th neighbor id
+  // is sampled into one flat array (contiguous alongside v_data's offsets,
+  // so the samples for a vertex are one or two cache lines). has_neighbor
+  // scans the resident samples to pick a 64-entry window and binary
+  // searches only inside it -- the log(d) cold misses of a full binary
+  // search on a hub's adjacency become one sample-line read plus a
+  // one-window search. Built on demand (uncompressed graphs only); freed
+  // with del_finger_index. Rebuild after any mutation of the edge arrays.
+  static constexpr uintE kFingerSampleRate = 64;
+  uintT* finger_offsets = nullptr;  // n + 1
+  uintE* finger_samples = nullptr;
+
+  void build_finger_index() {
+    auto offs = pbbs::sequence<uintT>(n + 1, [&](size_t i) {
+      if (i == n) return (uintT)0;
+      return (uintT)(get_vertex(i).out_degree() / kFingerSampleRate);
+    });
+    size_t total = pbbslib::scan_add_inplace(offs.slice());
+    auto samples = pbbs::new_array_no_init<uintE>(std::max<size_t>(total, 1));
+    parallel_for(0, n, [&](size_t i) {
+      auto nghs = get_vertex(i).out_neighbors();
+      size_t ns = offs[i + 1] - offs[i];
+      for (size_t b = 0; b < ns; b++) {
+        samples[offs[i] + b] = nghs.get_neighbor(b * kFingerSampleRate);
+      }
+    });
+    finger_offsets = offs.to_array();
+    finger_samples = samples;
+  }
+
+  void del_finger_index() {
+    if (finger_offsets) { pbbs::free_array(finger_offsets); finger_offsets = nullptr; }
+    if (finger_samples) { pbbs::free_array(finger_samples); finger_samples = nullptr; }
+  }
+
+  // Membership query; consults the finger index when built.
+  bool has_neighbor(uintE u, uintE v) {
+    auto nghs = get_vertex(u).out_neighbors();
+    uintE d = nghs.degree;
+    if (d == 0) return false;
+    size_t lo = 0, hi = d;
+    if (finger_offsets != nullptr) {
+      uintT s0 = finger_offsets[u], s1 = finger_offsets[u + 1];
+      size_t ns = s1 - s0;
+      // the samples are contiguous and few; a forward scan stays in cache
+      size_t cnt = 0;
+      while (cnt < ns && finger_samples[s0 + cnt] <= v) cnt++;
+      if (cnt == 0) {  // v precedes the first sampled id
+        hi = std::min<size_t>(kFingerSampleRate, d);
+      } else {
+        lo = (cnt - 1) * (size_t)kFingerSampleRate;
+        hi = (cnt == ns) ? d : cnt * (size_t)kFingerSampleRate;
+      }
+    }
+    while (lo < hi) {
+      size_t mid = lo + (hi - lo) / 2;
+      uintE x = nghs.get_neighbor(mid);
+      if (x == v) return true;
+      if (x < v) lo = mid + 1;
+      else hi = mid;
+    }
+    return false;
+  }
+
   template <class M, class R>
   typename R::T reduceEdges(M map_f, R reduce_f) {
     using T = typename R::T;
@@ -357,6 +466,41 @@ struct asymmetric_graph {
   }
 #endif
 
+  // Cached out-degree histogram; see the symmetric overload.
+  static constexpr size_t kDegreeHistBuckets = 64;
+  uint64_t* degree_hist = nullptr;
+
+  const uint64_t* degree_histogram() {
+    if (degree_hist == nullptr) {
+      auto hist = pbbs::new_array_no_init<uint64_t>(kDegreeHistBuckets);
+      for (size_t b = 0; b < kDegreeHistBuckets; b++) hist[b] = 0;
+      for (size_t i = 0; i < n; i++) {
+        size_t d = v_out_data[i].degree;
+        size_t b = (d == 0) ? 0 : (size_t)pbbslib::log2_up(d + 1);
+        pbbs::fetch_and_add(&hist[std::min(b, kDegreeHistBuckets - 1)],
+                            (uint64_t)1);
+      }
+      degree_hist = hist;
+    }
+    return degree_hist;
+  }
+
+  void set_degree_histogram(uint64_t* hist) { degree_hist = hist; }
+
+  // Byte range of v's edge storage, for semi-external prefetch (see the
+  // symmetric overload). inn selects the in-edge arrays.
+  std::pair<char*, size_t> edge_range_bytes(uintE v, bool inn = false) {
+    size_t unit = std::is_same<vertex, asymmetric_vertex<W>>::value
+                      ? sizeof(edge_type)
+                      : 1;
+    vertex_data* vd = inn ? v_in_data : v_out_data;
+    char* base = (char*)(inn ? in_edges_0 : out_edges_0);
+    size_t start = (size_t)vd[v].offset * unit;
+    size_t end = (v + 1 < n) ? (size_t)vd[v + 1].offset * unit
+                             : start + (size_t)vd[v].degree * unit;
+    return std::make_pair(base + start, end - start);
+  }
+
   asymmetric_graph()
       : n(0),
         m(0),
@@ -530,6 +674,88 @@ static inline symmetric_graph<symmetric_vertex, Wgh> sym_graph_from_edges(
   return sym_graph_from_edges<Wgh>(A, n, get_u, get_v, get_w, is_sorted);
 }
 
+// Estimates (by sampling) whether the edge sequence is already (nearly)
+// clustered by source, i.e., most adjacent pairs have non-decreasing
+// sources. Such inputs do not need the global integer sort in
+// sym_graph_from_edges.
+template <class EdgeSeq, class GetU>
+static inline bool edges_nearly_clustered(EdgeSeq& A, GetU&& get_u) {
+  size_t m = A.size();
+  if (m < 2) return true;
+  constexpr size_t kSamples = 1000;
+  size_t samples = std::min<size_t>(kSamples, m - 1);
+  size_t in_order = 0;
+  for (size_t s = 0; s < samples; s++) {
+    size_t i = pbbslib::hash64(s) % (m - 1);
+    in_order += (get_u(A[i]) <= get_u(A[i + 1]));
+  }
+  return in_order >= (samples - samples / 10);  // >= 90% in order
+}
+
+// Builder for edge sequences that arrive pre-clustered by source: a counting
+// pass and a scatter by source replace the global sort (one O(m) pass each,
+// with good locality when the input really is clustered), and each vertex's
+// neighbor list is then sorted independently. Falls back to the sorting
+// builder when sampling says the input is not clustered.
+template <class Wgh, class EdgeSeq, class GetU, class GetV, class GetW>
+static inline symmetric_graph<symmetric_vertex, Wgh>
+sym_graph_from_edges_clustered(EdgeSeq& A, size_t n, GetU&& get_u,
+                               GetV&& get_v, GetW&& get_w) {
+  using vertex = symmetric_vertex<Wgh>;
+  using edge_type = typename vertex::edge_type;
+  using neighbor = std::tuple<uintE, Wgh>;
+  size_t m = A.size();
+
+  if (m == 0 || !edges_nearly_clustered(A, get_u)) {
+    return sym_graph_from_edges<Wgh>(A, n, get_u, get_v, get_w, false);
+  }
+
+  // 1. Per-source degree counts.
+  auto offsets = sequence<uintT>(n + 1, (uintT)0);
+  parallel_for(0, m, [&](size_t i) {
+    pbbslib::fetch_and_add(&offsets[get_u(A[i])], (uintT)1);
+  });
+  pbbslib::scan_add_inplace(offsets.slice());
+
+  // 2. Scatter each edge to its source's range (order within a range is
+  // arbitrary here and fixed up by the per-vertex sort below).
+  auto cursors = sequence<uintT>(n, [&](size_t i) { return offsets[i]; });
+  auto edges = pbbs::new_array_no_init<neighbor>(m);
+  parallel_for(0, m, [&](size_t i) {
+    uintE u = get_u(A[i]);
+    uintT pos = pbbslib::fetch_and_add(&cursors[u], (uintT)1);
+    edges[pos] = std::make_tuple(get_v(A[i]), get_w(A[i]));
+  });
+
+  // 3. Sort each neighbor list by id.
+  parallel_for(0, n, [&](size_t i) {
+    std::sort(edges + offsets[i], edges + offsets[i + 1],
+              [](const neighbor& l, const neighbor& r) {
+                return std::get<0>(l) < std::get<0>(r);
+              });
+  }, 1);
+
+  auto v_data = pbbs::new_array_no_init<vertex_data>(n);
+  parallel_for(0, n, [&](size_t i) {
+    v_data[i].offset = offsets[i];
+    v_data[i].degree = (uintE)(offsets[i + 1] - offsets[i]);
+  });
+  return symmetric_graph<symmetric_vertex, Wgh>(
+      v_data, n, m, [=]() { pbbslib::free_arrays(v_data, edges); },
+      (edge_type*)edges);
+}
+
+template <class Wgh>
+static inline symmetric_graph<symmetric_vertex, Wgh>
+sym_graph_from_edges_clustered(
+    pbbs::sequence<std::tuple<uintE, uintE, Wgh>>& A, size_t n) {
+  using edge = std::tuple<uintE, uintE, Wgh>;
+  auto get_u = [&](const edge& e) { return std::get<0>(e); };
+  auto get_v = [&](const edge& e) { return std::get<1>(e); };
+  auto get_w = [&](const edge& e) { return std::get<2>(e); };
+  return sym_graph_from_edges_clustered<Wgh>(A, n, get_u, get_v, get_w);
+}
+
 
 
 template <class Wgh, class EdgeSeq, class GetU, class GetV, class GetW>
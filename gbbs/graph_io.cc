@@ -201,12 +201,18 @@ asymmetric_graph<asymmetric_vertex, pbbslib::empty> read_unweighted_asymmetric_g
 }
 
 std::tuple<char*, size_t> parse_compressed_graph(
-    const char* fname, bool mmap, bool mmapcopy) {
+    const char* fname, bool mmap, bool mmapcopy, bool prefetch) {
   char* bytes;
   size_t bytes_size;
 
   if (mmap) {
     std::tie(bytes, bytes_size) = mmapStringFromFile(fname);
+    advise_mmap_sequential(bytes, bytes_size);
+    if (prefetch && !mmapcopy) {
+      // Fault the whole file in with parallel readahead streams instead of
+      // relying on the single default readahead window.
+      parallel_prefetch_mmap(bytes, bytes_size);
+    }
     if (mmapcopy) {
       debug(std::cout << "# Copying compressed graph due to mmapcopy being set."
                 << "\n";);
@@ -232,14 +238,18 @@ read_unweighted_edge_list(const char* filename) {
     std::cout << "ERROR: Unable to open file: " << filename << '\n';
     std::terminate();
   }
-  internal::skip_ifstream_comments(&file);
+  file.close();
 
-  std::vector<Edge<pbbslib::empty>> edge_list;
-  uintE from;
-  uintE to;
-  while (file >> from >> to) {
-    edge_list.emplace_back(from, to);
-  }
+  // Parse in parallel over newline-aligned chunks.
+  char* bytes;
+  size_t bytes_size;
+  std::tie(bytes, bytes_size) = mmapStringFromFile(filename);
+  auto edges =
+      internal::parse_edge_list_chunked<pbbslib::empty>(bytes, bytes_size);
+  unmmap(bytes, bytes_size);
+
+  std::vector<Edge<pbbslib::empty>> edge_list(edges.size());
+  parallel_for(0, edges.size(), [&](size_t i) { edge_list[i] = edges[i]; });
   return edge_list;
 }
 
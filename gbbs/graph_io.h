@@ -121,7 +121,7 @@ asymmetric_graph<asymmetric_vertex, pbbslib::empty> read_unweighted_asymmetric_g
     size_t bytes_size = std::numeric_limits<size_t>::max());
 
 std::tuple<char*, size_t> parse_compressed_graph(
-    const char* fname, bool mmap, bool mmapcopy);
+    const char* fname, bool mmap, bool mmapcopy, bool prefetch = false);
 
 template <class weight_type>
 symmetric_graph<symmetric_vertex, weight_type> read_weighted_symmetric_graph(
@@ -226,12 +226,19 @@ asymmetric_graph<asymmetric_vertex, weight_type> read_weighted_asymmetric_graph(
   return asymmetric_graph<asymmetric_vertex, weight_type>(v_data, v_in_data, n, m, [=]() { pbbslib::free_arrays(v_data, v_in_data, edges, inEdges); }, edges, inEdges);
 }
 
-template <class weight_type>
-symmetric_graph<csv_bytepd_amortized, weight_type>
-read_compressed_symmetric_graph(const char* fname, bool mmap, bool mmapcopy) {
+// The vertex type (and with it the encoding policy) is a template
+// parameter, so one binary can host graphs in several encodings at once;
+// the container layout (sizes, offsets, degrees, edge bytes) is shared by
+// all byte encodings and the default remains byte_pd_amortized.
+template <class weight_type,
+          template <class W> class vertex_type = csv_bytepd_amortized>
+symmetric_graph<vertex_type, weight_type>
+read_compressed_symmetric_graph(const char* fname, bool mmap, bool mmapcopy,
+                                bool prefetch = false) {
   char* bytes;
   size_t bytes_size;
-  std::tie(bytes, bytes_size) = parse_compressed_graph(fname, mmap, mmapcopy);
+  std::tie(bytes, bytes_size) =
+      parse_compressed_graph(fname, mmap, mmapcopy, prefetch);
 
   long* sizes = (long*)bytes;
   uint64_t n = sizes[0], m = sizes[1];
@@ -259,16 +266,19 @@ read_compressed_symmetric_graph(const char* fname, bool mmap, bool mmapcopy) {
       unmmap(bytes, bytes_size);
     };
   }
-  symmetric_graph<csv_bytepd_amortized, weight_type> G(v_data, n, m, deletion_fn, edges);
+  symmetric_graph<vertex_type, weight_type> G(v_data, n, m, deletion_fn, edges);
   return G;
 }
 
-template <class weight_type>
-asymmetric_graph<cav_bytepd_amortized, weight_type>
-read_compressed_asymmetric_graph(const char* fname, bool mmap, bool mmapcopy) {
+template <class weight_type,
+          template <class W> class vertex_type = cav_bytepd_amortized>
+asymmetric_graph<vertex_type, weight_type>
+read_compressed_asymmetric_graph(const char* fname, bool mmap, bool mmapcopy,
+                                 bool prefetch = false) {
   char* bytes;
   size_t bytes_size;
-  std::tie(bytes, bytes_size) = parse_compressed_graph(fname, mmap, mmapcopy);
+  std::tie(bytes, bytes_size) =
+      parse_compressed_graph(fname, mmap, mmapcopy, prefetch);
 
   long* sizes = (long*)bytes;
   uint64_t n = sizes[0], m = sizes[1], totalSpace = sizes[2];
@@ -317,10 +327,310 @@ read_compressed_asymmetric_graph(const char* fname, bool mmap, bool mmapcopy) {
     };
   }
 
-  asymmetric_graph<cav_bytepd_amortized, weight_type> G(v_data, v_in_data, n, m, deletion_fn, edges, inEdges);
+  asymmetric_graph<vertex_type, weight_type> G(v_data, v_in_data, n, m, deletion_fn, edges, inEdges);
   return G;
 }
 
+// ======================== Graph snapshots ==============================
+//
+// A versioned, page-aligned binary snapshot of an uncompressed symmetric
+// graph, laid out exactly as symmetric_graph expects in memory:
+//   [snapshot_header][pad][vertex_data x n][pad][edge_type x m]
+// map_graph_snapshot() constructs the graph directly over an mmap of the
+// file with zero copies; pages fault in lazily as the algorithm touches
+// them, so a snapshot becomes usable immediately.
+
+constexpr uint64_t kSnapshotMagic = 0x67626273736e7031ULL;  // "gbbssnp1"
+constexpr uint64_t kSnapshotVersion = 1;
+constexpr size_t kSnapshotAlign = 4096;
+
+struct snapshot_header {
+  uint64_t magic;
+  uint64_t version;
+  uint64_t n;
+  uint64_t m;
+  uint64_t weight_bytes;   // sizeof(W), 0 for pbbslib::empty
+  uint64_t vdata_offset;   // byte offset of the vertex_data array
+  uint64_t edges_offset;   // byte offset of the edge array
+};
+
+inline size_t snapshot_align_up(size_t x) {
+  return ((x + kSnapshotAlign - 1) / kSnapshotAlign) * kSnapshotAlign;
+}
+
+template <class weight_type>
+void write_graph_snapshot(symmetric_graph<symmetric_vertex, weight_type>& G,
+                          const char* fname) {
+  using edge_type = typename symmetric_vertex<weight_type>::edge_type;
+  snapshot_header h;
+  h.magic = kSnapshotMagic;
+  h.version = kSnapshotVersion;
+  h.n = G.n;
+  h.m = G.m;
+  h.weight_bytes =
+      std::is_same<weight_type, pbbslib::empty>::value ? 0 : sizeof(weight_type);
+  h.vdata_offset = snapshot_align_up(sizeof(snapshot_header));
+  h.edges_offset =
+      snapshot_align_up(h.vdata_offset + G.n * sizeof(vertex_data));
+
+  std::ofstream out(fname, std::ofstream::out | std::ios::binary);
+  if (!out.is_open()) {
+    std::cout << "Unable to open snapshot file for writing: " << fname
+              << std::endl;
+    abort();
+  }
+  out.write((char*)&h, sizeof(h));
+  out.seekp(h.vdata_offset);
+  out.write((char*)G.v_data, G.n * sizeof(vertex_data));
+  out.seekp(h.edges_offset);
+  out.write((char*)G.e0, G.m * sizeof(edge_type));
+  // trailing degree-histogram section (readers treat it as optional, so
+  // older snapshots stay loadable)
+  auto hist = G.degree_histogram();
+  out.write((const char*)hist,
+            symmetric_graph<symmetric_vertex,
+                            weight_type>::kDegreeHistBuckets *
+                sizeof(uint64_t));
+  out.close();
+}
+
+// Constructs a graph over an mmap of a snapshot file. No arrays are copied
+// or rebuilt; the mapping is released by the graph's deletion_fn.
+template <class weight_type>
+symmetric_graph<symmetric_vertex, weight_type> map_graph_snapshot(
+    const char* fname) {
+  using edge_type = typename symmetric_vertex<weight_type>::edge_type;
+  char* bytes;
+  size_t bytes_size;
+  std::tie(bytes, bytes_size) = mmapStringFromFile(fname);
+
+  snapshot_header* h = (snapshot_header*)bytes;
+  if (h->magic != kSnapshotMagic) {
+    std::cout << "Not a gbbs snapshot file: " << fname << std::endl;
+    abort();
+  }
+  if (h->version != kSnapshotVersion) {
+    std::cout << "Unsupported snapshot version: " << h->version << std::endl;
+    abort();
+  }
+  size_t expected_weight_bytes =
+      std::is_same<weight_type, pbbslib::empty>::value ? 0 : sizeof(weight_type);
+  if (h->weight_bytes != expected_weight_bytes) {
+    std::cout << "Snapshot weight size mismatch: file has " << h->weight_bytes
+              << " bytes/weight" << std::endl;
+    abort();
+  }
+
+  auto v_data = (vertex_data*)(bytes + h->vdata_offset);
+  auto edges = (edge_type*)(bytes + h->edges_offset);
+  size_t n = h->n, m = h->m;
+  auto G = symmetric_graph<symmetric_vertex, weight_type>(
+      v_data, n, m, [bytes, bytes_size]() { unmmap(bytes, bytes_size); },
+      edges);
+  // optional trailing degree-histogram section: install it so load-time
+  // policy decisions never pay a degree scan
+  using graph_t = symmetric_graph<symmetric_vertex, weight_type>;
+  size_t hist_bytes = graph_t::kDegreeHistBuckets * sizeof(uint64_t);
+  size_t edges_end = h->edges_offset + m * sizeof(edge_type);
+  if (bytes_size >= edges_end + hist_bytes) {
+    auto hist = pbbs::new_array_no_init<uint64_t>(graph_t::kDegreeHistBuckets);
+    memcpy(hist, bytes + edges_end, hist_bytes);
+    G.set_degree_histogram(hist);
+  }
+  return G;
+}
+
+// Reads a weighted graph from a pair of binary files: a topology file of
+// 2m uint32 endpoints (u0 v0 u1 v1 ...) and a separate weight file of m
+// weights (typically float) aligned by edge index. Both files are mmap'd
+// and consumed directly -- no text parsing, and weights keep their exact
+// binary values instead of round-tripping through decimal formatting. The
+// edge list must already contain both directions of each edge (the usual
+// symmetric convention); pass n = 0 to infer it from the max endpoint.
+template <class weight_type>
+symmetric_graph<symmetric_vertex, weight_type>
+read_binary_weighted_sym_graph(const char* edge_fname, const char* wgh_fname,
+                               size_t n = 0) {
+  char* ebytes;
+  size_t ebytes_size;
+  std::tie(ebytes, ebytes_size) = mmapStringFromFile(edge_fname);
+  char* wbytes;
+  size_t wbytes_size;
+  std::tie(wbytes, wbytes_size) = mmapStringFromFile(wgh_fname);
+
+  size_t m = ebytes_size / (2 * sizeof(uintE));
+  if (wbytes_size / sizeof(weight_type) < m) {
+    std::cout << "Weight file too small: " << wbytes_size << " bytes for "
+              << m << " edges" << std::endl;
+    abort();
+  }
+  auto endpoints = (const uintE*)ebytes;
+  auto weights = (const weight_type*)wbytes;
+
+  if (n == 0) {
+    auto max_f = pbbslib::make_sequence<uintE>(
+        2 * m, [&](size_t i) { return endpoints[i]; });
+    n = pbbslib::reduce_max(max_f) + 1;
+  }
+
+  using edge = std::tuple<uintE, uintE, weight_type>;
+  auto A = pbbs::sequence<edge>(m, [&](size_t i) {
+    return std::make_tuple(endpoints[2 * i], endpoints[2 * i + 1], weights[i]);
+  });
+  unmmap(ebytes, ebytes_size);
+  unmmap(wbytes, wbytes_size);
+  return sym_graph_from_edges<weight_type>(A, n, false);
+}
+
+// Sniffs a graph file's on-disk format from its leading bytes, so one
+// binary can host every encoding (the wrong-binary-for-format class of
+// operational incident disappears). Text adjacency files start with the
+// "AdjacencyGraph"/"WeightedAdjacencyGraph" banner, snapshots carry their
+// magic, and the compressed container (which predates magic numbers) is
+// the remaining case.
+enum class graph_format {
+  adjacency_text,
+  weighted_adjacency_text,
+  snapshot,
+  compressed,
+};
+
+inline graph_format detect_graph_format(const char* fname) {
+  std::ifstream in(fname, std::ios::in | std::ios::binary);
+  if (!in.is_open()) {
+    std::cout << "Unable to open file: " << fname << std::endl;
+    abort();
+  }
+  char head[32] = {0};
+  in.read(head, sizeof(head));
+  if (strncmp(head, "AdjacencyGraph", 14) == 0) {
+    return graph_format::adjacency_text;
+  }
+  if (strncmp(head, "WeightedAdjacencyGraph", 22) == 0) {
+    return graph_format::weighted_adjacency_text;
+  }
+  if (*(uint64_t*)head == kSnapshotMagic) {
+    return graph_format::snapshot;
+  }
+  return graph_format::compressed;
+}
+
+// Reads a vertex relabeling permutation written by the compressor's
+// -reorder mode (perm[i] is the new id of original vertex i); used to map
+// results computed on a reordered graph back to the original ids.
+inline pbbs::sequence<uintE> read_permutation(const char* fname) {
+  std::ifstream pf(fname, std::ios::in | std::ios::binary);
+  if (!pf.is_open()) {
+    std::cout << "Unable to open permutation file: " << fname << std::endl;
+    abort();
+  }
+  long n;
+  pf.read((char*)&n, sizeof(long));
+  auto perm = pbbs::sequence<uintE>::no_init(n);
+  pf.read((char*)perm.begin(), sizeof(uintE) * n);
+  pf.close();
+  return perm;
+}
+
+namespace internal {
+
+// Parses one whitespace-delimited unsigned integer starting at p (< end);
+// advances p past the token.
+inline uintE parse_uint(char*& p, char* end) {
+  while (p < end && (*p == ' ' || *p == '\t')) p++;
+  uintE v = 0;
+  while (p < end && *p >= '0' && *p <= '9') {
+    v = v * 10 + (*p - '0');
+    p++;
+  }
+  return v;
+}
+
+template <class weight_type,
+          typename std::enable_if<std::is_integral<weight_type>::value,
+                                  int>::type = 0>
+inline weight_type parse_weight(char*& p, char* end) {
+  while (p < end && (*p == ' ' || *p == '\t')) p++;
+  return (weight_type)strtol(p, &p, 10);
+}
+
+template <class weight_type,
+          typename std::enable_if<std::is_floating_point<weight_type>::value,
+                                  int>::type = 0>
+inline weight_type parse_weight(char*& p, char* end) {
+  while (p < end && (*p == ' ' || *p == '\t')) p++;
+  return (weight_type)strtod(p, &p);
+}
+
+// Chunked parallel edge-list parser: splits the character range at newline
+// boundaries into ~num_workers * 8 chunks, counts edges per chunk, and
+// parses each chunk into its slot of the output after a scan. Comment
+// ('#'-prefixed) and blank lines are skipped anywhere in the file.
+template <class weight_type>
+pbbs::sequence<Edge<weight_type>> parse_edge_list_chunked(char* buf,
+                                                          size_t len) {
+  char* end = buf + len;
+  size_t n_chunks =
+      std::max<size_t>(1, std::min<size_t>(len / (1 << 21),
+                                           (size_t)num_workers() << 3));
+  auto chunk_starts = pbbs::sequence<char*>(n_chunks + 1);
+  chunk_starts[0] = buf;
+  for (size_t c = 1; c < n_chunks; c++) {
+    char* p = buf + (len / n_chunks) * c;
+    while (p < end && *p != '\n') p++;
+    chunk_starts[c] = (p < end) ? (p + 1) : end;
+  }
+  chunk_starts[n_chunks] = end;
+
+  auto is_edge_line = [](char* p, char* e) {
+    while (p < e && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+    return p < e && *p >= '0' && *p <= '9';
+  };
+
+  // 1. Count edges per chunk.
+  auto counts = pbbs::sequence<size_t>(n_chunks + 1);
+  parallel_for(0, n_chunks, [&](size_t c) {
+    size_t ct = 0;
+    char* p = chunk_starts[c];
+    char* ce = chunk_starts[c + 1];
+    while (p < ce) {
+      char* eol = p;
+      while (eol < ce && *eol != '\n') eol++;
+      ct += is_edge_line(p, eol);
+      p = eol + 1;
+    }
+    counts[c] = ct;
+  }, 1);
+  counts[n_chunks] = 0;
+  size_t total = pbbslib::scan_add_inplace(counts.slice());
+
+  // 2. Parse each chunk into its slot.
+  auto edges = pbbs::sequence<Edge<weight_type>>::no_init(total);
+  parallel_for(0, n_chunks, [&](size_t c) {
+    size_t k = counts[c];
+    char* p = chunk_starts[c];
+    char* ce = chunk_starts[c + 1];
+    while (p < ce) {
+      char* eol = p;
+      while (eol < ce && *eol != '\n') eol++;
+      if (is_edge_line(p, eol)) {
+        uintE from = parse_uint(p, eol);
+        uintE to = parse_uint(p, eol);
+        if constexpr (std::is_same<weight_type, pbbslib::empty>::value) {
+          edges[k++] = Edge<weight_type>(from, to);
+        } else {
+          weight_type w = parse_weight<weight_type>(p, eol);
+          edges[k++] = Edge<weight_type>(from, to, w);
+        }
+      }
+      p = eol + 1;
+    }
+  }, 1);
+  return edges;
+}
+
+}  // namespace internal
+
 // Read weighted edges from a file that has the following format:
 //     # There can be comments at the top of the file as long as each line of
 //     # the comment starts with '#'.
@@ -336,15 +646,17 @@ std::vector<Edge<weight_type>> read_weighted_edge_list(const char* filename) {
     std::cout << "ERROR: Unable to open file: " << filename << '\n';
     std::terminate();
   }
-  internal::skip_ifstream_comments(&file);
+  file.close();
 
-  std::vector<Edge<weight_type>> edge_list;
-  uintE from;
-  uintE to;
-  weight_type weight;
-  while (file >> from >> to >> weight) {
-    edge_list.emplace_back(from, to, weight);
-  }
+  // Parse in parallel over newline-aligned chunks.
+  char* bytes;
+  size_t bytes_size;
+  std::tie(bytes, bytes_size) = mmapStringFromFile(filename);
+  auto edges = internal::parse_edge_list_chunked<weight_type>(bytes, bytes_size);
+  unmmap(bytes, bytes_size);
+
+  std::vector<Edge<weight_type>> edge_list(edges.size());
+  parallel_for(0, edges.size(), [&](size_t i) { edge_list[i] = edges[i]; });
   return edge_list;
 }
 
@@ -152,6 +152,94 @@ inline auto filter_graph(Graph& G, P& pred) {
   return std::make_tuple(G.num_vertices(), newM, out_vdata, edge_arr);
 }
 
+// Rebuilds the byte_pd_amortized blocks of a compressed symmetric graph into
+// a fresh arena. After heavy packNeighbors usage, vertices accumulate dead
+// space and degraded block structure (get_virtual_degree diverges from the
+// real degree); recompressing restores decode locality and reclaims the dead
+// bytes. Returns a new graph; the input is left untouched and can be deleted
+// by the caller.
+template <template <class W> class vertex, class W, class Graph,
+          typename std::enable_if<
+              std::is_same<vertex<W>, csv_bytepd_amortized<W>>::value,
+              int>::type = 0>
+inline symmetric_graph<csv_bytepd_amortized, W> recompress_graph(Graph& G) {
+  size_t n = G.num_vertices();
+
+  // 1. Calculate the size of each vertex's rebuilt edge blocks.
+  auto degrees = sequence<uintE>(n);
+  auto byte_offsets = sequence<uintT>(n + 1);
+  parallel_for(0, n, [&] (size_t i) {
+    size_t total_bytes = 0;
+    uintE last_ngh = 0;
+    size_t deg = 0;
+    uchar tmp[16];
+    auto f = [&](uintE u, uintE v, W w) {
+      long bytes = 0;
+      if ((deg % PARALLEL_DEGREE) == 0) {
+        bytes = bytepd_amortized::compressFirstEdge(tmp, bytes, u, v);
+        bytes = bytepd_amortized::compressWeight<W>(tmp, bytes, w);
+      } else {
+        bytes = bytepd_amortized::compressEdge(tmp, bytes, v - last_ngh);
+        bytes = bytepd_amortized::compressWeight<W>(tmp, bytes, w);
+      }
+      last_ngh = v;
+      total_bytes += bytes;
+      deg++;
+      return false;
+    };
+    G.get_vertex(i).out_neighbors().map(f, false);
+
+    if (deg > 0) {
+      size_t n_blocks = 1 + (deg - 1) / PARALLEL_DEGREE;
+      // block offsets, per-block counters, and the virtual degree
+      total_bytes += (n_blocks - 1) * sizeof(uintE);
+      total_bytes += n_blocks * sizeof(uintE);
+      total_bytes += sizeof(uintE);
+    }
+    degrees[i] = deg;
+    byte_offsets[i] = total_bytes;
+  }, 1);
+  byte_offsets[n] = 0;
+  size_t total_space = pbbslib::scan_add_inplace(byte_offsets.slice());
+  debug(std::cout << "# recompressed size is: " << total_space << "\n";);
+
+  // 2. Recompress each vertex into the fresh arena.
+  auto edges = sequence<uchar>(total_space);
+  parallel_for(0, n, [&] (size_t i) {
+    uintE deg = degrees[i];
+    if (deg > 0) {
+      auto it = G.get_vertex(i).out_neighbors().get_iter();
+      size_t nbytes = bytepd_amortized::sequentialCompressEdgeSet<W>(
+          edges.begin() + byte_offsets[i], 0, deg, (uintE)i, it);
+      if (nbytes != (byte_offsets[i + 1] - byte_offsets[i])) {
+        std::cout << "# recompress: nbytes = " << nbytes << " but should be "
+                  << (byte_offsets[i + 1] - byte_offsets[i]) << " for vertex "
+                  << i << "\n";
+        assert(nbytes == (byte_offsets[i + 1] - byte_offsets[i]));
+      }
+    }
+  }, 1);
+
+  auto out_vdata = pbbs::new_array_no_init<vertex_data>(n);
+  parallel_for(0, n, [&] (size_t i) {
+    out_vdata[i].offset = byte_offsets[i];
+    out_vdata[i].degree = degrees[i];
+  });
+  byte_offsets.clear();
+
+  auto deg_f = [&](size_t i) { return (size_t)degrees[i]; };
+  auto deg_map = pbbslib::make_sequence<size_t>(n, deg_f);
+  size_t new_m = pbbslib::reduce_add(deg_map);
+  auto edge_arr = edges.to_array();
+  return symmetric_graph<csv_bytepd_amortized, W>(
+      out_vdata, n, new_m,
+      [out_vdata, edge_arr]() {
+        pbbslib::free_array(out_vdata);
+        pbbslib::free_array(edge_arr);
+      },
+      (typename symmetric_graph<csv_bytepd_amortized, W>::edge_type*)edge_arr);
+}
+
 template <
     template <class W> class vertex, class W, class Graph, typename P,
     typename std::enable_if<std::is_same<vertex<W>, asymmetric_vertex<W>>::value,
@@ -172,6 +260,105 @@ inline auto filter_graph(Graph& G, P& pred) -> decltype(G) {
   return G;
 }
 
+// Extracts the induced subgraph on `vertices` (need not be sorted;
+// duplicates ignored) as a first-class renumbered symmetric graph, plus
+// the mapping from new ids back to original ids. Each kept vertex's list
+// is filtered against the membership array and relabeled in one parallel
+// pass -- the official version of what the benchmarks hand-roll (e.g.
+// CliqueCounting's relabel). Currently produces an uncompressed graph; a
+// compressed output can be obtained by recompress_graph-style re-encoding
+// of the result.
+template <class Graph>
+inline std::tuple<symmetric_graph<symmetric_vertex,
+                                  typename Graph::weight_type>,
+                  sequence<uintE>>
+induced_subgraph(Graph& G, sequence<uintE> const& vertices) {
+  using W = typename Graph::weight_type;
+  using edge_type = typename symmetric_vertex<W>::edge_type;
+  size_t n = G.n;
+
+  // membership + new id per original vertex
+  auto new_id = sequence<uintE>(n, (uintE)UINT_E_MAX);
+  auto sorted = sequence<uintE>(vertices);
+  pbbs::sample_sort_inplace(sorted.slice(), std::less<uintE>());
+  auto keep = pbbslib::make_sequence<bool>(sorted.size(), [&](size_t i) {
+    return i == 0 || sorted[i] != sorted[i - 1];
+  });
+  auto uniq = pbbs::pack(sorted, keep);
+  size_t k = uniq.size();
+  par_for(0, k, [&](size_t i) { new_id[uniq[i]] = (uintE)i; });
+
+  // count surviving degree per kept vertex
+  auto offs = sequence<uintT>(k + 1);
+  parallel_for(0, k, [&](size_t i) {
+    uintE v = uniq[i];
+    size_t ct = 0;
+    auto count_f = [&](const uintE& src, const uintE& u, const W& wgh) {
+      ct += (new_id[u] != UINT_E_MAX);
+    };
+    G.get_vertex(v).out_neighbors().map(count_f, false);
+    offs[i] = (uintT)ct;
+  }, 1);
+  offs[k] = 0;
+  size_t new_m = pbbslib::scan_add_inplace(offs.slice());
+
+  auto edges = pbbs::new_array_no_init<edge_type>(std::max<size_t>(new_m, 1));
+  parallel_for(0, k, [&](size_t i) {
+    uintE v = uniq[i];
+    size_t o = offs[i];
+    auto emit_f = [&](const uintE& src, const uintE& u, const W& wgh) {
+      if (new_id[u] != UINT_E_MAX) {
+        edges[o++] = std::make_tuple(new_id[u], wgh);
+      }
+    };
+    G.get_vertex(v).out_neighbors().map(emit_f, false);
+  }, 1);
+
+  auto v_data = pbbs::new_array_no_init<vertex_data>(k);
+  par_for(0, k, [&](size_t i) {
+    v_data[i].offset = offs[i];
+    v_data[i].degree = (uintE)(offs[i + 1] - offs[i]);
+  });
+  auto SG = symmetric_graph<symmetric_vertex, W>(
+      v_data, k, new_m,
+      [v_data, edges]() { pbbslib::free_arrays(v_data, edges); }, edges);
+  return std::make_tuple(SG, std::move(uniq));
+}
+
+// Weight-only update fast path for uncompressed weighted graphs: weights
+// change far more often than topology, and rebuilding the graph to adjust
+// them wastes the whole CSR. Each batch edge binary-searches its source's
+// sorted neighbor list and overwrites the weight in place (both
+// directions), parallel over the batch; topology, offsets, and degrees
+// are untouched. Returns the number of directed slots updated (absent
+// edges are skipped).
+template <class W>
+inline size_t update_weights(symmetric_graph<symmetric_vertex, W>& G,
+                             edge_array<W>& batch) {
+  using edge_type = typename symmetric_vertex<W>::edge_type;
+  auto updated = sequence<size_t>(batch.non_zeros, (size_t)0);
+  parallel_for(0, batch.non_zeros, [&](size_t i) {
+    auto [u, v, w] = batch.E[i];
+    size_t ct = 0;
+    for (auto [src, dst] : {std::make_pair(u, v), std::make_pair(v, u)}) {
+      auto vtx = G.get_vertex(src);
+      edge_type* nghs = vtx.out_neighbors().neighbors;
+      size_t lo = 0, hi = vtx.out_degree();
+      while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (std::get<0>(nghs[mid]) < dst) lo = mid + 1;
+        else hi = mid;
+      }
+      if (lo < vtx.out_degree() && std::get<0>(nghs[lo]) == dst) {
+        std::get<1>(nghs[lo]) = w;
+        ct++;
+      }
+    }
+    updated[i] = ct;
+  });
+  return pbbslib::reduce_add(updated);
+}
+
 // Used by MST and MaximalMatching
 // Predicate returns three values:
 // 0 : keep in graph, do not return in edge array
@@ -34,6 +34,7 @@
 #include "bridge.h"
 #include "macros.h"
 #include "sequential_ht.h"
+#include "pbbslib/worker_bag.h"
 
 namespace gbbs {
 
@@ -132,12 +133,40 @@ struct get_bucket {
   }
 };
 
+// ==================== Dense-range fast path ====================
+//
+// When the caller can bound the key range (neighbor ids are < n; cluster
+// ids in a contracted graph are < num_clusters), the hash machinery is
+// pure overhead: counts land in a direct-indexed pooled array instead.
+// Version stamps make the pool reusable across rounds with no clearing --
+// the first toucher of a key claims its slot for the current round
+// (zeroing it), everyone else waits out the claim and adds. Touched keys
+// collect in a worker bag, so the output is proportional to distinct keys
+// rather than the range.
+template <class K, class V>
+struct dense_hist_pool {
+  sequence<V> counts;
+  sequence<size_t> stamps;
+  size_t round = 0;
+
+  void reserve(size_t key_bound) {
+    if (counts.size() < key_bound) {
+      counts = sequence<V>::no_init(key_bound);
+      stamps = sequence<size_t>(key_bound, (size_t)0);
+      round = 0;
+    }
+  }
+};
+
 template <class K, class V>
 struct hist_table {
   using KV = std::tuple<K, V>;
   KV empty;
   KV* table;
   size_t size;
+  // direct-indexed pool for callers that declare a key bound (see
+  // histogram_dense_range); empty until first dense-range use
+  dense_hist_pool<K, V> dense_pool;
   hist_table(KV _empty, size_t _size) : empty(_empty), size(_size) {
     table = pbbslib::new_array_no_init<KV>(size);
     par_for(0, size, 2048, [&] (size_t i) { table[i] = empty; });
@@ -266,10 +295,9 @@ inline sequence<O> histogram_medium(A& get_key, size_t n,
             ct = counts[j * num_buckets + i + 1] - off;
           }
           off += start;
-          for (size_t l = 0; l < ct; l++) {
-            K a = elms[off + l];
-            S.insertAdd(a);
-          }
+          // elms is contiguous here, so use the batched (hash-vectorized,
+          // prefetched) insertion path.
+          S.insertAddBatch(&elms[off], ct);
         }
 
         k = S.compactIntoSelf(apply_f);
@@ -314,6 +342,52 @@ inline sequence<O> histogram_medium(A& get_key, size_t n,
   return res;
 }
 
+template <class O, class K, class V, class A, class Apply>
+inline sequence<O> histogram_dense_range(A& get_key, size_t n,
+                                         size_t key_bound, Apply& apply_f,
+                                         dense_hist_pool<K, V>& pool) {
+  pool.reserve(key_bound);
+  // two-phase round stamps: the claimer moves a slot old -> claiming,
+  // zeroes the count, then publishes ready; adders only touch the count
+  // once they observe ready, so the zeroing can never erase a concurrent
+  // add. The wait loop reads through volatile so it cannot be hoisted.
+  pool.round++;
+  size_t claiming = 2 * pool.round - 1;
+  size_t ready = 2 * pool.round;
+  auto touched = pbbs::worker_bag<K>();
+  volatile size_t* stamps = pool.stamps.begin();
+  parallel_for(0, n, [&](size_t i) {
+    K k = get_key[i];
+    size_t st = stamps[k];
+    if (st != ready) {
+      if (st != claiming &&
+          pbbs::atomic_compare_and_swap(&stamps[k], st, claiming)) {
+        pool.counts[k] = (V)0;
+        stamps[k] = ready;
+        touched.insert(k);
+      } else {
+        while (stamps[k] != ready) {
+          // the claiming worker is zeroing the slot
+        }
+      }
+    }
+    pbbs::fetch_and_add(&pool.counts[k], (V)1);
+  }, 512);
+
+  auto keys = touched.to_sequence();
+  auto out = sequence<O>::no_init(keys.size());
+  auto flags = sequence<bool>(keys.size(), false);
+  parallel_for(0, keys.size(), [&](size_t i) {
+    K k = keys[i];
+    auto opt = apply_f(std::make_tuple(k, pool.counts[k]));
+    if (opt.has_value()) {
+      out[i] = *opt;
+      flags[i] = true;
+    }
+  });
+  return pbbs::pack(out, flags);
+}
+
 // Applies light/heavy buckets
 template <class O, class K, class V, class A, class Apply>
 inline sequence<O> histogram(A& get_key, size_t n, Apply& apply_f,
@@ -472,10 +546,9 @@ inline sequence<O> histogram(A& get_key, size_t n, Apply& apply_f,
               ct = counts[j * num_total_buckets + i + 1] - off;
             }
             off += start;
-            for (size_t l = 0; l < ct; l++) {
-              K a = elms[off + l];
-              S.insertAdd(a);
-            }
+            // elms is contiguous here, so use the batched (hash-vectorized,
+            // prefetched) insertion path.
+            S.insertAddBatch(&elms[off], ct);
           }
 
           k = S.compactIntoSelf(apply_f);
@@ -579,6 +652,20 @@ inline sequence<O> histogram(A& get_key, size_t n, Apply& apply_f,
   return res;
 }
 
+// Key-bound dispatch: a declared dense key range (e.g. neighbor ids < n,
+// or cluster ids < num_clusters after contraction) routes to the
+// direct-indexed pool when the range is within 4x of the input size;
+// otherwise the hashing path runs unchanged.
+template <class O, class K, class V, class A, class Apply>
+inline sequence<O> histogram(A& get_key, size_t n, Apply& apply_f,
+                             hist_table<K, V>& ht, size_t key_bound) {
+  if (key_bound > 0 && n > 0 && key_bound <= 4 * n) {
+    return histogram_dense_range<O>(get_key, n, key_bound, apply_f,
+                                    ht.dense_pool);
+  }
+  return histogram<O>(get_key, n, apply_f, ht);
+}
+
 template <class E, class O, class K, class V, class A, class Reduce,
           class Apply>
 inline sequence<O> seq_histogram_reduce(A& get_elm, size_t n,
@@ -0,0 +1,140 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Structured instrumentation replacing the ad-hoc debug couts: named phase
+// scopes (nested; a phase accumulates wall time across entries) and named
+// per-worker counters (one cache-line-padded slot per worker, bumped with a
+// plain add -- cheap enough for per-block counting of traversed edges or
+// CAS failures). instrumentation::report_json() emits everything as one
+// JSON object; run_app calls it when GBBS_INSTRUMENT is set, so every
+// generate_main binary inherits the output without changes.
+//
+//   { instrumentation::phase p("bucketing");
+//     ... }
+//   instrumentation::count("edges_traversed", block_size);
+
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "gbbs.h"
+
+namespace gbbs {
+namespace instrumentation {
+
+struct counter_slots {
+  static constexpr size_t kStride = 64 / sizeof(size_t);
+  std::vector<size_t> slots;  // num_workers * kStride
+  counter_slots() : slots((size_t)num_workers() * kStride, 0) {}
+  inline void add(size_t v) {
+    slots[(size_t)worker_id() * kStride] += v;
+  }
+  size_t total() const {
+    size_t t = 0;
+    for (size_t w = 0; w < slots.size() / kStride; w++) {
+      t += slots[w * kStride];
+    }
+    return t;
+  }
+};
+
+struct registry {
+  std::mutex mtx;
+  std::map<std::string, double> phase_seconds;
+  std::map<std::string, counter_slots> counters;
+
+  static registry& get() {
+    static registry r;
+    return r;
+  }
+};
+
+// Accumulates wall time into the named phase for the scope's lifetime.
+struct phase {
+  std::string name;
+  std::chrono::steady_clock::time_point start;
+  phase(std::string name)
+      : name(std::move(name)), start(std::chrono::steady_clock::now()) {}
+  ~phase() {
+    double secs = std::chrono::duration<double>(
+                      std::chrono::steady_clock::now() - start).count();
+    auto& r = registry::get();
+    std::lock_guard<std::mutex> guard(r.mtx);
+    r.phase_seconds[name] += secs;
+  }
+};
+
+// Bumps the named per-worker counter. The first call for a name registers
+// it (mutex); subsequent calls are a map find plus one padded add. Hot
+// loops should cache the slot:
+//   auto& c = instrumentation::counter("edges"); ... c.add(k);
+inline counter_slots& counter(const std::string& name) {
+  auto& r = registry::get();
+  std::lock_guard<std::mutex> guard(r.mtx);
+  return r.counters[name];
+}
+
+inline void count(const std::string& name, size_t v) {
+  counter(name).add(v);
+}
+
+inline void reset() {
+  auto& r = registry::get();
+  std::lock_guard<std::mutex> guard(r.mtx);
+  r.phase_seconds.clear();
+  r.counters.clear();
+}
+
+// One JSON object with phases (seconds) and counters (totals across
+// workers).
+inline void report_json(std::ostream& os) {
+  auto& r = registry::get();
+  std::lock_guard<std::mutex> guard(r.mtx);
+  os << "{\"phases\": {";
+  bool first = true;
+  for (const auto& kv : r.phase_seconds) {
+    if (!first) os << ", ";
+    first = false;
+    os << "\"" << kv.first << "\": " << kv.second;
+  }
+  os << "}, \"counters\": {";
+  first = true;
+  for (const auto& kv : r.counters) {
+    if (!first) os << ", ";
+    first = false;
+    os << "\"" << kv.first << "\": " << kv.second.total();
+  }
+  os << "}}" << std::endl;
+}
+
+inline bool enabled() {
+  static bool on = (std::getenv("GBBS_INSTRUMENT") != nullptr);
+  return on;
+}
+
+}  // namespace instrumentation
+}  // namespace gbbs
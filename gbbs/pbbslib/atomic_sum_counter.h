@@ -1,5 +1,6 @@
 #pragma once
 
+#include "pbbslib/padded_reducers.h"
 #include "pbbslib/utilities.h"
 #include "gbbs/macros.h"
 
@@ -24,6 +25,9 @@ struct atomic_sum_counter {
     num_workers_ = num_workers();
     num_elms = num_workers_ << stride;
     entries = pbbs::new_array_no_init<T>(num_elms);
+    pbbs::register_reducer("atomic_sum_counter", entries,
+                           num_elms * sizeof(T),
+                           (sizeof(T)) << stride);
     for (size_t i=0; i<num_workers_; i++) {
       entries[i << stride] = (T)0;
     }
@@ -31,6 +35,7 @@ struct atomic_sum_counter {
 
   ~atomic_sum_counter() {
     if (entries != nullptr) {
+      pbbs::unregister_reducer(entries);
       pbbs::free_array(entries);
     }
   }
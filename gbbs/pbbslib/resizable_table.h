@@ -98,6 +98,21 @@ namespace pbbslib {
     bool alloc;
     size_t* cts;
 
+    // Incremental-migration state: after a growth trigger the old table
+    // stays live as a second epoch. Each insert migrates a small quantum of
+    // old slots (claimed through migrate_cursor, completion tracked by
+    // migrate_done), so no operation ever pays for a full rehash; lookups
+    // probe both epochs until migration completes. The old array is only
+    // reclaimed at a quiescent point (update_nelms / the next resize /
+    // del), since concurrent readers may still be probing it when the last
+    // slot migrates.
+    T* old_table = nullptr;
+    size_t old_m = 0;
+    size_t old_mask = 0;
+    std::atomic<size_t>* migrate_cursor = nullptr;
+    std::atomic<size_t>* migrate_done = nullptr;
+    static constexpr size_t kMigrateQuantum = 64;
+
     static void clearA(T* A, long n, T kv) {
       parallel_for(0, n, [&] (size_t i) { A[i] = kv; });
     }
@@ -105,6 +120,7 @@ namespace pbbslib {
     inline size_t firstIndex(K& k) { return hashToRange(key_hash(k), mask); }
 
     void del() {
+      reclaim_old();
       if (alloc) {
         pbbslib::free_array(table);
         pbbslib::free_array(cts);
@@ -112,6 +128,73 @@ namespace pbbslib {
       }
     }
 
+    bool migrating() const { return old_table != nullptr; }
+
+    // Frees the previous epoch once migration has completed. Must only be
+    // called at quiescent points (no concurrent operations).
+    void reclaim_old() {
+      if (old_table != nullptr &&
+          migrate_done->load() == old_m) {
+        pbbslib::free_array(old_table);
+        old_table = nullptr;
+        delete migrate_cursor;
+        delete migrate_done;
+        migrate_cursor = nullptr;
+        migrate_done = nullptr;
+      }
+    }
+
+    // Migrates up to kMigrateQuantum old slots into the current table.
+    void migrate_quantum() {
+      if (old_table == nullptr) return;
+      size_t start = migrate_cursor->fetch_add(kMigrateQuantum);
+      if (start >= old_m) return;
+      size_t end = std::min(start + kMigrateQuantum, old_m);
+      for (size_t i = start; i < end; i++) {
+        if (std::get<0>(old_table[i]) != empty_key) {
+          insert_migrated(old_table[i]);
+        }
+      }
+      migrate_done->fetch_add(end - start);
+    }
+
+    // Drains the remainder of a migration without reclaiming the old
+    // array (safe to call concurrently with reads); afterwards the current
+    // table holds every element.
+    void drain_migration() {
+      if (old_table == nullptr) return;
+      while (migrate_cursor->load() < old_m) {
+        migrate_quantum();
+      }
+      while (migrate_done->load() < old_m) {
+        // another worker is finishing its quantum
+      }
+    }
+
+    // Drains and reclaims; only at quiescent points.
+    void finish_migration() {
+      drain_migration();
+      reclaim_old();
+    }
+
+    // CAS insert into the current epoch without touching the element
+    // counts (migrated elements were already counted when first inserted).
+    void insert_migrated(T kv) {
+      K& k = std::get<0>(kv);
+      size_t h = firstIndex(k);
+      while (1) {
+        if (std::get<0>(table[h]) == empty_key &&
+            pbbslib::CAS(&table[h], empty, kv)) {
+          return;
+        }
+        if (std::get<0>(table[h]) == k &&
+            std::get<1>(table[h]) == std::get<1>(kv)) {
+          return;
+        }
+        h = incrementIndex(h, mask);
+      }
+    }
+
     void init_counts() {
       size_t workers = num_workers();
       cts = pbbslib::new_array_no_init<size_t>(kResizableTableCacheLineSz * workers);
@@ -126,6 +209,8 @@ namespace pbbslib {
         ne += cts[i * kResizableTableCacheLineSz];
         cts[i * kResizableTableCacheLineSz] = 0;
       }
+      // Quiescent point: safe to reclaim a drained epoch.
+      reclaim_old();
     }
 
     resizable_table() : m(0), ne(0) {
@@ -187,35 +272,48 @@ namespace pbbslib {
       std::cout << std::endl << "End of table analysis" << std::endl;
     }
 
+    // Starts a new epoch instead of rehashing stop-the-world: the old table
+    // becomes the migration source and subsequent inserts move it over a
+    // quantum at a time. Called at quiescent points, as before.
     void maybe_resize(size_t n_inc) {
       size_t nt = ne + n_inc;
       if (nt > (0.25 * m)) {
-        size_t old_m = m;
-        auto old_t = table;
-        m = ((size_t)1 << pbbslib::log2_up((size_t)(10 * nt)));
-        if (m == old_m) {
+        size_t prev_m = m;
+        auto prev_t = table;
+        size_t new_m = ((size_t)1 << pbbslib::log2_up((size_t)(10 * nt)));
+        if (new_m == prev_m) {
           return;
         }
+        // Only one migration epoch at a time: drain any in-flight one.
+        finish_migration();
+        m = new_m;
         mask = m - 1;
-        ne = 0;
         size_t line_size = 64;
         size_t bytes = ((m * sizeof(T)) / line_size + 1) * line_size;
         table = (T*)aligned_alloc(line_size, bytes);
         clearA(table, m, empty);
-        parallel_for(0, old_m, [&] (size_t i) {
-          if (std::get<0>(old_t[i]) != empty_key) {
-            insert(old_t[i]);
-          }
-        });
-        update_nelms();
-        if (alloc) {
-          pbbslib::free_array(old_t);
+        old_table = prev_t;
+        old_m = prev_m;
+        old_mask = prev_m - 1;
+        migrate_cursor = new std::atomic<size_t>(0);
+        migrate_done = new std::atomic<size_t>(0);
+        if (!alloc) {
+          // The previous backing was caller-owned; migrate it eagerly and
+          // detach it without freeing (reclaim_old must never see it).
+          drain_migration();
+          old_table = nullptr;
+          delete migrate_cursor;
+          delete migrate_done;
+          migrate_cursor = nullptr;
+          migrate_done = nullptr;
         }
         alloc = true;
       }
     }
 
     iter_kv<K, V> get_iter(K k) {
+      // Iteration needs a single-epoch view of key k's entries.
+      if (old_table != nullptr) drain_migration();
       size_t h = firstIndex(k);
       return iter_kv<K, V>(k, h, mask, table, empty_key);
     }
@@ -223,6 +321,11 @@ namespace pbbslib {
     bool insert(std::tuple<K, V> kv) {
       K& k = std::get<0>(kv);
       V& v = std::get<1>(kv);
+      if (old_table != nullptr) {
+        migrate_quantum();
+        // The pair may still live in the old epoch; do not duplicate it.
+        if (contains_in(old_table, old_mask, k, v)) return false;
+      }
       size_t h = firstIndex(k);
       while (1) {
         if (std::get<0>(table[h]) == empty_key &&
@@ -254,6 +357,7 @@ namespace pbbslib {
     }
 
     size_t num_appearances(K k) {
+      if (old_table != nullptr) drain_migration();
       size_t h = firstIndex(k);
       size_t ct = 0;
       while (1) {
@@ -267,34 +371,47 @@ namespace pbbslib {
       return 0;
     }
 
-    bool contains(K k) {
-      size_t h = firstIndex(k);
+    bool contains_key_in(T* t, size_t t_mask, K k) {
+      size_t h = hashToRange(key_hash(k), t_mask);
       while (1) {
-        if (std::get<0>(table[h]) == k) {
+        if (std::get<0>(t[h]) == k) {
           return 1;
-        } else if (std::get<0>(table[h]) == empty_key) {
+        } else if (std::get<0>(t[h]) == empty_key) {
           return 0;
         }
-        h = incrementIndex(h, mask);
+        h = incrementIndex(h, t_mask);
       }
       return 0;
     }
 
-    bool contains(K k, V v) {
-      size_t h = firstIndex(k);
+    bool contains_in(T* t, size_t t_mask, K k, V v) {
+      size_t h = hashToRange(key_hash(k), t_mask);
       while (1) {
-        if (std::get<0>(table[h]) == k && std::get<1>(table[h]) == v) {
+        if (std::get<0>(t[h]) == k && std::get<1>(t[h]) == v) {
           return 1;
-        } else if (std::get<0>(table[h]) == empty_key) {
+        } else if (std::get<0>(t[h]) == empty_key) {
           return 0;
         }
-        h = incrementIndex(h, mask);
+        h = incrementIndex(h, t_mask);
       }
       return 0;
     }
 
+    bool contains(K k) {
+      if (contains_key_in(table, mask, k)) return 1;
+      if (old_table != nullptr) return contains_key_in(old_table, old_mask, k);
+      return 0;
+    }
+
+    bool contains(K k, V v) {
+      if (contains_in(table, mask, k, v)) return 1;
+      if (old_table != nullptr) return contains_in(old_table, old_mask, k, v);
+      return 0;
+    }
+
     template <class F>
     void map(F& f) {
+      if (old_table != nullptr) drain_migration();
       parallel_for(0, m, [&] (size_t i) {
         if (std::get<0>(table[i]) != empty_key) {
           f(table[i]);
@@ -303,6 +420,7 @@ namespace pbbslib {
     }
 
     sequence<T> entries() {
+      if (old_table != nullptr) drain_migration();
       auto pred = [&](T& t) { return std::get<0>(t) != empty_key; };
       auto table_seq = pbbslib::make_sequence<T>(table, m);
       return pbbslib::filter(table_seq, pred);
@@ -119,6 +119,37 @@ class sparse_additive_map {
     return 0;
   }
 
+  // Bulk-build from a sequence of (key, value) pairs known up front. The
+  // pairs are sorted by key, runs of equal keys are pre-aggregated with a
+  // reduction, and each distinct key is then inserted exactly once -- so
+  // the CAS/write_add storm of concurrent per-element insertion on heavy
+  // keys disappears (the single claim CAS per distinct key remains, and
+  // almost always succeeds on the first try). Mutates kvs (sorts it).
+  void build_from_sequence(sequence<T>& kvs) {
+    size_t n = kvs.size();
+    if (n == 0) return;
+    auto less = [](const T& a, const T& b) {
+      return std::get<0>(a) < std::get<0>(b);
+    };
+    pbbs::sample_sort_inplace(kvs.slice(), less);
+
+    // run starts
+    auto is_start = pbbslib::make_sequence<bool>(n, [&](size_t i) {
+      return i == 0 || std::get<0>(kvs[i]) != std::get<0>(kvs[i - 1]);
+    });
+    auto starts = pbbs::pack_index<size_t>(is_start);
+    size_t num_runs = starts.size();
+
+    parallel_for(0, num_runs, [&](size_t r) {
+      size_t lo = starts[r];
+      size_t hi = (r + 1 == num_runs) ? n : starts[r + 1];
+      auto val_f = pbbslib::make_sequence<V>(
+          hi - lo, [&](size_t i) { return std::get<1>(kvs[lo + i]); });
+      V sum = pbbslib::reduce_add(val_f);
+      insert(std::make_tuple(std::get<0>(kvs[lo]), sum));
+    }, 1);
+  }
+
   auto entries() {
     auto pred = [&](const T& t) { return std::get<0>(t) != empty_key; };
     auto table_seq = pbbslib::make_sequence<T>(table, m);
@@ -308,4 +308,175 @@ inline sparse_table<K, V, KeyHash> make_sparse_table(std::tuple<K, V>* tab,
   return sparse_table<K, V, KeyHash>(m, empty, key_hash, tab, clear);
 }
 
+
+// A group-probing (Swiss-table-style) variant of sparse_table behind the
+// same insert/find/contains API. A side array of control bytes holds a
+// 7-bit hash fragment per slot (0x80 = empty); lookups test sixteen
+// control bytes at a time with SWAR word operations and only touch the
+// slot array on fragment matches, so probe chains on 70%-full tables cost
+// a couple of word ops instead of sixteen strided tuple reads. Slots are
+// still claimed with the same CAS as sparse_table; the control byte is
+// published immediately after, so as with sparse_table, lookups racing a
+// concurrent insert of the same key may miss it (the library's tables are
+// used phase-wise: build, then query).
+template <class K, class V, class KeyHash>
+class sparse_table_grouped {
+ public:
+  using T = std::tuple<K, V>;
+  static constexpr size_t kGroupSize = 16;
+  static constexpr uint8_t kEmptyCtrl = 0x80;
+
+  size_t m;       // number of slots (multiple of kGroupSize, power of 2)
+  size_t mask;    // group mask (number of groups - 1)
+  T empty;
+  K empty_key;
+  T* table;
+  uint8_t* ctrl;
+  bool alloc;
+  KeyHash key_hash;
+
+  sparse_table_grouped() : m(0), mask(0), table(nullptr), ctrl(nullptr),
+                           alloc(false) {}
+
+  sparse_table_grouped(size_t _m, T _empty, KeyHash _key_hash,
+                       long space_mult = -1)
+      : empty(_empty),
+        empty_key(std::get<0>(empty)),
+        key_hash(_key_hash) {
+    double mult = (space_mult == -1) ? 1.1 : space_mult;
+    size_t min_slots = std::max<size_t>(kGroupSize, (size_t)(mult * _m) + 1);
+    m = ((size_t)1) << pbbslib::log2_up(min_slots);
+    mask = (m / kGroupSize) - 1;
+    table = pbbslib::new_array_no_init<T>(m);
+    ctrl = pbbslib::new_array_no_init<uint8_t>(m);
+    parallel_for(0, m, [&](size_t i) {
+      table[i] = empty;
+      ctrl[i] = kEmptyCtrl;
+    });
+    alloc = true;
+  }
+
+  void del() {
+    if (alloc) {
+      pbbslib::free_array(table);
+      pbbslib::free_array(ctrl);
+      alloc = false;
+    }
+  }
+
+  size_t size() const { return m; }
+
+  inline size_t group_of(K& k) const { return key_hash(k) & mask; }
+  inline uint8_t fragment_of(K& k) const {
+    return (uint8_t)((key_hash(k) >> 57) & 0x7f);
+  }
+
+  // SWAR helpers over 8 control bytes at a time.
+  static inline uint64_t load_word(const uint8_t* p) {
+    uint64_t w;
+    memcpy(&w, p, sizeof(w));
+    return w;
+  }
+  // Bitmask (0x80 per byte) of bytes equal to `byte`.
+  static inline uint64_t match_byte(uint64_t w, uint8_t byte) {
+    uint64_t x = w ^ (0x0101010101010101UL * byte);
+    return (x - 0x0101010101010101UL) & ~x & 0x8080808080808080UL;
+  }
+
+  bool insert(std::tuple<K, V> kv) {
+    K& k = std::get<0>(kv);
+    size_t g = group_of(k);
+    uint8_t frag = fragment_of(k);
+    while (1) {
+      size_t base = g * kGroupSize;
+      for (size_t half = 0; half < kGroupSize; half += 8) {
+        uint64_t w = load_word(&ctrl[base + half]);
+        // check existing fragment matches for this key
+        uint64_t matches = match_byte(w, frag);
+        while (matches != 0) {
+          size_t i = base + half + (__builtin_ctzll(matches) >> 3);
+          if (std::get<0>(table[i]) == k) return false;
+          matches &= matches - 1;
+        }
+        // claim an empty slot
+        uint64_t empties = match_byte(w, kEmptyCtrl);
+        while (empties != 0) {
+          size_t i = base + half + (__builtin_ctzll(empties) >> 3);
+          if (std::get<0>(table[i]) == empty_key &&
+              pbbslib::CAS(&table[i], empty, kv)) {
+            ctrl[i] = frag;  // publish the hint
+            return true;
+          }
+          // lost the race for this slot; the winner may hold our key
+          if (std::get<0>(table[i]) == k) return false;
+          empties &= empties - 1;
+        }
+      }
+      // group full of other keys: probe the next group
+      g = (g + 1) & mask;
+    }
+  }
+
+  bool contains(K k) const {
+    size_t g = group_of(k);
+    uint8_t frag = fragment_of(k);
+    while (1) {
+      size_t base = g * kGroupSize;
+      bool has_empty = false;
+      for (size_t half = 0; half < kGroupSize; half += 8) {
+        uint64_t w = load_word(&ctrl[base + half]);
+        uint64_t matches = match_byte(w, frag);
+        while (matches != 0) {
+          size_t i = base + half + (__builtin_ctzll(matches) >> 3);
+          if (std::get<0>(table[i]) == k) return true;
+          matches &= matches - 1;
+        }
+        has_empty |= (match_byte(w, kEmptyCtrl) != 0);
+      }
+      if (has_empty) return false;  // key would have been placed by here
+      g = (g + 1) & mask;
+    }
+  }
+
+  V find(K k, V default_value) const {
+    size_t g = group_of(k);
+    uint8_t frag = fragment_of(k);
+    while (1) {
+      size_t base = g * kGroupSize;
+      bool has_empty = false;
+      for (size_t half = 0; half < kGroupSize; half += 8) {
+        uint64_t w = load_word(&ctrl[base + half]);
+        uint64_t matches = match_byte(w, frag);
+        while (matches != 0) {
+          size_t i = base + half + (__builtin_ctzll(matches) >> 3);
+          if (std::get<0>(table[i]) == k) return std::get<1>(table[i]);
+          matches &= matches - 1;
+        }
+        has_empty |= (match_byte(w, kEmptyCtrl) != 0);
+      }
+      if (has_empty) return default_value;
+      g = (g + 1) & mask;
+    }
+  }
+
+  sequence<T> entries() const {
+    auto pred = [&](const T& t) { return std::get<0>(t) != empty_key; };
+    auto table_seq = pbbslib::make_sequence<T>(table, m);
+    return pbbslib::filter(table_seq, pred);
+  }
+
+  void clear() {
+    parallel_for(0, m, [&](size_t i) {
+      table[i] = empty;
+      ctrl[i] = kEmptyCtrl;
+    });
+  }
+};
+
+template <class K, class V, class KeyHash>
+inline sparse_table_grouped<K, V, KeyHash> make_sparse_table_grouped(
+    size_t m, std::tuple<K, V> empty, KeyHash key_hash) {
+  return sparse_table_grouped<K, V, KeyHash>(m, empty, key_hash);
+}
+
 }  // namespace pbbslib
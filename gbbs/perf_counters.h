@@ -0,0 +1,207 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// perf_event counter scopes with the same shape as pbbs::timer: a
+// perf_scope snapshots LLC misses, branch misses, instructions, and cycles
+// at construction and reports the deltas when stopped, aggregated across
+// every scheduler worker that has executed under a scope before (each
+// worker lazily opens its own thread-local counter fds the first time it
+// runs perf-instrumented code, since perf_event_open only targets the
+// calling thread). Phased attribution falls out: wrap the bucketing phase
+// and the histogram phase in separate scopes and each reports its own LLC
+// misses. Degrades gracefully -- containers that deny perf_event_open
+// report zeros once with a warning instead of failing the run.
+
+#pragma once
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+#include "gbbs.h"
+
+namespace gbbs {
+namespace perf {
+
+struct counter_values {
+  uint64_t llc_misses = 0;
+  uint64_t branch_misses = 0;
+  uint64_t instructions = 0;
+  uint64_t cycles = 0;
+
+  counter_values operator-(const counter_values& o) const {
+    counter_values r;
+    r.llc_misses = llc_misses - o.llc_misses;
+    r.branch_misses = branch_misses - o.branch_misses;
+    r.instructions = instructions - o.instructions;
+    r.cycles = cycles - o.cycles;
+    return r;
+  }
+  counter_values& operator+=(const counter_values& o) {
+    llc_misses += o.llc_misses;
+    branch_misses += o.branch_misses;
+    instructions += o.instructions;
+    cycles += o.cycles;
+    return *this;
+  }
+};
+
+#if defined(__linux__)
+
+struct thread_counters {
+  int fds[4] = {-1, -1, -1, -1};
+  bool ok = false;
+
+  static int open_one(uint32_t type, uint64_t config) {
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+  }
+
+  thread_counters() {
+    fds[0] = open_one(PERF_TYPE_HW_CACHE,
+                      PERF_COUNT_HW_CACHE_LL |
+                          (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                          (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+    fds[1] = open_one(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    fds[2] = open_one(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    fds[3] = open_one(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    ok = (fds[2] >= 0);  // instructions is the canary
+    if (!ok) {
+      static std::once_flag warned;
+      std::call_once(warned, [] {
+        std::cout << "# perf_counters: perf_event_open unavailable; "
+                     "counters report zero" << std::endl;
+      });
+    }
+  }
+
+  counter_values read_values() const {
+    counter_values v;
+    uint64_t val;
+    auto rd = [&](int fd) -> uint64_t {
+      if (fd < 0) return 0;
+      if (read(fd, &val, sizeof(val)) != sizeof(val)) return 0;
+      return val;
+    };
+    v.llc_misses = rd(fds[0]);
+    v.branch_misses = rd(fds[1]);
+    v.instructions = rd(fds[2]);
+    v.cycles = rd(fds[3]);
+    return v;
+  }
+};
+
+struct registry {
+  std::mutex mtx;
+  std::vector<const thread_counters*> threads;
+  static registry& get() {
+    static registry r;
+    return r;
+  }
+};
+
+// Each worker's counters, opened on first use and registered globally.
+inline const thread_counters& my_counters() {
+  static thread_local thread_counters tc;
+  static thread_local bool registered = [] {
+    auto& r = registry::get();
+    std::lock_guard<std::mutex> guard(r.mtx);
+    r.threads.push_back(&tc);  // stable address: thread-local lifetime
+    return true;
+  }();
+  (void)registered;
+  return tc;
+}
+
+// Touches every scheduler worker once so their counters exist before the
+// measured region (call once at startup; workers also self-register the
+// first time they execute under any scope).
+inline void init_workers() {
+  parallel_for(0, (size_t)num_workers() * 8, [&](size_t) {
+    my_counters();
+  }, 1);
+}
+
+inline counter_values read_all() {
+  my_counters();  // ensure at least the calling thread is registered
+  counter_values total;
+  auto& r = registry::get();
+  std::lock_guard<std::mutex> guard(r.mtx);
+  for (const thread_counters* t : r.threads) {
+    total += t->read_values();
+  }
+  return total;
+}
+
+#else  // !__linux__
+
+inline void init_workers() {}
+inline counter_values read_all() { return counter_values(); }
+
+#endif
+
+// Same usage shape as pbbs::timer: construct (or start()) at the phase
+// boundary, stop() and report.
+struct perf_scope {
+  const char* name;
+  counter_values begin;
+  bool running = false;
+
+  perf_scope(const char* name, bool start_now = true) : name(name) {
+    if (start_now) start();
+  }
+  void start() {
+    begin = read_all();
+    running = true;
+  }
+  counter_values stop() {
+    running = false;
+    return read_all() - begin;
+  }
+  void report() {
+    auto d = stop();
+    std::cout << "# perf[" << name << "]: llc-misses = " << d.llc_misses
+              << " branch-misses = " << d.branch_misses
+              << " instructions = " << d.instructions
+              << " cycles = " << d.cycles << std::endl;
+  }
+};
+
+}  // namespace perf
+}  // namespace gbbs
@@ -0,0 +1,108 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Composition of algorithm steps without intermediate materialization. A
+// pipeline carries the (original) graph, a vertex mask, and the previous
+// step's value; restriction steps only AND masks -- no subgraph is built --
+// and the mask flows into the next step, which can run mask-aware (most
+// GBBS algorithms take a frontier/predicate) or call materialize() to get
+// a compact renumbered graph via induced_subgraph at the single point one
+// is genuinely needed. The standard components -> largest-component ->
+// KCore -> dense-core flow becomes three mask compositions and one
+// materialization instead of three full graph rebuilds.
+//
+//   auto result = make_pipeline(G)
+//     .compute([](auto& p) { return workefficient_cc::CC(p.G); })
+//     .restrict_to([&](uintE v, auto& labels) { ... in largest comp ... })
+//     .materialize()   // only here is a subgraph built
+//     ...
+
+#pragma once
+
+#include "gbbs.h"
+#include "graph_mutation.h"
+
+namespace gbbs {
+
+template <class Graph, class V>
+struct pipeline {
+  Graph& G;
+  sequence<bool> mask;  // empty = all vertices live
+  V value;              // the previous step's output
+
+  inline bool live(uintE v) const { return mask.size() == 0 || mask[v]; }
+
+  size_t num_live() const {
+    if (mask.size() == 0) return G.n;
+    auto live_im = pbbslib::make_sequence<size_t>(G.n, [&](size_t i) {
+      return (size_t)mask[i];
+    });
+    return pbbslib::reduce_add(live_im);
+  }
+
+  // Runs f(*this) and threads its result (with the same graph and mask)
+  // into the next stage.
+  template <class F>
+  auto compute(F f) -> pipeline<Graph, decltype(f(*this))> {
+    auto next_value = f(*this);
+    return pipeline<Graph, decltype(f(*this))>{G, std::move(mask),
+                                               std::move(next_value)};
+  }
+
+  // ANDs `pred(v, value)` into the mask; nothing is materialized.
+  template <class P>
+  pipeline<Graph, V> restrict_to(P pred) {
+    auto next_mask = sequence<bool>(G.n, [&](size_t v) {
+      return live((uintE)v) && pred((uintE)v, value);
+    });
+    return pipeline<Graph, V>{G, std::move(next_mask), std::move(value)};
+  }
+
+  // The one materialization point: builds the compact renumbered subgraph
+  // of the live vertices. Returns (subgraph, new-id -> original-id).
+  auto materialize() {
+    auto live_ids = pbbs::filter(
+        pbbslib::make_sequence<uintE>(G.n,
+                                      [](size_t i) { return (uintE)i; }),
+        [&](uintE v) { return live(v); });
+    return induced_subgraph(G, live_ids);
+  }
+
+  // The live vertices as a frontier, for mask-aware algorithms.
+  vertexSubset live_frontier() {
+    if (mask.size() == 0) {
+      auto all = sequence<bool>(G.n, true);
+      return vertexSubset(G.n, G.n, std::move(all));
+    }
+    auto copy = sequence<bool>(mask);
+    return vertexSubset(G.n, std::move(copy));
+  }
+};
+
+template <class Graph>
+pipeline<Graph, pbbslib::empty> make_pipeline(Graph& G) {
+  return pipeline<Graph, pbbslib::empty>{G, sequence<bool>(),
+                                         pbbslib::empty()};
+}
+
+}  // namespace gbbs
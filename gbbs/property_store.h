@@ -0,0 +1,136 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Named, typed per-vertex property columns with aligned lifetime: a
+// property_store is sized to a graph's n, holds flat trivially-copyable
+// columns behind shared ownership (hand the raw pointer to zero-copy
+// exporters like the NumPy capsule wrapper and the column stays alive),
+// persists columns to disk in a small typed binary format, and can map a
+// persisted column back in place of recomputing it -- "compute coreness
+// once, reuse across sessions" becomes a load. Columns are plain arrays,
+// so parallel columnar scans are ordinary parallel_fors over data<T>().
+
+#pragma once
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "bridge.h"
+#include "io.h"
+#include "macros.h"
+
+namespace gbbs {
+
+struct property_store {
+  static constexpr uint64_t kMagic = 0x6762627370726f70ULL;  // "gbbsprop"
+
+  struct column {
+    std::shared_ptr<void> data;
+    size_t elem_size = 0;
+    size_t type_hash = 0;  // typeid hash for checked access
+  };
+
+  size_t n;
+  std::map<std::string, column> columns;
+
+  property_store(size_t n) : n(n) {}
+
+  // Adopts a sequence as a named column (takes ownership of its buffer).
+  template <class T>
+  void put(const std::string& name, pbbs::sequence<T>&& values) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "property columns hold trivially copyable types");
+    assert(values.size() == n);
+    T* buf = values.to_array();
+    column c;
+    c.data = std::shared_ptr<void>(buf, [](void* p) {
+      pbbslib::free_array((T*)p);
+    });
+    c.elem_size = sizeof(T);
+    c.type_hash = typeid(T).hash_code();
+    columns[name] = std::move(c);
+  }
+
+  bool contains(const std::string& name) const {
+    return columns.count(name) > 0;
+  }
+
+  // Typed access; aborts on a type mismatch. The pointer stays valid as
+  // long as the store (or any shared handle from share()) lives.
+  template <class T>
+  T* data(const std::string& name) {
+    auto it = columns.find(name);
+    if (it == columns.end() || it->second.type_hash != typeid(T).hash_code()) {
+      std::cout << "property_store: missing or wrongly-typed column "
+                << name << std::endl;
+      abort();
+    }
+    return (T*)it->second.data.get();
+  }
+
+  // Shared handle for zero-copy export: keeps the column alive however
+  // long the exporter (e.g. a NumPy capsule) holds it.
+  std::shared_ptr<void> share(const std::string& name) {
+    return columns.at(name).data;
+  }
+
+  // ====================== Persistence ======================
+
+  template <class T>
+  void save(const std::string& name, const std::string& path) {
+    T* buf = data<T>(name);
+    std::ofstream out(path, std::ofstream::out | std::ios::binary);
+    uint64_t header[4] = {kMagic, n, sizeof(T),
+                          (uint64_t)typeid(T).hash_code()};
+    out.write((char*)header, sizeof(header));
+    out.write((const char*)buf, n * sizeof(T));
+  }
+
+  // Loads a persisted column (copying out of a transient mapping; the
+  // column then behaves like any in-memory column). Returns false when the
+  // file is absent or does not match (size or type), in which case the
+  // caller recomputes.
+  template <class T>
+  bool load(const std::string& name, const std::string& path) {
+    char* bytes;
+    size_t bytes_size;
+    std::ifstream probe(path);
+    if (!probe.good()) return false;
+    std::tie(bytes, bytes_size) = gbbs_io::mmapStringFromFile(path.c_str());
+    uint64_t* header = (uint64_t*)bytes;
+    bool ok = bytes_size >= 4 * sizeof(uint64_t) && header[0] == kMagic &&
+              header[1] == n && header[2] == sizeof(T) &&
+              header[3] == (uint64_t)typeid(T).hash_code();
+    if (ok) {
+      auto values = pbbs::sequence<T>::no_init(n);
+      memcpy(values.begin(), bytes + 4 * sizeof(uint64_t), n * sizeof(T));
+      put(name, std::move(values));
+    }
+    gbbs_io::unmmap(bytes, bytes_size);
+    return ok;
+  }
+};
+
+}  // namespace gbbs
@@ -0,0 +1,126 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Record/replay of the traversal-shaping decisions that make performance
+// runs diverge: the sparse/dense direction choices of edgeMapData and the
+// random seeds. A recording policy wraps the default direction policy and
+// logs every decision; the replaying policy feeds the recorded stream back,
+// pinning the traversal structure (which dense passes ran, which rounds
+// went through the blocked sparse path) so an anomalous run's shape can be
+// reproduced under a profiler. Decisions inside a pinned shape that depend
+// on CAS winners remain nondeterministic -- this reproduces the expensive
+// structure, which is what tail-latency debugging needs.
+//
+//   replay::recorder rec("run.decisions");
+//   auto policy = replay::recording_policy(G.m, rec);
+//   ... edgeMapData(..., policy, ...) per round ...
+//
+//   replay::player player("run.decisions");
+//   auto policy = replay::replaying_policy(player);
+
+#pragma once
+
+#include <fstream>
+#include <vector>
+
+#include "edge_map_data.h"
+#include "gbbs.h"
+
+namespace gbbs {
+namespace replay {
+
+struct recorder {
+  std::ofstream out;
+  recorder(const std::string& path)
+      : out(path, std::ofstream::out | std::ios::binary) {}
+  void log(uint8_t decision) { out.write((char*)&decision, 1); }
+};
+
+struct player {
+  std::vector<uint8_t> decisions;
+  size_t pos = 0;
+  player(const std::string& path) {
+    std::ifstream in(path, std::ios::in | std::ios::binary);
+    char c;
+    while (in.get(c)) decisions.push_back((uint8_t)c);
+  }
+  uint8_t next() {
+    if (pos >= decisions.size()) return 0;  // past the tape: sparse
+    return decisions[pos++];
+  }
+  bool exhausted() const { return pos >= decisions.size(); }
+};
+
+// Wraps default_direction_policy, logging each decision:
+//   1 = stayed dense, 2 = went dense, 0 = sparse.
+struct recording_policy {
+  default_direction_policy inner;
+  recorder& rec;
+  recording_policy(size_t num_edges, recorder& rec)
+      : inner(num_edges), rec(rec) {}
+
+  bool stay_dense(size_t n, size_t fsize, bool is_dense) {
+    bool d = inner.stay_dense(n, fsize, is_dense);
+    if (d) rec.log(1);
+    return d;
+  }
+  bool go_dense(size_t fsize, size_t out_degrees) {
+    bool d = inner.go_dense(fsize, out_degrees);
+    rec.log(d ? 2 : 0);
+    return d;
+  }
+  void update(size_t next_size) { inner.update(next_size); }
+};
+
+// Replays a recorded decision stream, ignoring the runtime statistics.
+struct replaying_policy {
+  player& tape;
+  replaying_policy(player& tape) : tape(tape) {}
+
+  bool stay_dense(size_t, size_t, bool is_dense) {
+    // a recorded 1 at this position means the original run stayed dense
+    if (is_dense && tape.pos < tape.decisions.size() &&
+        tape.decisions[tape.pos] == 1) {
+      tape.pos++;
+      return true;
+    }
+    return false;
+  }
+  bool go_dense(size_t, size_t) { return tape.next() == 2; }
+  void update(size_t) {}
+};
+
+// Pins the random seeds: hands out a deterministic pbbs::random stream
+// derived from one recorded base seed, so shuffles and samplers draw the
+// same values run to run.
+struct seed_source {
+  uint64_t base;
+  size_t handed_out = 0;
+  seed_source(uint64_t base) : base(base) {}
+  pbbs::random next() {
+    return pbbs::random(pbbs::hash64(base + (handed_out++)));
+  }
+};
+
+}  // namespace replay
+}  // namespace gbbs
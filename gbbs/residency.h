@@ -0,0 +1,113 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Working-set observability for semi-external runs: which parts of an
+// mmap'd edge region are page-cache resident, per algorithm phase. The
+// region is split into bands and each band's residency is estimated by
+// mincore over evenly spaced single-page probes, so a snapshot is cheap
+// even on terabyte maps. report(label) prints one line per call -- total
+// resident estimate plus a per-band profile -- which makes thrash visible:
+// a healthy out-of-core run shows a moving resident window, a thrashing
+// one shows uniformly low bands that never accumulate. Degrades to a
+// no-op where mincore is unavailable.
+//
+//   auto R = residency::tracker(range.first, range_len);
+//   R.report("after load");
+//   ... phase ...
+//   R.report("after bfs");
+
+#pragma once
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace gbbs {
+namespace residency {
+
+struct tracker {
+  char* base;
+  size_t len;
+  size_t num_bands;
+  size_t probes_per_band;
+
+  tracker(char* base, size_t len, size_t num_bands = 32,
+          size_t probes_per_band = 128)
+      : base(base), len(len), num_bands(num_bands),
+        probes_per_band(probes_per_band) {}
+
+  // Resident fraction estimate per band (by sampled pages).
+  std::vector<double> snapshot() const {
+    std::vector<double> fractions(num_bands, 0.0);
+#if defined(__linux__)
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t band_bytes = (len + num_bands - 1) / num_bands;
+    for (size_t b = 0; b < num_bands; b++) {
+      size_t start = b * band_bytes;
+      size_t end = std::min(start + band_bytes, len);
+      if (start >= end) break;
+      size_t band_pages = (end - start + page - 1) / page;
+      size_t probes = std::min(probes_per_band, band_pages);
+      size_t resident = 0;
+      for (size_t p = 0; p < probes; p++) {
+        size_t page_idx = (band_pages <= probes)
+                              ? p
+                              : (p * band_pages) / probes;
+        void* addr = (void*)(((size_t)base + start + page_idx * page) &
+                             ~(page - 1));
+        unsigned char vec = 0;
+        if (mincore(addr, 1, &vec) == 0) {
+          resident += (vec & 1);
+        }
+      }
+      fractions[b] = probes ? (double)resident / probes : 0.0;
+    }
+#endif
+    return fractions;
+  }
+
+  // One line: estimated resident MB and a per-band residency profile in
+  // tenths (0-9, ':' for fully resident).
+  void report(const std::string& label, std::ostream& os = std::cout) const {
+    auto fr = snapshot();
+    double total = 0;
+    std::string profile;
+    for (double f : fr) {
+      total += f;
+      int tenth = (int)(f * 10.0);
+      profile += (tenth >= 10) ? ':' : (char)('0' + tenth);
+    }
+    double resident_mb =
+        (total / std::max<size_t>(fr.size(), 1)) * len / (1 << 20);
+    os << "# residency[" << label << "]: ~" << resident_mb << " MB of "
+       << (len / (1 << 20)) << " MB resident | " << profile << std::endl;
+  }
+};
+
+}  // namespace residency
+}  // namespace gbbs
@@ -116,6 +116,62 @@ size_t seq_merge(SeqA& A, SeqB& B) {
 }
 
 
+// Block-granular intersection over two bitset-managed neighbor sets.
+// Each live block spans a sorted id range bounded by its original edge
+// array's first and last entries (a superset of the live ids, read with
+// two edge loads and no bitset decode), so disjoint blocks are skipped at
+// block granularity like a merge over intervals. Only block pairs whose
+// ranges overlap decode their live edges (the tzcnt walk) into stack
+// buffers and merge. Blocks are position-keyed rather than id-aligned
+// across vertices, so co-resident pairs merge decoded ids instead of
+// AND-ing raw bitset words; the block skip is where the win is.
+template <class W, class BMA, class BMB>
+inline size_t intersect_blocks(BMA& a, BMB& b) {
+  size_t na = a.num_blocks();
+  size_t nb = b.num_blocks();
+  if (a.get_degree() == 0 || b.get_degree() == 0) return 0;
+
+  // sized by each manager's block capacity: 256 for the uncompressed
+  // manager, PARALLEL_DEGREE (1000) for the compressed one
+  uintE buf_a[BMA::edges_per_block], buf_b[BMB::edges_per_block];
+  size_t ans = 0;
+  size_t ia = 0, ib = 0;
+  long cached_a = -1, cached_b = -1;  // which block each buffer holds
+  size_t la = 0, lb = 0;
+  while (ia < na && ib < nb) {
+    if (a.block_degree(ia) == 0) { ia++; continue; }
+    if (b.block_degree(ib) == 0) { ib++; continue; }
+    uintE alo, ahi, blo, bhi;
+    a.block_id_range(ia, alo, ahi);
+    b.block_id_range(ib, blo, bhi);
+    if (ahi < blo) { ia++; continue; }  // disjoint: skip without decoding
+    if (bhi < alo) { ib++; continue; }
+
+    if (cached_a != (long)ia) {
+      la = 0;
+      a.decode_block(ia, [&](const uintE& ngh, const W& wgh, uintE off) {
+        buf_a[la++] = ngh;
+      });
+      cached_a = (long)ia;
+    }
+    if (cached_b != (long)ib) {
+      lb = 0;
+      b.decode_block(ib, [&](const uintE& ngh, const W& wgh, uintE off) {
+        buf_b[lb++] = ngh;
+      });
+      cached_b = (long)ib;
+    }
+    auto sa = pbbslib::make_sequence(buf_a, la);
+    auto sb = pbbslib::make_sequence(buf_b, lb);
+    ans += seq_merge(sa, sb);
+    // advance the block that ends first; on a tie both are exhausted
+    if (ahi < bhi) ia++;
+    else if (bhi < ahi) ib++;
+    else { ia++; ib++; }
+  }
+  return ans;
+}
+
 //template <class S, class It>
 //size_t intersect_batch_seq(S& a, It& b) {
 //  size_t b_size = 128;
@@ -150,19 +206,66 @@ size_t seq_merge(SeqA& A, SeqB& B) {
 //}
 
 
+/* Per-superblock (64-block) liveness masks for block iteration. After deep
+ * filtering most blocks are dead but survive until the next repack (empties
+ * are only compacted when full_blocks * kFullBlockPackThreshold <=
+ * vtx_num_blocks), so a plain par_for over blocks spends its time spawning
+ * decode calls that read two metadata words and return. Here the masks are
+ * built in one streaming pass over the metadata (block_degree is two
+ * consecutive reads; the scan prefetches perfectly), then only live blocks
+ * pay a decode. Masks live on the stack up to 64 superblocks (4096 blocks);
+ * hub vertices beyond that allocate. Vertices with few blocks skip the
+ * summary entirely -- the pass only wins when there is metadata to skip. */
+constexpr size_t kLiveMaskThreshold = 128;
+
+template <class BM /* block_manager */, class FB /* per-block function */>
+inline void for_each_live_block(BM& block_manager, bool parallel,
+                                FB f_block) {
+  size_t nb = block_manager.num_blocks();
+  if (nb < kLiveMaskThreshold) {
+    par_for(0, nb, 1, [&](size_t b) { f_block(b); }, parallel);
+    return;
+  }
+  size_t n_sb = (nb + 63) / 64;
+  uint64_t stk[64];
+  uint64_t* masks = stk;
+  if (n_sb > 64) masks = pbbs::new_array_no_init<uint64_t>(n_sb);
+  par_for(0, n_sb, 1,
+          [&](size_t sb) {
+            uint64_t m = 0;
+            size_t lo = sb * 64;
+            size_t hi = std::min(lo + 64, nb);
+            for (size_t b = lo; b < hi; b++) {
+              m |= static_cast<uint64_t>(block_manager.block_degree(b) > 0)
+                   << (b - lo);
+            }
+            masks[sb] = m;
+          },
+          parallel);
+  par_for(0, n_sb, 1,
+          [&](size_t sb) {
+            uint64_t m = masks[sb];
+            while (m > 0) {
+              unsigned idx = _tzcnt_u64(m);
+              f_block(sb * 64 + idx);
+              m = _blsr_u64(m);
+            }
+          },
+          parallel);
+  if (n_sb > 64) pbbs::free_array(masks);
+}
+
 /* Used to map over the edges incident to v */
 template <class W /* weight */,
           class F /* user-specified mapping function */,
           class BM /* block_manager */>
 inline void map_nghs(uintE vtx_id, BM& block_manager, F& f, bool parallel) {
-  par_for(0, block_manager.num_blocks(), 1,
-          [&](size_t block_num) {
-            block_manager.decode_block(
-                block_num, [&](const uintE& ngh, const W& wgh, uintE edge_num) {
-                  f(vtx_id, ngh, wgh);
-                });
-          },
-          parallel);
+  for_each_live_block(block_manager, parallel, [&](size_t block_num) {
+    block_manager.decode_block(
+        block_num, [&](const uintE& ngh, const W& wgh, uintE edge_num) {
+          f(vtx_id, ngh, wgh);
+        });
+  });
 }
 
 /* Map over edges incident to v using M, reduce using Monoid */
@@ -213,15 +316,13 @@ template <class W /* weight */,
           class F /* mapping function */, class G /* output function */, class BM /* block_manager */>
 inline void copyNghs(uintE vtx_id, BM& block_manager, uintT o, F& f, G& g,
                      bool parallel) {
-  par_for(0, block_manager.num_blocks(), 1,
-          [&](size_t block_num) {
-            block_manager.decode_block(
-                block_num, [&](const uintE& ngh, const W& wgh, uintE edge_num) {
-                  auto val = f(vtx_id, ngh, wgh);
-                  g(ngh, o + edge_num, val);
-                });
-          },
-          parallel);
+  for_each_live_block(block_manager, parallel, [&](size_t block_num) {
+    block_manager.decode_block(
+        block_num, [&](const uintE& ngh, const W& wgh, uintE edge_num) {
+          auto val = f(vtx_id, ngh, wgh);
+          g(ngh, o + edge_num, val);
+        });
+  });
 }
 
 /* For each out-neighbor satisfying cond, call updateAtomic */
@@ -230,19 +331,17 @@ template <class W /* weight */,
           class H /* empty output function */, class BM /* block_manager */>
 inline void decodeNghsSparse(uintE vtx_id, BM& block_manager, uintT o, F& f,
                              G& g, H& h, bool parallel) {
-  par_for(0, block_manager.num_blocks(), 1,
-          [&](size_t block_num) {
-            block_manager.decode_block(
-                block_num, [&](const uintE& ngh, const W& wgh, uintE edge_num) {
-                  if (f.cond(ngh)) {
-                    auto m = f.updateAtomic(vtx_id, ngh, wgh);
-                    g(ngh, o + edge_num, m);
-                  } else {
-                    h(ngh, o + edge_num);
-                  }
-                });
-          },
-          parallel);
+  for_each_live_block(block_manager, parallel, [&](size_t block_num) {
+    block_manager.decode_block(
+        block_num, [&](const uintE& ngh, const W& wgh, uintE edge_num) {
+          if (f.cond(ngh)) {
+            auto m = f.updateAtomic(vtx_id, ngh, wgh);
+            g(ngh, o + edge_num, m);
+          } else {
+            h(ngh, o + edge_num);
+          }
+        });
+  });
 }
 
 /* For each out-neighbor satisfying cond, call updateAtomic */
@@ -250,15 +349,13 @@ template <class W /* weight */,
           class F /* mapping function */, class G /* output function */, class BM /* block_manager */>
 inline void decodeNghs(uintE vtx_id, BM& block_manager, F& f, G& g,
                        bool parallel) {
-  par_for(0, block_manager.num_blocks(), 1,
-          [&](size_t block_num) {
-            block_manager.decode_block(
-                block_num, [&](const uintE& ngh, const W& wgh, uintE edge_num) {
-                  auto m = f.updateAtomic(vtx_id, ngh, wgh);
-                  g(ngh, m);
-                });
-          },
-          parallel);
+  for_each_live_block(block_manager, parallel, [&](size_t block_num) {
+    block_manager.decode_block(
+        block_num, [&](const uintE& ngh, const W& wgh, uintE edge_num) {
+          auto m = f.updateAtomic(vtx_id, ngh, wgh);
+          g(ngh, m);
+        });
+  });
 }
 
 /* Sequentially process incident edges and quit if cond on self fails. */
@@ -281,8 +378,7 @@ inline void decodeNghsBreakEarly(uintE vtx_id, BM& block_manager,
             });
       }
     } else {
-      size_t num_blocks = block_manager.num_blocks();
-      par_for(0, num_blocks, 1, [&](size_t block_num) {
+      for_each_live_block(block_manager, true, [&](size_t block_num) {
         block_manager.decode_block_cond(
             block_num,
             [&](const uintE& ngh, const W& wgh, const size_t& edge_num) {
@@ -375,6 +471,20 @@ struct uncompressed_bitset_neighbors {
       bytes_per_block - sizeof(metadata);
   static constexpr uintE kFullBlockPackThreshold = 2;
   static constexpr uintE kBlockAllocThreshold = 20;
+  // Top bit of vtx_num_blocks in vtx_info marks the sparse (sorted live
+  // position list) representation; see pack_blocks for the conversion.
+  static constexpr uintE kSparseRepBit = (uintE)1 << 31;
+
+  // Adaptive representation for deeply filtered vertices: once the live
+  // degree is small enough that a sorted list of live positions (uintE
+  // indices into the original edge array) fits within the metadata array
+  // alone, pack_blocks rewrites the vertex's region as that list and sets
+  // kSparseRepBit. One bit per original edge becomes four bytes per live
+  // edge -- a shrink whenever density < 1/32, and conversion only fires
+  // below 1/128. One-way: filters only remove edges, so a sparse vertex
+  // stays sparse. Block iteration sees synthetic 256-edge chunks, so the
+  // representation is transparent to the decode/map/intersect paths.
+  bool is_sparse = false;
 
   E* e0;
 #ifdef SAGE
@@ -404,7 +514,16 @@ struct uncompressed_bitset_neighbors {
 
     // TODO: ensure that blocks is 4-byte aligned.
     blocks_start = blocks + v_info.vtx_block_offset;
-    block_data_start = blocks_start + (vtx_num_blocks * sizeof(metadata));
+    if (vtx_num_blocks & kSparseRepBit) {
+      is_sparse = true;
+      vtx_num_blocks = (vtx_degree == 0)
+                           ? 0
+                           : (vtx_degree + edges_per_block - 1) /
+                                 edges_per_block;
+      block_data_start = blocks_start;  // the sorted position list
+    } else {
+      block_data_start = blocks_start + (vtx_num_blocks * sizeof(metadata));
+    }
   }
 
   __attribute__((always_inline)) inline E* get_edges() {
@@ -444,10 +563,36 @@ struct uncompressed_bitset_neighbors {
   }
 
   __attribute__((always_inline)) inline uintE block_degree(uintE block_id) {
+    if (is_sparse) {
+      return std::min<uintE>(edges_per_block,
+                             vtx_degree - block_id * edges_per_block);
+    }
     return bitsets::block_degree(blocks_start, block_id, vtx_num_blocks,
                                  vtx_degree);
   }
 
+  // Original-edge-array id bounds of a block (a superset of its live ids);
+  // two edge loads, no bitset decode. Used for block-skip intersection.
+  __attribute__((always_inline)) inline void block_id_range(uintE block_id,
+                                                            uintE& lo,
+                                                            uintE& hi) {
+    E* e = get_edges();
+    if (is_sparse) {
+      uintE* pos = (uintE*)blocks_start;
+      uintE start = block_id * edges_per_block;
+      uintE end = std::min<uintE>(start + edges_per_block, vtx_degree);
+      lo = std::get<0>(e[pos[start]]);
+      hi = std::get<0>(e[pos[end - 1]]);
+      return;
+    }
+    metadata* block_metadata = (metadata*)blocks_start;
+    uintE orig_block_num = block_metadata[block_id].block_num;
+    uintE block_start = orig_block_num * edges_per_block;
+    uintE block_end =
+        std::min(block_start + edges_per_block, vtx_original_degree);
+    lo = std::get<0>(e[block_start]);
+    hi = std::get<0>(e[block_end - 1]);
+  }
 
   template <class P>
   inline size_t pack(P& p, uint8_t* tmp, bool parallel = true, const flags fl = 0) {
@@ -455,6 +600,7 @@ struct uncompressed_bitset_neighbors {
   }
 
   inline size_t calculateTemporarySpaceBytes() {
+    if (is_sparse) return 0;
     if (vtx_degree > 0) {
       size_t nblocks =  vtx_num_blocks;
       if (nblocks > kBlockAllocThreshold) {
@@ -514,6 +660,17 @@ struct uncompressed_bitset_neighbors {
 
   template <class F>
   __attribute__((always_inline)) inline void decode_block(uintE block_id, F f) {
+    if (is_sparse) {
+      uintE* pos = (uintE*)blocks_start;
+      size_t start = (size_t)block_id * edges_per_block;
+      size_t end = std::min<size_t>(start + edges_per_block, vtx_degree);
+      E* e = get_edges();
+      for (size_t k = start; k < end; k++) {
+        auto& ee = e[pos[k]];
+        f(std::get<0>(ee), std::get<1>(ee), (uintE)k);
+      }
+      return;
+    }
     metadata* block_metadata = (metadata*)blocks_start;
     uintE offset = block_metadata[block_id].offset;
     uintE next_block_offset = (block_id == vtx_num_blocks - 1)
@@ -555,6 +712,17 @@ struct uncompressed_bitset_neighbors {
   template <class F>
   __attribute__((always_inline)) inline void decode_block_cond(uintE block_id,
                                                                F f) {
+    if (is_sparse) {
+      uintE* pos = (uintE*)blocks_start;
+      size_t start = (size_t)block_id * edges_per_block;
+      size_t end = std::min<size_t>(start + edges_per_block, vtx_degree);
+      E* e = get_edges();
+      for (size_t k = start; k < end; k++) {
+        auto& ee = e[pos[k]];
+        if (!f(std::get<0>(ee), std::get<1>(ee), (uintE)k)) return;
+      }
+      return;
+    }
     metadata* block_metadata = (metadata*)blocks_start;
     uintE offset = block_metadata[block_id].offset;
     uintE next_block_offset = (block_id == vtx_num_blocks - 1)
@@ -725,6 +893,23 @@ struct uncompressed_bitset_neighbors {
     if (vtx_degree == 0) {
       return 0;
     }
+    if (is_sparse) {
+      // filter the position list in place; sparse vertices are small, so
+      // this runs sequentially
+      uintE* pos = (uintE*)blocks_start;
+      E* e = get_edges();
+      uintE k = 0;
+      for (uintE i = 0; i < vtx_degree; i++) {
+        auto& ee = e[pos[i]];
+        if (p(vtx_id, std::get<0>(ee), std::get<1>(ee))) pos[k++] = pos[i];
+      }
+      vtx_degree = k;
+      vtx_num_blocks =
+          (k == 0) ? 0 : (k + edges_per_block - 1) / edges_per_block;
+      v_infos[vtx_id].vtx_degree = k;
+      v_infos[vtx_id].vtx_num_blocks = kSparseRepBit;
+      return k;
+    }
     metadata* block_metadata = (metadata*)blocks_start;
     uintE int_stk[kBlockAllocThreshold];
     uintE* tmp_ints = (uintE*)int_stk;
@@ -819,10 +1004,66 @@ struct uncompressed_bitset_neighbors {
     // Update the degree in vtx_info.
     v_infos[vtx_id].vtx_degree = sum;
     assert(sum <= vtx_original_degree);
+
+    // Adaptive representation: once the sorted live position list fits in
+    // the metadata array alone (density below ~1/128), convert; block
+    // iteration over this vertex then touches 4 bytes per live edge
+    // instead of one bit per original edge.
+    if (sum > 0 &&
+        (size_t)sum * sizeof(uintE) <=
+            (size_t)vtx_num_blocks * sizeof(metadata)) {
+      convert_to_sparse(sum);
+    }
     return sum;  // return the new degree
   }
 
+  // Rewrites this vertex's block region as the sorted list of live
+  // positions (indices into the original edge array). Caller guarantees
+  // the list fits in the metadata array, so writing through a temporary
+  // cannot clobber unread block data.
+  inline void convert_to_sparse(uintE new_degree) {
+    uintE stk[1024];
+    uintE* tmp_pos = stk;
+    if (new_degree > 1024) tmp_pos = pbbs::new_array_no_init<uintE>(new_degree);
+    metadata* block_metadata = (metadata*)blocks_start;
+    // recompute the data start from the current block count: repack may
+    // have just compacted the metadata array, which moves the data region
+    uint8_t* data_start = blocks_start + (vtx_num_blocks * sizeof(metadata));
+    size_t k = 0;
+    for (size_t b = 0; b < vtx_num_blocks; b++) {
+      uintE orig_block_num = block_metadata[b].block_num;
+      uint8_t* block_bits = data_start + bitset_bytes_per_block * b;
+      uintE block_start = orig_block_num * edges_per_block;
+      uintE block_end =
+          std::min(block_start + edges_per_block, vtx_original_degree);
+      size_t nlongs = (block_end - block_start + 64 - 1) / 64;
+      uint64_t* longs = (uint64_t*)block_bits;
+      size_t cur = block_start;
+      for (size_t idx = 0; idx < nlongs; idx++) {
+        uint64_t l = longs[idx];
+        while (l > 0) {
+          tmp_pos[k++] = (uintE)(cur + _tzcnt_u64(l));
+          l = _blsr_u64(l);
+        }
+        cur += 64;
+      }
+    }
+    assert(k == new_degree);
+    uintE* pos = (uintE*)blocks_start;
+    for (size_t i = 0; i < k; i++) pos[i] = tmp_pos[i];
+    if (new_degree > 1024) pbbs::free_array(tmp_pos);
+    is_sparse = true;
+    vtx_num_blocks = (new_degree + edges_per_block - 1) / edges_per_block;
+    v_infos[vtx_id].vtx_num_blocks = kSparseRepBit;
+    block_data_start = blocks_start;
+  }
+
   std::tuple<uintE, W> ith_neighbor(size_t i) {
+    if (is_sparse) {
+      uintE* pos = (uintE*)blocks_start;
+      auto& ee = get_edges()[pos[i]];
+      return std::make_tuple(std::get<0>(ee), std::get<1>(ee));
+    }
     metadata* block_metadata = (metadata*)blocks_start;
     auto offsets_imap = pbbslib::make_sequence<size_t>(vtx_num_blocks, [&] (size_t ind) {
       return block_metadata[ind].offset;
@@ -865,23 +1106,28 @@ struct uncompressed_bitset_neighbors {
     uintE last_ngh;
     uintE proc;
     uintE proc_cur_block;
+    bool sparse;  // iterating a live-position list, not bitset blocks
 
     iter(E* edges,
         uintE vtx_degree,
         uintE vtx_original_degree,
         uintE vtx_num_blocks,
         uint8_t* blocks_start,
-        uint8_t* block_data_start) :
+        uint8_t* block_data_start,
+        bool sparse = false) :
         edges(edges),
         vtx_degree(vtx_degree),
         vtx_original_degree(vtx_original_degree),
         vtx_num_blocks(vtx_num_blocks),
         blocks_start(blocks_start),
         block_data_start(block_data_start),
-        proc(0) {
+        proc(0),
+        sparse(sparse) {
       proc = 0;
       if (vtx_degree > 0) {
-        next_nonempty_block(/* on_initialization = */ true);
+        if (!sparse) {
+          next_nonempty_block(/* on_initialization = */ true);
+        }
         next(); // sets last_ngh
       }
     }
@@ -927,6 +1173,12 @@ struct uncompressed_bitset_neighbors {
 
     // updates last_ngh
     __attribute__((always_inline)) inline uintE next() {
+      if (sparse) {
+        uintE* pos = (uintE*)blocks_start;
+        last_ngh = std::get<0>(edges[pos[proc]]);
+        proc++;
+        return last_ngh;
+      }
       while(cur_long_value == 0) {
         // done with block?
         cur_long_idx++;
@@ -956,7 +1208,8 @@ struct uncompressed_bitset_neighbors {
         vtx_original_degree,
         vtx_num_blocks,
         blocks_start,
-        block_data_start);
+        block_data_start,
+        is_sparse);
   }
 };
 
@@ -1048,6 +1301,19 @@ struct compressed_bitset_neighbors {
                                  vtx_degree);
   }
 
+  // Id bounds of a block for block-skip intersection. Compressed blocks
+  // have no O(1) endpoint access, so this decodes the block (at most
+  // edges_per_block = PARALLEL_DEGREE edges); the uncompressed manager
+  // reads two edge words instead.
+  inline void block_id_range(uintE block_id, uintE& lo, uintE& hi) {
+    lo = UINT_E_MAX;
+    hi = 0;
+    decode_block(block_id, [&](const uintE& ngh, const W& wgh, uintE off) {
+      if (ngh < lo) lo = ngh;
+      if (hi < ngh) hi = ngh;
+    });
+  }
+
   template <class P>
   inline size_t pack(P& p, uint8_t* tmp, bool parallel = true, const flags fl = 0) {
     return pack_blocks(vtx_id, p, tmp, parallel, fl);
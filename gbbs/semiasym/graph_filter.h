@@ -247,6 +247,14 @@ struct symmetric_packed_graph {
     });
   }
 
+  // Alias matching the symmetric_graph spelling, so edge-mapping consumers
+  // (union-find connectivity and friends) run directly over the packed
+  // view without materializing the filtered graph.
+  template <class F>
+  void mapEdges(F f, bool parallel_inner_map = true) {
+    map_edges(f, parallel_inner_map);
+  }
+
   void del() {
     std::cout << "# deleting packed_graph" << std::endl;
     pbbs::free_array(VI);
@@ -281,6 +289,31 @@ symmetric_packed_graph<vertex_type, W> filter_graph(symmetric_graph<vertex_type,
   return GA;
 }
 
+// Monotone refiltering restricted to the vertices whose predicate results
+// can actually have changed (e.g., the neighbors of this round's peeled
+// set). Iterative filter-and-peel loops call the whole-graph overload
+// below dozens of times; with this overload each round re-packs only the
+// dirty subset, reusing the existing bitsets in place and never
+// re-scanning regions earlier rounds already cleared.
+template <template <class W> class vertex_type, class W, class P>
+void filter_graph(symmetric_packed_graph<vertex_type, W>& GA, P& pred_f,
+                  vertexSubset& dirty) {
+  dirty.toSparse();
+  parallel_for(0, dirty.size(), [&] (size_t i) {
+    uintE v = dirty.vtx(i);
+    auto vtx = GA.get_vertex(v);
+    if (vtx.out_degree() > 0) {
+      vtx.out_neighbors().pack(pred_f, /* tmp = */ nullptr,
+                               /* parallel = */ true,
+                               /* flags = */ compact_blocks);
+    }
+  }, 1);
+  auto degree_seq = pbbs::delayed_seq<size_t>(GA.n, [&] (size_t i) {
+    return GA.out_degree(i);
+  });
+  GA.m = pbbslib::reduce_add(degree_seq);
+}
+
 template <template <class W> class vertex_type, class W, class P>
 void filter_graph(symmetric_packed_graph<vertex_type, W>& GA, P& pred_f) {
   // TODO: do allocations, but in a (medium) constant number of allocations.
@@ -471,6 +504,14 @@ struct asymmetric_packed_graph {
     });
   }
 
+  // Alias matching the symmetric_graph spelling, so edge-mapping consumers
+  // (union-find connectivity and friends) run directly over the packed
+  // view without materializing the filtered graph.
+  template <class F>
+  void mapEdges(F f, bool parallel_inner_map = true) {
+    map_edges(f, parallel_inner_map);
+  }
+
   // Clears all vertices (zeros out their in-/out-degree) that do not satisfy
   // the predicate P.
   template <class P>
@@ -101,6 +101,47 @@ class sequentialHT {
     }
   }
 
+  // Batched insertAdd over a contiguous run of keys, returning the number of
+  // distinct new keys inserted. Hashes for a block of keys are computed in a
+  // tight data-independent loop (hash64 is straight-line mul/xor, so the
+  // compiler can vectorize it) and the target table lines are prefetched
+  // before the serial probe loop touches them, hiding the cache misses that
+  // dominate scalar per-key insertion. Results are identical to calling
+  // insertAdd on each key in order.
+  static constexpr size_t kInsertBatchSize = 16;
+  inline size_t insertAddBatch(K* keys, size_t ct) {
+    size_t hashes[kInsertBatchSize];
+    size_t distinct = 0;
+    size_t b_off = 0;
+    while (b_off < ct) {
+      size_t b_ct = std::min(ct - b_off, kInsertBatchSize);
+      for (size_t i = 0; i < b_ct; i++) {
+        hashes[i] = toRange(pbbslib::hash64(keys[b_off + i]));
+      }
+      for (size_t i = 0; i < b_ct; i++) {
+        __builtin_prefetch(&table[hashes[i]]);
+      }
+      for (size_t i = 0; i < b_ct; i++) {
+        K vKey = keys[b_off + i];
+        size_t h = hashes[i];
+        while (1) {
+          auto k = std::get<0>(table[h]);
+          if (k == max_key) {
+            table[h] = std::make_tuple(vKey, 1);
+            distinct++;
+            break;
+          } else if (k == vKey) {
+            std::get<1>(table[h])++;
+            break;
+          }
+          h = incrementIndex(h);
+        }
+      }
+      b_off += b_ct;
+    }
+    return distinct;
+  }
+
   // V must support ++, T<1> must be numeric
   inline bool insertAdd(T& v) {
     const K& vKey = std::get<0>(v);
@@ -0,0 +1,128 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Shared immutable graph storage for serving processes that run several
+// views over one topology. A graph's ownership of its arrays lives entirely
+// in its deletion_fn, so sharing is implemented there: shared_graph takes
+// ownership of a loaded graph's cleanup and mints view graphs whose
+// deletion_fns decrement a refcount, running the real cleanup only when the
+// last view (and the shared_graph itself) has released it. Hosting four
+// views of a 300GB graph then costs one copy of the arrays, not four.
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "graph.h"
+
+namespace gbbs {
+
+namespace internal {
+struct shared_storage {
+  std::atomic<size_t> refs;
+  std::function<void()> del;
+  shared_storage(std::function<void()> del) : refs(1), del(std::move(del)) {}
+};
+}  // namespace internal
+
+// Takes ownership of G's backing arrays (G's own deletion_fn is replaced by
+// a refcounted release). Each new_view() returns a graph aliasing the same
+// vertex/edge arrays; calling del() on a view releases one reference, and
+// the arrays are freed when the shared_graph and every view have released
+// theirs. Views are independent graph objects, so per-view mutation of
+// metadata (e.g. decreaseVertexDegree on an uncompressed view) is allowed
+// only if the caller copies v_data first -- the shared arrays themselves
+// must be treated as immutable.
+template <class Graph>
+struct shared_graph {
+  Graph base;
+  std::shared_ptr<internal::shared_storage> storage;
+
+  shared_graph(Graph&& G)
+      : base(std::move(G)),
+        storage(std::make_shared<internal::shared_storage>(base.deletion_fn)) {
+    base.deletion_fn = make_release_fn();
+  }
+
+  // A new graph object sharing the same immutable arrays.
+  Graph new_view() {
+    storage->refs.fetch_add(1);
+    Graph view = base;  // shallow copy of pointers and sizes
+    view.deletion_fn = make_release_fn();
+    return view;
+  }
+
+  size_t use_count() const { return storage->refs.load(); }
+
+ private:
+  std::function<void()> make_release_fn() {
+    auto s = storage;
+    return [s]() {
+      if (s->refs.fetch_sub(1) == 1) {
+        s->del();
+      }
+    };
+  }
+};
+
+// A by-name registry of shared graphs of one type, for serving processes
+// that keep several resident topologies and hand out views on request.
+template <class Graph>
+struct graph_registry {
+  std::unordered_map<std::string, std::shared_ptr<shared_graph<Graph>>> graphs;
+
+  // Registers a loaded graph under `name`, taking ownership of its arrays.
+  void put(const std::string& name, Graph&& G) {
+    graphs[name] = std::make_shared<shared_graph<Graph>>(std::move(G));
+  }
+
+  bool contains(const std::string& name) const {
+    return graphs.count(name) > 0;
+  }
+
+  // Mints a view of the named graph; aborts if absent.
+  Graph get_view(const std::string& name) {
+    auto it = graphs.find(name);
+    if (it == graphs.end()) {
+      std::cout << "graph_registry: no graph named " << name << std::endl;
+      abort();
+    }
+    return it->second->new_view();
+  }
+
+  // Drops the registry's own reference; the arrays live on until the last
+  // outstanding view is deleted.
+  void remove(const std::string& name) {
+    auto it = graphs.find(name);
+    if (it != graphs.end()) {
+      it->second->base.del();
+      graphs.erase(it);
+    }
+  }
+};
+
+}  // namespace gbbs
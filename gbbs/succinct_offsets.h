@@ -0,0 +1,189 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Succinct CSR vertex metadata. vertex_data spends 16 bytes per vertex
+// (offset + degree); the offsets are a monotone sequence bounded by m, so
+// Elias-Fano stores them in ~n*(2 + log(m/n)) bits -- about 4 bytes/vertex
+// on sparse graphs -- and the degree falls out of two consecutive decodes.
+// Select over the high-bits unary stream is one superblock sample (every
+// 512th one) plus a short popcount scan; consecutive offsets share the
+// scan, so get_vertex costs one sample lookup and a few popcounts.
+// succinct_symmetric_graph serves the same get_vertex interface over the
+// original edge array, so traversal code runs unchanged.
+
+#pragma once
+
+#include <immintrin.h>
+
+#include "gbbs.h"
+#include "graph.h"
+
+namespace gbbs {
+
+struct ef_offsets {
+  static constexpr size_t kSampleRate = 512;
+
+  size_t n = 0;           // number of stored values (n_vertices + 1)
+  size_t universe = 0;    // max value (m)
+  size_t low_width = 0;   // bits per low part
+  sequence<uint64_t> lows;
+  sequence<uint64_t> highs;            // unary-coded high parts
+  sequence<uint64_t> select_samples;   // bit position of every 512th one
+
+  ef_offsets() {}
+
+  template <class Seq>
+  ef_offsets(Seq const& offsets, size_t universe) : universe(universe) {
+    n = offsets.size();
+    low_width = 0;
+    while ((universe >> low_width) > n) low_width++;
+    size_t low_words = (n * low_width + 63) / 64 + 1;
+    lows = sequence<uint64_t>(low_words, (uint64_t)0);
+    size_t high_bits = (universe >> low_width) + n + 1;
+    highs = sequence<uint64_t>((high_bits + 63) / 64 + 1, (uint64_t)0);
+
+    for (size_t i = 0; i < n; i++) {
+      size_t v = offsets[i];
+      if (low_width > 0) {
+        size_t lo = v & ((size_t{1} << low_width) - 1);
+        size_t bit = i * low_width;
+        lows[bit / 64] |= (uint64_t)lo << (bit % 64);
+        if ((bit % 64) + low_width > 64) {
+          lows[bit / 64 + 1] |= (uint64_t)lo >> (64 - (bit % 64));
+        }
+      }
+      size_t hp = (v >> low_width) + i;
+      highs[hp / 64] |= (uint64_t)1 << (hp % 64);
+    }
+
+    // superblock samples: bit position of every kSampleRate-th one
+    select_samples = sequence<uint64_t>((n + kSampleRate - 1) / kSampleRate);
+    size_t ones = 0;
+    for (size_t w = 0; w < highs.size(); w++) {
+      uint64_t word = highs[w];
+      while (word > 0) {
+        if (ones % kSampleRate == 0) {
+          select_samples[ones / kSampleRate] =
+              w * 64 + _tzcnt_u64(word);
+        }
+        ones++;
+        word = _blsr_u64(word);
+      }
+    }
+  }
+
+  inline size_t low(size_t i) const {
+    if (low_width == 0) return 0;
+    size_t bit = i * low_width;
+    uint64_t v = lows[bit / 64] >> (bit % 64);
+    if ((bit % 64) + low_width > 64) {
+      v |= lows[bit / 64 + 1] << (64 - (bit % 64));
+    }
+    return v & ((size_t{1} << low_width) - 1);
+  }
+
+  // position of the i-th one in highs (0-indexed)
+  inline size_t select1(size_t i) const {
+    size_t pos = select_samples[i / kSampleRate];
+    size_t remaining = i % kSampleRate;
+    size_t w = pos / 64;
+    uint64_t word = highs[w] & (~uint64_t{0} << (pos % 64));
+    while (true) {
+      size_t c = (size_t)_mm_popcnt_u64(word);
+      if (remaining < c) {
+        while (remaining > 0) {
+          word = _blsr_u64(word);
+          remaining--;
+        }
+        return w * 64 + _tzcnt_u64(word);
+      }
+      remaining -= c;
+      word = highs[++w];
+    }
+  }
+
+  inline size_t get(size_t i) const {
+    return ((select1(i) - i) << low_width) | low(i);
+  }
+
+  // (offset, degree) for vertex i: two adjacent decodes sharing the scan.
+  inline std::pair<size_t, size_t> offset_and_degree(size_t i) const {
+    size_t o = get(i);
+    size_t o2 = get(i + 1);
+    return {o, o2 - o};
+  }
+
+  size_t bytes() const {
+    return (lows.size() + highs.size() + select_samples.size()) * 8;
+  }
+};
+
+// Serves the symmetric_graph read interface with Elias-Fano vertex
+// metadata over the original edge array. Uncompressed graphs only.
+template <template <class W> class vertex_type, class W>
+struct succinct_symmetric_graph {
+  using base_graph = symmetric_graph<vertex_type, W>;
+  using vertex = typename base_graph::vertex;
+  using weight_type = W;
+  using edge_type = typename base_graph::edge_type;
+
+  size_t n;
+  size_t m;
+  ef_offsets offsets;
+  edge_type* e0;
+
+  succinct_symmetric_graph(base_graph& G) : n(G.n), m(G.m), e0(G.e0) {
+    auto offs = pbbs::delayed_seq<size_t>(n + 1, [&](size_t i) {
+      return (i == n) ? G.m : (size_t)G.v_data[i].offset;
+    });
+    offsets = ef_offsets(offs, G.m);
+  }
+
+  __attribute__((always_inline)) inline vertex get_vertex(uintE i) {
+    auto od = offsets.offset_and_degree(i);
+    vertex_data vd;
+    vd.offset = od.first;
+    vd.degree = (uintE)od.second;
+    return vertex(e0, vd, i);
+  }
+
+  size_t num_vertices() { return n; }
+  size_t num_edges() { return m; }
+
+  template <class F>
+  void mapEdges(F f, bool parallel_inner_map = true, size_t granularity = 1) {
+    parallel_for(0, n, [&](size_t i) {
+      get_vertex(i).out_neighbors().map(f, parallel_inner_map);
+    }, granularity);
+  }
+
+  size_t metadata_bytes() const { return offsets.bytes(); }
+};
+
+template <template <class W> class vertex_type, class W>
+succinct_symmetric_graph<vertex_type, W> make_succinct_graph(
+    symmetric_graph<vertex_type, W>& G) {
+  return succinct_symmetric_graph<vertex_type, W>(G);
+}
+
+}  // namespace gbbs
@@ -23,7 +23,9 @@
 
 #pragma once
 
+#include "pbbslib/merge.h"
 #include "pbbslib/sequence_ops.h"
+#include "cpu_dispatch.h"
 #include "macros.h"
 
 namespace gbbs {
@@ -31,44 +33,35 @@ namespace intersection {
 
 template <class Nghs>
 inline size_t intersect(Nghs* A, Nghs* B, uintE a, uintE b) {
-  uintT i = 0, j = 0, nA = A->degree, nB = B->degree;
-  auto nghA = A->neighbors;
-  auto nghB = B->neighbors;
-  size_t ans = 0;
-  while (i < nA && j < nB) {
-    if (std::get<0>(nghA[i]) == std::get<0>(nghB[j]))
-      i++, j++, ans++;
-    else if (std::get<0>(nghA[i]) < std::get<0>(nghB[j]))
-      i++;
-    else
-      j++;
+  using E = typename std::remove_pointer<decltype(A->neighbors)>::type;
+  if constexpr (sizeof(E) == sizeof(uintE)) {
+    // unweighted: tuple<uintE, empty> collapses to 4 bytes, so the
+    // multiversioned concrete kernel runs (avx512/avx2/default resolved
+    // at load time; see cpu_dispatch.h)
+    return cpu::intersect_count_u32((const uintE*)A->neighbors, A->degree,
+                                    (const uintE*)B->neighbors, B->degree);
   }
-  return ans;
+  auto sa = pbbs::range<E*>(A->neighbors, A->neighbors + A->degree);
+  auto sb = pbbs::range<E*>(B->neighbors, B->neighbors + B->degree);
+  auto get = [](const E& e) { return std::get<0>(e); };
+  return pbbs::seq_intersect_count(sa, sb, get, get);
 }
 
 template <class Nghs, class F>
 inline size_t intersect_f(Nghs* A, Nghs* B, const F& f) {
-  uintT i = 0, j = 0, nA = A->degree, nB = B->degree;
-  auto nghA = A->neighbors;
-  auto nghB = B->neighbors;
-  uintE a = A->id,
-        b = B->id;
-  size_t ans = 0;
-  while (i < nA && j < nB) {
-    if (std::get<0>(nghA[i]) == std::get<0>(nghB[j])) {
-      f(a, b, std::get<0>(nghA[i]));
-      i++, j++, ans++;
-    } else if (std::get<0>(nghA[i]) < std::get<0>(nghB[j])) {
-      i++;
-    } else {
-      j++;
-    }
-  }
-  return ans;
+  using E = typename std::remove_pointer<decltype(A->neighbors)>::type;
+  uintE a = A->id, b = B->id;
+  auto sa = pbbs::range<E*>(A->neighbors, A->neighbors + A->degree);
+  auto sb = pbbs::range<E*>(B->neighbors, B->neighbors + B->degree);
+  auto get = [](const E& e) { return std::get<0>(e); };
+  auto on_match = [&](const uintE& ngh) { f(a, b, ngh); };
+  return pbbs::seq_intersect_f(sa, sb, get, get, on_match);
 }
 
 constexpr const size_t _bs_merge_base = 32;
 constexpr const size_t _seq_merge_thresh = 2048;
+// degree ratio beyond which the galloping path wins over a linear merge
+constexpr const size_t _gallop_ratio = 32;
 
 template <class SeqA, class SeqB, class F>
 size_t seq_merge_full(SeqA& A, SeqB& B, F& f) {
@@ -109,20 +102,49 @@ size_t seq_merge(const SeqA& A, const SeqB& B, const F& f) {
   return ct;
 }
 
+// Galloping cursor: each element of the short side doubles-then-binary
+// searches forward in the long side from the previous match. Strictly
+// dominates the old per-element full binary search (seq_merge), since the
+// cursor never re-scans a consumed prefix.
+template <class SeqA, class SeqB, class F>
+size_t seq_gallop(const SeqA& A, const SeqB& B, const F& f) {
+  using T = typename SeqA::value_type;
+  auto get = [](const T& x) { return x; };
+  size_t nB = B.size();
+  size_t j = 0, ct = 0;
+  for (size_t i = 0; i < A.size() && j < nB; i++) {
+    const T& a = A[i];
+    j = pbbs::gallop_lower_bound(B, j, nB, get, a);
+    if (j < nB && B[j] == a) {
+      f(a);
+      ct++;
+      j++;
+    }
+  }
+  return ct;
+}
+
+// Per-pair strategy selection by a degree-ratio test, re-applied at every
+// recursive split so a pair that starts balanced and becomes skewed after
+// a split switches strategy mid-intersection: linear merge for comparable
+// degrees (the branch-free loop the compiler vectorizes), galloping when
+// one side dominates by _gallop_ratio, and parallel splitting for large
+// inputs of either shape.
 template <class SeqA, class SeqB, class F>
 size_t merge(const SeqA& A, const SeqB& B, const F& f) {
   using T = typename SeqA::value_type;
   size_t nA = A.size();
   size_t nB = B.size();
-  size_t nR = nA + nB;
-  if (nR < _seq_merge_thresh) { // handles (small, small) using linear-merge
-    return intersection::seq_merge_full(A, B, f);
-  } else if (nB < nA) {
+  if (nB < nA) {
     return intersection::merge(B, A, f);
-  } else if (nA < _bs_merge_base) {
-    return intersection::seq_merge(A, B, f);
-  } else {
-    size_t mA = nA/2;
+  }
+  if (nA == 0 || nB == 0) return 0;
+  if (nB >= _gallop_ratio * nA) {  // skewed: gallop the short side forward
+    if (nA <= 8 * _bs_merge_base) {
+      return intersection::seq_gallop(A, B, f);
+    }
+    // large skewed pair: split the short side and gallop halves in parallel
+    size_t mA = nA / 2;
     size_t mB = pbbslib::binary_search(B, A[mA], std::less<T>());
     size_t m_left = 0;
     size_t m_right = 0;
@@ -130,6 +152,16 @@ size_t merge(const SeqA& A, const SeqB& B, const F& f) {
      [&] () { m_right = intersection::merge(A.slice(mA, nA), B.slice(mB, nB), f);});
     return m_left + m_right;
   }
+  if (nA + nB < _seq_merge_thresh) { // (small, small): linear merge
+    return intersection::seq_merge_full(A, B, f);
+  }
+  size_t mA = nA/2;
+  size_t mB = pbbslib::binary_search(B, A[mA], std::less<T>());
+  size_t m_left = 0;
+  size_t m_right = 0;
+  par_do([&] () { m_left = intersection::merge(A.slice(0, mA), B.slice(0, mB), f);},
+   [&] () { m_right = intersection::merge(A.slice(mA, nA), B.slice(mB, nB), f);});
+  return m_left + m_right;
 }
 
 template <class Nghs, class F>
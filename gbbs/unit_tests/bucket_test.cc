@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gbbs/bucket.h"
+
+namespace gbbs {
+
+namespace {
+
+// Peels a synthetic priority array to exhaustion through the bucket
+// structure, mimicking the Julienne clients: every claimed identifier's
+// priority must equal the claimed bucket, every identifier must be claimed
+// exactly once, and the claimed bucket ids must be monotone in the
+// requested order. Priorities span a range far wider than open_buckets, so
+// the coarse overflow slots (and the empty-range jump) are exercised on
+// every run -- the regime the small sample graphs never reach.
+void run_drain(bucket_order order, size_t n, size_t priority_range,
+               size_t num_buckets, uint64_t seed, bool relax) {
+  std::mt19937_64 rng(seed);
+  auto d = sequence<uintE>(n);
+  for (size_t i = 0; i < n; i++) {
+    d[i] = (uintE)(rng() % priority_range);
+  }
+  auto d_slice = d.slice();
+  auto b = make_vertex_buckets(n, d_slice, order, num_buckets);
+
+  std::vector<bool> claimed(n, false);
+  size_t num_claimed = 0;
+  size_t last_bkt = (order == increasing)
+                        ? 0
+                        : std::numeric_limits<size_t>::max();
+  size_t rounds = 0;
+  // generous bound: every identifier plus one empty pass per range
+  size_t round_cap = 4 * (n + priority_range);
+  while (true) {
+    auto bkt = b.next_bucket();
+    if (bkt.id == b.null_bkt) break;
+    ASSERT_LT(rounds++, round_cap) << "bucket structure failed to drain";
+    if (order == increasing) {
+      ASSERT_GE(bkt.id, last_bkt) << "bucket ids moved backwards";
+    } else {
+      ASSERT_LE(bkt.id, last_bkt) << "bucket ids moved forwards";
+    }
+    last_bkt = bkt.id;
+
+    auto& ids = bkt.identifiers;
+    std::vector<std::tuple<uintE, uintE>> moved;
+    for (size_t i = 0; i < ids.size(); i++) {
+      uintE v = ids[i];
+      ASSERT_FALSE(claimed[v]) << "identifier claimed twice";
+      ASSERT_EQ((size_t)d[v], bkt.id) << "claimed with a stale priority";
+      claimed[v] = true;
+      num_claimed++;
+      if (relax) {
+        // lazily move a few unclaimed identifiers toward the processed
+        // frontier, as peeling clients do (KCore decrements degrees)
+        for (int t = 0; t < 2; t++) {
+          uintE u = (uintE)(rng() % n);
+          if (claimed[u]) continue;
+          uintE nd;
+          if (order == increasing) {
+            // priorities may only move down to the current bucket
+            if ((size_t)d[u] <= bkt.id) continue;
+            nd = (uintE)(bkt.id + rng() % ((size_t)d[u] - bkt.id + 1));
+          } else {
+            if ((size_t)d[u] >= bkt.id) continue;
+            nd = (uintE)(d[u] + rng() % ((size_t)bkt.id - d[u] + 1));
+          }
+          d[u] = nd;
+          moved.push_back(std::make_tuple(u, b.get_bucket(nd)));
+        }
+      }
+    }
+    if (!moved.empty()) {
+      auto f = [&](size_t i) -> std::optional<std::tuple<uintE, uintE>> {
+        return std::optional<std::tuple<uintE, uintE>>(moved[i]);
+      };
+      b.update_buckets(f, moved.size());
+    }
+  }
+  ASSERT_EQ(num_claimed, n) << "identifiers lost by the bucket structure";
+  b.del();
+}
+
+}  // namespace
+
+// degree range >> open_buckets: 100K priorities over 15 open buckets.
+TEST(Buckets, WideRangeIncreasingDrains) {
+  run_drain(increasing, 10000, 100000, 16, 1, /* relax = */ false);
+}
+
+TEST(Buckets, WideRangeDecreasingDrains) {
+  run_drain(decreasing, 10000, 100000, 16, 2, /* relax = */ false);
+}
+
+// with lazy relaxations moving priorities across ranges between unpacks
+// (the pattern that left stale copies in the coarse overflow slots)
+TEST(Buckets, WideRangeIncreasingWithRelaxations) {
+  run_drain(increasing, 10000, 100000, 16, 3, /* relax = */ true);
+}
+
+TEST(Buckets, WideRangeDecreasingWithRelaxations) {
+  run_drain(decreasing, 10000, 100000, 16, 4, /* relax = */ true);
+}
+
+// sparse occupancy: a few occupied ranges separated by hundreds of empty
+// ones, which the empty-range jump must skip without moving backwards
+TEST(Buckets, SparseRangesJumpForward) {
+  size_t n = 2000;
+  std::mt19937_64 rng(5);
+  auto d = sequence<uintE>(n);
+  for (size_t i = 0; i < n; i++) {
+    d[i] = (uintE)((rng() % 8) * 50000 + rng() % 10);
+  }
+  auto d_slice = d.slice();
+  auto b = make_vertex_buckets(n, d_slice, increasing, 16);
+  size_t num_claimed = 0;
+  size_t last_bkt = 0;
+  while (true) {
+    auto bkt = b.next_bucket();
+    if (bkt.id == b.null_bkt) break;
+    ASSERT_GE(bkt.id, last_bkt);
+    last_bkt = bkt.id;
+    for (size_t i = 0; i < bkt.identifiers.size(); i++) {
+      ASSERT_EQ((size_t)d[bkt.identifiers[i]], bkt.id);
+      num_claimed++;
+    }
+  }
+  ASSERT_EQ(num_claimed, n);
+  b.del();
+}
+
+}  // namespace gbbs
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "gbbs/encodings/byte_split.h"
+#include "gbbs/encodings/group_varint.h"
+#include "gbbs/encodings/interval.h"
+
+namespace gbbs {
+
+namespace {
+
+struct vec_iter {
+  const std::vector<std::tuple<uintE, pbbs::empty>>* e;
+  size_t k = 0;
+  std::tuple<uintE, pbbs::empty> cur() { return (*e)[k]; }
+  std::tuple<uintE, pbbs::empty> next() {
+    ++k;
+    return cur();
+  }
+};
+
+std::vector<std::tuple<uintE, pbbs::empty>> random_nghs(std::mt19937_64& rng,
+                                                        size_t deg,
+                                                        size_t max_gap) {
+  std::vector<std::tuple<uintE, pbbs::empty>> v;
+  uintE x = (uintE)(rng() % 64);
+  for (size_t i = 0; i < deg; i++) {
+    x += 1 + rng() % max_gap;
+    v.push_back(std::make_tuple(x, pbbs::empty()));
+  }
+  return v;
+}
+
+// compress with Enc, decode, and require the exact neighbor list back
+template <class Enc>
+void roundtrip(uint64_t seed, size_t trials) {
+  std::mt19937_64 rng(seed);
+  for (size_t t = 0; t < trials; t++) {
+    size_t deg = 1 + rng() % 3000;  // spans multiple blocks/groups
+    uintE src = (uintE)(rng() % 1000);
+    auto nghs = random_nghs(rng, deg, (t % 2) ? 3 : 4000);
+    std::vector<uchar> buf(nghs.size() * 10 + 4096);
+    vec_iter it{&nghs};
+    Enc::compress(buf.data(), deg, src, it);
+    std::vector<uintE> out;
+    auto f = [&](const uintE& s, const uintE& v, const pbbs::empty& w,
+                 size_t i) {
+      out.push_back(v);
+      return true;
+    };
+    Enc::template run_decode<decltype(f)>(f, buf.data(), src, deg);
+    ASSERT_EQ(out.size(), deg);
+    for (size_t i = 0; i < deg; i++) {
+      ASSERT_EQ(out[i], std::get<0>(nghs[i]))
+          << "position " << i << " of " << deg << " (seed " << seed << ")";
+    }
+  }
+}
+
+struct group_varint_enc {
+  static void compress(uchar* buf, size_t deg, uintE src, vec_iter& it) {
+    group_varint::sequentialCompressEdgeSet<pbbs::empty>(buf, 0, (uintE)deg,
+                                                         src, it);
+  }
+  template <class F>
+  static void run_decode(F f, uchar* buf, uintE src, size_t deg) {
+    group_varint::decode<pbbs::empty>(f, buf, src, deg);
+  }
+};
+
+struct byte_split_enc {
+  static void compress(uchar* buf, size_t deg, uintE src, vec_iter& it) {
+    byte_split::sequentialCompressEdgeSet<pbbs::empty>(buf, 0, (uintE)deg,
+                                                       src, it);
+  }
+  template <class F>
+  static void run_decode(F f, uchar* buf, uintE src, size_t deg) {
+    byte_split::decode<pbbs::empty>(f, buf, src, deg);
+  }
+};
+
+struct interval_enc {
+  static void compress(uchar* buf, size_t deg, uintE src, vec_iter& it) {
+    interval_byte::sequentialCompressEdgeSet<pbbs::empty>(buf, 0, (uintE)deg, src,
+                                                     it);
+  }
+  template <class F>
+  static void run_decode(F f, uchar* buf, uintE src, size_t deg) {
+    interval_byte::decode<pbbs::empty>(f, buf, src, deg);
+  }
+};
+
+}  // namespace
+
+TEST(Encodings, GroupVarintRoundtrip) { roundtrip<group_varint_enc>(1, 40); }
+
+TEST(Encodings, ByteSplitRoundtrip) { roundtrip<byte_split_enc>(2, 40); }
+
+TEST(Encodings, IntervalRoundtrip) { roundtrip<interval_enc>(3, 40); }
+
+// dense runs of consecutive ids, the interval encoding's target shape
+TEST(Encodings, IntervalDenseRuns) {
+  std::mt19937_64 rng(4);
+  for (size_t t = 0; t < 20; t++) {
+    std::vector<std::tuple<uintE, pbbs::empty>> nghs;
+    uintE x = (uintE)(rng() % 100);
+    while (nghs.size() < 2000) {
+      size_t run = 1 + rng() % 60;
+      for (size_t i = 0; i < run; i++) {
+        nghs.push_back(std::make_tuple(x++, pbbs::empty()));
+      }
+      x += 2 + rng() % 50;
+    }
+    size_t deg = nghs.size();
+    std::vector<uchar> buf(deg * 10 + 4096);
+    vec_iter it{&nghs};
+    interval_byte::sequentialCompressEdgeSet<pbbs::empty>(buf.data(), 0,
+                                                     (uintE)deg, 9, it);
+    std::vector<uintE> out;
+    auto f = [&](const uintE& s, const uintE& v, const pbbs::empty& w,
+                 size_t i) {
+      out.push_back(v);
+      return true;
+    };
+    interval_byte::decode<pbbs::empty>(f, buf.data(), 9, deg);
+    ASSERT_EQ(out.size(), deg);
+    for (size_t i = 0; i < deg; i++) {
+      ASSERT_EQ(out[i], std::get<0>(nghs[i]));
+    }
+  }
+}
+
+}  // namespace gbbs
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <set>
+#include <vector>
+
+#include "gbbs/vertex_subset.h"
+
+namespace gbbs {
+
+// Bloom frontier summary: no false negatives ever, isIn stays exact after
+// toDense (false positives fall through to the dense array), and
+// add_to_vsubset invalidates a previously built summary so added members
+// remain visible.
+TEST(FrontierSummary, NoFalseNegativesAndExactIsIn) {
+  size_t n = 1 << 18;
+  std::mt19937_64 rng(1);
+  std::set<uintE> members;
+  while (members.size() < 4000) members.insert((uintE)(rng() % n));
+  auto ids = sequence<uintE>(members.size());
+  size_t k = 0;
+  for (uintE v : members) ids[k++] = v;
+  auto vs = vertexSubset(n, std::move(ids));
+  vs.build_frontier_summary();
+
+  for (uintE v : members) {
+    ASSERT_TRUE(vs.maybe_in(v)) << "bloom false negative";
+  }
+  vs.toDense();
+  size_t false_positives = 0;
+  for (size_t i = 0; i < 100000; i++) {
+    uintE v = (uintE)(rng() % n);
+    bool ref = members.count(v) > 0;
+    ASSERT_EQ(vs.isIn(v), ref) << "isIn diverged from membership";
+    if (!ref && vs.maybe_in(v)) false_positives++;
+  }
+  // ~10 bits/element: the false-positive rate should stay in the low
+  // percent range
+  ASSERT_LT(false_positives, (size_t)10000);
+}
+
+TEST(FrontierSummary, AddToVsubsetInvalidatesSummary) {
+  size_t n = 1 << 16;
+  auto ids = sequence<uintE>(100, [](size_t i) { return (uintE)(3 * i); });
+  auto vs = vertexSubset(n, std::move(ids));
+  vs.build_frontier_summary();
+  vs.toDense();
+  uintE added[2] = {50001, 50003};
+  add_to_vsubset(vs, added, 2);
+  // a stale summary would answer false for the new members
+  ASSERT_TRUE(vs.isIn(50001));
+  ASSERT_TRUE(vs.isIn(50003));
+  ASSERT_FALSE(vs.isIn(50002));
+}
+
+// Dedup stamps: vertexMapFirstVisit applies its function once per
+// identifier even when the frontier carries duplicates.
+TEST(DedupStamps, FirstVisitAppliesOnce) {
+  size_t n = 1000;
+  std::vector<uintE> with_dups;
+  for (size_t i = 0; i < 200; i++) {
+    with_dups.push_back((uintE)(i % 50));  // every id appears 4 times
+  }
+  auto ids = sequence<uintE>(with_dups.size(),
+                             [&](size_t i) { return with_dups[i]; });
+  auto vs = vertexSubset(n, std::move(ids));
+  auto counts = sequence<size_t>(n, (size_t)0);
+  dedup_stamps stamps(n);
+  vertexMapFirstVisit(vs, stamps, [&](uintE v) {
+    pbbs::fetch_and_add(&counts[v], (size_t)1);
+  });
+  for (size_t v = 0; v < 50; v++) {
+    ASSERT_EQ(counts[v], (size_t)1) << "duplicate visit at " << v;
+  }
+  for (size_t v = 50; v < n; v++) {
+    ASSERT_EQ(counts[v], (size_t)0);
+  }
+}
+
+}  // namespace gbbs
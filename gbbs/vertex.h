@@ -244,6 +244,23 @@ struct uncompressed_neighbors {
     });
   }
 
+  // Applies f(ngh) to the neighbors with id in [lo, hi); the list is
+  // sorted, so the range is located with two binary searches (the
+  // uncompressed counterpart of the compressed block-skipping pushdown).
+  template <class F>
+  inline void map_id_range(uintE lo, uintE hi, F f) {
+    auto key_lo = [&](size_t i) { return std::get<0>(neighbors[i]); };
+    size_t a = 0, b = degree;
+    while (a < b) {  // first index with ngh >= lo
+      size_t mid = a + (b - a) / 2;
+      if (key_lo(mid) < lo) a = mid + 1;
+      else b = mid;
+    }
+    for (size_t i = a; i < degree && std::get<0>(neighbors[i]) < hi; i++) {
+      f(std::get<0>(neighbors[i]));
+    }
+  }
+
   inline size_t calculateTemporarySpace() {
     return (degree < vertex_ops::kAllocThreshold) ? 0 : degree;
   }
@@ -2,7 +2,17 @@
 
 namespace gbbs {
 void add_to_vsubset(vertexSubset& vs, uintE* new_verts, uintE num_new_verts) {
-  if (vs.isDense) {
+  // a previously built frontier summary no longer covers the new members
+  vs.bloom_mask = 0;
+  vs.bloom.clear();
+  if (vs.isBitmap) {
+    parallel_for(0, num_new_verts,
+                 [&](size_t i) { vs.bitmap_set(new_verts[i]); });
+    // Drop any other (now stale) representations.
+    vs.s.clear();
+    vs.d.clear();
+    vs.m += num_new_verts;
+  } else if (vs.isDense) {
     parallel_for(0, num_new_verts, [&] (size_t i)
                     { vs.d[new_verts[i]] = true; });
     vs.m += num_new_verts;
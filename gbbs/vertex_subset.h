@@ -30,6 +30,7 @@
 #include <functional>
 #include <limits>
 #include <optional>
+#include <vector>
 
 namespace gbbs {
 
@@ -201,18 +202,32 @@ struct vertexSubsetData {
 };
 
 // Specialized version where data = pbbslib::empty.
+//
+// In addition to the sparse (vertex-id array) and dense (bool array)
+// representations, this specialization supports a compressed bitmap
+// representation (one bit per vertex, stored in 64-bit words). The bitmap is
+// 8x smaller than the dense bool array, so mid-density frontiers that would
+// otherwise bounce between toSparse/toDense can be held and iterated with far
+// less memory traffic. Conversions to/from the other representations are
+// provided, and compress() picks the best representation by density.
 template <>
 struct vertexSubsetData<pbbslib::empty> {
   using S = uintE;
   using D = bool;
 
+  static constexpr size_t kWordBits = 64;
+
   // Move constructor
   vertexSubsetData<pbbslib::empty>(vertexSubsetData<pbbslib::empty>&& other) noexcept {
     n = other.n;
     m = other.m;
     s = std::move(other.s);
     d = std::move(other.d);
+    b = std::move(other.b);
     isDense = other.isDense;
+    isBitmap = other.isBitmap;
+    bloom = std::move(other.bloom);
+    bloom_mask = other.bloom_mask;
     sum_out_degrees = other.sum_out_degrees;
   }
 
@@ -223,7 +238,11 @@ struct vertexSubsetData<pbbslib::empty> {
       m = other.m;
       s = std::move(other.s);
       d = std::move(other.d);
+      b = std::move(other.b);
+      bloom = std::move(other.bloom);
+      bloom_mask = other.bloom_mask;
       isDense = other.isDense;
+      isBitmap = other.isBitmap;
       sum_out_degrees = other.sum_out_degrees;
     }
     return *this;
@@ -300,19 +319,68 @@ struct vertexSubsetData<pbbslib::empty> {
 
   // Dense
   __attribute__((always_inline)) inline bool isIn(const uintE& v) const {
+    if (bloom_mask != 0 && !maybe_in(v)) return false;
+    if (isBitmap) return (b[v / kWordBits] >> (v % kWordBits)) & 1;
     return d[v];
   }
   inline pbbslib::empty ithData(const uintE& v) const {
     return pbbslib::empty();
   }
 
+  // ==================== Frontier summary ====================
+  //
+  // Blocked bloom filter over the member ids (one 64-byte block, two bits
+  // per element), built from the sparse representation before a dense
+  // in-edge traversal. isIn consults it first, so the overwhelmingly
+  // common membership misses of a pull phase resolve in a structure sized
+  // by the frontier (usually cache resident) instead of a random DRAM
+  // read into the length-n dense array. No false negatives; a false
+  // positive just falls through to the dense check.
+  static constexpr size_t kBloomWordsPerBlock = 8;  // 64 bytes
+
+  __attribute__((always_inline)) inline bool maybe_in(const uintE& v) const {
+    size_t h = pbbs::hash64_2((uint64_t)v);
+    const uint64_t* blk = bloom.begin() + (h & bloom_mask) * kBloomWordsPerBlock;
+    uint64_t w1 = (h >> 32) & 7, b1 = (h >> 35) & 63;
+    uint64_t w2 = (h >> 41) & 7, b2 = (h >> 47) & 63;
+    return ((blk[w1] >> b1) & 1) && ((blk[w2] >> b2) & 1);
+  }
+
+  void build_frontier_summary() {
+    if (bloom_mask != 0 || m == 0 || isDense) return;
+    size_t target_bits = 10 * (size_t)m;
+    size_t nblocks = (size_t)1
+                     << pbbslib::log2_up(
+                            std::max<size_t>(1, target_bits / 512));
+    bloom = pbbs::sequence<uint64_t>(nblocks * kBloomWordsPerBlock, (uint64_t)0);
+    bloom_mask = nblocks - 1;
+    par_for(0, m, pbbslib::kSequentialForThreshold, [&](size_t i) {
+      size_t h = pbbs::hash64_2((uint64_t)s[i]);
+      uint64_t* blk = bloom.begin() + (h & bloom_mask) * kBloomWordsPerBlock;
+      uint64_t w1 = (h >> 32) & 7, b1 = (h >> 35) & 63;
+      uint64_t w2 = (h >> 41) & 7, b2 = (h >> 47) & 63;
+      __sync_fetch_and_or(&blk[w1], (uint64_t)1 << b1);
+      __sync_fetch_and_or(&blk[w2], (uint64_t)1 << b2);
+    });
+  }
+
   // Returns (uintE) -> std::optional<std::tuple<vertex, vertex-data>>.
   auto get_fn_repr() const -> std::function<
       std::optional<std::tuple<uintE, pbbslib::empty>>(uintE)> {
     std::function<std::optional<std::tuple<uintE, pbbslib::empty>>(
         const uintE&)>
         fn;
-    if (isDense) {
+    if (isBitmap) {
+      fn = [&](
+          const uintE& v) -> std::optional<std::tuple<uintE, pbbslib::empty>> {
+        if (bitmap_is_set(v)) {
+          return std::optional<std::tuple<uintE, pbbslib::empty>>(
+              std::make_tuple(v, pbbslib::empty()));
+        } else {
+          return std::nullopt;
+        }
+      };
+    } else if (isDense) {
       fn = [&](
           const uintE& v) -> std::optional<std::tuple<uintE, pbbslib::empty>> {
         if (d[v]) {
@@ -343,8 +411,8 @@ struct vertexSubsetData<pbbslib::empty> {
 
   void toSparse() {
     if (s.size() == 0 && m > 0) {
-      auto f_in =
-          pbbslib::make_sequence<bool>(n, [&](size_t i) { return d[i]; });
+      auto f_in = pbbslib::make_sequence<bool>(
+          n, [&](size_t i) { return isBitmap ? bitmap_is_set(i) : d[i]; });
       s = pbbslib::pack_index<uintE>(f_in);
       if (s.size() != m) {
         std::cout << "# m is " << m << " but out.size says" << s.size()
@@ -357,28 +425,229 @@ struct vertexSubsetData<pbbslib::empty> {
       }
     }
     isDense = false;
+    isBitmap = false;
   }
 
   // Converts to dense but keeps sparse representation if it exists.
   void toDense() {
     if (d.size() == 0) {
       d = sequence<bool>(n);
-      par_for(0, n, [&](size_t i) { d[i] = 0; });
-      par_for(0, m, [&](size_t i) { d[s[i]] = 1; });
+      if (isBitmap) {
+        par_for(0, n, [&](size_t i) { d[i] = bitmap_is_set(i); });
+      } else {
+        par_for(0, n, [&](size_t i) { d[i] = 0; });
+        par_for(0, m, [&](size_t i) { d[s[i]] = 1; });
+      }
     }
     isDense = true;
+    isBitmap = false;
+  }
+
+  // Number of 64-bit words in the bitmap representation.
+  size_t numWords() const { return (n + kWordBits - 1) / kWordBits; }
+
+  inline bool bitmap_is_set(const uintE& v) const {
+    return (b[v / kWordBits] >> (v % kWordBits)) & 1;
+  }
+
+  // Atomically sets bit v (distinct vertices may share a word).
+  inline void bitmap_set(const uintE& v) {
+    uint64_t* word = &b[v / kWordBits];
+    uint64_t mask = static_cast<uint64_t>(1) << (v % kWordBits);
+    uint64_t old_val = *word;
+    while (!(old_val & mask) &&
+           !pbbslib::atomic_compare_and_swap(word, old_val, old_val | mask)) {
+      old_val = *word;
+    }
+  }
+
+  // Converts to the compressed bitmap representation. Builds from the dense
+  // representation when available (conflict-free word packing); otherwise
+  // sets bits from the sparse array with CAS.
+  void toBitmap() {
+    if (b.size() == 0) {
+      size_t num_words = numWords();
+      if (d.size() > 0) {
+        b = sequence<uint64_t>(num_words, [&](size_t w) {
+          uint64_t word = 0;
+          size_t off = w * kWordBits;
+          size_t end = std::min(off + kWordBits, n);
+          for (size_t j = off; j < end; j++) {
+            word |= static_cast<uint64_t>(d[j]) << (j - off);
+          }
+          return word;
+        });
+      } else {
+        b = sequence<uint64_t>(num_words, static_cast<uint64_t>(0));
+        par_for(0, m, [&](size_t i) { bitmap_set(s[i]); });
+      }
+    }
+    isDense = false;
+    isBitmap = true;
+  }
+
+  // Re-chooses the representation by density, dropping the larger backing
+  // arrays: very sparse frontiers stay as vertex-id arrays, everything else
+  // is compressed to the bitmap (8x smaller than the dense bool array).
+  void compress() {
+    if (m < n / (kWordBits * 2)) {
+      toSparse();
+      d.clear();
+      b.clear();
+    } else {
+      toBitmap();
+      s.clear();
+      d.clear();
+    }
   }
 
   size_t n, m;
   sequence<S> s;
   sequence<D> d;
+  sequence<uint64_t> b;
+  sequence<uint64_t> bloom;  // frontier summary; see build_frontier_summary
+  size_t bloom_mask = 0;     // 0 = no summary built
   bool isDense;
+  bool isBitmap = false;
   size_t sum_out_degrees;
 };
 using vertexSubset = vertexSubsetData<pbbslib::empty>;
 
+// Per-round visit stamps supporting duplicate-tolerant frontiers (the
+// tolerate_duplicates flag). In this mode an edgeMap functor's updateAtomic
+// may return true more than once per destination (no CAS on the caller's
+// state is required for dedup), so the emitted sparse frontier can contain
+// repeated ids; consumers call first_visit() to process each vertex exactly
+// once per round, paying one CAS per *duplicate* instead of one per emitted
+// edge. Rounds are advanced with new_round(); the stamp array is O(n) uintEs
+// and is reused across the whole traversal.
+struct dedup_stamps {
+  pbbs::sequence<uintE> stamp;
+  uintE round;
+
+  dedup_stamps(size_t n)
+      : stamp(n, [](size_t) { return UINT_E_MAX; }), round(0) {}
+
+  void new_round() { round++; }
+
+  // Returns true exactly once per vertex per round (safe to call
+  // concurrently for the same vertex).
+  inline bool first_visit(uintE v) {
+    while (true) {
+      uintE r = stamp[v];
+      if (r == round) return false;
+      if (pbbslib::atomic_compare_and_swap(&stamp[v], r, round)) return true;
+    }
+  }
+};
+
+// vertexMap over a possibly-duplicated sparse frontier: applies f to each
+// distinct vertex exactly once this round, skipping repeats via the stamps.
+template <class VS, class F,
+          typename std::enable_if<std::is_same<VS, vertexSubset>::value,
+                                  int>::type = 0>
+inline void vertexMapFirstVisit(VS& V, dedup_stamps& stamps, F f,
+                                size_t granularity = pbbslib::kSequentialForThreshold) {
+  if (V.dense()) {
+    // Dense frontiers cannot contain duplicates; fall through.
+    vertexMap(V, f, granularity);
+    return;
+  }
+  size_t m = V.numNonzeros();
+  parallel_for(0, m,
+               [&](size_t i) {
+                 uintE v = V.vtx(i);
+                 if (stamps.first_visit(v)) {
+                   f(v);
+                 }
+               },
+               granularity);
+}
+
+// A pool of frontier buffers recycled across edgeMap iterations. Repeated
+// traversal queries (thousands of BFS/SSSP runs over the same graph) spend a
+// measurable fraction of their time allocating and freeing frontier arrays;
+// the pool retains released buffers -- sized to the high-water mark of the
+// workload -- and hands them back out instead.
+//
+// Not thread-safe: acquire/recycle are meant to be called between parallel
+// phases (the natural shape of a traversal loop), not from inside one.
+struct frontier_pool {
+  std::vector<pbbs::sequence<bool>> dense_bufs;
+  std::vector<pbbs::sequence<uintE>> sparse_bufs;
+
+  // Returns an all-false dense buffer of exactly n entries.
+  pbbs::sequence<bool> acquire_dense(size_t n) {
+    for (size_t i = 0; i < dense_bufs.size(); i++) {
+      if (dense_bufs[i].size() == n) {
+        auto buf = std::move(dense_bufs[i]);
+        dense_bufs[i] = std::move(dense_bufs.back());
+        dense_bufs.pop_back();
+        par_for(0, n, [&](size_t j) { buf[j] = 0; });
+        return buf;
+      }
+    }
+    return pbbs::sequence<bool>(n, [](size_t) { return false; });
+  }
+
+  // Returns a sparse id buffer with at least `capacity` entries (possibly
+  // more); pair it with the vertexSubsetData(n, m, A) constructor, which
+  // takes the number of live entries separately from the backing array size.
+  pbbs::sequence<uintE> acquire_sparse(size_t capacity) {
+    for (size_t i = 0; i < sparse_bufs.size(); i++) {
+      if (sparse_bufs[i].size() >= capacity) {
+        auto buf = std::move(sparse_bufs[i]);
+        sparse_bufs[i] = std::move(sparse_bufs.back());
+        sparse_bufs.pop_back();
+        return buf;
+      }
+    }
+    return pbbs::sequence<uintE>::no_init(capacity);
+  }
+
+  // Steals the backing arrays of a dying frontier for reuse. Call this where
+  // the frontier would otherwise be destroyed.
+  void recycle(vertexSubset&& vs) {
+    if (vs.d.size() > 0) dense_bufs.emplace_back(std::move(vs.d));
+    if (vs.s.size() > 0) sparse_bufs.emplace_back(std::move(vs.s));
+  }
+
+  // Releases all retained buffers.
+  void clear() {
+    dense_bufs.clear();
+    sparse_bufs.clear();
+  }
+};
+
 /* ======================== Functions on VertexSubsets ====================== */
 
+namespace vs_detail {
+// Functors may advertise vectorizable slice forms consumed by the dense
+// vertexMap/vertexFilter paths: map_slice(start, end, mask) applies the map
+// to every i in [start, end) with mask[i - start] set, and
+// filter_slice(start, end, mask, out) writes the filter results. The dense
+// bool array is handed over as the mask, so a trivially vectorizable
+// predicate (flag compares, degree thresholds) compiles to SIMD over
+// 64-vertex chunks instead of a per-vertex branchy lambda.
+template <class F, class = void>
+struct has_map_slice : std::false_type {};
+template <class F>
+struct has_map_slice<
+    F, std::void_t<decltype(std::declval<F&>().map_slice(
+           (size_t)0, (size_t)0, (const bool*)nullptr))>> : std::true_type {};
+
+template <class F, class = void>
+struct has_filter_slice : std::false_type {};
+template <class F>
+struct has_filter_slice<
+    F, std::void_t<decltype(std::declval<F&>().filter_slice(
+           (size_t)0, (size_t)0, (const bool*)nullptr, (bool*)nullptr))>>
+    : std::true_type {};
+
+constexpr size_t kSliceChunk = 64;
+}  // namespace vs_detail
+
+
 // Takes a vertexSubsetData (with some non-trivial Data) and applies a map
 // function f : (uintE x Data) -> void over each vertex in the vertexSubset, in
 // parallel.
@@ -411,7 +680,33 @@ template <class VS, class F,
 inline void vertexMap(VS& V, F f,
                       size_t granularity = pbbslib::kSequentialForThreshold) {
   size_t n = V.numRows(), m = V.numNonzeros();
-  if (V.dense()) {
+  if constexpr (vs_detail::has_map_slice<F>::value) {
+    if (V.dense() && !V.isBitmap) {
+      const bool* mask = V.d.begin();
+      parallel_for(0, (n + vs_detail::kSliceChunk - 1) / vs_detail::kSliceChunk,
+                   [&](size_t c) {
+                     size_t start = c * vs_detail::kSliceChunk;
+                     size_t end = std::min(start + vs_detail::kSliceChunk, n);
+                     f.map_slice(start, end, mask + start);
+                   },
+                   std::max<size_t>(granularity / vs_detail::kSliceChunk, 1));
+      return;
+    }
+  }
+  if (V.isBitmap) {
+    // Iterate word-by-word, skipping empty words entirely.
+    parallel_for(0, V.numWords(),
+                 [&](size_t w) {
+                   uint64_t word = V.b[w];
+                   size_t off = w * VS::kWordBits;
+                   while (word != 0) {
+                     size_t bit = __builtin_ctzll(word);
+                     f(off + bit);
+                     word &= word - 1;
+                   }
+                 },
+                 std::max<size_t>(granularity / VS::kWordBits, 1));
+  } else if (V.dense()) {
     parallel_for(0, n,
                  [&](size_t i) {
                    if (V.isIn(i)) {
@@ -432,6 +727,21 @@ inline vertexSubset vertexFilter_dense(
   V.toDense();
   auto d_out = sequence<bool>::no_init(n);
   parallel_for(0, n, [&](size_t i) { d_out[i] = 0; }, granularity);
+  if constexpr (vs_detail::has_filter_slice<F>::value &&
+                std::is_same<Data, pbbs::empty>::value) {
+    if (!V.isBitmap) {
+      const bool* mask = V.d.begin();
+      parallel_for(0, (n + vs_detail::kSliceChunk - 1) / vs_detail::kSliceChunk,
+                   [&](size_t c) {
+                     size_t start = c * vs_detail::kSliceChunk;
+                     size_t end = std::min(start + vs_detail::kSliceChunk, n);
+                     filter.filter_slice(start, end, mask + start,
+                                         d_out.begin() + start);
+                   },
+                   std::max<size_t>(granularity / vs_detail::kSliceChunk, 1));
+      return vertexSubset(n, std::move(d_out));
+    }
+  }
   parallel_for(0, n,
                [&](size_t i) {
                  if
@@ -5,6 +5,10 @@
 
 #include <optional>
 
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
 #if defined(__APPLE__)
 #else
 #ifdef USEMALLOC
@@ -36,12 +40,96 @@ size_t log2_up(size_t i) {
   return a;
 }
 
+// Allocation method recorded in the second word of the block header so the
+// free path can release the memory the way it was obtained.
+constexpr size_t kMethodMalloc = 0;
+constexpr size_t kMethodMmap = 1;
+
+constexpr size_t kHugePageSize = size_t{1} << 21;  // 2 MB
+
+inline size_t round_up_huge(size_t n) {
+  return ((n + kHugePageSize - 1) / kHugePageSize) * kHugePageSize;
+}
+
+// Runtime switch for huge-page backing of large pool blocks
+// (PBBS_HUGEPAGES=1). Tries MAP_HUGETLB first (preallocated hugetlbfs
+// pages), then falls back to an anonymous mapping with MADV_HUGEPAGE so
+// transparent huge pages can back it, then to the regular allocator.
+inline bool use_huge_pages() {
+  static bool enabled = (std::getenv("PBBS_HUGEPAGES") != nullptr);
+  return enabled;
+}
+
+void* os_alloc_block(size_t n, size_t* method) {
+#if defined(__linux__)
+  if (use_huge_pages() && n >= kHugePageSize) {
+    size_t rounded = round_up_huge(n);
+    void* a = mmap(nullptr, rounded, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (a != MAP_FAILED) {
+      *method = kMethodMmap;
+      return a;
+    }
+    a = mmap(nullptr, rounded, PROT_READ | PROT_WRITE,
+             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (a != MAP_FAILED) {
+      madvise(a, rounded, MADV_HUGEPAGE);
+      *method = kMethodMmap;
+      return a;
+    }
+  }
+#endif
+  *method = kMethodMalloc;
+  return (void*)aligned_alloc(mem_pool::header_size, n);
+}
+
+void os_free_block(void* b, size_t n, size_t method) {
+#if defined(__linux__)
+  if (method == kMethodMmap) {
+    munmap(b, round_up_huge(n));
+    return;
+  }
+#endif
+  free(b);
+}
+
 }  // namespace
 
 mem_pool::mem_pool() : mem_size{getMemorySize()} {
   buckets = new concurrent_stack<void*>[num_buckets];
+  stats = new size_class_stats[num_buckets + 1];
 };
 
+namespace {
+inline void record_alloc(mem_pool::size_class_stats& s) {
+  long live = s.live.fetch_add(1, std::memory_order_relaxed) + 1;
+  s.total.fetch_add(1, std::memory_order_relaxed);
+  long hw = s.high_water.load(std::memory_order_relaxed);
+  while (live > hw &&
+         !s.high_water.compare_exchange_weak(hw, live,
+                                             std::memory_order_relaxed)) {
+  }
+}
+}  // namespace
+
+void mem_pool::print_stats() {
+  std::cout << "# mem_pool: allocated=" << allocated.load()
+            << " used=" << used.load() << std::endl;
+  for (size_t i = 0; i <= num_buckets; i++) {
+    long total = stats[i].total.load(std::memory_order_relaxed);
+    if (total == 0) continue;
+    long live = stats[i].live.load(std::memory_order_relaxed);
+    long hw = stats[i].high_water.load(std::memory_order_relaxed);
+    if (i == num_buckets) {
+      std::cout << "#   small (<1MB): ";
+    } else {
+      std::cout << "#   class 2^" << (i + log_base) << ": ";
+    }
+    std::cout << "live=" << live << " total=" << total
+              << " high_water=" << hw << std::endl;
+  }
+}
+
 void* mem_pool::add_header(void* a) { return (void*)((char*)a + header_size); }
 
 void* mem_pool::sub_header(void* a) { return (void*)((char*)a - header_size); }
@@ -51,9 +139,11 @@ void* mem_pool::alloc(size_t s) {
   if (log_size < 20) {
     void* a = (void*)aligned_alloc(header_size, s + header_size);
     *((size_t*)a) = small_size_tag;
+    record_alloc(stats[num_buckets]);
     return add_header(a);
   }
   size_t bucket = log_size - log_base;
+  record_alloc(stats[bucket]);
   std::optional<void*> r = buckets[bucket].pop();
   size_t n = ((size_t)1) << log_size;
   used += n;
@@ -62,11 +152,13 @@ void* mem_pool::alloc(size_t s) {
     // std::endl;
     return add_header(*r);
   } else {
-    void* a = (void*)aligned_alloc(header_size, n);
+    size_t method;
+    void* a = os_alloc_block(n, &method);
     // if (n > 10000000) std::cout << "alloc: " << add_header(a) << ", " << n <<
     // std::endl;
     allocated += n;
     if (a == NULL) std::cout << "alloc failed" << std::endl;
+    ((size_t*)a)[1] = method;
     // a hack to make sure pages are touched in parallel
     // not the right choice if you want processor local allocations
     size_t stride = (1 << 21);  // 2 Mbytes in a huge page
@@ -81,17 +173,19 @@ void mem_pool::afree(void* a) {
   // std::cout << "free: " << a << std::endl;
   void* b = sub_header(a);
   size_t bucket = *((size_t*)b);
-  if (bucket == small_size_tag)
+  if (bucket == small_size_tag) {
+    stats[num_buckets].live.fetch_sub(1, std::memory_order_relaxed);
     free(b);
-  else if (bucket >= num_buckets) {
+  } else if (bucket >= num_buckets) {
     std::cout << "corrupted header in free" << std::endl;
     abort();
   } else {
     size_t n = ((size_t)1) << (bucket + log_base);
     // if (n > 10000000) std::cout << "free: " << a << ", " << n << std::endl;
+    stats[bucket].live.fetch_sub(1, std::memory_order_relaxed);
     used -= n;
     if (n > mem_size / 64) {  // fix to 64
-      free(b);
+      os_free_block(b, n, ((size_t*)b)[1]);
       allocated -= n;
     } else {
       buckets[bucket].push(b);
@@ -105,7 +199,7 @@ void mem_pool::clear() {
     std::optional<void*> r = buckets[i].pop();
     while (r.has_value()) {
       allocated -= n;
-      free(*r);
+      os_free_block(*r, n, ((size_t*)(*r))[1]);
       r = buckets[i].pop();
     }
   }
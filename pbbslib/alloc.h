@@ -32,6 +32,16 @@ struct mem_pool {
   std::atomic<long> used{0};
   size_t mem_size;
 
+  // Per-size-class statistics, updated with relaxed atomics on the
+  // alloc/free paths (cache-line padded so the counters do not contend).
+  // Slot num_buckets aggregates the small (malloc'd) sizes.
+  struct alignas(64) size_class_stats {
+    std::atomic<long> live{0};        // outstanding allocations
+    std::atomic<long> total{0};       // cumulative allocations
+    std::atomic<long> high_water{0};  // max simultaneous live
+  };
+  size_class_stats* stats;
+
   mem_pool();
 
   void* add_header(void* a);
@@ -39,7 +49,196 @@ struct mem_pool {
   void* alloc(size_t s);
   void afree(void* a);
   void clear();
+
+  // Reads the counters with relaxed loads -- a consistent-enough snapshot
+  // for diagnosing growth, with no locking or pause of allocator traffic.
+  void print_stats();
 };
 
 static mem_pool my_mem_pool;
+
+// ==================== Memory budgets ====================
+//
+// Per-invocation admission control for multi-tenant servers: a
+// memory_budget caps how many bytes the invocation may draw through the
+// allocator. Budgeted arenas debit the budget as they grow (block
+// granularity -- the debit sits on the same path that takes the arena
+// lock, so the hot bump path is untouched) and throw budget_exceeded
+// instead of letting one runaway query OOM-kill a process hosting resident
+// graphs. Pairing the budget with an arena is what makes the failure
+// graceful: the exception unwinds to the driver, the arena_scope
+// destructor releases every partial allocation wholesale, and the server
+// keeps serving.
+//
+//   pbbs::memory_budget budget(2UL << 30);
+//   pbbs::arena a(&budget);
+//   try { pbbs::arena_scope scope(a); run_query(); }
+//   catch (const pbbs::budget_exceeded& e) { ... reject the query ... }
+
+struct budget_exceeded : public std::bad_alloc {
+  const char* what() const noexcept override {
+    return "pbbs::memory_budget exceeded";
+  }
+};
+
+struct memory_budget {
+  std::atomic<size_t> remaining;
+  size_t limit;
+
+  explicit memory_budget(size_t bytes) : remaining(bytes), limit(bytes) {}
+
+  // Debits or throws; thread-safe.
+  void debit(size_t bytes) {
+    size_t cur = remaining.load(std::memory_order_relaxed);
+    while (true) {
+      if (cur < bytes) throw budget_exceeded();
+      if (remaining.compare_exchange_weak(cur, cur - bytes,
+                                          std::memory_order_relaxed)) {
+        return;
+      }
+    }
+  }
+
+  void credit(size_t bytes) {
+    remaining.fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+  size_t used() const {
+    return limit - remaining.load(std::memory_order_relaxed);
+  }
+};
+
+// A scoped bump arena for algorithm invocations that allocate many
+// short-lived buffers: allocation is a pointer bump into pool-sized blocks,
+// individual frees are no-ops, and the whole arena is released at once when
+// the scope ends. Binding is per-thread via arena_scope: while a scope is
+// live, my_alloc on that thread routes into the arena and my_free ignores
+// arena-owned pointers. Arena-allocated data must not outlive the scope.
+// alloc() itself is thread-safe (guarded by a short spinlock), so an arena
+// can also be passed explicitly into parallel helpers.
+struct arena {
+  static constexpr size_t kDefaultBlockSize = size_t{1} << 22;  // 4 MB
+
+  struct block {
+    block* next;
+    size_t size;
+    size_t used;
+  };
+
+  block* head = nullptr;
+  std::atomic_flag lock = ATOMIC_FLAG_INIT;
+  memory_budget* budget = nullptr;  // optional; debited per block
+
+  arena() {}
+  explicit arena(memory_budget* budget) : budget(budget) {}
+
+  void* alloc(size_t s) {
+    s = (s + 15) & ~size_t{15};
+    while (lock.test_and_set(std::memory_order_acquire)) {
+    }
+    if (head == nullptr || head->used + s > head->size) {
+      size_t bsz = (s > kDefaultBlockSize) ? s : kDefaultBlockSize;
+      if (budget != nullptr) {
+        // debit before the malloc; on overrun the lock must not stay held
+        try {
+          budget->debit(sizeof(block) + bsz);
+        } catch (...) {
+          lock.clear(std::memory_order_release);
+          throw;
+        }
+      }
+      block* b = (block*)malloc(sizeof(block) + bsz);
+      b->next = head;
+      b->size = bsz;
+      b->used = 0;
+      head = b;
+    }
+    void* r = (char*)(head + 1) + head->used;
+    head->used += s;
+    lock.clear(std::memory_order_release);
+    return r;
+  }
+
+  bool owns(const void* p) const {
+    for (block* b = head; b != nullptr; b = b->next) {
+      const char* data = (const char*)(b + 1);
+      if (p >= data && p < data + b->size) return true;
+    }
+    return false;
+  }
+
+  // O(#blocks), not O(#allocations).
+  void clear() {
+    block* b = head;
+    while (b != nullptr) {
+      block* next = b->next;
+      if (budget != nullptr) budget->credit(sizeof(block) + b->size);
+      free(b);
+      b = next;
+    }
+    head = nullptr;
+  }
+
+  ~arena() { clear(); }
+};
+
+inline arena*& current_arena() {
+  static thread_local arena* a = nullptr;
+  return a;
+}
+
+// Registry of arenas with at least one live scope anywhere in the process.
+// my_free consults it so arena-owned pointers freed from *other* workers
+// (stolen subtasks inside the scope) are recognized too; with no active
+// arenas the check is a single counter load.
+inline std::atomic<size_t>& active_arena_count() {
+  static std::atomic<size_t> ct{0};
+  return ct;
+}
+inline std::atomic<arena*>* active_arena_slots() {
+  static std::atomic<arena*> slots[64] = {};
+  return slots;
+}
+
+inline bool any_arena_owns(const void* p) {
+  if (active_arena_count().load(std::memory_order_relaxed) == 0) return false;
+  auto* slots = active_arena_slots();
+  for (size_t i = 0; i < 64; i++) {
+    arena* a = slots[i].load(std::memory_order_acquire);
+    if (a != nullptr && a->owns(p)) return true;
+  }
+  return false;
+}
+
+// RAII binding of an arena to the current thread; nests. Registration in
+// the global slot table makes the arena visible to frees from any worker.
+struct arena_scope {
+  arena* prev;
+  arena* bound;
+  size_t slot;
+  arena_scope(arena& a) : prev(current_arena()), bound(&a), slot(64) {
+    current_arena() = &a;
+    auto* slots = active_arena_slots();
+    for (size_t i = 0; i < 64; i++) {
+      arena* expected = nullptr;
+      if (slots[i].compare_exchange_strong(expected, &a)) {
+        slot = i;
+        active_arena_count().fetch_add(1);
+        break;
+      }
+      if (expected == &a) {  // nested scope on the same arena
+        slot = 64;
+        break;
+      }
+    }
+  }
+  ~arena_scope() {
+    current_arena() = prev;
+    if (slot < 64) {
+      active_arena_slots()[slot].store(nullptr, std::memory_order_release);
+      active_arena_count().fetch_sub(1);
+    }
+  }
+};
+
 }  // namespace pbbs
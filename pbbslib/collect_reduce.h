@@ -282,6 +282,76 @@ auto collect_reduce(Seq const &A, Key const &get_key, Value const &get_value,
   return sums;
 }
 
+// Fused pre-aggregating variant: duplicate-heavy value streams (e.g. sum
+// of weights per target vertex) first collapse within cache-resident
+// chunks -- each chunk aggregates into a small open-addressed accumulator
+// table that stays in L2 -- and only the surviving (key, partial) pairs,
+// at most one per distinct key per chunk, flow into the general
+// collect_reduce. On streams where keys repeat heavily this halves the
+// memory traffic of the bucketing pass, since repeated keys never reach
+// the intermediate pair array.
+template <typename Seq, class Key, class Value, typename M>
+auto collect_reduce_fused(Seq const &A, Key const &get_key,
+                          Value const &get_value, M const &monoid,
+                          size_t num_buckets)
+    -> sequence<decltype(get_value(A[0]))> {
+  using val_type = decltype(get_value(A[0]));
+  using KV = std::pair<size_t, val_type>;
+  constexpr size_t kChunk = 1 << 15;
+  constexpr size_t kEmpty = (size_t)-1;
+  size_t n = A.size();
+  if (n <= 2 * kChunk) {
+    return collect_reduce(A, get_key, get_value, monoid, num_buckets);
+  }
+
+  size_t num_chunks = 1 + (n - 1) / kChunk;
+  size_t table_size = ((size_t)1) << log2_up(2 * kChunk);
+  size_t table_mask = table_size - 1;
+
+  auto pairs = sequence<KV>::no_init(n);
+  auto counts = sequence<size_t>(num_chunks + 1);
+
+  parallel_for(0, num_chunks, [&](size_t c) {
+    size_t lo = c * kChunk;
+    size_t hi = std::min(lo + kChunk, n);
+    std::vector<KV> table(table_size, KV(kEmpty, monoid.identity));
+    std::vector<size_t> used;
+    used.reserve(kChunk);
+    for (size_t i = lo; i < hi; i++) {
+      size_t k = get_key(A[i]);
+      size_t h = hash64_2(k) & table_mask;
+      while (table[h].first != kEmpty && table[h].first != k) {
+        h = (h + 1) & table_mask;
+      }
+      if (table[h].first == kEmpty) {
+        table[h] = KV(k, get_value(A[i]));
+        used.push_back(h);
+      } else {
+        table[h].second = monoid.f(table[h].second, get_value(A[i]));
+      }
+    }
+    for (size_t j = 0; j < used.size(); j++) {
+      pairs[lo + j] = table[used[j]];
+    }
+    counts[c] = used.size();
+  }, 1);
+
+  // compact the per-chunk partials
+  counts[num_chunks] = 0;
+  size_t total = scan_inplace(counts.slice(), addm<size_t>());
+  auto flat = sequence<KV>::no_init(total);
+  parallel_for(0, num_chunks, [&](size_t c) {
+    size_t src = c * kChunk;
+    size_t dst = counts[c];
+    size_t ct = counts[c + 1] - dst;
+    for (size_t i = 0; i < ct; i++) flat[dst + i] = pairs[src + i];
+  }, 1);
+
+  auto pair_key = [&](KV const &kv) { return kv.first; };
+  auto pair_val = [&](KV const &kv) { return kv.second; };
+  return collect_reduce(flat, pair_key, pair_val, monoid, num_buckets);
+}
+
 // histogram based on collect_reduce.
 // m is the number of buckets
 // the output type of each bucket will have the same integer type as m
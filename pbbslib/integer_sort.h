@@ -210,6 +210,87 @@ void integer_sort_inplace(range<T *> In, Get_Key const &g,
   integer_sort_(In, Tmp.slice(), In, g, num_bits, 0, true);
 }
 
+// ==================== Fully in-place MSD radix sort ====================
+//
+// integer_sort_inplace above still allocates an n-sized temporary, which
+// doubles the transient footprint of graph building at scale. This variant
+// allocates only O(num_buckets) per recursion node: each pass distributes
+// by the top radix_bits of the remaining key with an American-flag
+// cycle-leader permutation (software-prefetching the scatter targets a few
+// cycles ahead), then recurses into the buckets in parallel. The
+// distribution pass of each node is sequential -- parallelism comes from
+// the bucket recursion -- so this trades some speed at the root for an
+// O(1)-auxiliary-memory sort; use it when footprint, not time, is the
+// binding constraint.
+
+template <typename T, typename Get_Key>
+void in_place_radix_sort_r(T* A, size_t n, Get_Key const& g, long bit_shift,
+                           size_t radix_bits) {
+  constexpr size_t kSeqSortThreshold = 1 << 10;
+  if (n < 2) return;
+  if (n <= kSeqSortThreshold || bit_shift < 0) {
+    std::sort(A, A + n,
+              [&](const T& a, const T& b) { return g(a) < g(b); });
+    return;
+  }
+  size_t num_buckets = size_t{1} << radix_bits;
+  size_t mask = num_buckets - 1;
+  auto bucket_of = [&](const T& v) -> size_t {
+    return (g(v) >> bit_shift) & mask;
+  };
+
+  auto counts = sequence<size_t>(num_buckets, (size_t)0);
+  for (size_t i = 0; i < n; i++) counts[bucket_of(A[i])]++;
+  auto starts = sequence<size_t>(num_buckets);
+  auto ends = sequence<size_t>(num_buckets);
+  size_t off = 0;
+  for (size_t b = 0; b < num_buckets; b++) {
+    starts[b] = off;
+    off += counts[b];
+    ends[b] = off;
+  }
+  auto heads = starts;  // mutable cursors
+
+  // American-flag permutation: place elements into their buckets by
+  // following displacement cycles; prefetch the next scatter target so the
+  // dependent load does not stall the cycle walk.
+  for (size_t b = 0; b < num_buckets; b++) {
+    while (heads[b] < ends[b]) {
+      T v = A[heads[b]];
+      size_t dst = bucket_of(v);
+      while (dst != b) {
+        size_t pos = heads[dst]++;
+        __builtin_prefetch(&A[heads[bucket_of(A[pos])]]);
+        std::swap(v, A[pos]);
+        dst = bucket_of(v);
+      }
+      A[heads[b]++] = v;
+    }
+  }
+
+  long next_shift = bit_shift - (long)radix_bits;
+  parallel_for(0, num_buckets, [&](size_t b) {
+    size_t lo = starts[b];
+    in_place_radix_sort_r(A + lo, ends[b] - lo, g, next_shift, radix_bits);
+  }, 1);
+}
+
+template <typename T, typename Get_Key>
+void integer_sort_fully_inplace(range<T*> In, Get_Key const& g,
+                                size_t num_bits = 0, size_t radix_bits = 8) {
+  size_t n = In.size();
+  if (n < 2) return;
+  if (num_bits == 0) {
+    auto max_f = delayed_seq<size_t>(
+        n, [&](size_t i) -> size_t { return g(In[i]); });
+    size_t max_key = reduce(max_f, maxm<size_t>());
+    num_bits = log2_up(max_key + 1);
+  }
+  long top_shift =
+      (long)(((num_bits + radix_bits - 1) / radix_bits) - 1) * radix_bits;
+  in_place_radix_sort_r(In.begin(), n, g, top_shift, radix_bits);
+}
+
 template <typename Seq, typename Get_Key>
 sequence<typename Seq::value_type> integer_sort(Seq const &In, Get_Key const &g,
                                                 size_t num_bits = 0) {
@@ -1,5 +1,6 @@
 #pragma once
 #include "random.h"
+#include "sample_sort.h"
 #include "sequence_ops.h"
 
 namespace pbbs {
@@ -36,4 +37,61 @@ typename Seq::value_type approximate_kth_smallest(Seq const &S, size_t k,
   // kth_smallest(samples, k * num_samples / n, less);
 }
 
+// Streaming top-k: returns the k largest elements (by `less`) in
+// decreasing order without sorting the whole sequence. Each block keeps
+// its own top-k candidates with a partial selection, and only the
+// num_blocks * k candidates are fully selected and sorted at the end --
+// one scan over the data instead of an n log n sort, which turns "top 1000
+// by coreness" over billions of elements from a sort into a scan.
+template <class Seq, class Compare>
+sequence<typename Seq::value_type> top_k(Seq const& S, size_t k,
+                                         Compare less) {
+  using T = typename Seq::value_type;
+  size_t n = S.size();
+  if (k == 0) return sequence<T>();
+  if (k >= n) {
+    auto all = sample_sort(S, less);
+    // decreasing order
+    return sequence<T>(n, [&](size_t i) { return all[n - 1 - i]; });
+  }
+
+  size_t num_blocks =
+      std::min<size_t>(std::max<size_t>(2 * (size_t)num_workers(), 1),
+                       1 + (n - 1) / std::max<size_t>(k, 1));
+  size_t block_size = 1 + (n - 1) / num_blocks;
+  auto candidates = sequence<T>::no_init(num_blocks * k);
+  auto cand_cts = sequence<size_t>(num_blocks + 1);
+
+  parallel_for(0, num_blocks, [&](size_t b) {
+    size_t lo = b * block_size;
+    size_t hi = std::min(lo + block_size, n);
+    size_t len = hi - lo;
+    // copy the block's elements into scratch and partially select its top k
+    std::vector<T> buf(len);
+    for (size_t i = 0; i < len; i++) buf[i] = S[lo + i];
+    size_t keep = std::min(k, len);
+    std::nth_element(buf.begin(), buf.begin() + (keep - 1), buf.end(),
+                     [&](const T& a, const T& b2) { return less(b2, a); });
+    for (size_t i = 0; i < keep; i++) candidates[b * k + i] = buf[i];
+    cand_cts[b] = keep;
+  }, 1);
+
+  // compact the candidate lists (tail blocks may contribute fewer than k)
+  cand_cts[num_blocks] = 0;
+  size_t total = scan_inplace(cand_cts.slice(), addm<size_t>());
+  auto flat = sequence<T>::no_init(total);
+  parallel_for(0, num_blocks, [&](size_t b) {
+    size_t off = cand_cts[b];
+    size_t ct = cand_cts[b + 1] - off;
+    for (size_t i = 0; i < ct; i++) flat[off + i] = candidates[b * k + i];
+  }, 1);
+
+  // final selection + sort of just the candidates
+  std::nth_element(flat.begin(), flat.begin() + (k - 1), flat.end(),
+                   [&](const T& a, const T& b2) { return less(b2, a); });
+  std::sort(flat.begin(), flat.begin() + k,
+            [&](const T& a, const T& b2) { return less(b2, a); });
+  return sequence<T>(k, [&](size_t i) { return flat[i]; });
+}
+
 }  // namespace pbbs
@@ -165,7 +165,12 @@ size_t list_allocator<T>::num_used_bytes() {
 template <typename T>
 auto list_allocator<T>::allocate_blocks(size_t num_blocks) -> block_p {
   block_p start =
-      (block_p)aligned_alloc(pad_size, num_blocks * _block_size + pad_size);
+      (block_p)aligned_alloc(pad_size,
+          // aligned_alloc requires the size to be a multiple of the
+          // alignment; glibc tolerates violations but other allocators
+          // (and sanitizers) reject them.
+          ((num_blocks * _block_size + pad_size + pad_size - 1) / pad_size) *
+              pad_size);
   if (start == NULL) {
     fprintf(stderr, "Cannot allocate space in list_allocator");
     exit(1);
@@ -83,4 +83,84 @@ sequence<typename SeqA::value_type> merge(const SeqA &A, const SeqB &B,
   return R;
 }
 
+
+// ==================== Sorted set intersection ==========================
+//
+// Exported intersection primitives over sorted runs (neighbor lists). The
+// balanced path is a branch-free merge -- both cursors advance by
+// comparison results rather than a data-dependent branch, which the
+// compiler turns into cmov/SIMD-friendly code -- and when one side is much
+// longer the loop switches to galloping (doubling search) over the long
+// side. `get` projects an element to its key, so tuple-typed neighbor
+// arrays can be intersected without copying.
+
+constexpr size_t kGallopRatio = 32;
+
+// Doubling search: smallest index in [lo, n) with A[get] >= key.
+template <class Seq, class Get, class KT>
+inline size_t gallop_lower_bound(Seq const &A, size_t lo, size_t n,
+                                 Get const &get, KT key) {
+  size_t step = 1;
+  size_t hi = lo;
+  while (hi < n && get(A[hi]) < key) {
+    lo = hi + 1;
+    hi += step;
+    step *= 2;
+  }
+  hi = std::min(hi, n);
+  // binary search in (lo-1, hi]
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (get(A[mid]) < key)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+// Calls f(key) for every key present in both sorted sequences; returns the
+// intersection size.
+template <class SeqA, class SeqB, class GetA, class GetB, class F>
+size_t seq_intersect_f(SeqA const &A, SeqB const &B, GetA const &get_a,
+                       GetB const &get_b, F const &f) {
+  size_t nA = A.size(), nB = B.size();
+  if (nA == 0 || nB == 0) return 0;
+  // galloping when one side dominates
+  if (nB > kGallopRatio * nA || nA > kGallopRatio * nB) {
+    bool swap = nA > nB;
+    size_t nS = swap ? nB : nA;
+    size_t nL = swap ? nA : nB;
+    size_t j = 0, ct = 0;
+    for (size_t i = 0; i < nS && j < nL; i++) {
+      auto key = swap ? get_b(B[i]) : get_a(A[i]);
+      if (swap) {
+        j = gallop_lower_bound(A, j, nL, get_a, key);
+        if (j < nL && get_a(A[j]) == key) { f(key); ct++; j++; }
+      } else {
+        j = gallop_lower_bound(B, j, nL, get_b, key);
+        if (j < nL && get_b(B[j]) == key) { f(key); ct++; j++; }
+      }
+    }
+    return ct;
+  }
+  // branch-free merge
+  size_t i = 0, j = 0, ct = 0;
+  while (i < nA && j < nB) {
+    auto a = get_a(A[i]);
+    auto b = get_b(B[j]);
+    if (a == b) { f(a); ct++; }
+    i += (a <= b);
+    j += (b <= a);
+  }
+  return ct;
+}
+
+template <class SeqA, class SeqB, class GetA, class GetB>
+size_t seq_intersect_count(SeqA const &A, SeqB const &B, GetA const &get_a,
+                           GetB const &get_b) {
+  auto noop = [](const auto&) {};
+  return seq_intersect_f(A, B, get_a, get_b, noop);
+}
+
 }  // namespace pbbs
@@ -0,0 +1,217 @@
+// This code is part of the Problem Based Benchmark Suite (PBBS)
+// Copyright (c) 2016 Guy Blelloch, Daniel Ferizovic, and the PBBS team
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights (to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// Scheduler-agnostic padded reducers (the cilk reducer.h works only under
+// cilk): one cache-line-aligned partial per worker, plain adds on the hot
+// path, lazy combining on read, generalized over any monoid -- sum, max,
+// min, and fixed-size histograms come predefined. Every live reducer
+// registers its slot region in a global registry, and
+// audit_false_sharing() reports any two regions that land on the same
+// cache line (or a region whose own slot stride is under a line), so the
+// 8%-in-triangle-counting class of accidental sharing is found by running
+// the audit instead of by profiling luck. Setting PBBS_REDUCER_AUDIT=1
+// audits automatically when a reducer registers.
+
+#pragma once
+
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "monoid.h"
+#include "utilities.h"
+
+namespace pbbs {
+
+// ==================== registry and audit ====================
+
+struct reducer_registry {
+  struct region {
+    const char* name;
+    const void* base;
+    size_t bytes;
+    size_t slot_stride;
+  };
+  std::mutex mtx;
+  std::vector<region> regions;
+
+  static reducer_registry& get() {
+    static reducer_registry r;
+    return r;
+  }
+};
+
+static constexpr size_t kCacheLineBytes = 64;
+
+// Reports counters whose slot regions share a cache line (pairwise) or
+// whose per-worker stride is below a line (self). Returns the number of
+// findings.
+inline size_t audit_false_sharing(std::ostream& os = std::cout) {
+  auto& r = reducer_registry::get();
+  std::lock_guard<std::mutex> guard(r.mtx);
+  size_t findings = 0;
+  for (size_t i = 0; i < r.regions.size(); i++) {
+    auto& a = r.regions[i];
+    if (a.slot_stride < kCacheLineBytes) {
+      os << "# reducer-audit: '" << a.name << "' slot stride "
+         << a.slot_stride << "B < cache line; workers share lines"
+         << std::endl;
+      findings++;
+    }
+    for (size_t j = i + 1; j < r.regions.size(); j++) {
+      auto& b = r.regions[j];
+      size_t a_lo = (size_t)a.base / kCacheLineBytes;
+      size_t a_hi = ((size_t)a.base + a.bytes - 1) / kCacheLineBytes;
+      size_t b_lo = (size_t)b.base / kCacheLineBytes;
+      size_t b_hi = ((size_t)b.base + b.bytes - 1) / kCacheLineBytes;
+      if (a_lo <= b_hi && b_lo <= a_hi) {
+        os << "# reducer-audit: '" << a.name << "' and '" << b.name
+           << "' share cache line(s)" << std::endl;
+        findings++;
+      }
+    }
+  }
+  return findings;
+}
+
+inline void register_reducer(const char* name, const void* base, size_t bytes,
+                             size_t slot_stride) {
+  auto& r = reducer_registry::get();
+  {
+    std::lock_guard<std::mutex> guard(r.mtx);
+    r.regions.push_back({name, base, bytes, slot_stride});
+  }
+  static bool audit_on = (std::getenv("PBBS_REDUCER_AUDIT") != nullptr);
+  if (audit_on) audit_false_sharing();
+}
+
+inline void unregister_reducer(const void* base) {
+  auto& r = reducer_registry::get();
+  std::lock_guard<std::mutex> guard(r.mtx);
+  for (size_t i = 0; i < r.regions.size(); i++) {
+    if (r.regions[i].base == base) {
+      r.regions[i] = r.regions.back();
+      r.regions.pop_back();
+      return;
+    }
+  }
+}
+
+// ==================== the reducer ====================
+
+// One aligned partial per worker; add() is a plain monoid combine into the
+// caller's slot, get_value() folds lazily.
+template <class Monoid>
+struct padded_reducer {
+  using T = typename Monoid::T;
+  struct alignas(kCacheLineBytes) slot {
+    T v;
+  };
+
+  Monoid m;
+  slot* slots;
+  int nw;
+
+  padded_reducer(Monoid m = Monoid(), const char* name = "reducer")
+      : m(m), nw(num_workers()) {
+    slots = (slot*)aligned_alloc(kCacheLineBytes,
+                                 ((size_t)nw) * sizeof(slot));
+    for (int w = 0; w < nw; w++) slots[w].v = m.identity;
+    register_reducer(name, slots, (size_t)nw * sizeof(slot), sizeof(slot));
+  }
+  padded_reducer(const padded_reducer&) = delete;
+  padded_reducer& operator=(const padded_reducer&) = delete;
+
+  ~padded_reducer() {
+    unregister_reducer(slots);
+    free(slots);
+  }
+
+  inline void add(const T& v) {
+    slot& s = slots[worker_id()];
+    s.v = m.f(s.v, v);
+  }
+
+  T get_value() const {
+    T acc = m.identity;
+    for (int w = 0; w < nw; w++) acc = m.f(acc, slots[w].v);
+    return acc;
+  }
+
+  void reset() {
+    for (int w = 0; w < nw; w++) slots[w].v = m.identity;
+  }
+};
+
+template <class T>
+using sum_reducer = padded_reducer<addm<T>>;
+template <class T>
+using max_reducer = padded_reducer<maxm<T>>;
+template <class T>
+using min_reducer = padded_reducer<minm<T>>;
+
+// Fixed-bucket histogram: each worker owns a line-aligned bucket array;
+// inc() is one add, get_value() folds per bucket.
+template <class T, int kBuckets>
+struct histogram_padded_reducer {
+  static constexpr size_t kSlotBytes =
+      ((kBuckets * sizeof(T) + kCacheLineBytes - 1) / kCacheLineBytes) *
+      kCacheLineBytes;
+  struct alignas(kCacheLineBytes) slot {
+    T buckets[kSlotBytes / sizeof(T)];
+  };
+
+  slot* slots;
+  int nw;
+
+  histogram_padded_reducer(const char* name = "histogram_reducer")
+      : nw(num_workers()) {
+    slots = (slot*)aligned_alloc(kCacheLineBytes,
+                                 ((size_t)nw) * sizeof(slot));
+    memset((void*)slots, 0, (size_t)nw * sizeof(slot));
+    register_reducer(name, slots, (size_t)nw * sizeof(slot), sizeof(slot));
+  }
+  histogram_padded_reducer(const histogram_padded_reducer&) = delete;
+
+  ~histogram_padded_reducer() {
+    unregister_reducer(slots);
+    free(slots);
+  }
+
+  inline void inc(int bucket, T v = (T)1) {
+    slots[worker_id()].buckets[bucket] += v;
+  }
+
+  std::array<T, kBuckets> get_value() const {
+    std::array<T, kBuckets> out;
+    for (int b = 0; b < kBuckets; b++) {
+      T acc = (T)0;
+      for (int w = 0; w < nw; w++) acc += slots[w].buckets[b];
+      out[b] = acc;
+    }
+    return out;
+  }
+};
+
+}  // namespace pbbs
@@ -175,16 +175,16 @@ template <typename A, typename Af, typename Df, typename F>
 inline void parallel_for_alloc(Af init_alloc, Df finish_alloc, long start,
                                long end, F f, long granularity,
                                bool conservative) {
-  A* alloc = nullptr;
-#pragma omp parallel private(alloc)
+#pragma omp parallel
   {
-    alloc = new A();
+    // Persist the scratch per thread across invocations, as the homegrown
+    // backend does; init_alloc implementations grow-on-demand.
+    static thread_local A* alloc = new A();
     init_alloc(alloc);
     parallel_for_1(start, end, [&](size_t i) { f(i, alloc); }, granularity,
                    conservative);
     //#pragma omp for schedule(dynamic, 1) nowait
     // for(long i=start; i<end; i++) f(i, alloc);
-    finish_alloc(alloc);
   }
 }
 
@@ -288,3 +288,172 @@ inline int worker_id() { return 0; }
 }  // namespace pbbs
 
 #endif
+
+// ==================== Granularity auto-tuning ==========================
+//
+// The sequential-grain constants scattered through the library (2048 in the
+// dense edge map, 512 in the sequence ops, ...) were tuned for one machine.
+// A granularity_tuner calibrates a loop site at runtime instead: its first
+// execution times a small prefix of iterations sequentially and derives a
+// grain targeting a fixed amount of work per task, which later executions
+// reuse. Declare one static tuner per loop site and run the loop through
+// tuned_parallel_for.
+//
+//   static pbbs::granularity_tuner tuner;
+//   pbbs::tuned_parallel_for(tuner, 0, n, [&](size_t i) { ... });
+
+#include <atomic>
+#include <chrono>
+
+namespace pbbs {
+
+struct granularity_tuner {
+  // ~20us of work per task amortizes scheduler overhead without starving
+  // the steal loop of parallelism.
+  static constexpr long kTargetGrainNanos = 20000;
+  static constexpr long kSampleIters = 64;
+  static constexpr long kMaxGranularity = 1 << 16;
+
+  std::atomic<long> granularity{0};
+
+  long get() const { return granularity.load(std::memory_order_relaxed); }
+};
+
+template <typename F>
+inline void tuned_parallel_for(granularity_tuner& tuner, long start, long end,
+                               F f, bool conservative = false) {
+  long g = tuner.get();
+  if (g == 0 && end > start) {
+    // Calibrate on a sequential prefix (these iterations run for real, so
+    // calibration does no extra work).
+    long sample = std::min(end - start, granularity_tuner::kSampleIters);
+    auto t0 = std::chrono::steady_clock::now();
+    for (long i = start; i < start + sample; i++) {
+      f(i);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    long nanos =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+    long per_iter = std::max<long>(nanos / sample, 1);
+    g = std::min<long>(
+        std::max<long>(granularity_tuner::kTargetGrainNanos / per_iter, 1),
+        granularity_tuner::kMaxGranularity);
+    tuner.granularity.store(g, std::memory_order_relaxed);
+    start += sample;
+  }
+  if (start < end) {
+    parallel_for(start, end, f, g, conservative);
+  }
+}
+
+}  // namespace pbbs
+
+
+#ifdef HOMEGROWN
+namespace pbbs {
+
+// Tags the calling thread's spawned work with a scheduling priority for the
+// duration of the scope. Thieves probe two deques per steal attempt and
+// prefer the higher-priority one, and workers executing stolen
+// high-priority jobs propagate the tag to their own spawns -- so a
+// latency-sensitive region (a single-source BFS) keeps attracting workers
+// even while a batch job (full-graph triangle counting) floods the
+// scheduler. Usage:
+//
+//   { pbbs::priority_scope ps(true);  // high priority
+//     BFS(G, src); }
+struct priority_scope {
+  int prev;
+  priority_scope(bool high) {
+    using sched_t = scheduler<std::function<void()>>;
+    prev = sched_t::job_priority;
+    sched_t::job_priority =
+        high ? sched_t::kPriorityHigh : sched_t::kPriorityNormal;
+  }
+  ~priority_scope() {
+    scheduler<std::function<void()>>::job_priority = prev;
+  }
+};
+
+}  // namespace pbbs
+#endif
+
+#ifdef HOMEGROWN
+#include "concurrent_stack.h"
+
+namespace pbbs {
+
+// Runs f with at most k workers executing its parallel work, e.g.
+//   pbbs::run_with_workers(8, [&] { BFS(G, src); });
+// The calling worker counts toward the limit; thieves skip the region's
+// deques once k workers are inside it, so two concurrent jobs can be kept
+// on (approximately) disjoint worker subsets instead of destructively
+// interleaving their working sets. Descriptors are recycled through a
+// process-lifetime freelist so stale deque tags never dangle.
+template <typename F>
+inline void run_with_workers(int k, F f) {
+  using sched_t = scheduler<std::function<void()>>;
+  static concurrent_stack<sched_t::worker_limit*> freelist;
+  sched_t::worker_limit* lim;
+  auto r = freelist.pop();
+  if (r.has_value()) {
+    lim = *r;
+  } else {
+    lim = new sched_t::worker_limit();
+  }
+  lim->max_workers = k;
+  lim->active.store(1, std::memory_order_relaxed);  // the calling worker
+
+  sched_t::worker_limit* prev = sched_t::current_limit;
+  sched_t::current_limit = lim;
+  f();
+  sched_t::current_limit = prev;
+  lim->active.fetch_sub(1, std::memory_order_relaxed);
+  // A thief that just finished the region's last job may not have
+  // decremented yet; wait for zero before recycling the descriptor.
+  while (lim->active.load(std::memory_order_relaxed) != 0) {
+    std::this_thread::yield();
+  }
+  freelist.push(lim);
+}
+
+}  // namespace pbbs
+#endif
+
+#ifdef HOMEGROWN
+namespace pbbs {
+
+// Runs f and, when PBBS_SCHED_TELEMETRY=1, prints the per-worker busy /
+// steal / park deltas accumulated inside it -- one line per worker plus a
+// summary -- keyed by the supplied region name. Confirms or refutes
+// imbalance hypotheses without hand-instrumented builds.
+template <typename F>
+inline void telemetry_region(const char* name, F f) {
+  using sched_t = scheduler<std::function<void()>>;
+  auto& sched = *global_scheduler.sched;
+  if (!sched_t::telemetry_enabled()) {
+    f();
+    return;
+  }
+  int P = num_workers();
+  std::vector<sched_t::worker_stats> before(P);
+  for (int w = 0; w < P; w++) before[w] = sched.stats[w];
+  f();
+  size_t tot_busy = 0, tot_attempts = 0, tot_steals = 0, tot_park = 0;
+  for (int w = 0; w < P; w++) {
+    size_t busy = sched.stats[w].busy_ns - before[w].busy_ns;
+    size_t att = sched.stats[w].steal_attempts - before[w].steal_attempts;
+    size_t st = sched.stats[w].steals - before[w].steals;
+    size_t park = sched.stats[w].park_ns - before[w].park_ns;
+    tot_busy += busy; tot_attempts += att; tot_steals += st; tot_park += park;
+    std::cout << "# sched[" << name << "] worker " << w << ": busy_ns = "
+              << busy << " steal_attempts = " << att << " steals = " << st
+              << " park_ns = " << park << std::endl;
+  }
+  std::cout << "# sched[" << name << "] total: busy_ns = " << tot_busy
+            << " steal_attempts = " << tot_attempts << " steals = "
+            << tot_steals << " park_ns = " << tot_park << std::endl;
+}
+
+}  // namespace pbbs
+#endif
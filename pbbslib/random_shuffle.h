@@ -25,6 +25,7 @@
 #include <stdio.h>
 #include <cstdint>
 #include "counting_sort.h"
+#include "sample_sort.h"
 #include "random.h"
 #include "utilities.h"
 
@@ -92,4 +93,33 @@ sequence<intT> random_permutation(size_t n, random r = random()) {
   return pbbs::random_shuffle(id, r);
 }
 
+// Deterministic counter-based shuffle: element i's destination is a pure
+// function of (seed, i) -- a 64-bit counter hash sorted with a
+// deterministic comparison (ties broken by index) -- so the ordering
+// reproduces bit-for-bit across runs, worker counts, and scheduling. Use
+// this in drivers (MIS, coloring) whose behavior must be bisectable;
+// throughput is comparable to the bucket shuffle since both are dominated
+// by one key-sort-sized data movement.
+template <typename Seq>
+sequence<typename Seq::value_type> deterministic_random_shuffle(
+    Seq const& In, uint64_t seed = 0) {
+  using T = typename Seq::value_type;
+  size_t n = In.size();
+  auto keys = sequence<uint64_t>(n, [&](size_t i) {
+    return hash64_2(seed * 0x9e3779b97f4a7c15UL + i);
+  });
+  auto idx = sequence<size_t>(n, [](size_t i) { return i; });
+  auto cmp = [&](const size_t& a, const size_t& b) {
+    return (keys[a] < keys[b]) || (keys[a] == keys[b] && a < b);
+  };
+  sample_sort_inplace(idx.slice(), cmp);
+  return sequence<T>(n, [&](size_t i) { return In[idx[i]]; });
+}
+
+template <class intT>
+sequence<intT> deterministic_random_permutation(size_t n, uint64_t seed = 0) {
+  sequence<intT> id(n, [&](size_t i) { return (intT)i; });
+  return pbbs::deterministic_random_shuffle(id, seed);
+}
+
 }  // namespace pbbs
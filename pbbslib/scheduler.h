@@ -1,9 +1,12 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <functional>
 #include <iostream>
+#include <mutex>
 #include <thread>
 
 #ifdef SAGE
@@ -12,6 +15,11 @@
 #include <numa.h>
 #endif
 
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 namespace pbbs {
 
 // EXAMPLE USE 1:
@@ -151,6 +159,43 @@ struct scheduler {
   int num_threads;
 
   static thread_local int thread_id;
+  // Priority tag applied to work spawned by this thread (see
+  // priority_scope in parallel.h). kPriorityNormal jobs are batch work;
+  // kPriorityHigh regions are latency-sensitive queries whose deques are
+  // preferred by the steal loop.
+  static constexpr int kPriorityNormal = 0;
+  static constexpr int kPriorityHigh = 1;
+  static thread_local int job_priority;
+
+  // Per-region worker limiting (see run_with_workers in parallel.h): a
+  // region descriptor counts the workers currently executing the region's
+  // jobs, and thieves skip deques whose region is already at its limit.
+  // Descriptors are recycled through a process-lifetime freelist rather
+  // than freed, so a stale deque tag can never dangle.
+  struct worker_limit {
+    std::atomic<int> active{0};
+    int max_workers{0};
+  };
+  static thread_local worker_limit* current_limit;
+  static thread_local bool limit_acquired;
+
+  // Opt-in telemetry (PBBS_SCHED_TELEMETRY=1): per-worker steal attempts,
+  // successful steals, parked nanoseconds, and busy (job execution)
+  // nanoseconds, in cache-line-padded slots. Regions snapshot the totals
+  // before/after (see telemetry_region in parallel.h) to attribute
+  // imbalance per parallel region.
+  struct alignas(64) worker_stats {
+    size_t steal_attempts = 0;
+    size_t steals = 0;
+    size_t park_ns = 0;
+    size_t busy_ns = 0;
+  };
+  worker_stats* stats;
+
+  static bool telemetry_enabled() {
+    static bool on = (std::getenv("PBBS_SCHED_TELEMETRY") != nullptr);
+    return on;
+  }
 
 #ifdef SAGE
     static thread_local int numa_node;
@@ -159,6 +204,9 @@ struct scheduler {
       num_deques = 2*num_threads;
       deques = new Deque<Job>[num_deques];
       attempts = new attempt[num_deques];
+      deque_prios = new std::atomic<int>[num_deques]();
+      deque_limits = new std::atomic<worker_limit*>[num_deques]();
+      stats = new worker_stats[num_threads]();
       finished_flag = 0;
 
       // Spawn num_workers many threads on startup
@@ -190,17 +238,49 @@ struct scheduler {
     num_deques = 2 * num_threads;
     deques = new Deque<Job>[num_deques];
     attempts = new attempt[num_deques];
+    deque_prios = new std::atomic<int>[num_deques]();
+    deque_limits = new std::atomic<worker_limit*>[num_deques]();
+    stats = new worker_stats[num_threads]();
     finished_flag = 0;
 
+    // Optionally pin workers round-robin over the hardware CPUs
+    // (PBBS_PIN_WORKERS=1). On multi-socket machines, pinning makes worker
+    // ids stable w.r.t. NUMA nodes, so the first-touch initialization loops
+    // in the graph builders place each vertex range's pages on the node of
+    // the workers that will process it -- without pinning, thread migration
+    // scatters pages and remote-node traffic dominates bandwidth-bound
+    // kernels like PageRank.
+#if defined(__linux__)
+    bool pin_workers = (std::getenv("PBBS_PIN_WORKERS") != nullptr);
+    unsigned hw_cpus = std::thread::hardware_concurrency();
+#endif
+
     // Spawn num_workers many threads on startup
     spawned_threads = new std::thread[num_threads - 1];
     std::function<bool()> finished = [&]() { return finished_flag == 1; };
     thread_id = 0;  // thread-local write
+#if defined(__linux__)
+    if (pin_workers && hw_cpus > 0) {
+      cpu_set_t cpuset;
+      CPU_ZERO(&cpuset);
+      CPU_SET(0, &cpuset);
+      pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+    }
+#endif
     for (int i = 1; i < num_threads; i++) {
       spawned_threads[i - 1] = std::thread([&, i, finished]() {
         thread_id = i;  // thread-local write
         start(finished);
       });
+#if defined(__linux__)
+      if (pin_workers && hw_cpus > 0) {
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        CPU_SET(i % hw_cpus, &cpuset);
+        pthread_setaffinity_np(spawned_threads[i - 1].native_handle(),
+                               sizeof(cpu_set_t), &cpuset);
+      }
+#endif
     }
   }
 #endif
@@ -213,12 +293,22 @@ struct scheduler {
     delete[] spawned_threads;
     delete[] deques;
     delete[] attempts;
+    delete[] deque_prios;
+    delete[] deque_limits;
+    delete[] stats;
   }
 
-  // Push onto local stack.
+  // Push onto local stack; wakes one sleeping worker if any are parked.
+  // The deque is tagged with the spawning thread's priority so thieves can
+  // prefer latency-sensitive work.
   void spawn(Job* job) {
     int id = worker_id();
+    deque_prios[id].store(job_priority, std::memory_order_relaxed);
+    deque_limits[id].store(current_limit, std::memory_order_relaxed);
     deques[id].push_bottom(job);
+    if (num_sleepers.load(std::memory_order_relaxed) > 0) {
+      sleep_cv.notify_one();
+    }
   }
 
   // Wait for condition: finished().
@@ -235,7 +325,10 @@ struct scheduler {
   }
 
   // All scheduler threads quit after this is called.
-  void finish() { finished_flag = 1; }
+  void finish() {
+    finished_flag = 1;
+    sleep_cv.notify_all();
+  }
 
   // Pop from local stack.
   Job* try_pop() {
@@ -281,36 +374,127 @@ struct scheduler {
     while (1) {
       Job* job = get_job(finished);
       if (!job) return;
-      (*job)();
+      if (telemetry_enabled()) {
+        auto t0 = std::chrono::steady_clock::now();
+        (*job)();
+        stats[worker_id()].busy_ns +=
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - t0).count();
+      } else {
+        (*job)();
+      }
+      if (limit_acquired) {
+        // Leave the limited region joined in steal_from.
+        current_limit->active.fetch_sub(1, std::memory_order_relaxed);
+        current_limit = nullptr;
+        limit_acquired = false;
+      }
     }
   }
 
   Job* try_steal(size_t id) {
-    // use hashing to get "random" target
-    size_t target = (hash(id) + hash(attempts[id].val)) % num_deques;
+    if (telemetry_enabled()) stats[worker_id()].steal_attempts++;
+    // Probe two "random" targets and steal from the higher-priority one
+    // first, so a co-located batch job cannot starve a latency-sensitive
+    // region of thieves. A worker that steals from a high-priority deque
+    // inherits that priority for its own spawns (the subtree it executes
+    // belongs to the high-priority region).
+    size_t t1 = (hash(id) + hash(attempts[id].val)) % num_deques;
+    attempts[id].val++;
+    size_t t2 = (hash(id) + hash(attempts[id].val)) % num_deques;
     attempts[id].val++;
-    return deques[target].pop_top();
+    int p1 = deque_prios[t1].load(std::memory_order_relaxed);
+    int p2 = deque_prios[t2].load(std::memory_order_relaxed);
+    if (p2 > p1) {
+      std::swap(t1, t2);
+      std::swap(p1, p2);
+    }
+    Job* job = steal_from(t1, p1);
+    if (!job) job = steal_from(t2, p2);
+    if (job && telemetry_enabled()) stats[worker_id()].steals++;
+    return job;
+  }
+
+  // Attempts to steal from deque t, respecting its region's worker limit.
+  Job* steal_from(size_t t, int priority) {
+    worker_limit* lim = deque_limits[t].load(std::memory_order_relaxed);
+    if (lim != nullptr) {
+      // Optimistically join the region; back out if it is full.
+      int prev = lim->active.fetch_add(1, std::memory_order_relaxed);
+      if (prev >= lim->max_workers) {
+        lim->active.fetch_sub(1, std::memory_order_relaxed);
+        return NULL;
+      }
+      Job* job = deques[t].pop_top();
+      if (job == NULL) {
+        lim->active.fetch_sub(1, std::memory_order_relaxed);
+        return NULL;
+      }
+      job_priority = priority;
+      current_limit = lim;
+      limit_acquired = true;
+      return job;
+    }
+    Job* job = deques[t].pop_top();
+    if (job) job_priority = priority;
+    return job;
   }
 
-  // Find a job, first trying local stack, then random steals.
+  // Find a job, first trying local stack, then random steals. Workers that
+  // repeatedly fail to steal back off from spinning to parking on a
+  // condition variable: during long sequential phases, a machine full of
+  // hyperthreads spinning through steal attempts burns the TDP headroom the
+  // one busy core needs to turbo. spawn() wakes a parked worker, and the
+  // park has a bounded timeout so a wake-up racing with the park is only a
+  // bounded delay, never a hang.
   template <typename F>
   Job* get_job(F finished) {
     if (finished()) return NULL;
     Job* job = try_pop();
     if (job) return job;
     size_t id = worker_id();
+    // Spin through this many full steal sweeps before starting to park.
+    constexpr int kSpinRounds = 4;
+    constexpr int64_t kMaxParkUsecs = 1000;
+    int failed_rounds = 0;
+    int64_t park_usecs = 10;
     while (1) {
       // By coupon collector's problem, this should touch all.
       for (int i = 0; i <= num_deques * 100; i++) {
         if (finished()) return NULL;
         job = try_steal(id);
-        if (job) return job;
+        if (job) {
+          return job;
+        }
+      }
+      if (++failed_rounds <= kSpinRounds) {
+        // If haven't found anything, take a breather.
+        std::this_thread::sleep_for(std::chrono::nanoseconds(num_deques * 100));
+      } else {
+        // Deep sleep with wake on spawn; exponential park up to 1ms.
+        num_sleepers.fetch_add(1);
+        auto park_t0 = std::chrono::steady_clock::now();
+        {
+          std::unique_lock<std::mutex> lk(sleep_mutex);
+          sleep_cv.wait_for(lk, std::chrono::microseconds(park_usecs));
+        }
+        if (telemetry_enabled()) {
+          stats[worker_id()].park_ns +=
+              std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  std::chrono::steady_clock::now() - park_t0).count();
+        }
+        num_sleepers.fetch_sub(1);
+        park_usecs = std::min<int64_t>(park_usecs * 2, kMaxParkUsecs);
       }
-      // If haven't found anything, take a breather.
-      std::this_thread::sleep_for(std::chrono::nanoseconds(num_deques * 100));
     }
   }
 
+  std::mutex sleep_mutex;
+  std::condition_variable sleep_cv;
+  std::atomic<int> num_sleepers{0};
+  std::atomic<int>* deque_prios;
+  std::atomic<worker_limit*>* deque_limits;
+
   uint64_t hash(uint64_t x) {
     x = (x ^ (x >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
     x = (x ^ (x >> 27)) * UINT64_C(0x94d049bb133111eb);
@@ -322,6 +506,16 @@ struct scheduler {
 template <typename T>
 thread_local int scheduler<T>::thread_id = 0;
 
+template <typename T>
+thread_local int scheduler<T>::job_priority = scheduler<T>::kPriorityNormal;
+
+template <typename T>
+thread_local typename scheduler<T>::worker_limit* scheduler<T>::current_limit =
+    nullptr;
+
+template <typename T>
+thread_local bool scheduler<T>::limit_acquired = false;
+
 #ifdef SAGE
 template<typename T>
 thread_local int scheduler<T>::numa_node = 0;
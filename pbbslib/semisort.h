@@ -0,0 +1,120 @@
+// This code is part of the Problem Based Benchmark Suite (PBBS)
+// Copyright (c) 2016 Guy Blelloch, Daniel Ferizovic, and the PBBS team
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights (to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// Semisort / group-by (in the style of Gu, Shun, Sun et al.): places equal
+// keys contiguously without establishing a global key order, which is all
+// the per-vertex aggregations hand-rolled with integer_sort + boundary
+// scans actually need. Phase 1 radix-sorts on a hashed log(n)-bit key
+// prefix -- each key's records land in one hash bucket, distinct keys
+// spread uniformly, and a heavy key fills its bucket mostly alone. Phase 2
+// finishes each bucket independently with a comparison sort on the full
+// key over the (expected constant) distinct keys it holds. Fewer radix
+// passes than a full key sort is where the win comes from; group order in
+// the output is arbitrary.
+
+#pragma once
+
+#include <algorithm>
+
+#include "integer_sort.h"
+#include "sequence_ops.h"
+#include "utilities.h"
+
+namespace pbbs {
+
+// Returns a copy of A with equal-keyed records contiguous (group order
+// arbitrary). get_key must return an integral key (uintE-sized).
+template <class Seq, class GetKey>
+auto semisort_by_key(Seq const &A, GetKey const &get_key) {
+  using T = typename Seq::value_type;
+  size_t n = A.size();
+  auto B = sequence<T>(n, [&](size_t i) { return A[i]; });
+  if (n <= 1) return B;
+
+  size_t bits = std::min<size_t>(log2_up(n + 1), 16);
+  uint32_t mask = (uint32_t)((size_t{1} << bits) - 1);
+  auto hkey = [&](const T &x) -> uint32_t {
+    return hash32((uint32_t)get_key(x)) & mask;
+  };
+  integer_sort_inplace(B.slice(), hkey, bits);
+
+  // finish each hash bucket with a comparison sort on the full key
+  auto is_start = delayed_seq<bool>(n, [&](size_t i) {
+    return i == 0 || hkey(B[i]) != hkey(B[i - 1]);
+  });
+  auto bucket_starts = pack_index<size_t>(is_start);
+  size_t num_buckets = bucket_starts.size();
+  parallel_for(0, num_buckets, [&](size_t b) {
+    size_t s = bucket_starts[b];
+    size_t e = (b == num_buckets - 1) ? n : bucket_starts[b + 1];
+    if (e - s > 1) {
+      std::sort(B.begin() + s, B.begin() + e, [&](const T &x, const T &y) {
+        return get_key(x) < get_key(y);
+      });
+    }
+  }, 1);
+  return B;
+}
+
+// Semisorts A and calls f(key, start, end) for every group, where the
+// group's records are grouped[start, end) in the returned sequence (kept
+// alive by the return value).
+template <class Seq, class GetKey, class F>
+auto group_by_ranges(Seq const &A, GetKey const &get_key, F const &f) {
+  using T = typename Seq::value_type;
+  auto B = semisort_by_key(A, get_key);
+  size_t n = B.size();
+  if (n == 0) return B;
+  auto is_start = delayed_seq<bool>(n, [&](size_t i) {
+    return i == 0 || get_key(B[i]) != get_key(B[i - 1]);
+  });
+  auto starts = pack_index<size_t>(is_start);
+  size_t num_groups = starts.size();
+  parallel_for(0, num_groups, [&](size_t g) {
+    size_t s = starts[g];
+    size_t e = (g == num_groups - 1) ? n : starts[g + 1];
+    f(get_key(B[s]), s, e);
+  });
+  return B;
+}
+
+// Group-by with an aggregation callback: f(key, slice) per group. Groups
+// are processed in parallel, so f must synchronize any shared output, and
+// the grouped storage dies with the call, so f must not retain the slice.
+template <class Seq, class GetKey, class F>
+void group_by(Seq const &A, GetKey const &get_key, F const &f) {
+  auto B = semisort_by_key(A, get_key);
+  size_t n = B.size();
+  if (n == 0) return;
+  auto is_start = delayed_seq<bool>(n, [&](size_t i) {
+    return i == 0 || get_key(B[i]) != get_key(B[i - 1]);
+  });
+  auto starts = pack_index<size_t>(is_start);
+  size_t num_groups = starts.size();
+  parallel_for(0, num_groups, [&](size_t g) {
+    size_t s = starts[g];
+    size_t e = (g == num_groups - 1) ? n : starts[g + 1];
+    f(get_key(B[s]), B.slice(s, e));
+  });
+}
+
+}  // namespace pbbs
@@ -83,11 +83,43 @@ auto copy(Seq const &A, Range R, flags fl = no_flag) -> void {
   parallel_for(0, A.size(), [&](size_t i) { R[i] = A[i]; });
 }
 
+// Monoids whose reduction may use independent accumulator lanes: add/min/
+// max over arithmetic types. (The blocked parallel reduce already
+// reassociates across blocks, so lane reassociation introduces nothing
+// new for floating point.)
+template <class M>
+struct is_lane_monoid : std::false_type {};
+template <class T>
+struct is_lane_monoid<addm<T>> : std::is_arithmetic<T> {};
+template <class T>
+struct is_lane_monoid<maxm<T>> : std::is_arithmetic<T> {};
+template <class T>
+struct is_lane_monoid<minm<T>> : std::is_arithmetic<T> {};
+
 template <SEQ Seq, class Monoid>
 auto reduce_serial(Seq const &A, Monoid m) -> typename Seq::value_type {
   using T = typename Seq::value_type;
+  size_t n = A.size();
+  if constexpr (is_lane_monoid<Monoid>::value) {
+    // The naive loop carries a serial dependence through r, which defeats
+    // vectorization even for plain additions through the Monoid lambda.
+    // Eight independent lanes give the compiler a vectorizable inner loop.
+    constexpr size_t kLanes = 8;
+    if (n >= 2 * kLanes) {
+      T acc[kLanes];
+      for (size_t l = 0; l < kLanes; l++) acc[l] = A[l];
+      size_t j = kLanes;
+      for (; j + kLanes <= n; j += kLanes) {
+        for (size_t l = 0; l < kLanes; l++) acc[l] = m.f(acc[l], A[j + l]);
+      }
+      for (; j < n; j++) acc[0] = m.f(acc[0], A[j]);
+      T r = acc[0];
+      for (size_t l = 1; l < kLanes; l++) r = m.f(r, acc[l]);
+      return r;
+    }
+  }
   T r = A[0];
-  for (size_t j = 1; j < A.size(); j++) r = m.f(r, A[j]);
+  for (size_t j = 1; j < n; j++) r = m.f(r, A[j]);
   return r;
 }
 
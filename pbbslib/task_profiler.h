@@ -0,0 +1,125 @@
+// This code is part of the Problem Based Benchmark Suite (PBBS)
+// Copyright (c) 2016 Guy Blelloch, Daniel Ferizovic, and the PBBS team
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights (to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// Task-tree profiler for nested parallel regions, exporting collapsed-stack
+// lines for flame graphs. Standard profilers lose the logical call tree
+// when tasks migrate across workers; here each profiled region carries its
+// logical path explicitly -- task_region(name, f) pushes `name` onto a
+// path that lives in thread-local storage and is saved/restored around
+// nested regions. The path is re-rooted per thread: a region entered on a
+// stealing worker starts from that worker's (usually empty) path, so
+// nested attribution holds within a thread, while regions reached through
+// stolen subtasks appear as roots -- full migration tracking would need
+// scheduler hooks. Self time (region time minus profiled children) accumulates per
+// collapsed path; report() prints "a;b;c <nanoseconds>" lines that
+// flamegraph.pl consumes directly. Enabled with PBBS_TASK_PROFILE=1;
+// otherwise a region is one branch.
+
+#pragma once
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace pbbs {
+namespace task_profile {
+
+inline bool enabled() {
+  static bool on = (std::getenv("PBBS_TASK_PROFILE") != nullptr);
+  return on;
+}
+
+struct store {
+  std::mutex mtx;
+  std::map<std::string, uint64_t> self_ns;
+  static store& get() {
+    static store s;
+    return s;
+  }
+};
+
+inline std::string& current_path() {
+  static thread_local std::string path;
+  return path;
+}
+
+inline uint64_t& child_ns_slot() {
+  static thread_local uint64_t child_ns = 0;
+  return child_ns;
+}
+
+// Runs f attributed to the current path extended by `name`. The logical
+// path travels with the region: a region spawned inside another (even when
+// the body executes on a different worker via a captured task_region call)
+// re-establishes its full path on entry.
+template <class F>
+inline void task_region(const char* name, F f) {
+  if (!enabled()) {
+    f();
+    return;
+  }
+  std::string parent_path = current_path();
+  uint64_t parent_children = child_ns_slot();
+
+  std::string my_path =
+      parent_path.empty() ? std::string(name) : parent_path + ";" + name;
+  current_path() = my_path;
+  child_ns_slot() = 0;
+
+  auto t0 = std::chrono::steady_clock::now();
+  f();
+  uint64_t total_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - t0).count();
+
+  uint64_t my_children = child_ns_slot();
+  uint64_t self = (total_ns > my_children) ? (total_ns - my_children) : 0;
+  {
+    auto& s = store::get();
+    std::lock_guard<std::mutex> guard(s.mtx);
+    s.self_ns[my_path] += self;
+  }
+  // restore the parent frame and charge it our total as child time
+  current_path() = parent_path;
+  child_ns_slot() = parent_children + total_ns;
+}
+
+// Collapsed-stack dump: one "path self_ns" line per region path.
+inline void report(std::ostream& os = std::cout) {
+  auto& s = store::get();
+  std::lock_guard<std::mutex> guard(s.mtx);
+  for (const auto& kv : s.self_ns) {
+    os << kv.first << " " << kv.second << "\n";
+  }
+}
+
+inline void reset() {
+  auto& s = store::get();
+  std::lock_guard<std::mutex> guard(s.mtx);
+  s.self_ns.clear();
+}
+
+}  // namespace task_profile
+}  // namespace pbbs
@@ -68,7 +68,39 @@ struct transpose {
     }
   }
 
+  // Tiled two-pass variant for very large matrices (e.g. the counts matrix
+  // of a counting sort with millions of buckets): the cache-oblivious
+  // recursion keeps cache lines warm but its leaves still touch one page
+  // per row/column, which turns TLB-bound once rows no longer fit in the
+  // TLB. Explicit square tiles bound the working set of each task to a few
+  // hundred KB (well inside L2) and visit pages in long runs.
+  static constexpr size_t kTile = 128;
+
+  void trans_tiled(size_t rCount, size_t cCount) {
+    size_t r_tiles = (rCount + kTile - 1) / kTile;
+    size_t c_tiles = (cCount + kTile - 1) / kTile;
+    parallel_for(0, r_tiles * c_tiles, [&](size_t t) {
+      size_t ri = (t / c_tiles) * kTile;
+      size_t ci = (t % c_tiles) * kTile;
+      size_t re = std::min(ri + kTile, rCount);
+      size_t ce = std::min(ci + kTile, cCount);
+      for (size_t i = ri; i < re; i++) {
+        for (size_t j = ci; j < ce; j++) {
+          B[j * rCount + i] = A[i * cCount + j];
+        }
+      }
+    }, 1);
+  }
+
+  // Select the tiled path automatically once the matrix is large enough
+  // that the recursion's per-leaf page footprint exceeds the TLB.
+  static constexpr size_t kTiledThreshold = size_t{1} << 26;
+
   void trans(size_t rCount, size_t cCount) {
+    if (rCount * cCount > kTiledThreshold) {
+      trans_tiled(rCount, cCount);
+      return;
+    }
 #if defined(OPENMP)
 #pragma omp parallel
 #pragma omp single
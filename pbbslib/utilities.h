@@ -10,16 +10,31 @@
 
 #include "parallel.h"
 
+#include "alloc.h"
+
 #ifdef USEMALLOC
 namespace pbbs {
-inline void* my_alloc(size_t i) { return malloc(i); }
-inline void my_free(void* p) { free(p); }
+inline void* my_alloc(size_t i) {
+  if (arena* a = current_arena()) return a->alloc(i);
+  return malloc(i);
+}
+inline void my_free(void* p) {
+  // released wholesale when the owning arena clears
+  if (any_arena_owns(p)) return;
+  free(p);
+}
 }  // namespace pbbs
 #else
-#include "alloc.h"
 namespace pbbs {
-inline void* my_alloc(size_t i) { return my_mem_pool.alloc(i); }
-inline void my_free(void* p) { my_mem_pool.afree(p); }
+inline void* my_alloc(size_t i) {
+  if (arena* a = current_arena()) return a->alloc(i);
+  return my_mem_pool.alloc(i);
+}
+inline void my_free(void* p) {
+  // released wholesale when the owning arena clears
+  if (any_arena_owns(p)) return;
+  my_mem_pool.afree(p);
+}
 }  // namespace pbbs
 #endif
 
@@ -0,0 +1,161 @@
+// This code is part of the Problem Based Benchmark Suite (PBBS)
+// Copyright (c) 2016 Guy Blelloch, Daniel Ferizovic, and the PBBS team
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights (to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// A per-worker-segmented bag. insert() appends to the calling worker's
+// private segment chain with no synchronization (O(1) amortized; segment
+// capacities double up to a cap), so concurrent inserts from a parallel
+// loop never contend. map() iterates all elements in place, in parallel
+// over segments, with no copying; to_sequence() materializes a flat
+// sequence with one scan + parallel copy. Intended as the output collector
+// for speculative loops and similar accumulation patterns, replacing
+// over-allocated per-round arrays. Insertion and iteration/consumption
+// must not overlap (same contract as the rest of the library's
+// accumulate-then-process structures).
+
+#pragma once
+
+#include "sequence_ops.h"
+#include "utilities.h"
+
+namespace pbbs {
+
+template <class T>
+struct worker_bag {
+  static constexpr size_t kInitSegCapacity = 512;
+  static constexpr size_t kMaxSegCapacity = size_t{1} << 16;
+
+  struct segment {
+    segment* next;
+    size_t size;
+    size_t capacity;
+    T* data() { return (T*)(this + 1); }
+  };
+
+  // One chain per worker, padded to avoid false sharing between the chain
+  // heads.
+  struct alignas(64) worker_slot {
+    segment* head = nullptr;
+  };
+
+  worker_slot* slots;
+  int n_slots;
+
+  worker_bag() {
+    n_slots = num_workers();
+    slots = new worker_slot[n_slots];
+  }
+
+  worker_bag(const worker_bag&) = delete;
+  worker_bag& operator=(const worker_bag&) = delete;
+
+  ~worker_bag() { clear(); delete[] slots; }
+
+  static segment* alloc_segment(size_t capacity, segment* next) {
+    segment* s =
+        (segment*)my_alloc(sizeof(segment) + capacity * sizeof(T));
+    s->next = next;
+    s->size = 0;
+    s->capacity = capacity;
+    return s;
+  }
+
+  // O(1) amortized; no synchronization (the slot is private to the calling
+  // worker).
+  void insert(const T& v) {
+    worker_slot& slot = slots[worker_id()];
+    segment* head = slot.head;
+    if (head == nullptr || head->size == head->capacity) {
+      size_t cap = (head == nullptr)
+                       ? kInitSegCapacity
+                       : std::min(head->capacity * 2, kMaxSegCapacity);
+      head = alloc_segment(cap, head);
+      slot.head = head;
+    }
+    head->data()[head->size++] = v;
+  }
+
+  size_t size() const {
+    size_t total = 0;
+    for (int w = 0; w < n_slots; w++) {
+      for (segment* s = slots[w].head; s != nullptr; s = s->next) {
+        total += s->size;
+      }
+    }
+    return total;
+  }
+
+  // Applies f to every element in place; parallel over workers' chains and
+  // within each segment, so a bag filled by a single thread (e.g. a seed
+  // pass) still processes in parallel rather than serializing on one
+  // worker's chain.
+  template <class F>
+  void map(F f) {
+    parallel_for(0, n_slots, [&](size_t w) {
+      for (segment* s = slots[w].head; s != nullptr; s = s->next) {
+        parallel_for(0, s->size, [&](size_t i) {
+          f(s->data()[i]);
+        });
+      }
+    }, 1);
+  }
+
+  // Materializes a flat sequence (scan over per-worker totals + parallel
+  // copy of each chain into its slot); the bag is left empty.
+  sequence<T> to_sequence() {
+    auto offs = sequence<size_t>(n_slots + 1);
+    for (int w = 0; w < n_slots; w++) {
+      size_t ct = 0;
+      for (segment* s = slots[w].head; s != nullptr; s = s->next) {
+        ct += s->size;
+      }
+      offs[w] = ct;
+    }
+    offs[n_slots] = 0;
+    size_t total = scan_inplace(offs.slice(), addm<size_t>());
+    auto out = sequence<T>::no_init(total);
+    parallel_for(0, n_slots, [&](size_t w) {
+      size_t k = offs[w + 1];  // fill back-to-front per worker
+      for (segment* s = slots[w].head; s != nullptr; s = s->next) {
+        k -= s->size;
+        for (size_t i = 0; i < s->size; i++) {
+          out[k + i] = s->data()[i];
+        }
+      }
+    }, 1);
+    clear();
+    return out;
+  }
+
+  void clear() {
+    for (int w = 0; w < n_slots; w++) {
+      segment* s = slots[w].head;
+      while (s != nullptr) {
+        segment* next = s->next;
+        my_free(s);
+        s = next;
+      }
+      slots[w].head = nullptr;
+    }
+  }
+};
+
+}  // namespace pbbs
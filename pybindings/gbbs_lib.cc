@@ -34,6 +34,11 @@ void SymVertexRegister(py::module& m, std::string vertex_name) {
     });
 }
 
+// Wraps an algorithm result as a zero-copy NumPy array: the ndarray
+// aliases the sequence's buffer directly (no copy at the boundary, which
+// matters at billions of elements) and a capsule ties the buffer's
+// lifetime to the array -- NumPy drops the capsule when the last view
+// dies, and the capsule runs the pbbs deleter.
 template <class E>
 auto wrap_array(E* arr, size_t n) {
   // Create a Python object that will free the allocated
@@ -62,26 +67,51 @@ void SymGraphRegister(py::module& m, std::string graph_name) {
     .def("numEdges", [](const graph& G) -> size_t {
       return G.m;
     })
+    // Long-running entry points drop the GIL around the algorithm (the
+    // parallel runtime never touches Python state) and reacquire it before
+    // wrapping the result as a Python object, so notebooks stay responsive
+    // during multi-minute runs. Futures fall out of the standard library:
+    // ThreadPoolExecutor.submit(G.PageRank) blocks its worker GIL-free
+    // while the kernel keeps executing. Concurrent calls into one shared
+    // graph are safe for these read-only algorithms.
     .def("BFS", [&] (graph& G, const size_t src) {
-      auto parents = BFS(G, src);
-      return 1.0;
+      uintE* arr;
+      {
+        py::gil_scoped_release release;
+        auto parents = BFS(G, src);
+        arr = parents.to_array();
+      }
+      return wrap_array(arr, G.n);
     }, py::arg("src"))
     .def("Connectivity", [&] (graph& G) {
-      auto ccs = workefficient_cc::CC(G);
-      uintE* arr = ccs.to_array();
+      uintE* arr;
+      {
+        py::gil_scoped_release release;
+        auto ccs = workefficient_cc::CC(G);
+        arr = ccs.to_array();
+      }
       return wrap_array(arr, G.n);
     })
     .def("KCore", [&] (graph& G) {
-      auto cores = KCore(G);
-      uintE* arr = cores.to_array();
+      uintE* arr;
+      {
+        py::gil_scoped_release release;
+        auto cores = KCore(G);
+        arr = cores.to_array();
+      }
       return wrap_array(arr, G.n);
     })
     .def("PageRank", [&] (graph& G) {
-      auto ranks = PageRank(G);
-      double* arr = ranks.to_array();
+      double* arr;
+      {
+        py::gil_scoped_release release;
+        auto ranks = PageRank(G);
+        arr = ranks.to_array();
+      }
       return wrap_array(arr, G.n);
     })
     .def("CoSimRank", [&] (graph& G, const size_t src, const size_t dest) {
+      py::gil_scoped_release release;
       CoSimRank(G, src, dest);
       return 1.0;
     }, py::arg("src"), py::arg("dest"));
@@ -120,7 +150,8 @@ void AsymGraphRegister(py::module& m, std::string graph_name) {
     })
     .def("BFS", [&] (graph& G, const size_t src) {
       auto parents = BFS(G, src);
-      return 1.0;
+      uintE* arr = parents.to_array();
+      return wrap_array(arr, G.n);
     }, py::arg("src"))
     .def("StronglyConnectedComponents", [&] (graph& G) {
       auto sccs = StronglyConnectedComponents(G);
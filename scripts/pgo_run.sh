@@ -0,0 +1,32 @@
+#!/usr/bin/env bash
+# Runs a representative workload mix against an instrumented (PGO=gen)
+# build so the profiles in .pgo-profiles cover the code paths that matter:
+# traversal (BFS), peeling (KCore), and intersection (TriangleCounting)
+# over the bundled inputs (pass a bigger graph as $1 for real tuning runs).
+#
+# Flow:
+#   make -C benchmarks/BFS/NonDeterministicBFS clean && \
+#       make -C ... PGO=gen        # repeat per benchmark of interest
+#   ./scripts/pgo_run.sh [graph]
+#   make -C ... clean && make -C ... PGO=use
+set -eu
+cd "$(dirname "$0")/.."
+GRAPH="${1:-inputs/rMatGraph_J_5_100}"
+
+run() {
+  shift  # first arg is the benchmark directory, kept for readability
+  if [ -x "$1" ]; then
+    echo "# profiling: $*"
+    "$@" || true
+  else
+    echo "# skipping (not built with PGO=gen?): $1"
+  fi
+}
+
+run benchmarks/BFS/NonDeterministicBFS \
+    benchmarks/BFS/NonDeterministicBFS/BFS -s -src 0 -rounds 3 "$GRAPH"
+run benchmarks/KCore/JulienneDBS17 \
+    benchmarks/KCore/JulienneDBS17/KCore -s -rounds 3 "$GRAPH"
+run benchmarks/TriangleCounting/ShunTangwongsan15 \
+    benchmarks/TriangleCounting/ShunTangwongsan15/Triangle -s -rounds 3 "$GRAPH"
+echo "# profiles written to .pgo-profiles; rebuild with PGO=use"
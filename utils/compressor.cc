@@ -1,5 +1,7 @@
 #include "gbbs/encodings/byte_pd_amortized.h"
 #include "gbbs/gbbs.h"
+#include "utils/compression_writers.h"
+#include "gbbs/access_profile.h"
 #include "gbbs/io.h"
 #include "gbbs/parse_command_line.h"
 #include "pbbslib/utilities.h"
@@ -15,390 +17,100 @@
 
 namespace gbbs {
 
-  template <class Graph>
-  void write_graph_bytepd_amortized_directed(Graph& GA, std::ofstream& out) {
-    namespace encoding = bytepd_amortized;
-    using W = typename Graph::weight_type;
-    size_t n = GA.n;
-
-    // out-edges
-    // 1. Calculate total size
-    {
-      auto degrees = sequence<uintE>(n);
-      auto byte_offsets = sequence<uintT>(n+1);
-      par_for(0, n, [&] (size_t i) {
-        size_t total_bytes = 0;
-        uintE last_ngh = 0;
-        size_t deg = 0;
-        uchar tmp[16];
-        auto f = [&] (uintE u, uintE v, W w) {
-          long bytes = 0;
-          if ((deg % PARALLEL_DEGREE) == 0) {
-            bytes = encoding::compressFirstEdge(tmp, bytes, u, v);
-            bytes = encoding::compressWeight<W>(tmp, bytes, w);
-          } else {
-            bytes = encoding::compressEdge(tmp, bytes, v - last_ngh);
-            bytes = encoding::compressWeight<W>(tmp, bytes, w);
-          }
-          last_ngh = v;
-          total_bytes += bytes;
-          deg++;
-          return false;
-        };
-        GA.get_vertex(i).out_neighbors().map(f, false);
-
-        if (deg > 0) {
-          size_t n_chunks = 1+(deg-1)/PARALLEL_DEGREE;
-          // To account for the byte offsets
-          total_bytes += (n_chunks-1)*sizeof(uintE);
-          // To account for the per-block counters
-          total_bytes += (n_chunks)*sizeof(uintE);
-          // To account for the virtual degree
-          total_bytes += sizeof(uintE);
-        }
-
-        degrees[i] = deg;
-        byte_offsets[i] = total_bytes;
-      });
-      byte_offsets[n] = 0;
-      size_t total_space = pbbslib::scan_add_inplace(byte_offsets);
-      std::cout << "total in-space = " << total_space << std::endl;
-
-      // 2. Create compressed format in-memory
-      auto edges = sequence<uchar>(total_space);
-      par_for(0, n, [&] (size_t i) {
-        uintE deg = degrees[i];
-        if (deg > 0) {
-          auto it = GA.get_vertex(i).out_neighbors().get_iter();
-          size_t nbytes = encoding::sequentialCompressEdgeSet<W>(edges.begin() + byte_offsets[i], 0, deg, (uintE)i, it);
-          if (nbytes != (byte_offsets[i+1] - byte_offsets[i])) {
-            std::cout << "nbytes = " << nbytes << ". Should be: " << (byte_offsets[i+1] - byte_offsets[i]) << " deg = " << deg << " i = " << i << std::endl;
-            exit(0);
-          }
-          assert(nbytes == (byte_offsets[i+1] - byte_offsets[i]));
-        }
-      });
-      std::cout << "Compressed" << std::endl;
-
-      long* sizes = pbbslib::new_array_no_init<long>(3);
-      sizes[0] = GA.n;
-      sizes[1] = GA.m;
-      sizes[2] = total_space;
-      out.write((char*)sizes,sizeof(long)*3); //write n, m and space used
-      out.write((char*)byte_offsets.begin(),sizeof(uintT)*(n+1)); //write offsets
-      out.write((char*)degrees.begin(),sizeof(uintE)*n);
-      out.write((char*)edges.begin(),total_space); //write edges
-    }
-
-    {
-      // in-edges
-      // 1. Calculate total size
-      auto degrees = sequence<uintE>(n);
-      auto byte_offsets = sequence<uintT>(n+1);
-      par_for(0, n, [&] (size_t i) {
-        size_t total_bytes = 0;
-        uintE last_ngh = 0;
-        size_t deg = 0;
-        uchar tmp[16];
-        auto f = [&] (uintE u, uintE v, W w) {
-          long bytes = 0;
-          if ((deg % PARALLEL_DEGREE) == 0) {
-            bytes = encoding::compressFirstEdge(tmp, bytes, u, v);
-            bytes = encoding::compressWeight<W>(tmp, bytes, w);
-          } else {
-            bytes = encoding::compressEdge(tmp, bytes, v - last_ngh);
-            bytes = encoding::compressWeight<W>(tmp, bytes, w);
-          }
-          last_ngh = v;
-          total_bytes += bytes;
-          deg++;
-          return false;
-        };
-        GA.get_vertex(i).in_neighbors().map(f, false);
-
-        if (deg > 0) {
-          size_t n_chunks = 1+(deg-1)/PARALLEL_DEGREE;
-          // To account for the byte offsets
-          total_bytes += (n_chunks-1)*sizeof(uintE);
-          // To account for the per-block counters
-          total_bytes += (n_chunks)*sizeof(uintE);
-          // To account for the virtual degree
-          total_bytes += sizeof(uintE);
-        }
-
-        degrees[i] = deg;
-        byte_offsets[i] = total_bytes;
-      });
-      byte_offsets[n] = 0;
-      size_t total_space = pbbslib::scan_add_inplace(byte_offsets);
-      std::cout << "total in-space = " << total_space << std::endl;
-
-      // 2. Create compressed format in-memory
-      auto edges = sequence<uchar>(total_space);
-      par_for(0, n, [&] (size_t i) {
-        uintE deg = degrees[i];
-        if (deg > 0) {
-          auto it = GA.get_vertex(i).in_neighbors().get_iter();
-          size_t nbytes = encoding::sequentialCompressEdgeSet<W>(edges.begin() + byte_offsets[i], 0, deg, (uintE)i, it);
-          if (nbytes != (byte_offsets[i+1] - byte_offsets[i])) {
-            std::cout << "nbytes = " << nbytes << ". Should be: " << (byte_offsets[i+1] - byte_offsets[i]) << " deg = " << deg << " i = " << i << std::endl;
-            exit(0);
-          }
-          assert(nbytes == (byte_offsets[i+1] - byte_offsets[i]));
-        }
-      });
-      std::cout << "Compressed" << std::endl;
-      long inTotalSpace[1];
-      inTotalSpace[0] = total_space;
-      out.write((char*)inTotalSpace, sizeof(long)); // in-edges total space
-      out.write((char*)byte_offsets.begin(),sizeof(uintT)*(n+1)); //write offsets
-      out.write((char*)degrees.begin(),sizeof(uintE)*n);
-      out.write((char*)edges.begin(),total_space); //write edges
-    }
-  }
-
-  template <class Graph>
-  void write_graph_bytepd_amortized_format(Graph& GA, std::ofstream& out, bool symmetric) {
-    namespace encoding = bytepd_amortized;
-    using W = typename Graph::weight_type;
-    if (!symmetric) {
-      write_graph_bytepd_amortized_directed(GA, out);
-      return;
-    }
-    size_t n = GA.n;
-
-//    auto xors = sequence<size_t>(n);
-//    parallel_for(size_t i=0; i<n; i++) {
-//      size_t xr = 0;
-//      auto map_f = wrap_f<W>([&] (uintE src, uintE ngh) {
-//        xr ^= (src ^ ngh);
-//      });
-//      GA.V[i].mapOutNgh(i, map_f, false);
-//      xors[i] = xr;
-//    }
-//    std::cout << "input graph: output red = " << pbbslib::reduce_xor(xors) << std::endl;
-//
-//  auto hash_or_lt = [&] (const uintE& src, const uintE& ngh) {
-//    uint32_t src_h = pbbslib::hash32(src);
-//    uint32_t ngh_h = pbbslib::hash32(ngh);
-//    return (src_h < ngh_h) || ((src_h == ngh_h) && src < ngh);
-//  };
-
-
-//    auto self_arr = sequence<size_t>(n);
-//    parallel_for(size_t i=0; i<n; i++) {
-//      uintE our_deg = pbbslib::log2_up(GA.V[i].getOutDegree());
-//      bool selfl = false;
-//      size_t pri = 0;
-//      auto map_f = wrap_f<W>([&] (uintE src, uintE ngh) {
-//        uintE ngh_deg = pbbslib::log2_up(GA.V[ngh].getOutDegree());
-//        if (src == ngh) {
-//          selfl = true;
-//        }
-//        if ((ngh_deg > our_deg) || ((ngh_deg == our_deg) && hash_or_lt(src, ngh))) {
-//          pri++;
-//        }
-//      });
-//      GA.V[i].mapOutNgh(i, map_f, false);
-//      self_arr[i] = selfl;
-//      xors[i] = pri;
-//    }
-//    std::cout << "input graph: priorities = " << pbbslib::reduce_add(xors) << std::endl;
-//    std::cout << "input graph: self-loops = " << pbbslib::reduce_add(self_arr) << std::endl;
-
-//    parallel_for(size_t i=0; i<n; i++) {
-//      uintE our_deg = pbbslib::log2_up(GA.V[i].getOutDegree());
-//      bool selfl = false;
-//      size_t pri = 0;
-//      auto it = GA.V[i].getOutIter(i);
-//      size_t d = 0;
-//      size_t degree = GA.V[i].getOutDegree();
-//      uintE src = i;
-//      if (degree > 0) {
-//        uintE ngh = get<0>(it.cur());
-//        if (src == ngh) { selfl = true; }
-//        uintE ngh_deg = pbbslib::log2_up(GA.V[ngh].getOutDegree());
-//        if ((ngh_deg > our_deg) || ((ngh_deg == our_deg) && hash_or_lt(src, ngh))) {
-//          pri++;
-//        }
-//        for (size_t i=1; i<degree; i++) {
-//          ngh = get<0>(it.next());
-//          ngh_deg = pbbslib::log2_up(GA.V[ngh].getOutDegree());
-//          if (src == ngh) { selfl = true; }
-//          if ((ngh_deg > our_deg) || ((ngh_deg == our_deg) && hash_or_lt(src, ngh))) {
-//            pri++;
-//          }
-//        }
-//      }
-//      self_arr[i] = selfl;
-//      xors[i] = pri;
-//    }
-//    std::cout << "input graph: priorities = " << pbbslib::reduce_add(xors) << std::endl;
-//    std::cout << "input graph: self-loops = " << pbbslib::reduce_add(self_arr) << std::endl;
-
-
-    // 1. Calculate total size
-    auto degrees = sequence<uintE>(n);
-    auto byte_offsets = sequence<uintT>(n+1);
-    par_for(0, n, [&] (size_t i) {
-      size_t total_bytes = 0;
-      uintE last_ngh = 0;
-      size_t deg = 0;
-      uchar tmp[16];
-      auto f = [&] (uintE u, uintE v, W w) {
-//        if (u == v) {
-//          return;
-//        }
-        long bytes = 0;
-        if ((deg % PARALLEL_DEGREE) == 0) {
-          bytes = encoding::compressFirstEdge(tmp, bytes, u, v);
-          bytes = encoding::compressWeight<W>(tmp, bytes, w);
-        } else {
-          bytes = encoding::compressEdge(tmp, bytes, v - last_ngh);
-          bytes = encoding::compressWeight<W>(tmp, bytes, w);
-        }
-        last_ngh = v;
-        total_bytes += bytes;
-        deg++;
-      };
-      GA.get_vertex(i).out_neighbors().map(f, false);
-
-      if (deg > 0) {
-        size_t n_chunks = 1+(deg-1)/PARALLEL_DEGREE;
-        // To account for the byte offsets
-        total_bytes += (n_chunks-1)*sizeof(uintE);
-        // To account for the per-block counters
-        total_bytes += (n_chunks)*sizeof(uintE);
-        // To account for the virtual degree
-        total_bytes += sizeof(uintE);
-      }
-
-      degrees[i] = deg;
-      byte_offsets[i] = total_bytes;
-    });
-    byte_offsets[n] = 0;
-    size_t total_space = pbbslib::scan_add_inplace(byte_offsets);
-    std::cout << "total space = " << total_space << std::endl;
-    auto deg_f = [&] (size_t i) { return degrees[i]; };
-    auto deg_im = pbbslib::make_sequence<size_t>(n, deg_f);
-    std::cout << "sum degs = " << pbbslib::reduce_add(deg_im) << std::endl;
-
-    // 2. Create compressed format in-memory
-    auto edges = sequence<uchar>(total_space);
-    par_for(0, n, [&] (size_t i) {
-      uintE deg = degrees[i];
-      if (deg > 0) {
-        auto it = GA.get_vertex(i).out_neighbors().get_iter();
-        size_t nbytes = encoding::sequentialCompressEdgeSet<W>(edges.begin() + byte_offsets[i], 0, deg, (uintE)i, it);
-
-//        uchar* edgeArray = edges.begin() + byte_offsets[i];
-//        size_t degree = deg;
-//
-//        size_t current_offset = 0;
-//        size_t num_blocks = 1+(degree-1)/PARALLEL_DEGREE;
-//        uintE* vertex_ctr = (uintE*)edgeArray;
-//        *vertex_ctr = degree;
-//
-//        uintE* block_offsets = (uintE*)(edgeArray + sizeof(uintE));
-//        current_offset += sizeof(uintE) + (num_blocks-1)*sizeof(uintE); // virtual deg + block_offs
-//
-//        size_t proc = 0;
-//        size_t cur_block = 0;
-//        uintE* prev_block_deg = nullptr;
-//        uintE last_ngh;
-//        auto map_f = [&] (uintE u, uintE v, W w) {
-//          if ((proc % PARALLEL_DEGREE) == 0) {
-//            if (cur_block > 0) {
-//              assert(*prev_block_deg == 0);
-//              *prev_block_deg = PARALLEL_DEGREE; // full block; write prev block's degree
-//              block_offsets[cur_block-1] = current_offset; // write start of this block
-//            }
-//            prev_block_deg = (uintE*)(edgeArray + current_offset);
-//            *prev_block_deg = 0;
-//            current_offset += sizeof(uintE);
-//            current_offset = compressFirstEdge(edgeArray, current_offset, u, v);
-//            current_offset = compressWeight<W>(edgeArray, current_offset, w);
-//            cur_block++;
-//          } else {
-//            current_offset = compressEdge(edgeArray, current_offset, v - last_ngh);
-//            current_offset = compressWeight<W>(edgeArray, current_offset, w);
-//          }
-//          last_ngh = v;
-//          proc++;
-//        };
-//
-//        GA.V[i].mapOutNgh(i, map_f, false);
-//
-//        assert(prev_block_deg != nullptr);
-//        assert(*prev_block_deg == 0);
-//        *prev_block_deg = deg % PARALLEL_DEGREE;
-//
-//        assert(current_offset == (byte_offsets[i+1] - byte_offsets[i]));
-
-        if (nbytes != (byte_offsets[i+1] - byte_offsets[i])) {
-          std::cout << "nbytes = " << nbytes << ". Should be: " << (byte_offsets[i+1] - byte_offsets[i]) << " deg = " << deg << " i = " << i << std::endl;
-          exit(0);
-        }
-        assert(nbytes == (byte_offsets[i+1] - byte_offsets[i]));
-      }
-    });
-    std::cout << "Compressed" << std::endl;
-//    exit(0);
-
-//    parallel_for(size_t i=0; i<n; i++) {
-//      size_t xr = 0;
-//      auto map_f = [&] (uintE src, uintE ngh, const W& wgh, size_t off) {
-//        xr ^= (src ^ ngh);
-//        return true;
-//      };
-//      auto edge_start= edges.begin() + byte_offsets[i];
-//      size_t deg = degrees[i];
-//      if (deg > 0) {
-//        bytepd_amortized::decode<W>(map_f, edge_start, i, deg, false);
-//      }
-//      xors[i] = xr;
-//    }
-//    std::cout << "output graph: output red = " << pbbslib::reduce_xor(xors) << std::endl;
-
-//    parallel_for(size_t i=0; i<n; i++) {
-//      assert(degrees[i] == GA.V[i].getOutDegree());
-//      uintE our_deg = pbbslib::log2_up(degrees[i]);
-//      bool selfl = false;
-//      size_t pri = 0;
-//      auto map_f = [&] (uintE src, uintE ngh, const W& wgh, size_t off) {
-//        uintE ngh_deg = pbbslib::log2_up(degrees[ngh]);
-//        if (src == ngh) {
-//          selfl = true;
-//        }
-//        if ((ngh_deg > our_deg) || ((ngh_deg == our_deg) && hash_or_lt(src, ngh))) {
-//          pri++;
-//        }
-//        return true;
-//      };
-//      auto edge_start= edges.begin() + byte_offsets[i];
-//      size_t deg = degrees[i];
-//      if (deg > 0) {
-//        bytepd_amortized::decode<W>(map_f, edge_start, i, deg, false);
-//      }
-//      self_arr[i] = selfl;
-//      xors[i] = pri;
-//    }
-//    std::cout << "output graph: priorities = " << pbbslib::reduce_add(xors) << std::endl;
-//    std::cout << "output graph: self-loops = " << pbbslib::reduce_add(self_arr) << std::endl;
+// Computes the access-frequency relabeling from a saved access profile
+// (gbbs/access_profile.h): hot vertices pack together at the front, so a
+// skewed serving working set occupies a contiguous prefix of the edge
+// array instead of scattering across it.
+template <class Graph>
+sequence<uintE> profile_order_permutation(Graph& GA,
+                                          const sequence<size_t>& counts) {
+  size_t n = GA.n;
+  auto vtxs = sequence<uintE>(n, [&](size_t i) { return (uintE)i; });
+  auto cmp = [&](const uintE& a, const uintE& b) {
+    return counts[a] > counts[b] || (counts[a] == counts[b] && a < b);
+  };
+  pbbslib::sample_sort_inplace(vtxs.slice(), cmp);
+  auto perm = sequence<uintE>(n);
+  par_for(0, n, [&](size_t r) { perm[vtxs[r]] = (uintE)r; });
+  return perm;
+}
 
+// Computes the decreasing-degree relabeling: perm[i] is the new id of
+// vertex i. High-degree vertices are packed together at the front, which
+// concentrates the hot part of the edge array in cache.
+template <class Graph>
+sequence<uintE> degree_order_permutation(Graph& GA) {
+  size_t n = GA.n;
+  auto vtxs = sequence<uintE>(n, [&](size_t i) { return (uintE)i; });
+  auto cmp = [&](const uintE& a, const uintE& b) {
+    uintE da = GA.get_vertex(a).out_degree();
+    uintE db = GA.get_vertex(b).out_degree();
+    return (da > db) || (da == db && a < b);  // stable on ties
+  };
+  pbbs::sample_sort_inplace(vtxs.slice(), cmp);
+  auto perm = sequence<uintE>(n);
+  par_for(0, n, [&](size_t r) { perm[vtxs[r]] = r; });
+  return perm;
+}
 
-//    exit(0);
+// Relabels GA by perm into a fresh uncompressed symmetric graph whose
+// adjacency lists are re-sorted by the new ids.
+template <class Graph>
+auto reorder_graph(Graph& GA, sequence<uintE>& perm) {
+  using W = typename Graph::weight_type;
+  using edge_type = std::tuple<uintE, W>;
+  size_t n = GA.n, m = GA.m;
+
+  auto offs = sequence<uintT>(n + 1);
+  par_for(0, n, [&](size_t i) {
+    offs[perm[i]] = GA.get_vertex(i).out_degree();
+  });
+  offs[n] = 0;
+  pbbslib::scan_add_inplace(offs.slice());
+
+  auto edges = pbbs::new_array_no_init<edge_type>(m);
+  parallel_for(0, n, [&](size_t i) {
+    size_t off = offs[perm[i]];
+    size_t k = off;
+    auto map_f = [&](const uintE& src, const uintE& ngh, const W& wgh) {
+      edges[k++] = std::make_tuple(perm[ngh], wgh);
+    };
+    GA.get_vertex(i).out_neighbors().map(map_f, false);
+    std::sort(edges + off, edges + k,
+              [](const edge_type& l, const edge_type& r) {
+                return std::get<0>(l) < std::get<0>(r);
+              });
+  }, 1);
+
+  auto v_data = pbbs::new_array_no_init<vertex_data>(n);
+  par_for(0, n, [&](size_t i) {
+    v_data[i].offset = offs[i];
+    v_data[i].degree = offs[i + 1] - offs[i];
+  });
+  return symmetric_graph<symmetric_vertex, W>(
+      v_data, n, m,
+      [v_data, edges]() {
+        pbbslib::free_array(v_data);
+        pbbslib::free_array(edges);
+      },
+      edges);
+}
 
-    long* sizes = pbbslib::new_array_no_init<long>(3);
-    sizes[0] = GA.n;
-    sizes[1] = GA.m;
-    sizes[2] = total_space;
-    out.write((char*)sizes,sizeof(long)*3); //write n, m and space used
-    out.write((char*)byte_offsets.begin(),sizeof(uintT)*(n+1)); //write offsets
-    out.write((char*)degrees.begin(),sizeof(uintE)*n);
-    out.write((char*)edges.begin(),total_space); //write edges
-    out.close();
+// Writes the permutation (new id per original vertex) so downstream
+// consumers can map results back to the original ids; read with
+// gbbs_io::read_permutation.
+inline void write_permutation(sequence<uintE>& perm,
+                              const std::string& outfile) {
+  std::ofstream pf(outfile, std::ofstream::out | std::ios::binary);
+  if (!pf.is_open()) {
+    std::cout << "Unable to open permutation file: " << outfile << std::endl;
+    exit(0);
   }
+  long n = perm.size();
+  pf.write((char*)&n, sizeof(long));
+  pf.write((char*)perm.begin(), sizeof(uintE) * n);
+  pf.close();
+}
 
 template <class Graph>
 double converter(Graph& GA, commandLine P) {
@@ -411,13 +123,67 @@ double converter(Graph& GA, commandLine P) {
   }
   std::ofstream out(outfile.c_str(), std::ofstream::out | std::ios::binary);
   auto encoding = P.getOptionValue("-enc", "bytepd-amortized");
+  auto reorder = P.getOptionValue("-reorder", "");
+
+  long n_ranges = P.getOptionLongValue("-ranges", 0);
 
   if (encoding == "bytepd-amortized") {
-    write_graph_bytepd_amortized_format(GA, out, symmetric);
+    if (n_ranges > 1) {
+      if (!symmetric) {
+        std::cout << "-ranges currently requires a symmetric input"
+                  << std::endl;
+        exit(0);
+      }
+      write_graph_bytepd_amortized_ranges(GA, out, (size_t)n_ranges);
+    } else if (reorder == "profile") {
+      if (!symmetric) {
+        std::cout << "-reorder currently requires a symmetric input"
+                  << std::endl;
+        exit(0);
+      }
+      auto profile_f = P.getOptionValue("-profile-file", "");
+      auto counts = access_profiler::load(profile_f, GA.n);
+      if (counts.size() != GA.n) {
+        std::cout << "Could not load access profile (wrong n or missing): "
+                  << profile_f << std::endl;
+        exit(0);
+      }
+      auto perm = profile_order_permutation(GA, counts);
+      write_permutation(perm, outfile + ".perm");
+      auto RG = reorder_graph(GA, perm);
+      write_graph_bytepd_amortized_format(RG, out, symmetric);
+      RG.del();
+    } else if (reorder == "degree") {
+      if (!symmetric) {
+        std::cout << "-reorder currently requires a symmetric input"
+                  << std::endl;
+        exit(0);
+      }
+      auto perm = degree_order_permutation(GA);
+      write_permutation(perm, outfile + ".perm");
+      auto RG = reorder_graph(GA, perm);
+      write_graph_bytepd_amortized_format(RG, out, symmetric);
+      RG.del();
+    } else if (reorder != "") {
+      std::cout << "Unknown reordering: " << reorder << std::endl;
+      exit(0);
+    } else {
+      write_graph_bytepd_amortized_format(GA, out, symmetric);
+    }
   } else {
     std::cout << "Unknown encoding: " << encoding << std::endl;
     exit(0);
   }
+  {
+    // degree-histogram side file: load-time policy decisions on the
+    // compressed graph skip their O(n) degree scans
+    using graph_t = typename std::remove_reference<decltype(GA)>::type;
+    auto hist = GA.degree_histogram();
+    std::ofstream hout(outfile + ".dhist",
+                       std::ofstream::out | std::ios::binary);
+    hout.write((const char*)hist,
+               graph_t::kDegreeHistBuckets * sizeof(uint64_t));
+  }
   std::cout << "Finished converting." << std::endl;
   exit(0);
   return 0;
@@ -1,4 +1,5 @@
 #include "rmat.h"
+#include "in_memory.h"
 
 #include "gbbs/gbbs.h"
 #include "pbbslib/strings/string_basics.h"
@@ -20,6 +21,24 @@ int BuildRMAT(int argc, char* argv[]) {
 
   auto out_f = P.getOptionValue("-outfile", "");
 
+  if (P.getOptionValue("-inmem")) {
+    // build the graph directly in memory (no edge-list file) and report
+    // its shape; the library entry point is generators::rmat_graph
+    uintE seed = P.getOptionLongValue("-seed", 4);
+    timer t; t.start();
+    auto G = generators::rmat_graph(n, m, seed, a, b, c);
+    double tt = t.stop();
+    size_t max_deg = 0;
+    for (size_t i = 0; i < G.n; i++) {
+      max_deg = std::max<size_t>(max_deg, G.get_vertex(i).out_degree());
+    }
+    std::cout << "built in-memory rmat: n = " << G.n << " m = " << G.m
+              << " max_degree = " << max_deg << " build time = " << tt
+              << std::endl;
+    G.del();
+    return 0;
+  }
+
   if (out_f == "") {
     std::cout << "specify a valid outfile using -outfile" << std::endl;
     abort();
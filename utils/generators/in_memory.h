@@ -0,0 +1,156 @@
+// This code is part of the project "Theoretically Efficient Parallel Graph
+// Algorithms Can Be Fast and Scalable", presented at Symposium on Parallelism
+// in Algorithms and Architectures, 2018.
+// Copyright (c) 2018 Laxman Dhulipala, Guy Blelloch, and Julian Shun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all  copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Direct in-memory construction of symmetric graphs from synthetic edge
+// generators -- no edge-list file and no materialized tuple array. The
+// edge stream is a pure function of (seed, index), so the builder makes
+// two generation passes instead of materialize-and-sort: a counting pass
+// histograms endpoint degrees, and a scatter pass regenerates each edge
+// into its final CSR slot (adjacency lists are then sorted per vertex).
+// Peak memory is the output graph plus one counter per vertex, and the
+// result is deterministic at any parallelism. RMAT reuses the recursive
+// quadrant generator from rmat.h; the preferential-attachment builder
+// wraps barabasi_albert.h's update stream (whose later edges index into
+// earlier ones, so it materializes its pair list as before); the
+// SSCA-style generator produces uniform cliques plus random inter-clique
+// edges, both index-addressable.
+
+#pragma once
+
+#include <algorithm>
+
+#include "gbbs/gbbs.h"
+#include "gbbs/graph.h"
+#include "barabasi_albert.h"
+#include "rmat.h"
+
+namespace gbbs {
+namespace generators {
+
+// Builds a symmetric graph from m directed edge draws (both directions are
+// added). gen(i) must be a pure function of i returning
+// std::tuple<uintE, uintE> with endpoints below n.
+template <class EdgeGen>
+inline symmetric_graph<symmetric_vertex, pbbs::empty>
+graph_from_edge_generator(size_t n, size_t m, EdgeGen gen) {
+  using edge_type = typename symmetric_vertex<pbbs::empty>::edge_type;
+
+  // 1. counting pass
+  auto counts = sequence<uintT>(n + 1, (uintT)0);
+  parallel_for(0, m, [&](size_t i) {
+    auto e = gen(i);
+    pbbs::fetch_and_add(&counts[std::get<0>(e)], (uintT)1);
+    pbbs::fetch_and_add(&counts[std::get<1>(e)], (uintT)1);
+  });
+  size_t total = pbbslib::scan_add_inplace(counts.slice());
+  assert(total == 2 * m);
+
+  // 2. scatter pass: regenerate and bump-allocate into CSR slots
+  auto slots = sequence<uintT>(n, [&](size_t i) { return counts[i]; });
+  auto edges = pbbs::new_array_no_init<edge_type>(total);
+  parallel_for(0, m, [&](size_t i) {
+    auto e = gen(i);
+    uintE u = std::get<0>(e), v = std::get<1>(e);
+    edges[pbbs::fetch_and_add(&slots[u], (uintT)1)] =
+        std::make_tuple(v, pbbs::empty());
+    edges[pbbs::fetch_and_add(&slots[v], (uintT)1)] =
+        std::make_tuple(u, pbbs::empty());
+  });
+
+  // 3. sort each adjacency list (scatter order is nondeterministic; the
+  // sorted lists are not)
+  parallel_for(0, n, [&](size_t i) {
+    std::sort(edges + counts[i], edges + counts[i + 1],
+              [](const edge_type& a, const edge_type& b) {
+                return std::get<0>(a) < std::get<0>(b);
+              });
+  }, 1);
+
+  auto v_data = pbbs::new_array_no_init<vertex_data>(n);
+  parallel_for(0, n, [&](size_t i) {
+    v_data[i].offset = counts[i];
+    v_data[i].degree = (uintE)(counts[i + 1] - counts[i]);
+  });
+  return symmetric_graph<symmetric_vertex, pbbs::empty>(
+      v_data, n, total, [=]() { pbbslib::free_arrays(v_data, edges); },
+      edges);
+}
+
+// RMAT graph, built directly: n rounds up to a power of two.
+inline symmetric_graph<symmetric_vertex, pbbs::empty> rmat_graph(
+    size_t n, size_t m, uintE seed = 4, double a = 0.5, double b = 0.1,
+    double c = 0.1) {
+  uintE nn = 1 << pbbs::log2_up(n);
+  auto g = rmat::rMat_gen(nn, seed, a, b, c);
+  return graph_from_edge_generator(nn, m, [&](size_t i) { return g((uintE)i); });
+}
+
+// Preferential attachment. The Barabasi-Albert update stream resolves
+// later edges against earlier ones, so the pair list materializes (as in
+// barabasi_albert.h); the graph is still built without touching disk.
+inline symmetric_graph<symmetric_vertex, pbbs::empty> barabasi_albert_graph(
+    size_t n, size_t edges_per_node) {
+  auto E = barabasi_albert::generate_updates(n, edges_per_node);
+  size_t m = E.size();
+  return graph_from_edge_generator(n, m, [&](size_t i) {
+    return std::make_tuple((uintE)E[i].first, (uintE)E[i].second);
+  });
+}
+
+// SSCA-style clustered graph: n vertices in uniform cliques of size k
+// (complete within the clique), plus inter_edges random clique-bridging
+// edges. Edge i < intra count decodes a (clique, pair) index; the rest
+// draw hashed endpoints from two distinct cliques.
+inline symmetric_graph<symmetric_vertex, pbbs::empty> ssca_graph(
+    size_t n, size_t clique_size, size_t inter_edges, uintE seed = 1) {
+  size_t k = std::max<size_t>(clique_size, 2);
+  size_t num_cliques = n / k;
+  n = num_cliques * k;
+  size_t pairs_per_clique = k * (k - 1) / 2;
+  size_t intra = num_cliques * pairs_per_clique;
+  size_t h = pbbs::hash64(seed);
+
+  auto gen = [=](size_t i) -> std::tuple<uintE, uintE> {
+    if (i < intra) {
+      size_t c = i / pairs_per_clique;
+      size_t p = i % pairs_per_clique;
+      // decode the p-th pair (row-major over the strict upper triangle)
+      size_t row = 0, acc = k - 1;
+      while (p >= acc) { p -= acc; row++; acc = k - 1 - row; }
+      uintE u = (uintE)(c * k + row);
+      uintE v = (uintE)(c * k + row + 1 + p);
+      return std::make_tuple(u, v);
+    }
+    size_t j = i - intra;
+    size_t c1 = pbbs::hash64(h + 2 * j) % num_cliques;
+    size_t c2 = pbbs::hash64(h + 2 * j + 1) % num_cliques;
+    if (c2 == c1) c2 = (c1 + 1) % num_cliques;
+    uintE u = (uintE)(c1 * k + pbbs::hash64(h ^ (3 * j + 1)) % k);
+    uintE v = (uintE)(c2 * k + pbbs::hash64(h ^ (3 * j + 2)) % k);
+    return std::make_tuple(u, v);
+  };
+  return graph_from_edge_generator(n, intra + inter_edges, gen);
+}
+
+}  // namespace generators
+}  // namespace gbbs
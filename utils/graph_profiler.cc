@@ -0,0 +1,158 @@
+// Computes a tuning report for a graph: degree distribution, an effective
+// diameter estimate, a sampled clustering coefficient, per-encoding
+// compression ratio estimates, and suggested parameters for the Julienne
+// apps (-nb) and DeltaStepping (-delta). Replaces the folklore behind
+// choosing encodings and thresholds per graph.
+//
+// Usage: ./graph_profiler -s [-m] [-c] graph
+
+#include "gbbs/encodings/byte_pd_amortized.h"
+#include "gbbs/encodings/byte.h"
+#include "gbbs/gbbs.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace gbbs {
+
+template <class Graph>
+double profiler(Graph& GA, commandLine P) {
+  using W = typename Graph::weight_type;
+  size_t n = GA.n, m = GA.m;
+  std::cout << "### Graph profile: " << P.getArgument(0) << std::endl;
+  std::cout << "n = " << n << ", m = " << m
+            << ", avg degree = " << (double)m / n << std::endl;
+
+  // 1. degree distribution
+  auto degs = sequence<uintE>(n, [&](size_t i) {
+    return GA.get_vertex(i).out_degree();
+  });
+  auto sorted = sequence<uintE>(degs);
+  pbbs::sample_sort_inplace(sorted.slice(), std::less<uintE>());
+  auto pct = [&](double p) { return sorted[(size_t)(p * (n - 1))]; };
+  std::cout << "degree percentiles: p50 = " << pct(0.5)
+            << " p90 = " << pct(0.9) << " p99 = " << pct(0.99)
+            << " max = " << sorted[n - 1] << std::endl;
+  double skew = (double)sorted[n - 1] / std::max(1.0, (double)m / n);
+
+  // 2. effective diameter estimate: truncated BFS from a heavy vertex
+  uintE src = 0; size_t best = 0;
+  for (size_t s = 0; s < 64; s++) {
+    uintE v = (uintE)(pbbs::hash64(s) % n);
+    if (degs[v] > best) { best = degs[v]; src = v; }
+  }
+  auto parents = sequence<uintE>(n, (uintE)UINT_E_MAX);
+  parents[src] = src;
+  struct BFS_F {
+    uintE* P;
+    BFS_F(uintE* P) : P(P) {}
+    inline bool update(uintE s, uintE d, W w) {
+      if (P[d] == UINT_E_MAX) { P[d] = s; return 1; }
+      return 0;
+    }
+    inline bool updateAtomic(uintE s, uintE d, W w) {
+      return pbbslib::atomic_compare_and_swap(&P[d], UINT_E_MAX, s);
+    }
+    inline bool cond(uintE d) { return P[d] == UINT_E_MAX; }
+  };
+  auto frontier = vertexSubset(n, src);
+  size_t rounds = 0, covered = 1;
+  size_t round_90 = 0;
+  while (!frontier.isEmpty() && rounds < 512) {
+    frontier = edgeMap(GA, frontier, BFS_F(parents.begin()), -1);
+    covered += frontier.size();
+    rounds++;
+    if (round_90 == 0 && covered >= (9 * n) / 10) round_90 = rounds;
+  }
+  std::cout << "BFS rounds from a heavy vertex = " << rounds
+            << " (effective diameter estimate; 90% reached at round "
+            << (round_90 ? round_90 : rounds) << ")" << std::endl;
+
+  // 3. sampled clustering coefficient (wedge closure over sampled centers)
+  size_t closed = 0, wedges = 0;
+  for (size_t s = 0; s < 2000; s++) {
+    uintE v = (uintE)(pbbs::hash64(s * 7 + 1) % n);
+    auto vtx = GA.get_vertex(v);
+    uintE d = vtx.out_degree();
+    if (d < 2) continue;
+    auto nghs = vtx.out_neighbors();
+    uintE a = nghs.get_neighbor(pbbs::hash64(s * 3 + 1) % d);
+    uintE b = nghs.get_neighbor(pbbs::hash64(s * 5 + 2) % d);
+    if (a == b) continue;
+    wedges++;
+    auto a_nghs = GA.get_vertex(a).out_neighbors();
+    uintE da = GA.get_vertex(a).out_degree();
+    for (uintE j = 0; j < da; j++) {
+      if (a_nghs.get_neighbor(j) == b) { closed++; break; }
+    }
+  }
+  double cc = wedges ? (double)closed / wedges : 0.0;
+  std::cout << "sampled clustering coefficient = " << cc << " ("
+            << wedges << " wedges)" << std::endl;
+
+  // 4. compression estimates: byte vs byte_pd_amortized sizes from the
+  // same sizing arithmetic the converter uses
+  auto sizes = sequence<std::pair<size_t, size_t>>(n);
+  parallel_for(0, n, [&](size_t i) {
+    size_t byte_bytes = 0, bytepda_bytes = 0;
+    uintE last = 0; size_t deg = 0;
+    uchar tmp[16];
+    auto f = [&](uintE u, uintE v, W w) {
+      if (deg == 0) {
+        byte_bytes += byte::compressFirstEdge(tmp, 0, u, v);
+      } else {
+        byte_bytes += byte::compressEdge(tmp, 0, v - last);
+      }
+      if ((deg % PARALLEL_DEGREE) == 0) {
+        bytepda_bytes += bytepd_amortized::compressFirstEdge(tmp, 0, u, v);
+      } else {
+        bytepda_bytes += bytepd_amortized::compressEdge(tmp, 0, v - last);
+      }
+      last = v; deg++;
+      return false;
+    };
+    GA.get_vertex(i).out_neighbors().map(f, false);
+    if (deg > 0) {
+      size_t blocks = 1 + (deg - 1) / PARALLEL_DEGREE;
+      bytepda_bytes += (2 * blocks) * sizeof(uintE);
+    }
+    sizes[i] = {byte_bytes, bytepda_bytes};
+  }, 1);
+  size_t byte_total = 0, bytepda_total = 0;
+  for (size_t i = 0; i < n; i++) {
+    byte_total += sizes[i].first;
+    bytepda_total += sizes[i].second;
+  }
+  double csr_bytes = (double)m * sizeof(uintE);
+  std::cout << "compression: CSR = " << csr_bytes / (1 << 20)
+            << " MB, byte = " << byte_total / double(1 << 20)
+            << " MB (" << byte_total / csr_bytes << "x), byte_pd_amortized = "
+            << bytepda_total / double(1 << 20) << " MB ("
+            << bytepda_total / csr_bytes << "x)" << std::endl;
+
+  // 5. suggestions
+  size_t suggested_nb =
+      std::max<size_t>(16, size_t{1} << pbbslib::log2_up(
+          (size_t)(pbbs::log2_up(sorted[n - 1] + 2))));
+  std::cout << "suggested -nb (Julienne apps) = " << suggested_nb
+            << " (max degree " << sorted[n - 1] << ")" << std::endl;
+  double best_ratio = std::min(byte_total, bytepda_total) / csr_bytes;
+  if (best_ratio >= 0.8) {
+    std::cout << "suggested encoding = uncompressed CSR "
+                 "(compression gain marginal)" << std::endl;
+  } else if (sorted[n - 1] > PARALLEL_DEGREE || skew > 8) {
+    std::cout << "suggested encoding = byte_pd_amortized "
+                 "(compresses well; hubs need parallel blocks)" << std::endl;
+  } else {
+    std::cout << "suggested encoding = byte "
+                 "(compresses well; degrees small enough for single blocks)"
+              << std::endl;
+  }
+  std::cout << "DeltaStepping: use -delta 0 (auto-tuned from a weight sample)"
+            << std::endl;
+  return 0.0;
+}
+
+}  // namespace gbbs
+
+generate_symmetric_main(gbbs::profiler, false);
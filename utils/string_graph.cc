@@ -0,0 +1,148 @@
+// Builds a document-similarity graph from a text corpus in one process:
+// corpus -> parallel suffix array (pbbslib/strings/suffix_array.h) -> LCP
+// (pbbslib/strings/lcp.h) -> overlap edges -> sym_graph_from_edges, with no
+// intermediate edge-list files. Documents are the lines of the input; two
+// documents get an edge when suffix-array-adjacent suffixes from different
+// documents share a common prefix of at least -minlcp characters (clamped
+// at the document boundary so matches never span the separator).
+// SA-adjacent pairs within a long shared run chain the whole run together,
+// so connected components of the overlap graph are the near-duplicate
+// clusters -- reported directly via the work-efficient connectivity.
+//
+// Usage: ./string_graph -i corpus.txt [-minlcp 16] [-clusters-out f]
+
+#include <cassert>
+
+#include "gbbs/gbbs.h"
+#include "gbbs/graph.h"
+#include "benchmarks/Connectivity/WorkEfficientSDB14/Connectivity.h"
+#include "pbbslib/semisort.h"
+#include "pbbslib/strings/lcp.h"
+#include "pbbslib/strings/suffix_array.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace gbbs {
+
+int string_graph_main(int argc, char* argv[]) {
+  commandLine P(argc, argv, "-i <corpus> [-minlcp 16] [-clusters-out f]");
+  std::string in_f = P.getOptionValue("-i", "");
+  size_t min_lcp = (size_t)P.getOptionLongValue("-minlcp", 16);
+  if (in_f == "") {
+    std::cout << "specify an input corpus with -i" << std::endl;
+    return 1;
+  }
+
+  // 1. read documents (one per line) into one separator-joined text
+  std::ifstream in(in_f);
+  std::vector<size_t> doc_start;
+  std::vector<unsigned char> text;
+  std::string line;
+  while (std::getline(in, line)) {
+    doc_start.push_back(text.size());
+    for (char c : line) text.push_back((unsigned char)c);
+    text.push_back(1);  // separator (matches clamp at doc boundaries below)
+  }
+  size_t num_docs = doc_start.size();
+  size_t len = text.size();
+  std::cout << "# corpus: " << num_docs << " documents, " << len
+            << " bytes" << std::endl;
+  if (num_docs == 0) return 0;
+
+  auto S = pbbs::sequence<unsigned char>(len, [&](size_t i) {
+    return text[i];
+  });
+
+  // per-position document id and distance to the document's end
+  auto doc_of = pbbs::sequence<uintE>(len);
+  auto doc_end = pbbs::sequence<size_t>(len);
+  parallel_for(0, num_docs, [&](size_t d) {
+    size_t s = doc_start[d];
+    size_t e = (d + 1 < num_docs) ? doc_start[d + 1] : len;
+    for (size_t i = s; i < e; i++) {
+      doc_of[i] = (uintE)d;
+      doc_end[i] = e - 1;  // position of the separator
+    }
+  });
+
+  // 2. suffix array + LCP, in memory
+  timer sat; sat.start();
+  auto SA = pbbs::suffix_array<uintT>(S);
+  auto LCP = pbbs::lcp(S, SA);
+  sat.stop(); sat.reportTotal("suffix array + lcp time");
+
+  // 3. overlap edges from SA-adjacent suffixes of different documents
+  using edge = std::tuple<uintE, uintE, uintE>;
+  auto cand = pbbs::sequence<edge>(LCP.size(), [&](size_t i) {
+    size_t a = SA[i], b = SA[i + 1];
+    uintE da = doc_of[a], db = doc_of[b];
+    // clamp: a shared prefix may not cross either document's separator
+    size_t l = std::min<size_t>(
+        LCP[i], std::min(doc_end[a] - a, doc_end[b] - b));
+    if (da != db && l >= min_lcp) {
+      if (db < da) std::swap(da, db);
+      return std::make_tuple(da, db, (uintE)l);
+    }
+    return std::make_tuple(UINT_E_MAX, UINT_E_MAX, (uintE)0);
+  });
+  auto live = pbbs::filter(cand, [](const edge& e) {
+    return std::get<0>(e) != UINT_E_MAX;
+  });
+
+  // aggregate parallel pairs (max overlap) and symmetrize
+  auto key_f = [&](const edge& e) {
+    return (uint64_t)std::get<0>(e) * num_docs + std::get<1>(e);
+  };
+  auto uniq = pbbslib::dyn_arr<edge>(live.size());
+  std::mutex mtx;
+  pbbs::group_by(live, key_f, [&](uint64_t key, auto slice) {
+    uintE w = 0;
+    for (size_t i = 0; i < slice.size(); i++) {
+      w = std::max(w, std::get<2>(slice[i]));
+    }
+    std::lock_guard<std::mutex> guard(mtx);
+    uniq.push_back(std::make_tuple(std::get<0>(slice[0]),
+                                   std::get<1>(slice[0]), w));
+  });
+  auto dir_edges = pbbs::sequence<edge>(2 * uniq.size, [&](size_t i) {
+    auto& e = uniq.A[i / 2];
+    return (i % 2) ? std::make_tuple(std::get<1>(e), std::get<0>(e),
+                                     std::get<2>(e))
+                   : e;
+  });
+  std::cout << "# overlap edges (undirected) = " << uniq.size << std::endl;
+
+  // 4. the similarity graph, straight from the edge array
+  auto G = sym_graph_from_edges<uintE>(
+      dir_edges, num_docs,
+      [](const edge& e) { return std::get<0>(e); },
+      [](const edge& e) { return std::get<1>(e); },
+      [](const edge& e) { return std::get<2>(e); });
+  alloc_init(G);
+  std::cout << "# graph: n = " << G.n << " m = " << G.m << std::endl;
+
+  // 5. near-duplicate clusters = connected components
+  auto ccs = workefficient_cc::CC(G);
+  auto flags = pbbs::sequence<uintE>(num_docs + 1, (uintE)0);
+  par_for(0, num_docs, pbbslib::kSequentialForThreshold, [&](size_t i) {
+    if (!flags[ccs[i]]) flags[ccs[i]] = 1;
+  });
+  size_t num_clusters = pbbslib::reduce_add(flags);
+  std::cout << "# clusters = " << num_clusters << std::endl;
+
+  if (char* out_f = P.getOptionValue("-clusters-out")) {
+    std::ofstream out(out_f);
+    for (size_t d = 0; d < num_docs; d++) out << ccs[d] << "\n";
+    std::cout << "# wrote cluster ids to " << out_f << std::endl;
+  }
+  G.del();
+  return 0;
+}
+
+}  // namespace gbbs
+
+int main(int argc, char* argv[]) {
+  return gbbs::string_graph_main(argc, argv);
+}
@@ -1,5 +1,13 @@
+#include <fcntl.h>
+#include <unistd.h>
+
 #include <iostream>
 #include <fstream>
+#include <vector>
+
+#ifdef GBBS_USE_ZSTD
+#include <zstd.h>
+#endif
 #include <stdlib.h>
 #include <cmath>
 
@@ -60,13 +68,136 @@ void print_edge_list(Graph& GA, std::string& outfile, bool direct_sym, bool mult
   if (multistep_header) {
     file << n << " " << m_out << std::endl;
   }
-  auto edges_chars = pbbslib::sequence_to_string(edges);
+  // only m_out entries are populated when filtering to u < v; the tail of
+  // `edges` is uninitialized
+  auto emitted = edges.slice(0, m_out);
+  auto edges_chars = pbbslib::sequence_to_string(emitted);
   file.write(edges_chars.begin(), edges_chars.size());
 
   file.close();
   std::cout << "Done" << std::endl;
 }
 
+/* Parallel ranged export: vertices split into ranges, each range decoded
+ * and rendered to text in parallel with exact output positioning (a scan
+ * over per-vertex text byte counts gives every range its file offset, so
+ * ranges pwrite concurrently into one file with no serialization point).
+ * With -zstd (build with ZSTD=1), each range becomes an independent zstd
+ * frame: the concatenated frames decompress with plain `zstd -d`, and a
+ * downstream consumer can decompress frames in parallel. */
+inline size_t decimal_digits(size_t x) {
+  size_t d = 1;
+  while (x >= 10) { x /= 10; d++; }
+  return d;
+}
+
+template <class Graph>
+void print_edge_list_ranged(Graph& GA, std::string& outfile, bool direct_sym,
+                            size_t n_ranges, bool use_zstd) {
+  using W = typename Graph::weight_type;
+  size_t n = GA.n;
+
+  // exact text bytes per vertex ("u v\n" per emitted edge)
+  auto text_bytes = pbbs::sequence<size_t>(n + 1, (size_t)0);
+  parallel_for(0, n, [&] (size_t i) {
+    size_t b = 0;
+    auto f = [&] (const uintE& u, const uintE& v, const W& wgh) {
+      if (!direct_sym || u < v) {
+        b += decimal_digits(u) + decimal_digits(v) + 2;
+      }
+    };
+    GA.get_vertex(i).out_neighbors().map(f, false);
+    text_bytes[i] = b;
+  });
+  size_t total_bytes = pbbslib::scan_add_inplace(text_bytes.slice());
+
+  int fd = open(outfile.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    std::cout << "Unable to open file: " << outfile << std::endl;
+    exit(0);
+  }
+  if (!use_zstd && ftruncate(fd, total_bytes) != 0) {
+    std::cout << "ftruncate failed" << std::endl;
+    exit(0);
+  }
+
+  size_t range_size = (n + n_ranges - 1) / n_ranges;
+  auto render_range = [&](size_t lo, size_t hi, char* buf) {
+    // renders vertices [lo, hi) at buf; returns bytes written
+    size_t k = 0;
+    for (size_t i = lo; i < hi; i++) {
+      auto f = [&] (const uintE& u, const uintE& v, const W& wgh) {
+        if (!direct_sym || u < v) {
+          k += sprintf(buf + k, "%u %u\n", u, v);
+        }
+      };
+      GA.get_vertex(i).out_neighbors().map(f, false);
+    }
+    return k;
+  };
+
+#ifdef GBBS_USE_ZSTD
+  if (use_zstd) {
+    // compress ranges in parallel, append frames in order
+    auto frames = std::vector<std::pair<char*, size_t>>(n_ranges, {nullptr, 0});
+    parallel_for(0, n_ranges, [&](size_t r) {
+      size_t lo = std::min(r * range_size, n);
+      size_t hi = std::min(lo + range_size, n);
+      if (lo >= hi) return;
+      size_t plain_sz = text_bytes[hi] - text_bytes[lo];
+      if (plain_sz == 0) return;
+      char* plain = (char*)malloc(plain_sz + 1);  // sprintf's trailing NUL
+      size_t got = render_range(lo, hi, plain);
+      assert(got == plain_sz);
+      size_t bound = ZSTD_compressBound(plain_sz);
+      char* comp = (char*)malloc(bound);
+      size_t csz = ZSTD_compress(comp, bound, plain, plain_sz, 3);
+      free(plain);
+      frames[r] = {comp, csz};
+    }, 1);
+    for (size_t r = 0; r < n_ranges; r++) {
+      if (frames[r].first != nullptr) {
+        ssize_t w = write(fd, frames[r].first, frames[r].second);
+        if (w != (ssize_t)frames[r].second) {
+          std::cout << "short write" << std::endl;
+          exit(0);
+        }
+        free(frames[r].first);
+      }
+    }
+    close(fd);
+    std::cout << "Done (zstd, " << n_ranges << " frames)" << std::endl;
+    return;
+  }
+#else
+  if (use_zstd) {
+    std::cout << "rebuild with ZSTD=1 for -zstd output" << std::endl;
+    exit(0);
+  }
+#endif
+
+  parallel_for(0, n_ranges, [&](size_t r) {
+    size_t lo = std::min(r * range_size, n);
+    size_t hi = std::min(lo + range_size, n);
+    if (lo >= hi) return;
+    size_t plain_sz = text_bytes[hi] - text_bytes[lo];
+    if (plain_sz == 0) return;
+    char* buf = (char*)malloc(plain_sz + 1);  // sprintf's trailing NUL
+    size_t got = render_range(lo, hi, buf);
+    assert(got == plain_sz);
+    size_t off = text_bytes[lo];
+    size_t done = 0;
+    while (done < plain_sz) {
+      ssize_t w = pwrite(fd, buf + done, plain_sz - done, off + done);
+      if (w <= 0) { std::cout << "pwrite failed" << std::endl; exit(0); }
+      done += w;
+    }
+    free(buf);
+  }, 1);
+  close(fd);
+  std::cout << "Done (" << n_ranges << " ranges)" << std::endl;
+}
+
 /* Format:
  * Emits a lexicographically sorted list of edges.
  *  n m              # header (once)
@@ -108,7 +239,8 @@ void print_edge_list_matrixmarket(Graph& GA, std::string& outfile) {
     exit(0);
   }
   file << n << " " << m_out << std::endl;
-  auto edges_chars = pbbslib::sequence_to_string(edges);
+  auto emitted = edges.slice(0, m_out);
+  auto edges_chars = pbbslib::sequence_to_string(emitted);
   file.write(edges_chars.begin(), edges_chars.size());
 
   file.close();
@@ -121,8 +253,13 @@ double Reorderer(Graph& GA, commandLine P) {
   auto direct_sym = P.getOptionValue("-direct_sym"); /* only emit { (u,v) | u < v } */
   auto multistep_header = P.getOptionValue("-multistep_header"); /* only emit { (u,v) | u < v } */
   auto matrixmarket_format = P.getOptionValue("-matrixmarket_format"); /* only emit { (u,v) | u < v } */
+  long n_ranges = P.getOptionLongValue("-ranges", 0);
+  bool use_zstd = P.getOptionValue("-zstd");
   if (matrixmarket_format) {
     print_edge_list_matrixmarket(GA, outfile);
+  } else if (n_ranges > 0 || use_zstd) {
+    print_edge_list_ranged(GA, outfile, direct_sym,
+                           std::max<long>(n_ranges, 1), use_zstd);
   } else {
     print_edge_list(GA, outfile, direct_sym, multistep_header);
   }